@@ -0,0 +1,293 @@
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+#include "bm_config.hpp"
+
+/**
+ * pairs each view and algorithm with the hand-written raw pointer loop of the same work, and fails
+ * when the runtime ratio of the view over the loop exceeds --penalty_max_ratio. the lambda_tensor
+ * functors are expected to be inlined into the loop of the algorithm, a compiler or refactor which
+ * breaks it shows up here as a ratio far above one.
+ */
+namespace {
+
+// the cases run sequentially, the parallel policies would only add noise to the ratio
+typedef tensor<float, 2> tensor_type;
+
+class penalty_case {
+   public:
+    explicit penalty_case(int_t side)
+        : ts_view_dst_(pointi<2>{side, side}), ts_raw_dst_(pointi<2>{side, side}) {}
+    virtual ~penalty_case() {}
+
+    virtual void run_view() = 0;
+    virtual void run_raw() = 0;
+
+    /// the max absolute difference of the two results, the pair must do the same work
+    float difference() const {
+        float re = 0;
+        for (int_t i = 0; i < ts_view_dst_.size(); ++i) {
+            re = std::max(re, std::abs(ts_view_dst_[i] - ts_raw_dst_[i]));
+        }
+        return re;
+    }
+
+    int_t size() const { return ts_view_dst_.size(); }
+
+   protected:
+    static tensor_type make_source(pointi<2> shape, float seed) {
+        tensor_type ts(shape);
+        for_index(0, ts.size(), [=](int_t i) { ts[i] = seed + (i % 97) * 0.25f; });
+        return ts;
+    }
+
+    tensor_type ts_view_dst_;
+    tensor_type ts_raw_dst_;
+};
+
+class map_case : public penalty_case {
+   public:
+    explicit map_case(int_t side)
+        : penalty_case(side), ts_src_(make_source(ts_view_dst_.shape(), 1.0f)) {}
+
+    void run_view() override {
+        copy(view::map(ts_src_, [](float v) { return v * 2.0f + 1.0f; }), ts_view_dst_);
+    }
+
+    void run_raw() override {
+        auto p_src = ts_src_.data();
+        auto p_dst = ts_raw_dst_.data();
+        for (int_t i = 0, size = ts_src_.size(); i < size; ++i) {
+            p_dst[i] = p_src[i] * 2.0f + 1.0f;
+        }
+    }
+
+   private:
+    tensor_type ts_src_;
+};
+
+class slice_case : public penalty_case {
+   public:
+    explicit slice_case(int_t side)
+        : penalty_case(side), ts_src_(make_source(pointi<2>{side + 2, side + 2}, 1.0f)) {}
+
+    void run_view() override {
+        copy(view::slice(ts_src_, pointi<2>{1, 1}, ts_view_dst_.shape()), ts_view_dst_);
+    }
+
+    void run_raw() override {
+        auto rows = ts_raw_dst_.shape(0);
+        auto cols = ts_raw_dst_.shape(1);
+        auto src_cols = ts_src_.shape(1);
+        auto p_src = ts_src_.data() + src_cols + 1;
+        auto p_dst = ts_raw_dst_.data();
+        for (int_t i = 0; i < rows; ++i) {
+            for (int_t j = 0; j < cols; ++j) {
+                p_dst[i * cols + j] = p_src[i * src_cols + j];
+            }
+        }
+    }
+
+   private:
+    tensor_type ts_src_;
+};
+
+class conv_case : public penalty_case {
+   public:
+    explicit conv_case(int_t side)
+        : penalty_case(side), ts_src_pad_(make_source(pointi<2>{side + 2, side + 2}, 1.0f)) {
+        for_index(kernel_.shape(), [&](pointi<2> idx) {
+            kernel_(idx) = 0.1f * (idx[0] * 3 + idx[1] + 1);
+        });
+    }
+
+    void run_view() override {
+        copy(view::conv(view::slice(ts_src_pad_, pointi<2>{1, 1}, ts_view_dst_.shape()), kernel_),
+             ts_view_dst_);
+    }
+
+    void run_raw() override {
+        float weights[9];
+        for (int_t a = 0; a < 3; ++a) {
+            for (int_t b = 0; b < 3; ++b) {
+                weights[a * 3 + b] = kernel_(pointi<2>{a, b});
+            }
+        }
+
+        auto rows = ts_raw_dst_.shape(0);
+        auto cols = ts_raw_dst_.shape(1);
+        auto src_cols = ts_src_pad_.shape(1);
+        auto p_src = ts_src_pad_.data();
+        auto p_dst = ts_raw_dst_.data();
+        for (int_t i = 0; i < rows; ++i) {
+            for (int_t j = 0; j < cols; ++j) {
+                float re = 0;
+                for (int_t a = 0; a < 3; ++a) {
+                    for (int_t b = 0; b < 3; ++b) {
+                        re += weights[a * 3 + b] * p_src[(i + a) * src_cols + j + b];
+                    }
+                }
+                p_dst[i * cols + j] = re;
+            }
+        }
+    }
+
+   private:
+    tensor_type ts_src_pad_;
+    local_tensor<float, dim<3, 3>> kernel_;
+};
+
+class binary_operator_case : public penalty_case {
+   public:
+    explicit binary_operator_case(int_t side)
+        : penalty_case(side),
+          ts_a_(make_source(ts_view_dst_.shape(), 1.0f)),
+          ts_b_(make_source(ts_view_dst_.shape(), 2.0f)),
+          ts_c_(make_source(ts_view_dst_.shape(), 3.0f)) {}
+
+    void run_view() override { copy((ts_a_ + ts_b_) * ts_c_ - ts_a_, ts_view_dst_); }
+
+    void run_raw() override {
+        auto p_a = ts_a_.data();
+        auto p_b = ts_b_.data();
+        auto p_c = ts_c_.data();
+        auto p_dst = ts_raw_dst_.data();
+        for (int_t i = 0, size = ts_a_.size(); i < size; ++i) {
+            p_dst[i] = (p_a[i] + p_b[i]) * p_c[i] - p_a[i];
+        }
+    }
+
+   private:
+    tensor_type ts_a_;
+    tensor_type ts_b_;
+    tensor_type ts_c_;
+};
+
+class transform_case : public penalty_case {
+   public:
+    explicit transform_case(int_t side)
+        : penalty_case(side), ts_src_(make_source(ts_view_dst_.shape(), 1.0f)) {}
+
+    void run_view() override {
+        transform(ts_src_, ts_view_dst_, [](float v) { return v * v - 0.5f; });
+    }
+
+    void run_raw() override {
+        auto p_src = ts_src_.data();
+        auto p_dst = ts_raw_dst_.data();
+        for (int_t i = 0, size = ts_src_.size(); i < size; ++i) {
+            p_dst[i] = p_src[i] * p_src[i] - 0.5f;
+        }
+    }
+
+   private:
+    tensor_type ts_src_;
+};
+
+struct pair_timing {
+    double view_seconds = 0;
+    int64_t view_iterations = 0;
+    double raw_seconds = 0;
+    int64_t raw_iterations = 0;
+};
+
+std::map<std::string, pair_timing>& timings() {
+    static std::map<std::string, pair_timing> instance;
+    return instance;
+}
+
+// records a side of a pair, the runs with most iterations are the final ones of the benchmark
+void run_side(benchmark::State& state, const std::string& name, penalty_case& pc, bool view) {
+    perf_counter_scope perf_scope(state);
+    auto t0 = std::chrono::steady_clock::now();
+    while (state.KeepRunning()) {
+        if (view) {
+            pc.run_view();
+        } else {
+            pc.run_raw();
+        }
+        benchmark::ClobberMemory();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    auto iterations = static_cast<int64_t>(state.iterations());
+    auto seconds = std::chrono::duration<double>(t1 - t0).count() / iterations;
+    auto& timing = timings()[name];
+    auto& side_seconds = view ? timing.view_seconds : timing.raw_seconds;
+    auto& side_iterations = view ? timing.view_iterations : timing.raw_iterations;
+    // the repetitions of the final run keep the best one
+    if (iterations > side_iterations || (iterations == side_iterations && seconds < side_seconds)) {
+        side_seconds = seconds;
+        side_iterations = iterations;
+    }
+
+    state.SetItemsProcessed(state.iterations() * pc.size());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string value;
+    double max_ratio = 1.5;
+    int_t side = 1_K;
+    if (parse_flag_value(argc, argv, "penalty_max_ratio", value)) max_ratio = std::stod(value);
+    if (parse_flag_value(argc, argv, "penalty_side", value)) side = std::stoi(value);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    perf_counters::instance().open();
+
+    std::vector<std::pair<std::string, std::shared_ptr<penalty_case>>> cases = {
+        {"view_map", std::make_shared<map_case>(side)},
+        {"view_slice", std::make_shared<slice_case>(side)},
+        {"view_conv3x3", std::make_shared<conv_case>(side)},
+        {"binary_operator_chain", std::make_shared<binary_operator_case>(side)},
+        {"transform", std::make_shared<transform_case>(side)},
+    };
+
+    int failed = 0;
+    for (auto& item : cases) {
+        auto name = item.first;
+        auto sp_case = item.second;
+        sp_case->run_view();
+        sp_case->run_raw();
+        if (sp_case->difference() > 1e-3f) {
+            std::cerr << name << ": the view and the raw loop differ by " << sp_case->difference()
+                      << std::endl;
+            ++failed;
+        }
+
+        benchmark::RegisterBenchmark(("bm_penalty_" + name + "_view").c_str(),
+                                     [=](benchmark::State& state) {
+                                         run_side(state, name, *sp_case, true);
+                                     });
+        benchmark::RegisterBenchmark(("bm_penalty_" + name + "_raw").c_str(),
+                                     [=](benchmark::State& state) {
+                                         run_side(state, name, *sp_case, false);
+                                     });
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+
+    std::cout << "\n" << std::left << std::setw(26) << "case" << std::right << std::setw(14)
+              << "view(us)" << std::setw(14) << "raw(us)" << std::setw(10) << "ratio" << "\n";
+    for (auto& item : timings()) {
+        auto& timing = item.second;
+        if (timing.view_iterations == 0 || timing.raw_iterations == 0) continue;
+
+        auto ratio = timing.view_seconds / timing.raw_seconds;
+        auto exceeded = ratio > max_ratio;
+        failed += exceeded;
+        std::cout << std::left << std::setw(26) << item.first << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(14) << timing.view_seconds * 1e6
+                  << std::setw(14) << timing.raw_seconds * 1e6 << std::setw(10) << ratio
+                  << (exceeded ? "  FAILED" : "") << "\n";
+    }
+    std::cout << "max ratio " << max_ratio << ", " << failed << " failed" << std::endl;
+
+    return failed ? 1 : 0;
+}
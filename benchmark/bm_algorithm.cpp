@@ -5,6 +5,7 @@ void bm_host_memcpy(benchmark::State& state) {
     tensor<float, 1> ts_src(ts_size);
     tensor<float, 1> ts_dst(ts_size);
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         memcpy(ts_dst.data(), ts_src.data(), sizeof(ts_src[0]) * ts_src.size());
         benchmark::DoNotOptimize(ts_dst.data());
@@ -14,6 +14,7 @@ inline void bm_tensor_fill(benchmark::State& state) {
 
     tensor_type ts_dst(shape);
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         fill(ts_dst, v);
         benchmark::DoNotOptimize(ts_dst.data());
@@ -35,6 +36,7 @@ inline void bm_tensor_for_each(benchmark::State& state) {
 
     tensor_type ts_dst(shape);
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         for_each(ts_dst, [v] MATAZURE_GENERAL(typename tensor_type::value_type & e) { e = v; });
 
@@ -56,6 +58,7 @@ inline void bm_tensor_copy(benchmark::State& state) {
     tensor_type ts_src(shape);
     tensor_type ts_dst(shape);
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         copy(ts_src, ts_dst);
         benchmark::DoNotOptimize(ts_dst.data());
@@ -78,6 +81,7 @@ inline void bm_tensor_transform(benchmark::State& state) {
 
     typedef typename tensor_type::value_type value_type;
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         transform(ts_src, ts_dst, [] MATAZURE_GENERAL(value_type & v) { return v; });
         benchmark::DoNotOptimize(ts_dst.data());
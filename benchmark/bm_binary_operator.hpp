@@ -11,6 +11,7 @@
         fill(ts1, zero<typename _Tensor::value_type>::value());                           \
         decltype((ts0 Op ts1).persist()) ts_re(ts0.shape());                              \
                                                                                           \
+        perf_counter_scope perf_scope(state);                                             \
         while (state.KeepRunning()) {                                                     \
             copy(ts0 Op ts1, ts_re);                                                      \
             benchmark::DoNotOptimize(ts_re.data());                                       \
@@ -2,7 +2,10 @@
 
 #include <benchmark/benchmark.h>
 #include <cmath>
+#include <cstring>
+#include <string>
 #include <mtensor.hpp>
+#include "bm_perf_counters.hpp"
 #include "padding_layout.hpp"
 
 using namespace matazure;
@@ -15,3 +18,18 @@ constexpr int_t operator"" _G(unsigned long long v) {
 }
 constexpr int_t operator"" _M(unsigned long long v) { return static_cast<int_t>(1000 * 1000 * v); }
 constexpr int_t operator"" _K(unsigned long long v) { return static_cast<int_t>(1000 * v); }
+
+/// strips the --name=value flag of a benchmark main from argv, the benchmark rejects unknown flags
+inline bool parse_flag_value(int& argc, char** argv, const char* name, std::string& value) {
+    auto prefix = std::string("--") + name + "=";
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], prefix.c_str(), prefix.size()) == 0) {
+            value = argv[i] + prefix.size();
+            std::copy(argv + i + 1, argv + argc, argv + i);
+            --argc;
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -27,6 +27,7 @@ inline void bm_tensor2f_general_roll_conv(benchmark::State& state) {
     tensor_type ts_src_pad(shape + kernel.shape() - 1);
     auto ts_src_view = view::slice(ts_src_pad, kernel_radius, shape);
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         _tmp::for_index(ts_dst.shape(), MLAMBDA(pointi<rank> idx) {
             auto re = zero<value_type>::value();
@@ -61,6 +62,7 @@ inline void bm_tensor2f_general_unroll_conv(benchmark::State& state) {
     tensor_type ts_src_pad(shape + kernel.shape() - 1);
     auto ts_src_view = view::slice(ts_src_pad, kernel_radius, shape);
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         _tmp::for_index(ts_dst.shape(), MLAMBDA(pointi<rank> idx) {
             // clang-format off
@@ -102,6 +104,7 @@ inline void bm_tensor2f_padding_layout_general_unroll_conv(benchmark::State& sta
     _tmp::tensor<value_type, rank, padding_layout<rank>> ts_src(shape, kernel_radius,
                                                                 kernel_radius);
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         _tmp::for_index(ts_dst.shape(), MLAMBDA(pointi<rank> idx) {
             // clang-format off
@@ -141,6 +144,7 @@ inline void bm_tensor2_view_conv_local_tensor3x3(benchmark::State& state) {
     auto ts_src_view = view::slice(ts_src_pad, kernel.shape() / 2, shape);
     tensor_type ts_dst(shape);
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         copy(view::conv(ts_src_view, kernel), ts_dst);
         benchmark::DoNotOptimize(ts_dst.data());
@@ -168,6 +172,7 @@ inline void bm_tensor_view_conv_tensor3x3(benchmark::State& state) {
     auto ts_src_view = view::slice(ts_src_pad, kernel.shape() / 2, shape);
     tensor_type ts_dst(shape);
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         copy(view::conv(ts_src_view, kernel), ts_dst);
         benchmark::DoNotOptimize(ts_dst.data());
@@ -203,6 +208,7 @@ inline void bm_tensor2_view_conv_neighbors_weights3x3(benchmark::State& state) {
     auto ts_src_view = view::slice(ts_src_pad, padding, shape);
     tensor_type ts_dst(shape);
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         copy(view::conv(ts_src_view, neightbors_weights), ts_dst);
         benchmark::DoNotOptimize(ts_dst.data());
@@ -227,6 +233,7 @@ inline void bm_tensor2_view_conv_stride2_relu6_local_tensor3x3(benchmark::State&
     auto ts_src_view = view::slice(ts_src_pad, kernel.shape() / 2, shape);
     tensor_type ts_dst(shape / 2);
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         auto ts_conv_view = view::conv(ts_src_view, kernel);
         auto ts_conv_stride_view = view::stride(ts_conv_view, pointi<2>{2, 2});
@@ -9,6 +9,7 @@ void bm_host_raw1f_copy(benchmark::State& state) {
     auto p_src = ts_src.data();
     auto p_dst = ts_dst.data();
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         for (int i = 0; i < total_size; ++i) {
             p_dst[i] = p_src[i];
@@ -33,6 +34,7 @@ void bm_tensor_for_array_index_copy(benchmark::State& state) {
     tensor_type ts_src(shape);
     tensor_type ts_dst(shape);
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         for_index(shape, [ts_src, ts_dst] MATAZURE_GENERAL(pointi<rank> idx) {
             ts_dst(idx) = ts_src(idx);
@@ -1,3 +1,10 @@
 #include "bm_config.hpp"
 
-BENCHMARK_MAIN();
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    // opens the counters before any benchmark creates its worker threads
+    perf_counters::instance().open();
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -41,6 +41,7 @@ void bm_matrix_vector_multiply(benchmark::State& state) {
     tensor<value_type, 1> vec(col);
     tensor<value_type, 1> vec_re(row);
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         matrix_vector_multiply(mat, vec, vec_re);
     }
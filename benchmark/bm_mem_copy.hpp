@@ -9,6 +9,7 @@ static void bm_tensor_mem_copy(benchmark::State& state) {
     _TensorSrc ts_src(state.range(0));
     _TensorDst ts_dst(ts_src.shape());
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         mem_copy(ts_src, ts_dst);
     }
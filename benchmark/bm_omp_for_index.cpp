@@ -18,6 +18,7 @@ void bm_tesnor1f_for_index_flops(benchmark::State& state) {
 
     int_t iterations = 1000;
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         for_index(shape, [=](pointi<1> idx) {
             auto tmp = ts_src(idx);
@@ -50,6 +51,7 @@ void bm_tesnor1f_omp_for_index_flops(benchmark::State& state) {
 
     int_t iterations = 1000;
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         for_index(omp_policy{}, shape, [=](pointi<1> idx) {
             auto tmp = ts_src(idx);
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#ifdef __linux__
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * hardware performance counters for the host benchmarks, by perf_event_open on linux.
+ *
+ * the counters are opened once by the benchmark main with inherit, so the threads created later
+ * (the openmp pool) are counted too, and only the user space is counted, which the default
+ * perf_event_paranoid level permits. an event which can't be opened, for example in a virtual
+ * machine or a container without the permission, is skipped, and without any event the benchmarks
+ * run as before with no counter reported.
+ */
+class perf_counters {
+   public:
+    enum event_id {
+        cycles,
+        instructions,
+        cache_misses,
+        l1d_read_misses,
+        dtlb_read_misses,
+        branch_misses,
+        event_size
+    };
+
+    static perf_counters& instance() {
+        static perf_counters counters;
+        return counters;
+    }
+
+    /// opens the events, it's called before any benchmark runs
+    void open() {
+        if (opened_) return;
+        opened_ = true;
+
+#ifdef __linux__
+        const uint64_t cache_read_miss = (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        open_event(cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        open_event(instructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        open_event(cache_misses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        open_event(l1d_read_misses, PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | cache_read_miss);
+        open_event(dtlb_read_misses, PERF_TYPE_HW_CACHE,
+                   PERF_COUNT_HW_CACHE_DTLB | cache_read_miss);
+        open_event(branch_misses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+
+        if (!available()) {
+            std::fprintf(stderr,
+                         "perf counters are unavailable (%s), check "
+                         "/proc/sys/kernel/perf_event_paranoid\n",
+                         error_.c_str());
+        }
+#else
+        std::fprintf(stderr, "perf counters are only supported on linux\n");
+#endif
+    }
+
+    bool available() const {
+        for (int i = 0; i < event_size; ++i) {
+            if (fds_[i] >= 0) return true;
+        }
+        return false;
+    }
+
+    bool available(event_id id) const { return fds_[id] >= 0; }
+
+    /// resets and enables the opened events
+    void start() {
+#ifdef __linux__
+        for (int i = 0; i < event_size; ++i) {
+            if (fds_[i] < 0) continue;
+            ioctl(fds_[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fds_[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /// disables the opened events and reads them, scaled up when the kernel multiplexed them
+    void stop(double* values) {
+        for (int i = 0; i < event_size; ++i) {
+            values[i] = 0;
+#ifdef __linux__
+            if (fds_[i] < 0) continue;
+            ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+            // value, time enabled, time running
+            uint64_t data[3] = {0, 0, 0};
+            if (read(fds_[i], data, sizeof(data)) != sizeof(data)) continue;
+            values[i] = data[2] ? static_cast<double>(data[0]) * data[1] / data[2] : 0;
+#endif
+        }
+    }
+
+   private:
+    perf_counters() : opened_(false) {
+        for (int i = 0; i < event_size; ++i) {
+            fds_[i] = -1;
+        }
+    }
+
+    ~perf_counters() {
+#ifdef __linux__
+        for (int i = 0; i < event_size; ++i) {
+            if (fds_[i] >= 0) close(fds_[i]);
+        }
+#endif
+    }
+
+#ifdef __linux__
+    void open_event(event_id id, uint32_t type, uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        fds_[id] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fds_[id] < 0 && error_.empty()) {
+            error_ = std::strerror(errno);
+        }
+    }
+#endif
+
+    bool opened_;
+    int fds_[event_size];
+    std::string error_;
+};
+
+/**
+ * @brief counts the hardware events from its construction to its destruction and reports them
+ * per iteration as the user counters of the benchmark, put it right before the benchmark loop
+ */
+class perf_counter_scope {
+   public:
+    explicit perf_counter_scope(benchmark::State& state) : state_(state) {
+        perf_counters::instance().start();
+    }
+
+    ~perf_counter_scope() {
+        auto& counters = perf_counters::instance();
+        double values[perf_counters::event_size];
+        counters.stop(values);
+        if (!counters.available() || state_.iterations() == 0) return;
+
+        const char* names[perf_counters::event_size] = {"cycles",      "instructions",
+                                                        "cache_misses", "L1D_misses",
+                                                        "dTLB_misses", "branch_misses"};
+        auto iterations = static_cast<double>(state_.iterations());
+        for (int i = 0; i < perf_counters::event_size; ++i) {
+            if (counters.available(static_cast<perf_counters::event_id>(i))) {
+                state_.counters[names[i]] = values[i] / iterations;
+            }
+        }
+        if (counters.available(perf_counters::cycles) &&
+            counters.available(perf_counters::instructions) && values[perf_counters::cycles] > 0) {
+            state_.counters["IPC"] =
+                values[perf_counters::instructions] / values[perf_counters::cycles];
+        }
+    }
+
+    perf_counter_scope(const perf_counter_scope&) = delete;
+    perf_counter_scope& operator=(const perf_counter_scope&) = delete;
+
+   private:
+    benchmark::State& state_;
+};
@@ -0,0 +1,272 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "bm_roofline.hpp"
+
+using roofline::kernel_cost;
+using roofline::policy_type;
+using roofline::stream_kernel;
+
+namespace {
+
+// the cases run on square float tensors of the side state.range(0), the default side is large
+// enough to stream from memory
+typedef tensor<float, 2> tensor_type;
+
+void bm_roofline_copy(benchmark::State& state) {
+    tensor_type ts_src(pointi<2>::all(state.range(0)));
+    tensor_type ts_dst(ts_src.shape());
+    fill(policy_type{}, ts_src, 1.0f);
+
+    double size = ts_dst.size();
+    roofline::run_case(state, "copy", kernel_cost{8 * size, 0, stream_kernel::copy}, [&]() {
+        copy(policy_type{}, ts_src, ts_dst);
+        benchmark::DoNotOptimize(ts_dst.data());
+    });
+}
+
+void bm_roofline_fill(benchmark::State& state) {
+    tensor_type ts_dst(pointi<2>::all(state.range(0)));
+
+    // there isn't a write only STREAM kernel, the copy bandwidth bounds it
+    double size = ts_dst.size();
+    roofline::run_case(state, "fill", kernel_cost{4 * size, 0, stream_kernel::copy}, [&]() {
+        fill(policy_type{}, ts_dst, 1.0f);
+        benchmark::DoNotOptimize(ts_dst.data());
+    });
+}
+
+void bm_roofline_for_each(benchmark::State& state) {
+    tensor_type ts(pointi<2>::all(state.range(0)));
+    fill(policy_type{}, ts, 1.0f);
+
+    double size = ts.size();
+    roofline::run_case(state, "for_each", kernel_cost{8 * size, size, stream_kernel::scale},
+                       [&]() {
+                           for_each(policy_type{}, ts, [](float& v) { v *= 0.5f; });
+                           benchmark::DoNotOptimize(ts.data());
+                       });
+}
+
+void bm_roofline_transform(benchmark::State& state) {
+    tensor_type ts_src(pointi<2>::all(state.range(0)));
+    tensor_type ts_dst(ts_src.shape());
+    fill(policy_type{}, ts_src, 1.0f);
+
+    double size = ts_dst.size();
+    roofline::run_case(state, "transform",
+                       kernel_cost{8 * size, 2 * size, stream_kernel::scale}, [&]() {
+                           transform(policy_type{}, ts_src, ts_dst,
+                                     [](float v) { return v * 2.0f + 1.0f; });
+                           benchmark::DoNotOptimize(ts_dst.data());
+                       });
+}
+
+void bm_roofline_reduce(benchmark::State& state) {
+    tensor_type ts_src(pointi<2>::all(state.range(0)));
+    fill(policy_type{}, ts_src, 1.0f);
+
+    // reduce only has the sequence policy, the gap to the parallel bound is expected
+    double size = ts_src.size();
+    roofline::run_case(state, "reduce", kernel_cost{4 * size, size, stream_kernel::copy}, [&]() {
+        auto re = reduce(ts_src, 0.0f, [](float lhs, float rhs) { return lhs + rhs; });
+        benchmark::DoNotOptimize(re);
+    });
+}
+
+void bm_roofline_view_slice(benchmark::State& state) {
+    tensor_type ts_src(pointi<2>::all(state.range(0)));
+    tensor_type ts_dst(ts_src.shape() / 2);
+    fill(policy_type{}, ts_src, 1.0f);
+
+    double size = ts_dst.size();
+    roofline::run_case(state, "view::slice", kernel_cost{8 * size, 0, stream_kernel::copy},
+                       [&]() {
+                           copy(policy_type{},
+                                view::slice(ts_src, ts_src.shape() / 4, ts_dst.shape()), ts_dst);
+                           benchmark::DoNotOptimize(ts_dst.data());
+                       });
+}
+
+void bm_roofline_view_stride(benchmark::State& state) {
+    tensor_type ts_src(pointi<2>::all(state.range(0)));
+    tensor_type ts_dst(ts_src.shape() / 2);
+    fill(policy_type{}, ts_src, 1.0f);
+
+    // the bytes are the touched elements, the skipped half of each cache line is the penalty
+    double size = ts_dst.size();
+    roofline::run_case(state, "view::stride", kernel_cost{8 * size, 0, stream_kernel::copy},
+                       [&]() {
+                           copy(policy_type{}, view::stride(ts_src, 2), ts_dst);
+                           benchmark::DoNotOptimize(ts_dst.data());
+                       });
+}
+
+void bm_roofline_view_permute(benchmark::State& state) {
+    tensor_type ts_src(pointi<2>::all(state.range(0)));
+    tensor_type ts_dst(ts_src.shape());
+    fill(policy_type{}, ts_src, 1.0f);
+
+    double size = ts_dst.size();
+    roofline::run_case(state, "view::permute", kernel_cost{8 * size, 0, stream_kernel::copy},
+                       [&]() {
+                           copy(policy_type{}, view::permute<1, 0>(ts_src), ts_dst);
+                           benchmark::DoNotOptimize(ts_dst.data());
+                       });
+}
+
+void bm_roofline_view_broadcast(benchmark::State& state) {
+    tensor<float, 1> ts_src(static_cast<int_t>(state.range(0)));
+    tensor_type ts_dst(pointi<2>::all(state.range(0)));
+    fill(policy_type{}, ts_src, 1.0f);
+
+    double size = ts_dst.size();
+    roofline::run_case(state, "view::broadcast",
+                       kernel_cost{4 * size + 4.0 * ts_src.size(), 0, stream_kernel::copy}, [&]() {
+                           copy(policy_type{}, view::broadcast(ts_src, ts_dst.shape()), ts_dst);
+                           benchmark::DoNotOptimize(ts_dst.data());
+                       });
+}
+
+void bm_roofline_view_zip(benchmark::State& state) {
+    tensor_type ts0(pointi<2>::all(state.range(0)));
+    tensor_type ts1(ts0.shape());
+    tensor<tuple<float, float>, 2> ts_dst(ts0.shape());
+    fill(policy_type{}, ts0, 1.0f);
+    fill(policy_type{}, ts1, 2.0f);
+
+    double size = ts_dst.size();
+    roofline::run_case(state, "view::zip", kernel_cost{16 * size, 0, stream_kernel::add}, [&]() {
+        copy(policy_type{}, view::zip(ts0, ts1), ts_dst);
+        benchmark::DoNotOptimize(ts_dst.data());
+    });
+}
+
+void bm_roofline_view_cast(benchmark::State& state) {
+    tensor_type ts_src(pointi<2>::all(state.range(0)));
+    tensor<int, 2> ts_dst(ts_src.shape());
+    fill(policy_type{}, ts_src, 1.0f);
+
+    double size = ts_dst.size();
+    roofline::run_case(state, "view::cast", kernel_cost{8 * size, 0, stream_kernel::copy},
+                       [&]() {
+                           copy(policy_type{}, view::cast<int>(ts_src), ts_dst);
+                           benchmark::DoNotOptimize(ts_dst.data());
+                       });
+}
+
+void bm_roofline_view_map(benchmark::State& state) {
+    tensor_type ts_src(pointi<2>::all(state.range(0)));
+    tensor_type ts_dst(ts_src.shape());
+    fill(policy_type{}, ts_src, 1.0f);
+
+    double size = ts_dst.size();
+    roofline::run_case(state, "view::map", kernel_cost{8 * size, 2 * size, stream_kernel::scale},
+                       [&]() {
+                           copy(policy_type{},
+                                view::map(ts_src, [](float v) { return v * 2.0f + 1.0f; }),
+                                ts_dst);
+                           benchmark::DoNotOptimize(ts_dst.data());
+                       });
+}
+
+void bm_roofline_view_gather(benchmark::State& state) {
+    tensor_type ts_src(pointi<2>::all(state.range(0)));
+    tensor<int_t, 1> ts_indices(ts_src.shape(1) / 2);
+    for_index(0, ts_indices.size(), [=](int_t i) { ts_indices[i] = 2 * i + 1; });
+    tensor_type ts_dst(pointi<2>{ts_src.shape(0), ts_indices.size()});
+    fill(policy_type{}, ts_src, 1.0f);
+
+    // each gathered element reads its index too
+    double size = ts_dst.size();
+    roofline::run_case(state, "view::gather", kernel_cost{12 * size, 0, stream_kernel::add},
+                       [&]() {
+                           copy(policy_type{}, view::gather<1>(ts_src, ts_indices), ts_dst);
+                           benchmark::DoNotOptimize(ts_dst.data());
+                       });
+}
+
+void bm_roofline_view_conv(benchmark::State& state) {
+    local_tensor<float, dim<3, 3>> kernel;
+    fill(kernel, 1.0f / 9);
+    pointi<2> shape = pointi<2>::all(state.range(0));
+    tensor_type ts_src_pad(shape + kernel.shape() - 1);
+    auto ts_src_view = view::slice(ts_src_pad, kernel.shape() / 2, shape);
+    tensor_type ts_dst(shape);
+    fill(policy_type{}, ts_src_pad, 1.0f);
+
+    double size = ts_dst.size();
+    roofline::run_case(state, "view::conv",
+                       kernel_cost{8 * size, 2 * kernel.size() * size, stream_kernel::copy},
+                       [&]() {
+                           copy(policy_type{}, view::conv(ts_src_view, kernel), ts_dst);
+                           benchmark::DoNotOptimize(ts_dst.data());
+                       });
+}
+
+void bm_roofline_view_mask(benchmark::State& state) {
+    tensor_type ts_src(pointi<2>::all(state.range(0)));
+    tensor<bool, 2> ts_mask(ts_src.shape());
+    tensor_type ts_dst(ts_src.shape());
+    fill(policy_type{}, ts_src, 1.0f);
+    for_index(0, ts_mask.size(), [=](int_t i) { ts_mask[i] = i % 3 != 0; });
+
+    // the skipped writes still own their cache lines, the whole dest is counted
+    double size = ts_dst.size();
+    roofline::run_case(state, "view::mask", kernel_cost{9 * size, 0, stream_kernel::add}, [&]() {
+        copy(policy_type{}, ts_src, view::mask(ts_dst, ts_mask));
+        benchmark::DoNotOptimize(ts_dst.data());
+    });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string json_path = "bm_roofline.json";
+    std::string value;
+    int_t stream_size = 1 << 25;
+    int_t side = 4_K;
+    parse_flag_value(argc, argv, "roofline_out", json_path);
+    if (parse_flag_value(argc, argv, "roofline_stream_size", value)) stream_size = std::stoi(value);
+    if (parse_flag_value(argc, argv, "roofline_side", value)) side = std::stoi(value);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    perf_counters::instance().open();
+
+    roofline::peak() = roofline::measure_machine_peak(stream_size);
+    auto& mp = roofline::peak();
+    std::cout << "STREAM copy " << mp.bandwidth[0] * 1e-9 << " GB/s, scale "
+              << mp.bandwidth[1] * 1e-9 << " GB/s, add " << mp.bandwidth[2] * 1e-9
+              << " GB/s, triad " << mp.bandwidth[3] * 1e-9 << " GB/s, peak "
+              << mp.flops * 1e-9 << " GFLOP/s" << std::endl;
+
+    typedef void (*case_fun)(benchmark::State&);
+    const std::pair<const char*, case_fun> cases[] = {
+        {"bm_roofline_copy", bm_roofline_copy},
+        {"bm_roofline_fill", bm_roofline_fill},
+        {"bm_roofline_for_each", bm_roofline_for_each},
+        {"bm_roofline_transform", bm_roofline_transform},
+        {"bm_roofline_reduce", bm_roofline_reduce},
+        {"bm_roofline_view_slice", bm_roofline_view_slice},
+        {"bm_roofline_view_stride", bm_roofline_view_stride},
+        {"bm_roofline_view_permute", bm_roofline_view_permute},
+        {"bm_roofline_view_broadcast", bm_roofline_view_broadcast},
+        {"bm_roofline_view_zip", bm_roofline_view_zip},
+        {"bm_roofline_view_cast", bm_roofline_view_cast},
+        {"bm_roofline_view_map", bm_roofline_view_map},
+        {"bm_roofline_view_gather", bm_roofline_view_gather},
+        {"bm_roofline_view_conv", bm_roofline_view_conv},
+        {"bm_roofline_view_mask", bm_roofline_view_mask},
+    };
+    for (auto& item : cases) {
+        benchmark::RegisterBenchmark(item.first, item.second)->Arg(side)->UseRealTime();
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+
+    std::ofstream ofs(json_path);
+    roofline::write_json(ofs);
+    std::cout << "roofline report: " << json_path << std::endl;
+    return 0;
+}
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <string>
+#include "bm_config.hpp"
+
+#ifdef MATAZURE_OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * a roofline reference for the host benchmarks.
+ *
+ * the machine peaks are measured once by STREAM like copy/scale/add/triad kernels and a register
+ * resident multiply-add kernel, with the same policy and compiler flags as the cases. every case
+ * declares the bytes and flops of one iteration and the STREAM kernel with the matched access
+ * pattern, the attainable time is max(bytes / bandwidth, flops / peak flops), the case is reported
+ * as the percent of the attainable time over the measured one.
+ */
+namespace roofline {
+
+#ifdef MATAZURE_OPENMP
+typedef omp_policy policy_type;
+#else
+typedef sequence_policy policy_type;
+#endif
+
+/// the STREAM kernels, the cases name the one whose streams match their own
+enum struct stream_kernel { copy, scale, add, triad };
+
+inline const char* stream_kernel_name(stream_kernel kernel) {
+    switch (kernel) {
+        case stream_kernel::copy:
+            return "copy";
+        case stream_kernel::scale:
+            return "scale";
+        case stream_kernel::add:
+            return "add";
+        default:
+            return "triad";
+    }
+}
+
+/// the measured peaks of the host, the bandwidths are in bytes/s and the flops in flop/s
+struct machine_peak {
+    double bandwidth[4];
+    double flops;
+
+    double stream_bandwidth(stream_kernel kernel) const {
+        return bandwidth[static_cast<int_t>(kernel)];
+    }
+};
+
+namespace internal {
+
+template <typename _Fun>
+inline double best_seconds(int_t repeats, _Fun fun) {
+    auto re = 1e30;
+    for (int_t i = 0; i < repeats; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        fun();
+        auto t1 = std::chrono::steady_clock::now();
+        re = std::min(re, std::chrono::duration<double>(t1 - t0).count());
+    }
+    return re;
+}
+
+// the lanes are independent multiply-add chains, enough of them to hide the latency of the
+// vectorized multiply-add of the host
+static const int_t flops_lanes = 128;
+
+inline void multiply_add_lanes(float* lanes, int_t steps) {
+    const float a = 0.999999f;
+    const float b = 1e-7f;
+    for (int_t step = 0; step < steps; ++step) {
+        for (int_t j = 0; j < flops_lanes; ++j) {
+            lanes[j] = lanes[j] * a + b;
+        }
+    }
+}
+
+}  // namespace internal
+
+/**
+ * @brief measures the STREAM bandwidths and the multiply-add peak of the host
+ * @param size the element size of each STREAM array, it should be far larger than the last level
+ * cache
+ * @param repeats the repeats of each kernel, the best one is kept as STREAM does
+ */
+inline machine_peak measure_machine_peak(int_t size, int_t repeats = 5) {
+    policy_type policy{};
+    tensor<float, 1> ts_a(size);
+    tensor<float, 1> ts_b(size);
+    tensor<float, 1> ts_c(size);
+    auto p_a = ts_a.data();
+    auto p_b = ts_b.data();
+    auto p_c = ts_c.data();
+    // first touch by the policy, so the pages are placed where the kernels run
+    for_index(policy, 0, size, [=](int_t i) {
+        p_a[i] = 1.0f;
+        p_b[i] = 2.0f;
+        p_c[i] = 0.0f;
+    });
+
+    const float scalar = 3.0f;
+    const double bytes = static_cast<double>(size) * sizeof(float);
+    machine_peak re;
+    re.bandwidth[0] = 2 * bytes / internal::best_seconds(repeats, [=]() {
+        for_index(policy, 0, size, [=](int_t i) { p_c[i] = p_a[i]; });
+    });
+    re.bandwidth[1] = 2 * bytes / internal::best_seconds(repeats, [=]() {
+        for_index(policy, 0, size, [=](int_t i) { p_b[i] = scalar * p_c[i]; });
+    });
+    re.bandwidth[2] = 3 * bytes / internal::best_seconds(repeats, [=]() {
+        for_index(policy, 0, size, [=](int_t i) { p_c[i] = p_a[i] + p_b[i]; });
+    });
+    re.bandwidth[3] = 3 * bytes / internal::best_seconds(repeats, [=]() {
+        for_index(policy, 0, size, [=](int_t i) { p_a[i] = p_b[i] + scalar * p_c[i]; });
+    });
+    benchmark::DoNotOptimize(p_a);
+
+    // each work item runs its own lanes, one item per hardware thread for the parallel policy
+    const int_t steps = 1 << 16;
+    int_t work_size = 1;
+#ifdef MATAZURE_OPENMP
+    work_size = omp_get_max_threads();
+#endif
+    tensor<float, 2> ts_lanes(pointi<2>{work_size, internal::flops_lanes});
+    fill(ts_lanes, 1.0f);
+    auto p_lanes = ts_lanes.data();
+    auto seconds = internal::best_seconds(repeats, [=]() {
+        for_index(policy, 0, work_size, [=](int_t i) {
+            internal::multiply_add_lanes(p_lanes + i * internal::flops_lanes, steps);
+        });
+    });
+    benchmark::DoNotOptimize(p_lanes);
+    re.flops = 2.0 * internal::flops_lanes * steps * work_size / seconds;
+
+    return re;
+}
+
+/// the machine peak shared by all cases, it's measured by the benchmark main before any case runs
+inline machine_peak& peak() {
+    static machine_peak instance = {{0, 0, 0, 0}, 0};
+    return instance;
+}
+
+/// the work of one iteration of a case
+struct kernel_cost {
+    double bytes;
+    double flops;
+    stream_kernel kernel;
+};
+
+/// the attainable seconds of a kernel on the roofline of a machine
+inline double bound_seconds(const machine_peak& mp, const kernel_cost& cost) {
+    auto memory_seconds = cost.bytes / mp.stream_bandwidth(cost.kernel);
+    auto compute_seconds = mp.flops > 0 ? cost.flops / mp.flops : 0.0;
+    return std::max(memory_seconds, compute_seconds);
+}
+
+/// the measurement of a case
+struct case_result {
+    kernel_cost cost;
+    double seconds;
+    int64_t iterations;
+};
+
+/// the results of the cases by name, a repeated case keeps its last run which has most iterations
+inline std::map<std::string, case_result>& results() {
+    static std::map<std::string, case_result> instance;
+    return instance;
+}
+
+/**
+ * @brief runs a case and records it on the roofline
+ * @param state the benchmark state
+ * @param name the case name in the json report
+ * @param cost the work of one iteration
+ * @param fun the case body, () -> none pattern
+ */
+template <typename _Fun>
+inline void run_case(benchmark::State& state, const std::string& name, kernel_cost cost,
+                     _Fun fun) {
+    perf_counter_scope perf_scope(state);
+    auto t0 = std::chrono::steady_clock::now();
+    while (state.KeepRunning()) {
+        fun();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    auto iterations = static_cast<int64_t>(state.iterations());
+    auto seconds = std::chrono::duration<double>(t1 - t0).count() / iterations;
+    results()[name] = case_result{cost, seconds, iterations};
+
+    state.SetBytesProcessed(static_cast<int64_t>(cost.bytes) * iterations);
+    state.counters["GFLOP/s"] = cost.flops / seconds * 1e-9;
+    state.counters["roofline_%"] = 100.0 * bound_seconds(peak(), cost) / seconds;
+}
+
+/// writes the machine peak and the recorded cases as json
+inline void write_json(std::ostream& os) {
+    auto& mp = peak();
+    os << "{\n  \"machine\": {";
+    for (int_t i = 0; i < 4; ++i) {
+        os << "\"" << stream_kernel_name(static_cast<stream_kernel>(i))
+           << "_GBps\": " << mp.bandwidth[i] * 1e-9 << ", ";
+    }
+    os << "\"GFLOPs\": " << mp.flops * 1e-9 << "},\n  \"cases\": [";
+
+    bool first = true;
+    for (auto& item : results()) {
+        auto& r = item.second;
+        auto bound = bound_seconds(mp, r.cost);
+        auto memory_bound = r.cost.bytes / mp.stream_bandwidth(r.cost.kernel) >= bound;
+        os << (first ? "\n" : ",\n") << "    {\"name\": \"" << item.first << "\", "
+           << "\"stream_kernel\": \"" << stream_kernel_name(r.cost.kernel) << "\", "
+           << "\"bound\": \"" << (memory_bound ? "memory" : "compute") << "\", "
+           << "\"bytes\": " << r.cost.bytes << ", \"flops\": " << r.cost.flops << ", "
+           << "\"arithmetic_intensity\": " << (r.cost.bytes > 0 ? r.cost.flops / r.cost.bytes : 0)
+           << ", \"iterations\": " << r.iterations << ", \"seconds\": " << r.seconds << ", "
+           << "\"GBps\": " << r.cost.bytes / r.seconds * 1e-9 << ", "
+           << "\"GFLOPs\": " << r.cost.flops / r.seconds * 1e-9 << ", "
+           << "\"bound_seconds\": " << bound << ", "
+           << "\"percent_of_bound\": " << 100.0 * bound / r.seconds << "}";
+        first = false;
+    }
+    os << "\n  ]\n}\n";
+}
+
+}  // namespace roofline
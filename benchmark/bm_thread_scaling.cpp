@@ -0,0 +1,214 @@
+#include <omp.h>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <tuple>
+#include <vector>
+#include "bm_config.hpp"
+
+/**
+ * sweeps the thread count, the problem size and the parallel policy over the representative
+ * kernels, and reports the speedup and the efficiency over the one thread run of the same kernel,
+ * size and policy, as tables and as csv (--scaling_out, default bm_thread_scaling.csv).
+ *
+ * the sizes are the sides of square float tensors, from l1 resident to memory bound, and the
+ * thread counts default to the powers of two up to the processor count and the count itself.
+ */
+namespace {
+
+typedef tensor<float, 2> tensor_type;
+typedef double (*kernel_fun)(benchmark::State&, omp_policy, int_t);
+
+/// runs the benchmark loop, returns its seconds per iteration without the setup of the kernel
+template <typename _Fun>
+double timed_loop(benchmark::State& state, _Fun fun) {
+    perf_counter_scope perf_scope(state);
+    auto t0 = std::chrono::steady_clock::now();
+    while (state.KeepRunning()) {
+        fun();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count() / state.iterations();
+}
+
+double scaling_copy(benchmark::State& state, omp_policy policy, int_t side) {
+    tensor_type ts_src(pointi<2>{side, side});
+    tensor_type ts_dst(ts_src.shape());
+    fill(policy, ts_src, 1.0f);
+    fill(policy, ts_dst, 0.0f);
+
+    return timed_loop(state, [&]() {
+        copy(policy, ts_src, ts_dst);
+        benchmark::DoNotOptimize(ts_dst.data());
+    });
+}
+
+double scaling_transform(benchmark::State& state, omp_policy policy, int_t side) {
+    tensor_type ts_src(pointi<2>{side, side});
+    tensor_type ts_dst(ts_src.shape());
+    fill(policy, ts_src, 1.0f);
+    fill(policy, ts_dst, 0.0f);
+
+    return timed_loop(state, [&]() {
+        transform(policy, ts_src, ts_dst, [](float v) { return v * 2.0f + 1.0f; });
+        benchmark::DoNotOptimize(ts_dst.data());
+    });
+}
+
+double scaling_reduce(benchmark::State& state, omp_policy policy, int_t side) {
+    tensor_type ts_src(pointi<2>{side, side});
+    fill(policy, ts_src, 1.0f);
+    // the tensor reduce is sequential, the dynamic_tensor one runs rows by the policy
+    auto ts_dynamic = dynamic_tensor_wrap(ts_src);
+
+    return timed_loop(state, [&]() {
+        auto ts_re = reduce(policy, ts_dynamic, reduce_op::sum);
+        benchmark::DoNotOptimize(ts_re.data<float>());
+    });
+}
+
+double scaling_conv3x3(benchmark::State& state, omp_policy policy, int_t side) {
+    local_tensor<float, dim<3, 3>> kernel;
+    fill(kernel, 1.0f / 9);
+    pointi<2> shape{side, side};
+    tensor_type ts_src_pad(shape + kernel.shape() - 1);
+    tensor_type ts_dst(shape);
+    fill(policy, ts_src_pad, 1.0f);
+    fill(policy, ts_dst, 0.0f);
+    auto ts_src_view = view::slice(ts_src_pad, kernel.shape() / 2, shape);
+
+    return timed_loop(state, [&]() {
+        copy(policy, view::conv(ts_src_view, kernel), ts_dst);
+        benchmark::DoNotOptimize(ts_dst.data());
+    });
+}
+
+double scaling_permute(benchmark::State& state, omp_policy policy, int_t side) {
+    tensor_type ts_src(pointi<2>{side, side});
+    tensor_type ts_dst(ts_src.shape());
+    fill(policy, ts_src, 1.0f);
+    fill(policy, ts_dst, 0.0f);
+
+    return timed_loop(state, [&]() {
+        copy(policy, view::permute<1, 0>(ts_src), ts_dst);
+        benchmark::DoNotOptimize(ts_dst.data());
+    });
+}
+
+// kernel, side, policy, threads
+typedef std::tuple<std::string, int_t, std::string, int_t> scaling_key;
+
+std::map<scaling_key, double>& timings() {
+    static std::map<scaling_key, double> instance;
+    return instance;
+}
+
+/// runs a kernel with a thread count and records the seconds per iteration of its final run
+void run_scaling(benchmark::State& state, const scaling_key& key, kernel_fun kernel) {
+    auto threads = std::get<3>(key);
+    auto max_threads = omp_get_max_threads();
+    omp_set_num_threads(threads);
+
+    timings()[key] = kernel(state, omp_policy{}, std::get<1>(key));
+
+    omp_set_num_threads(max_threads);
+    auto side = static_cast<int64_t>(std::get<1>(key));
+    state.SetItemsProcessed(state.iterations() * side * side);
+}
+
+std::vector<int_t> parse_int_list(const std::string& str) {
+    std::vector<int_t> re;
+    std::istringstream iss(str);
+    std::string item;
+    while (std::getline(iss, item, ',')) {
+        if (!item.empty()) re.push_back(std::stoi(item));
+    }
+    return re;
+}
+
+std::vector<int_t> default_threads() {
+    std::vector<int_t> re;
+    auto procs = omp_get_num_procs();
+    for (int_t t = 1; t < procs; t *= 2) {
+        re.push_back(t);
+    }
+    re.push_back(procs);
+    return re;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string csv_path = "bm_thread_scaling.csv";
+    std::string value;
+    auto threads_list = default_threads();
+    // about l1, l2, last level cache and memory resident
+    std::vector<int_t> sides = {48, 192, 1_K, 4_K};
+    parse_flag_value(argc, argv, "scaling_out", csv_path);
+    if (parse_flag_value(argc, argv, "scaling_threads", value)) {
+        threads_list = parse_int_list(value);
+    }
+    if (parse_flag_value(argc, argv, "scaling_sides", value)) sides = parse_int_list(value);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    perf_counters::instance().open();
+
+    const std::pair<const char*, kernel_fun> kernels[] = {
+        {"copy", scaling_copy},       {"transform", scaling_transform},
+        {"reduce", scaling_reduce},   {"conv3x3", scaling_conv3x3},
+        {"permute", scaling_permute},
+    };
+    // omp is the only host parallel policy, a new one adds its kernels and its name to the sweep
+    const char* policy = "omp";
+
+    for (auto& kernel : kernels) {
+        for (auto side : sides) {
+            for (auto threads : threads_list) {
+                scaling_key key(kernel.first, side, policy, threads);
+                std::ostringstream oss;
+                oss << "bm_scaling_" << kernel.first << "/" << side << "/" << policy
+                    << "/threads:" << threads;
+                auto fun = kernel.second;
+                benchmark::RegisterBenchmark(oss.str().c_str(), [=](benchmark::State& state) {
+                    run_scaling(state, key, fun);
+                })->UseRealTime();
+            }
+        }
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+
+    std::ofstream ofs(csv_path);
+    ofs << "kernel,side,policy,threads,seconds,speedup,efficiency\n";
+    std::string table_name;
+    for (auto& item : timings()) {
+        auto& key = item.first;
+        auto base_it = timings().find(
+            scaling_key(std::get<0>(key), std::get<1>(key), std::get<2>(key), 1));
+        auto speedup = base_it != timings().end() ? base_it->second / item.second : 0.0;
+        auto efficiency = speedup / std::get<3>(key);
+
+        ofs << std::get<0>(key) << "," << std::get<1>(key) << "," << std::get<2>(key) << ","
+            << std::get<3>(key) << "," << item.second << "," << speedup << "," << efficiency
+            << "\n";
+
+        auto name = std::get<0>(key) + "/" + std::to_string(std::get<1>(key)) + "/" +
+                    std::get<2>(key);
+        if (name != table_name) {
+            table_name = name;
+            std::cout << "\n" << name << "\n"
+                      << std::setw(10) << "threads" << std::setw(14) << "time(us)"
+                      << std::setw(10) << "speedup" << std::setw(12) << "efficiency" << "\n";
+        }
+        std::cout << std::fixed << std::setprecision(2) << std::setw(10) << std::get<3>(key)
+                  << std::setw(14) << item.second * 1e6 << std::setw(10) << speedup
+                  << std::setw(12) << efficiency << "\n";
+    }
+    std::cout << "\nscaling csv: " << csv_path << std::endl;
+
+    return 0;
+}
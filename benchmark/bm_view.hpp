@@ -9,6 +9,7 @@ inline void bm_tensor_view_slice(benchmark::State& state) {
     auto dst_shape = ts_src.shape() / 2;
     tensor_type ts_dst(dst_shape);
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         copy(view::slice(ts_src, center, dst_shape), ts_dst);
         benchmark::DoNotOptimize(ts_dst.data());
@@ -25,6 +26,7 @@ inline void bm_tensor_view_stride(benchmark::State& state) {
     auto dst_shape = ts_src.shape() / 2;
     tensor_type ts_dst(dst_shape);
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         copy(view::stride(ts_src, 2), ts_dst);
         benchmark::DoNotOptimize(ts_dst.data());
@@ -42,6 +44,7 @@ inline void bm_tensor_view_gather_scalar_axis0(benchmark::State& state) {
     dst_tensor_type ts_dst(gather_point<0>(ts_src.shape()));
 
     int i = 0;
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         ++i;
         copy(view::gather<0>(ts_src, i % ts_src.shape(0)), ts_dst);
@@ -60,6 +63,7 @@ inline void bm_tensor_view_gather_scalar_axis1(benchmark::State& state) {
     dst_tensor_type ts_dst(gather_point<1>(ts_src.shape()));
 
     int i = 0;
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         ++i;
         copy(view::gather<1>(ts_src, i % ts_src.shape(1)), ts_dst);
@@ -83,6 +87,7 @@ inline void bm_tensor_view_zip2(benchmark::State& state) {
 
     tensor_tuple_type ts_dst(ts0.shape());
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         copy(view::zip(ts0, ts1), ts_dst);
         benchmark::DoNotOptimize(ts_dst.data());
@@ -99,6 +104,7 @@ inline void bm_tensor_view_eye(benchmark::State& state) {
     tensor_type ts_dst(pointi<tensor_type::rank>::all(state.range(0)));
     auto center = ts_dst.shape() / 4;
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         copy(view::eye<typename tensor_type::value_type>(ts_dst.shape(), ts_dst.runtime(),
                                                          ts_dst.layout()),
@@ -121,6 +127,7 @@ inline void bm_tensor_view_meshgrid2(benchmark::State& state) {
     vector_type v0(shape[0]);
     vector_type v1(shape[1]);
 
+    perf_counter_scope perf_scope(state);
     while (state.KeepRunning()) {
         copy(view::meshgrid(v0, v1), ts);
         benchmark::DoNotOptimize(ts.data());
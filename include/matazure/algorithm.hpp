@@ -2,6 +2,7 @@
 
 #include <matazure/for_index.hpp>
 #include <matazure/layout.hpp>
+#include <matazure/trace.hpp>
 
 namespace matazure {
 
@@ -15,6 +16,8 @@ template <typename _ExectutionPolicy, typename _Tensor, typename _Fun>
 inline void for_each(_ExectutionPolicy policy, _Tensor&& ts, _Fun fun,
                      enable_if_t<are_linear_index<decay_t<_Tensor>>::value &&
                                  none_device_memory<decay_t<_Tensor>>::value>* = 0) {
+    MATAZURE_TRACE_SCOPE("for_each", policy, ts.shape(), trace::element_size(ts),
+                         trace::tensor_bytes(ts), 0);
     for_index(policy, 0, ts.size(), [&](int_t i) { fun(ts[i]); });
 }
 
@@ -28,6 +31,8 @@ template <typename _ExectutionPolicy, typename _Tensor, typename _Fun>
 inline void for_each(_ExectutionPolicy policy, _Tensor&& ts, _Fun fun,
                      enable_if_t<!are_linear_index<decay_t<_Tensor>>::value &&
                                  none_device_memory<decay_t<_Tensor>>::value>* = 0) {
+    MATAZURE_TRACE_SCOPE("for_each", policy, ts.shape(), trace::element_size(ts),
+                         trace::tensor_bytes(ts), 0);
     for_index(policy, zero<pointi<decay_t<_Tensor>::rank>>::value(), ts.shape(),
               [&](pointi<decay_t<_Tensor>::rank> idx) {
                   fun(ts(internal::get_array_index_by_layout(idx, ts.layout())));
@@ -57,6 +62,8 @@ inline void for_each(
 template <typename _ExectutionPolicy, typename _Tensor, typename _ValueType>
 inline void fill(_ExectutionPolicy policy, _Tensor&& ts, _ValueType v,
                  enable_if_t<none_device_memory<decay_t<_Tensor>>::value>* = 0) {
+    MATAZURE_TRACE_SCOPE("fill", policy, ts.shape(), trace::element_size(ts), 0,
+                         trace::tensor_bytes(ts));
     static_assert(is_assignable<typename decay_t<_Tensor>::reference, _ValueType>::value,
                   "the type of v is not convertiable to the value_type of ts");
     for_each(policy, std::forward<_Tensor>(ts),
@@ -88,6 +95,8 @@ inline void copy(
     _ExectutionPolicy policy, const _TensorSrc& ts_src, _TensorDst&& ts_dst,
     enable_if_t<are_linear_index<decay_t<_TensorSrc>, decay_t<_TensorDst>>::value &&
                 none_device_memory<decay_t<_TensorSrc>, decay_t<_TensorDst>>::value>* = 0) {
+    MATAZURE_TRACE_SCOPE("copy", policy, ts_src.shape(), trace::element_size(ts_src),
+                         trace::tensor_bytes(ts_src), trace::tensor_bytes(ts_dst));
     for_index(policy, 0, ts_src.size(), [&](int_t i) { ts_dst[i] = ts_src[i]; });
 }
 
@@ -102,6 +111,8 @@ inline void copy(
     _ExectutionPolicy policy, const _TensorSrc& ts_src, _TensorDst&& ts_dst,
     enable_if_t<!are_linear_index<decay_t<_TensorSrc>, decay_t<_TensorDst>>::value &&
                 none_device_memory<decay_t<_TensorSrc>, decay_t<_TensorDst>>::value>* = 0) {
+    MATAZURE_TRACE_SCOPE("copy", policy, ts_src.shape(), trace::element_size(ts_src),
+                         trace::tensor_bytes(ts_src), trace::tensor_bytes(ts_dst));
     for_index(policy, zero<pointi<_TensorSrc::rank>>::value(), ts_src.shape(),
               [&](pointi<_TensorSrc::rank> idx) {
                   ts_dst(idx) = ts_src(internal::get_array_index_by_layout(idx, ts_src.layout()));
@@ -134,6 +145,8 @@ inline void transform(
     _ExectutionPolicy policy, const _TensorSrc& ts_src, _TensorDst&& ts_dst, _Fun fun,
     enable_if_t<are_linear_index<decay_t<_TensorSrc>, decay_t<_TensorDst>>::value &&
                 none_device_memory<decay_t<_TensorSrc>, decay_t<_TensorDst>>::value>* = 0) {
+    MATAZURE_TRACE_SCOPE("transform", policy, ts_src.shape(), trace::element_size(ts_src),
+                         trace::tensor_bytes(ts_src), trace::tensor_bytes(ts_dst));
     for_index(policy, 0, ts_src.size(), [&](int_t i) { ts_dst[i] = fun(ts_src[i]); });
 }
 
@@ -149,6 +162,8 @@ inline void transform(_ExectutionPolicy policy, const _TensorSrc& ts_src, _Tenso
                       _Fun fun,
                       enable_if_t<!are_linear_index<decay_t<_TensorSrc>>::value &&
                                   none_device_memory<decay_t<_TensorSrc>>::value>* = 0) {
+    MATAZURE_TRACE_SCOPE("transform", policy, ts_src.shape(), trace::element_size(ts_src),
+                         trace::tensor_bytes(ts_src), trace::tensor_bytes(ts_dst));
     for_index(policy, zero<pointi<_TensorSrc::rank>>::value(), ts_src.shape(),
               [&](pointi<_TensorSrc::rank> idx) {
                   ts_dst(idx) =
@@ -199,6 +214,8 @@ inline void transform(
 template <typename _Tensor, typename _VT, typename _BinaryFunc>
 inline _VT reduce(const _Tensor& ts, _VT init, _BinaryFunc binary_fun) {
     sequence_policy policy{};
+    MATAZURE_TRACE_SCOPE("reduce", policy, ts.shape(), trace::element_size(ts),
+                         trace::tensor_bytes(ts), 0);
     auto re = init;
     for_each(policy, ts, [&re, binary_fun](decltype(ts[0]) x) { re = binary_fun(re, x); });
 
@@ -2,6 +2,7 @@
 
 #include <malloc.h>
 #include <matazure/config.hpp>
+#include <matazure/for_index.hpp>
 
 namespace matazure {
 
@@ -32,4 +33,22 @@ class aligned_allocator : public std::allocator<_Type> {
     ~aligned_allocator(){};
 };
 
+/**
+ * @brief the policy a tensor constructs the elements of its allocator by
+ *
+ * an allocator declares first_touch_policy to have the elements constructed in parallel, so the
+ * pages are first touched by the threads of the later loops, the default is sequence_policy.
+ */
+template <typename _Allocator>
+struct allocator_first_touch_policy {
+   private:
+    template <typename _Alloc>
+    static typename _Alloc::first_touch_policy test(int);
+    template <typename _Alloc>
+    static sequence_policy test(...);
+
+   public:
+    typedef decltype(test<_Allocator>(0)) type;
+};
+
 }  // namespace matazure
\ No newline at end of file
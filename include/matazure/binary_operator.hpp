@@ -7,31 +7,36 @@
 
 namespace matazure {
 
-#define __MATAZURE_LINEAR_ACCESS_TENSOR_BINARY_OPERATOR(name, op)   \
-    template <typename _T1, typename _T2>                           \
-    struct name {                                                   \
-       private:                                                     \
-        _T1 x1_;                                                    \
-        _T2 x2_;                                                    \
-                                                                    \
-       public:                                                      \
-        MATAZURE_STATIC_ASSERT_DIM_MATCHED(_T1, _T2);               \
-        MATAZURE_STATIC_ASSERT_VALUE_TYPE_MATCHED(_T1, _T2);        \
-                                                                    \
-        MATAZURE_GENERAL name(_T1 x1, _T2 x2) : x1_(x1), x2_(x2) {} \
-                                                                    \
-        MATAZURE_GENERAL auto operator()(int_t i) const             \
-            -> decltype(this->x1_[i] op this->x2_[i]) {             \
-            return x1_[i] op x2_[i];                                \
-        }                                                           \
+#define __MATAZURE_LINEAR_ACCESS_TENSOR_BINARY_OPERATOR(name, op)     \
+    template <typename _T1, typename _T2>                             \
+    struct name {                                                     \
+       private:                                                       \
+        view_capture_t<_T1> x1_;                                      \
+        view_capture_t<_T2> x2_;                                      \
+                                                                      \
+       public:                                                        \
+        MATAZURE_STATIC_ASSERT_DIM_MATCHED(_T1, _T2);                 \
+        MATAZURE_STATIC_ASSERT_VALUE_TYPE_MATCHED(_T1, _T2);          \
+                                                                      \
+        MATAZURE_GENERAL name(_T1 x1, _T2 x2) : x1_(x1), x2_(x2) {}   \
+                                                                      \
+        MATAZURE_GENERAL auto operator()(int_t i) const               \
+            -> decltype(this->x1_[i] op this->x2_[i]) {               \
+            return x1_[i] op x2_[i];                                  \
+        }                                                             \
+                                                                      \
+        bool may_alias(const void* first, const void* last) const {   \
+            return matazure::internal::may_alias(x1_, first, last) || \
+                   matazure::internal::may_alias(x2_, first, last);   \
+        }                                                             \
     };
 
 #define __MATAZURE_ARRAY_INDEX_TENSOR_BINARY_OPERATOR(name, op)              \
     template <typename _T1, typename _T2>                                    \
     struct name {                                                            \
        private:                                                              \
-        _T1 x1_;                                                             \
-        _T2 x2_;                                                             \
+        view_capture_t<_T1> x1_;                                             \
+        view_capture_t<_T2> x2_;                                             \
                                                                              \
        public:                                                               \
         MATAZURE_STATIC_ASSERT_DIM_MATCHED(_T1, _T2);                        \
@@ -41,6 +46,11 @@ namespace matazure {
         MATAZURE_GENERAL auto operator()(const pointi<_T1::rank>& idx) const \
             -> decltype(this->x1_(idx) op this->x2_(idx)) {                  \
             return x1_(idx) op x2_(idx);                                     \
+        }                                                                    \
+                                                                             \
+        bool may_alias(const void* first, const void* last) const {          \
+            return matazure::internal::may_alias(x1_, first, last) ||        \
+                   matazure::internal::may_alias(x2_, first, last);          \
         }                                                                    \
     };
 
@@ -50,7 +60,7 @@ namespace matazure {
        private:                                                                                \
         typedef typename _T::value_type value_type;                                            \
                                                                                                \
-        _T x_;                                                                                 \
+        view_capture_t<_T> x_;                                                                 \
         value_type v_;                                                                         \
                                                                                                \
        public:                                                                                 \
@@ -58,6 +68,10 @@ namespace matazure {
                                                                                                \
         MATAZURE_GENERAL auto operator()(int_t i) const -> decltype(this->x_[i] op this->v_) { \
             return x_[i] op v_;                                                                \
+        }                                                                                      \
+                                                                                               \
+        bool may_alias(const void* first, const void* last) const {                            \
+            return matazure::internal::may_alias(x_, first, last);                             \
         }                                                                                      \
     };
 
@@ -67,7 +81,7 @@ namespace matazure {
        private:                                                             \
         typedef typename _T::value_type value_type;                         \
                                                                             \
-        _T x_;                                                              \
+        view_capture_t<_T> x_;                                              \
         value_type v_;                                                      \
                                                                             \
        public:                                                              \
@@ -76,6 +90,10 @@ namespace matazure {
         MATAZURE_GENERAL auto operator()(const pointi<_T::rank>& idx) const \
             -> decltype(this->x_(idx) op this->v_) {                        \
             return x_(idx) op v_;                                           \
+        }                                                                   \
+                                                                            \
+        bool may_alias(const void* first, const void* last) const {         \
+            return matazure::internal::may_alias(x_, first, last);          \
         }                                                                   \
     };
 
@@ -86,7 +104,7 @@ namespace matazure {
         typedef typename _T::value_type value_type;                          \
                                                                              \
         value_type v_;                                                       \
-        _T x_;                                                               \
+        view_capture_t<_T> x_;                                               \
                                                                              \
        public:                                                               \
         MATAZURE_GENERAL name(value_type v, _T x) : v_(v), x_(x) {}          \
@@ -94,6 +112,10 @@ namespace matazure {
         MATAZURE_GENERAL auto operator()(const int_t& i) const               \
             -> decltype((this->v_)op(this->x_[i])) {                         \
             return v_ op x_[i];                                              \
+        }                                                                    \
+                                                                             \
+        bool may_alias(const void* first, const void* last) const {          \
+            return matazure::internal::may_alias(x_, first, last);           \
         }                                                                    \
     };
 
@@ -104,7 +126,7 @@ namespace matazure {
         typedef typename _T::value_type value_type;                         \
                                                                             \
         value_type v_;                                                      \
-        _T x_;                                                              \
+        view_capture_t<_T> x_;                                              \
                                                                             \
        public:                                                              \
         MATAZURE_GENERAL name(_T x, value_type v) : v_(v), x_(x) {}         \
@@ -112,9 +134,35 @@ namespace matazure {
         MATAZURE_GENERAL auto operator()(const pointi<_T::rank>& idx) const \
             -> decltype(this->v_ op this->x_(idx)) {                        \
             return v_ op x_(idx);                                           \
+        }                                                                   \
+                                                                            \
+        bool may_alias(const void* first, const void* last) const {         \
+            return matazure::internal::may_alias(x_, first, last);          \
         }                                                                   \
     };
 
+namespace internal {
+
+/// the lambda_tensor of a binary operator of two host sources, the functor is chosen by the index
+template <template <typename, typename> class _LinearFunctor,
+          template <typename, typename> class _ArrayFunctor, typename _TS1, typename _TS2>
+inline enable_if_t<none_device_memory<_TS1, _TS2>::value && are_linear_index<_TS1, _TS2>::value,
+                   lambda_tensor<_TS1::rank, _LinearFunctor<_TS1, _TS2>>>
+make_binary_lambda(_TS1 lhs, _TS2 rhs) {
+    return make_lambda(lhs.shape(), _LinearFunctor<_TS1, _TS2>(lhs, rhs), host_t{},
+                       layout_t<_TS1>{});
+}
+
+template <template <typename, typename> class _LinearFunctor,
+          template <typename, typename> class _ArrayFunctor, typename _TS1, typename _TS2>
+inline enable_if_t<none_device_memory<_TS1, _TS2>::value && !are_linear_index<_TS1, _TS2>::value,
+                   lambda_tensor<_TS1::rank, _ArrayFunctor<_TS1, _TS2>>>
+make_binary_lambda(_TS1 lhs, _TS2 rhs) {
+    return make_lambda(lhs.shape(), _ArrayFunctor<_TS1, _TS2>(lhs, rhs), layout_t<_TS1>{});
+}
+
+}  // namespace internal
+
 // host tensor operations
 #define TENSOR_BINARY_OPERATOR(name, op)                                                       \
     __MATAZURE_LINEAR_ACCESS_TENSOR_BINARY_OPERATOR(__##name##_are_linear_index_tensor__, op)  \
@@ -136,6 +184,41 @@ namespace matazure {
         return make_lambda(e_lhs().shape(),                                                    \
                            __##name##_array_indexensor__<_TS1, _TS2>(e_lhs(), e_rhs()),        \
                            layout_t<_TS1>{});                                                  \
+    }                                                                                          \
+    template <typename _ValueType, int_t _Rank, typename _Layout, typename _Allocator,         \
+              typename _TS2>                                                                   \
+    inline auto operator op(tensor<_ValueType, _Rank, _Layout, _Allocator>&& lhs,              \
+                            const tensor_expression<_TS2>& e_rhs)                              \
+        -> decltype(internal::make_binary_lambda<__##name##_are_linear_index_tensor__,         \
+                                                 __##name##_array_indexensor__>(               \
+            owned_tensor<tensor<_ValueType, _Rank, _Layout, _Allocator>>(lhs), e_rhs())) {     \
+        return internal::make_binary_lambda<__##name##_are_linear_index_tensor__,              \
+                                            __##name##_array_indexensor__>(                    \
+            owned_tensor<tensor<_ValueType, _Rank, _Layout, _Allocator>>(lhs), e_rhs());       \
+    }                                                                                          \
+    template <typename _TS1, typename _ValueType, int_t _Rank, typename _Layout,               \
+              typename _Allocator>                                                             \
+    inline auto operator op(const tensor_expression<_TS1>& e_lhs,                              \
+                            tensor<_ValueType, _Rank, _Layout, _Allocator>&& rhs)              \
+        -> decltype(internal::make_binary_lambda<__##name##_are_linear_index_tensor__,         \
+                                                 __##name##_array_indexensor__>(               \
+            e_lhs(), owned_tensor<tensor<_ValueType, _Rank, _Layout, _Allocator>>(rhs))) {     \
+        return internal::make_binary_lambda<__##name##_are_linear_index_tensor__,              \
+                                            __##name##_array_indexensor__>(                    \
+            e_lhs(), owned_tensor<tensor<_ValueType, _Rank, _Layout, _Allocator>>(rhs));       \
+    }                                                                                          \
+    template <typename _ValueType, int_t _Rank, typename _Layout, typename _Allocator,         \
+              typename _ValueType2, typename _Layout2, typename _Allocator2>                   \
+    inline auto operator op(tensor<_ValueType, _Rank, _Layout, _Allocator>&& lhs,              \
+                            tensor<_ValueType2, _Rank, _Layout2, _Allocator2>&& rhs)           \
+        -> decltype(internal::make_binary_lambda<__##name##_are_linear_index_tensor__,         \
+                                                 __##name##_array_indexensor__>(               \
+            owned_tensor<tensor<_ValueType, _Rank, _Layout, _Allocator>>(lhs),                 \
+            owned_tensor<tensor<_ValueType2, _Rank, _Layout2, _Allocator2>>(rhs))) {           \
+        return internal::make_binary_lambda<__##name##_are_linear_index_tensor__,              \
+                                            __##name##_array_indexensor__>(                    \
+            owned_tensor<tensor<_ValueType, _Rank, _Layout, _Allocator>>(lhs),                 \
+            owned_tensor<tensor<_ValueType2, _Rank, _Layout2, _Allocator2>>(rhs));             \
     }
 
 #define TENSOR_WITH_VALUE_BINARY_OPERATOR(name, op)                                             \
@@ -184,6 +267,28 @@ namespace matazure {
         return make_lambda(e_ts().shape(),                                                      \
                            __##name##_value_with_array_indexensor__<_TS>(e_ts(), v),            \
                            layout_t<_TS>{});                                                    \
+    }                                                                                           \
+                                                                                                \
+    template <typename _ValueType, int_t _Rank, typename _Layout, typename _Allocator>          \
+    inline lambda_tensor<_Rank, __##name##_are_linear_index_tensor_with_value__<                \
+        owned_tensor<tensor<_ValueType, _Rank, _Layout, _Allocator>>>>                          \
+    operator op(tensor<_ValueType, _Rank, _Layout, _Allocator>&& ts, decay_t<_ValueType> v) {   \
+        return make_lambda(                                                                     \
+            ts.shape(),                                                                         \
+            __##name##_are_linear_index_tensor_with_value__<                                    \
+                owned_tensor<tensor<_ValueType, _Rank, _Layout, _Allocator>>>(ts, v),           \
+            _Layout{});                                                                         \
+    }                                                                                           \
+                                                                                                \
+    template <typename _ValueType, int_t _Rank, typename _Layout, typename _Allocator>          \
+    inline lambda_tensor<_Rank, __##name##_value_with_are_linear_index_tensor__<                \
+        owned_tensor<tensor<_ValueType, _Rank, _Layout, _Allocator>>>>                          \
+    operator op(decay_t<_ValueType> v, tensor<_ValueType, _Rank, _Layout, _Allocator>&& ts) {   \
+        return make_lambda(                                                                     \
+            ts.shape(),                                                                         \
+            __##name##_value_with_are_linear_index_tensor__<                                    \
+                owned_tensor<tensor<_ValueType, _Rank, _Layout, _Allocator>>>(v, ts),           \
+            _Layout{});                                                                         \
     }
 
 // device tensor operations
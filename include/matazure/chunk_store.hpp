@@ -0,0 +1,642 @@
+#pragma once
+
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <matazure/dynamic_dispatch.hpp>
+#include <mutex>
+#include <vector>
+
+namespace matazure {
+
+/**
+ * @brief the codec of the chunks of a chunk store
+ *
+ * shuffle_lz groups the i-th bytes of the elements then compresses them by a LZ77 block codec,
+ * delta_rle stores the differences of the neighbouring elements by the shuffled run lengths, it's
+ * good at the smooth integer data. a chunk is stored raw if the codec doesn't make it smaller.
+ */
+enum struct chunk_codec { none = 0, shuffle_lz = 1, delta_rle = 2 };
+
+/// the header of a chunk store
+struct chunk_store_info {
+    data_type type;
+    dynamic_shape shape;
+    dynamic_shape chunk_shape;
+    chunk_codec codec;
+};
+
+namespace internal {
+
+static const char chunk_store_magic[4] = {'M', 'T', 'Z', 'C'};
+static const std::uint32_t chunk_store_version = 1;
+
+/**
+ * @brief the chunks are in row major order of the grid, the edge chunks are clipped by the shape
+ *
+ * the grid is computed in 64 bits, the chunks count should be representable by int_t.
+ */
+struct chunk_grid {
+    dynamic_shape shape;
+    dynamic_shape chunk_shape;
+    dynamic_shape grid_shape;
+    int_t count;
+
+    chunk_grid(const dynamic_shape& shape, const dynamic_shape& chunk_shape)
+        : shape(shape), chunk_shape(chunk_shape), grid_shape(shape.size()), count(1) {
+        for (int_t i = 0; i < shape.size(); ++i) {
+            if (chunk_shape[i] <= 0 || shape[i] < 0) throw invalid_shape{};
+            auto extent =
+                (static_cast<std::int64_t>(shape[i]) + chunk_shape[i] - 1) / chunk_shape[i];
+            grid_shape[i] = static_cast<int_t>(extent);
+            if (static_cast<std::int64_t>(count) * extent > std::numeric_limits<int_t>::max()) {
+                throw invalid_shape{};
+            }
+            count *= grid_shape[i];
+        }
+    }
+
+    void chunk_box(int_t chunk_i, dynamic_shape& origin, dynamic_shape& extent) const {
+        origin = dynamic_shape(shape.size());
+        extent = dynamic_shape(shape.size());
+        for (int_t d = shape.size() - 1; d >= 0; --d) {
+            origin[d] = (chunk_i % grid_shape[d]) * chunk_shape[d];
+            extent[d] = std::min(chunk_shape[d], shape[d] - origin[d]);
+            chunk_i /= grid_shape[d];
+        }
+    }
+};
+
+/// copies a box between two contiguous row major buffers, row by row
+inline void copy_box(const byte* p_src, const dynamic_shape& src_shape,
+                     const dynamic_shape& src_origin, byte* p_dst, const dynamic_shape& dst_shape,
+                     const dynamic_shape& dst_origin, const dynamic_shape& extent,
+                     int_t element_size) {
+    auto rank = extent.size();
+    if (rank == 0) {
+        std::memcpy(p_dst, p_src, element_size);
+        return;
+    }
+
+    int_t row_count = 1;
+    for (int_t d = 0; d < rank - 1; ++d) row_count *= extent[d];
+    auto row_bytes = extent[rank - 1] * element_size;
+    if (row_bytes == 0) return;
+
+    for (int_t row = 0; row < row_count; ++row) {
+        int_t src_offset = 0;
+        int_t dst_offset = 0;
+        int_t src_stride = 1;
+        int_t dst_stride = 1;
+        auto rest = row;
+        for (int_t d = rank - 1; d >= 0; --d) {
+            int_t i = 0;
+            if (d != rank - 1) {
+                i = rest % extent[d];
+                rest /= extent[d];
+            }
+            src_offset += (src_origin[d] + i) * src_stride;
+            dst_offset += (dst_origin[d] + i) * dst_stride;
+            src_stride *= src_shape[d];
+            dst_stride *= dst_shape[d];
+        }
+        std::memcpy(p_dst + dst_offset * element_size, p_src + src_offset * element_size,
+                    row_bytes);
+    }
+}
+
+/// groups the i-th bytes of all elements together
+inline void shuffle_bytes(const byte* p_src, byte* p_dst, int_t bytes, int_t element_size) {
+    auto count = bytes / element_size;
+    for (int_t i = 0; i < count; ++i) {
+        for (int_t b = 0; b < element_size; ++b) {
+            p_dst[b * count + i] = p_src[i * element_size + b];
+        }
+    }
+}
+
+inline void unshuffle_bytes(const byte* p_src, byte* p_dst, int_t bytes, int_t element_size) {
+    auto count = bytes / element_size;
+    for (int_t i = 0; i < count; ++i) {
+        for (int_t b = 0; b < element_size; ++b) {
+            p_dst[i * element_size + b] = p_src[b * count + i];
+        }
+    }
+}
+
+template <typename _UInt>
+inline void delta_encode(byte* p, int_t bytes) {
+    auto count = bytes / static_cast<int_t>(sizeof(_UInt));
+    _UInt prev = 0;
+    for (int_t i = 0; i < count; ++i) {
+        _UInt v;
+        std::memcpy(&v, p + i * sizeof(_UInt), sizeof(_UInt));
+        _UInt d = static_cast<_UInt>(v - prev);
+        std::memcpy(p + i * sizeof(_UInt), &d, sizeof(_UInt));
+        prev = v;
+    }
+}
+
+template <typename _UInt>
+inline void delta_decode(byte* p, int_t bytes) {
+    auto count = bytes / static_cast<int_t>(sizeof(_UInt));
+    _UInt prev = 0;
+    for (int_t i = 0; i < count; ++i) {
+        _UInt d;
+        std::memcpy(&d, p + i * sizeof(_UInt), sizeof(_UInt));
+        prev = static_cast<_UInt>(prev + d);
+        std::memcpy(p + i * sizeof(_UInt), &prev, sizeof(_UInt));
+    }
+}
+
+/// the elements are differenced as the unsigned integers of their size, it's lossless for floats
+inline void delta_bytes(byte* p, int_t bytes, int_t element_size, bool encode) {
+    switch (element_size) {
+        case 1:
+            encode ? delta_encode<std::uint8_t>(p, bytes) : delta_decode<std::uint8_t>(p, bytes);
+            break;
+        case 2:
+            encode ? delta_encode<std::uint16_t>(p, bytes) : delta_decode<std::uint16_t>(p, bytes);
+            break;
+        case 4:
+            encode ? delta_encode<std::uint32_t>(p, bytes) : delta_decode<std::uint32_t>(p, bytes);
+            break;
+        case 8:
+            encode ? delta_encode<std::uint64_t>(p, bytes) : delta_decode<std::uint64_t>(p, bytes);
+            break;
+    }
+}
+
+/**
+ * @brief the run length encoding of bytes
+ *
+ * a control byte c < 128 is followed by c + 1 literal bytes, otherwise the next byte repeats
+ * c - 125 times.
+ */
+inline void rle_compress(const byte* p_src, int_t size, std::vector<byte>& dst) {
+    int_t i = 0;
+    while (i < size) {
+        int_t run = 1;
+        while (i + run < size && run < 130 && p_src[i + run] == p_src[i]) ++run;
+        if (run >= 3) {
+            dst.push_back(static_cast<byte>(run + 125));
+            dst.push_back(p_src[i]);
+            i += run;
+            continue;
+        }
+
+        auto begin = i;
+        while (i < size && i - begin < 128) {
+            if (i + 2 < size && p_src[i] == p_src[i + 1] && p_src[i] == p_src[i + 2]) break;
+            ++i;
+        }
+        dst.push_back(static_cast<byte>(i - begin - 1));
+        dst.insert(dst.end(), p_src + begin, p_src + i);
+    }
+}
+
+inline void rle_decompress(const byte* p_src, int_t size, byte* p_dst, int_t dst_size) {
+    int_t i = 0;
+    int_t o = 0;
+    while (i < size) {
+        int_t c = p_src[i++];
+        if (c < 128) {
+            if (i + c + 1 > size || o + c + 1 > dst_size) throw invalid_file_format{};
+            std::memcpy(p_dst + o, p_src + i, c + 1);
+            i += c + 1;
+            o += c + 1;
+        } else {
+            if (i >= size || o + c - 125 > dst_size) throw invalid_file_format{};
+            std::memset(p_dst + o, p_src[i++], c - 125);
+            o += c - 125;
+        }
+    }
+    if (o != dst_size) throw invalid_file_format{};
+}
+
+static const int_t lz_hash_bits = 12;
+static const int_t lz_min_match = 4;
+static const int_t lz_max_offset = 65535;
+
+inline std::uint32_t lz_read32(const byte* p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline void lz_write_length(std::vector<byte>& dst, int_t length) {
+    while (length >= 255) {
+        dst.push_back(255);
+        length -= 255;
+    }
+    dst.push_back(static_cast<byte>(length));
+}
+
+inline void lz_write_sequence(std::vector<byte>& dst, const byte* p_literals, int_t literals,
+                              int_t offset, int_t match) {
+    auto match_code = match - lz_min_match;
+    byte token = static_cast<byte>(std::min<int_t>(literals, 15) << 4);
+    if (match > 0) token |= static_cast<byte>(std::min<int_t>(match_code, 15));
+    dst.push_back(token);
+    if (literals >= 15) lz_write_length(dst, literals - 15);
+    dst.insert(dst.end(), p_literals, p_literals + literals);
+    if (match > 0) {
+        dst.push_back(static_cast<byte>(offset & 0xff));
+        dst.push_back(static_cast<byte>(offset >> 8));
+        if (match_code >= 15) lz_write_length(dst, match_code - 15);
+    }
+}
+
+/**
+ * @brief the LZ77 block compression of the LZ4 sequence format
+ *
+ * a sequence is a token(4 bits literal length, 4 bits match length - 4), the literals, a 2 bytes
+ * offset and the extended match length. the last sequence has only literals.
+ */
+inline void lz_compress(const byte* p_src, int_t size, std::vector<byte>& dst) {
+    std::vector<int_t> table(1 << lz_hash_bits, -1);
+    int_t anchor = 0;
+    int_t i = 0;
+    while (i + lz_min_match <= size) {
+        auto seq = lz_read32(p_src + i);
+        auto h = (seq * 2654435761u) >> (32 - lz_hash_bits);
+        auto candidate = table[h];
+        table[h] = i;
+        if (candidate < 0 || i - candidate > lz_max_offset ||
+            lz_read32(p_src + candidate) != seq) {
+            ++i;
+            continue;
+        }
+
+        auto match = lz_min_match;
+        while (i + match < size && p_src[candidate + match] == p_src[i + match]) ++match;
+        lz_write_sequence(dst, p_src + anchor, i - anchor, i - candidate, match);
+        i += match;
+        anchor = i;
+    }
+    lz_write_sequence(dst, p_src + anchor, size - anchor, 0, 0);
+}
+
+inline int_t lz_read_length(const byte* p_src, int_t size, int_t& i) {
+    int_t length = 0;
+    byte b;
+    do {
+        if (i >= size) throw invalid_file_format{};
+        b = p_src[i++];
+        length += b;
+    } while (b == 255);
+    return length;
+}
+
+inline void lz_decompress(const byte* p_src, int_t size, byte* p_dst, int_t dst_size) {
+    int_t i = 0;
+    int_t o = 0;
+    while (i < size) {
+        auto token = p_src[i++];
+        int_t literals = token >> 4;
+        if (literals == 15) literals += lz_read_length(p_src, size, i);
+        if (i + literals > size || o + literals > dst_size) throw invalid_file_format{};
+        std::memcpy(p_dst + o, p_src + i, literals);
+        i += literals;
+        o += literals;
+        if (i == size) break;
+
+        if (i + 2 > size) throw invalid_file_format{};
+        int_t offset = p_src[i] | (p_src[i + 1] << 8);
+        i += 2;
+        int_t match = token & 0xf;
+        if (match == 15) match += lz_read_length(p_src, size, i);
+        match += lz_min_match;
+        if (offset == 0 || offset > o || o + match > dst_size) throw invalid_file_format{};
+        // the match could overlap the output, so it's copied byte by byte
+        for (int_t k = 0; k < match; ++k, ++o) p_dst[o] = p_dst[o - offset];
+    }
+    if (o != dst_size) throw invalid_file_format{};
+}
+
+inline std::vector<byte> encode_chunk(chunk_codec codec, const byte* p_src, int_t bytes,
+                                      int_t element_size) {
+    std::vector<byte> re;
+    if (codec != chunk_codec::none) {
+        std::vector<byte> tmp(p_src, p_src + bytes);
+        std::vector<byte> shuffled(bytes);
+        if (codec == chunk_codec::delta_rle) delta_bytes(tmp.data(), bytes, element_size, true);
+        shuffle_bytes(tmp.data(), shuffled.data(), bytes, element_size);
+        if (codec == chunk_codec::shuffle_lz) {
+            lz_compress(shuffled.data(), bytes, re);
+        } else {
+            rle_compress(shuffled.data(), bytes, re);
+        }
+    }
+
+    // the raw chunk is recognized by its size
+    if (codec == chunk_codec::none || static_cast<int_t>(re.size()) >= bytes) {
+        re.assign(p_src, p_src + bytes);
+    }
+    return re;
+}
+
+inline void decode_chunk(chunk_codec codec, const std::vector<byte>& blob, byte* p_dst,
+                         int_t bytes, int_t element_size) {
+    auto blob_size = static_cast<int_t>(blob.size());
+    if (blob_size == bytes) {
+        std::memcpy(p_dst, blob.data(), bytes);
+        return;
+    }
+
+    std::vector<byte> shuffled(bytes);
+    switch (codec) {
+        case chunk_codec::shuffle_lz:
+            lz_decompress(blob.data(), blob_size, shuffled.data(), bytes);
+            break;
+        case chunk_codec::delta_rle:
+            rle_decompress(blob.data(), blob_size, shuffled.data(), bytes);
+            break;
+        default:
+            throw invalid_file_format{};
+    }
+    unshuffle_bytes(shuffled.data(), p_dst, bytes, element_size);
+    if (codec == chunk_codec::delta_rle) delta_bytes(p_dst, bytes, element_size, false);
+}
+
+template <typename _Type>
+inline void write_pod(std::ostream& ostr, _Type v) {
+    ostr.write(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+/// reads the bytes, a truncated file is an invalid_file_format rather than a stream failure
+inline void read_bytes(std::istream& istr, void* p, std::int64_t bytes) {
+    istr.read(reinterpret_cast<char*>(p), bytes);
+    if (istr.gcount() != bytes) throw invalid_file_format{};
+}
+
+template <typename _Type>
+inline _Type read_pod(std::istream& istr) {
+    _Type v;
+    read_bytes(istr, &v, sizeof(v));
+    return v;
+}
+
+/// a dim of the header should be representable by int_t, a chunk dim should be positive
+inline int_t read_chunk_store_dim(std::istream& istr, bool is_chunk_dim) {
+    auto extent = read_pod<std::int64_t>(istr);
+    if (extent < (is_chunk_dim ? 1 : 0)) throw invalid_file_format{};
+    if (extent > std::numeric_limits<int_t>::max()) throw invalid_shape{};
+    return static_cast<int_t>(extent);
+}
+
+/// the chunk index, the offsets are from the beginning of the file
+struct chunk_store_index {
+    std::vector<std::uint64_t> offsets;
+    std::vector<std::uint64_t> sizes;
+};
+
+/**
+ * @brief reads the header and the chunk index
+ *
+ * all values are checked before they are used, the rank and the index are bounded by the file
+ * size, so a corrupted file doesn't cause a huge allocation.
+ * @param file_size the size of the file, the stream is at its beginning
+ */
+inline chunk_store_info read_chunk_store_header(std::istream& istr, std::int64_t file_size,
+                                                chunk_store_index& index) {
+    char magic[4];
+    read_bytes(istr, magic, 4);
+    if (std::memcmp(magic, chunk_store_magic, 4) != 0) throw invalid_file_format{};
+    if (read_pod<std::uint32_t>(istr) != chunk_store_version) throw invalid_file_format{};
+
+    chunk_store_info info;
+    info.type = static_cast<data_type>(read_pod<std::uint32_t>(istr));
+    dispatch_type_slot(info.type);
+    auto rank_u32 = read_pod<std::uint32_t>(istr);
+    info.codec = static_cast<chunk_codec>(read_pod<std::uint32_t>(istr));
+    // the dims follow the fixed header, 16 bytes a rank
+    std::int64_t header_bytes = 4 + 4 * sizeof(std::uint32_t);
+    std::int64_t pair_bytes = 2 * sizeof(std::int64_t);
+    if (rank_u32 > (file_size - header_bytes) / pair_bytes) throw invalid_file_format{};
+    auto rank = static_cast<int_t>(rank_u32);
+    info.shape = dynamic_shape(rank);
+    info.chunk_shape = dynamic_shape(rank);
+    std::int64_t elements = 1;
+    for (int_t i = 0; i < rank; ++i) {
+        info.shape[i] = read_chunk_store_dim(istr, false);
+        elements *= info.shape[i];
+        if (elements > std::numeric_limits<int_t>::max()) throw invalid_shape{};
+    }
+    for (int_t i = 0; i < rank; ++i) info.chunk_shape[i] = read_chunk_store_dim(istr, true);
+
+    chunk_grid grid(info.shape, info.chunk_shape);
+    if (read_pod<std::uint64_t>(istr) != static_cast<std::uint64_t>(grid.count)) {
+        throw invalid_file_format{};
+    }
+    // the chunks count and the (offset, size) pairs of the index follow the dims
+    auto index_end = header_bytes + rank * pair_bytes + pair_bytes / 2 + grid.count * pair_bytes;
+    if (index_end > file_size) throw invalid_file_format{};
+    index.offsets.resize(grid.count);
+    index.sizes.resize(grid.count);
+    for (int_t c = 0; c < grid.count; ++c) {
+        index.offsets[c] = read_pod<std::uint64_t>(istr);
+        index.sizes[c] = read_pod<std::uint64_t>(istr);
+        auto size = static_cast<std::uint64_t>(file_size);
+        if (index.offsets[c] > size || index.sizes[c] > size - index.offsets[c]) {
+            throw invalid_file_format{};
+        }
+    }
+    return info;
+}
+
+/// opens a chunk store file, the stream throws on its bad state only, the truncation is checked
+inline std::int64_t open_chunk_store(std::ifstream& ifs, const std::string& path) {
+    ifs.open(path, std::ios::binary | std::ios::ate);
+    if (!ifs) throw std::ios_base::failure("failed to open " + path);
+    ifs.exceptions(std::ifstream::badbit);
+    auto file_size = static_cast<std::int64_t>(ifs.tellg());
+    ifs.seekg(0);
+    return file_size;
+}
+
+/**
+ * @brief runs fun(i) for i in [0, count) by the policy, the first exception of fun is rethrown
+ * after the loop, an exception mustn't escape an OpenMP parallel region
+ */
+template <typename _ExecutionPolicy, typename _Fun>
+inline void for_index_rethrow(_ExecutionPolicy policy, int_t count, _Fun fun) {
+    std::exception_ptr error;
+    std::mutex mutex;
+    for_index(policy, 0, count, [&](int_t i) {
+        try {
+            fun(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) error = std::current_exception();
+        }
+    });
+    if (error) std::rethrow_exception(error);
+}
+
+}  // namespace internal
+
+/**
+ * @brief writes a dynamic_tensor to a chunk store file
+ *
+ * the file is the header(data type, shape, chunk shape, codec), the chunk index and the encoded
+ * chunks, the values are in the native byte order. the chunks are encoded by the policy.
+ * @param chunk_shape the shape of a chunk, the edge chunks are clipped
+ */
+template <typename _ExecutionPolicy>
+inline void write_chunked(_ExecutionPolicy policy, const std::string& path,
+                          const dynamic_tensor& ts, const dynamic_shape& chunk_shape,
+                          chunk_codec codec = chunk_codec::shuffle_lz) {
+    if (chunk_shape.size() != ts.rank()) throw invalid_shape{};
+    auto ts_src = contiguous(policy, ts);
+    auto shape = ts_src.shape();
+    auto element_size = ts_src.element_size();
+    internal::chunk_grid grid(shape, chunk_shape);
+
+    std::vector<std::vector<byte>> blobs(grid.count);
+    internal::for_index_rethrow(policy, grid.count, [&](int_t chunk_i) {
+        dynamic_shape origin, extent;
+        grid.chunk_box(chunk_i, origin, extent);
+        std::vector<byte> chunk(internal::shape_size(extent) * element_size);
+        internal::copy_box(ts_src.data(), shape, origin, chunk.data(), extent,
+                           dynamic_shape(extent.size()), extent, element_size);
+        blobs[chunk_i] = internal::encode_chunk(codec, chunk.data(), chunk.size(), element_size);
+    });
+
+    std::ofstream ofs(path, std::ios::binary);
+    ofs.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    ofs.write(internal::chunk_store_magic, 4);
+    internal::write_pod(ofs, internal::chunk_store_version);
+    internal::write_pod(ofs, static_cast<std::uint32_t>(ts_src.type()));
+    internal::write_pod(ofs, static_cast<std::uint32_t>(ts_src.rank()));
+    internal::write_pod(ofs, static_cast<std::uint32_t>(codec));
+    for (int_t i = 0; i < shape.size(); ++i) internal::write_pod<std::int64_t>(ofs, shape[i]);
+    for (int_t i = 0; i < shape.size(); ++i) {
+        internal::write_pod<std::int64_t>(ofs, chunk_shape[i]);
+    }
+    internal::write_pod<std::uint64_t>(ofs, grid.count);
+
+    std::uint64_t offset = 4 + 4 * sizeof(std::uint32_t) + 2 * shape.size() * sizeof(std::int64_t) +
+                           sizeof(std::uint64_t) + 2 * grid.count * sizeof(std::uint64_t);
+    for (auto& blob : blobs) {
+        internal::write_pod<std::uint64_t>(ofs, offset);
+        internal::write_pod<std::uint64_t>(ofs, blob.size());
+        offset += blob.size();
+    }
+    for (auto& blob : blobs) {
+        ofs.write(reinterpret_cast<const char*>(blob.data()), blob.size());
+    }
+}
+
+inline void write_chunked(const std::string& path, const dynamic_tensor& ts,
+                          const dynamic_shape& chunk_shape,
+                          chunk_codec codec = chunk_codec::shuffle_lz) {
+    write_chunked(sequence_policy{}, path, ts, chunk_shape, codec);
+}
+
+/// reads the header of a chunk store file
+inline chunk_store_info read_chunked_info(const std::string& path) {
+    std::ifstream ifs;
+    auto file_size = internal::open_chunk_store(ifs, path);
+    internal::chunk_store_index index;
+    return internal::read_chunk_store_header(ifs, file_size, index);
+}
+
+/**
+ * @brief reads a region of a chunk store file
+ *
+ * only the chunks which intersect the region are read, they are decoded and scattered to the
+ * result by the policy.
+ * @param origin the origin of the region
+ * @param shape the shape of the region
+ * @return a contiguous dynamic_tensor of the region
+ */
+template <typename _ExecutionPolicy>
+inline dynamic_tensor read_region(_ExecutionPolicy policy, const std::string& path,
+                                  const dynamic_shape& origin, const dynamic_shape& shape) {
+    std::ifstream ifs;
+    auto file_size = internal::open_chunk_store(ifs, path);
+    internal::chunk_store_index index;
+    auto info = internal::read_chunk_store_header(ifs, file_size, index);
+    auto rank = info.shape.size();
+    if (origin.size() != rank || shape.size() != rank) throw invalid_shape{};
+    for (int_t d = 0; d < rank; ++d) {
+        if (origin[d] < 0 || shape[d] < 0 || shape[d] > info.shape[d] - origin[d]) {
+            throw invalid_shape{};
+        }
+    }
+
+    dynamic_tensor ts_re(info.type, shape);
+    if (ts_re.size() == 0) return ts_re;
+    auto element_size = ts_re.element_size();
+
+    // the chunks of the grid box [first, last] intersect the region
+    internal::chunk_grid grid(info.shape, info.chunk_shape);
+    dynamic_shape first(rank), last(rank);
+    int_t chunk_count = 1;
+    for (int_t d = 0; d < rank; ++d) {
+        first[d] = origin[d] / info.chunk_shape[d];
+        last[d] = (origin[d] + shape[d] - 1) / info.chunk_shape[d];
+        chunk_count *= last[d] - first[d] + 1;
+    }
+    std::vector<int_t> chunks(chunk_count);
+    for (int_t k = 0; k < chunk_count; ++k) {
+        int_t chunk_i = 0;
+        int_t grid_stride = 1;
+        auto rest = k;
+        for (int_t d = rank - 1; d >= 0; --d) {
+            auto n = last[d] - first[d] + 1;
+            chunk_i += (first[d] + rest % n) * grid_stride;
+            rest /= n;
+            grid_stride *= grid.grid_shape[d];
+        }
+        chunks[k] = chunk_i;
+    }
+
+    std::vector<std::vector<byte>> blobs(chunk_count);
+    for (int_t k = 0; k < chunk_count; ++k) {
+        // the sizes and offsets are bounded by the file size when the header is read
+        blobs[k].resize(index.sizes[chunks[k]]);
+        ifs.seekg(index.offsets[chunks[k]]);
+        internal::read_bytes(ifs, blobs[k].data(), blobs[k].size());
+    }
+
+    internal::for_index_rethrow(policy, chunk_count, [&](int_t k) {
+        dynamic_shape chunk_origin, extent;
+        grid.chunk_box(chunks[k], chunk_origin, extent);
+        std::vector<byte> chunk(internal::shape_size(extent) * element_size);
+        internal::decode_chunk(info.codec, blobs[k], chunk.data(), chunk.size(), element_size);
+
+        dynamic_shape src_origin(rank), dst_origin(rank), box(rank);
+        for (int_t d = 0; d < rank; ++d) {
+            auto begin = std::max(origin[d], chunk_origin[d]);
+            auto end = std::min(origin[d] + shape[d], chunk_origin[d] + extent[d]);
+            src_origin[d] = begin - chunk_origin[d];
+            dst_origin[d] = begin - origin[d];
+            box[d] = end - begin;
+        }
+        internal::copy_box(chunk.data(), extent, src_origin, ts_re.data(), shape, dst_origin, box,
+                           element_size);
+    });
+
+    return ts_re;
+}
+
+inline dynamic_tensor read_region(const std::string& path, const dynamic_shape& origin,
+                                  const dynamic_shape& shape) {
+    return read_region(sequence_policy{}, path, origin, shape);
+}
+
+/// reads the whole tensor of a chunk store file
+template <typename _ExecutionPolicy>
+inline dynamic_tensor read_chunked(_ExecutionPolicy policy, const std::string& path) {
+    auto info = read_chunked_info(path);
+    return read_region(policy, path, dynamic_shape(info.shape.size()), info.shape);
+}
+
+inline dynamic_tensor read_chunked(const std::string& path) {
+    return read_chunked(sequence_policy{}, path);
+}
+
+}  // namespace matazure
@@ -50,6 +50,42 @@ class lambda_tensor : public tensor_expression<lambda_tensor<_Rank, _Fun, _Layou
         return persist(policy);
     }
 
+    /// persists into an existing tensor, through a ping-pong buffer allocated if it reads ts_dst
+    template <typename _ExecutionPolicy, typename _TensorDst>
+    void persist_into(_ExecutionPolicy policy, const _TensorDst& ts_dst) const {
+        MATAZURE_ASSERT(equal(this->shape(), ts_dst.shape()), "the shapes are not matched");
+        if (matazure::internal::may_alias(functor_, ts_dst.data(),
+                                          ts_dst.data() + ts_dst.size())) {
+            tensor<decay_t<value_type>, rank> ts_pingpong(this->shape());
+            cuda::copy(policy, *this, ts_pingpong);
+            cuda::copy(policy, ts_pingpong, ts_dst);
+        } else {
+            cuda::copy(policy, *this, ts_dst);
+        }
+    }
+
+    /// persists into an existing tensor, through ts_scratch if it reads ts_dst
+    template <typename _ExecutionPolicy, typename _TensorDst, typename _TensorScratch>
+    void persist_into(_ExecutionPolicy policy, const _TensorDst& ts_dst,
+                      const _TensorScratch& ts_scratch) const {
+        MATAZURE_ASSERT(equal(this->shape(), ts_dst.shape()), "the shapes are not matched");
+        MATAZURE_ASSERT(equal(this->shape(), ts_scratch.shape()), "the shapes are not matched");
+        if (matazure::internal::may_alias(functor_, ts_dst.data(),
+                                          ts_dst.data() + ts_dst.size())) {
+            cuda::copy(policy, *this, ts_scratch);
+            cuda::copy(policy, ts_scratch, ts_dst);
+        } else {
+            cuda::copy(policy, *this, ts_dst);
+        }
+    }
+
+    template <typename _TensorDst>
+    void persist_into(const _TensorDst& ts_dst) const {
+        for_index_execution_policy policy{};
+        policy.total_size(this->size());
+        persist_into(policy, ts_dst);
+    }
+
     MATAZURE_GENERAL pointi<rank> shape() const { return shape_; }
 
     MATAZURE_GENERAL int_t shape(int_t i) const { return shape()[i]; }
@@ -60,6 +96,8 @@ class lambda_tensor : public tensor_expression<lambda_tensor<_Rank, _Fun, _Layou
 
     MATAZURE_GENERAL constexpr runtime_type runtime() const { return runtime_type{}; }
 
+    MATAZURE_GENERAL _Fun functor() const { return functor_; }
+
    public:
 #pragma nv_exec_check_disable
     template <typename _Mode>
@@ -105,6 +143,26 @@ inline auto make_lambda(pointi<_Rank> ext, _Fun fun, _Layout)
 
 }  // namespace cuda
 
+namespace internal {
+
+template <typename _ValueType, int_t _Rank, typename _Layout, typename _Allocator>
+struct alias_traits<cuda::tensor<_ValueType, _Rank, _Layout, _Allocator>> {
+    static bool may_alias(const cuda::tensor<_ValueType, _Rank, _Layout, _Allocator>& ts,
+                          const void* first, const void* last) {
+        return ranges_overlap(ts.data(), ts.data() + ts.size(), first, last);
+    }
+};
+
+template <int_t _Rank, typename _Fun, typename _Layout>
+struct alias_traits<cuda::lambda_tensor<_Rank, _Fun, _Layout>> {
+    static bool may_alias(const cuda::lambda_tensor<_Rank, _Fun, _Layout>& ts, const void* first,
+                          const void* last) {
+        return internal::may_alias(ts.functor(), first, last);
+    }
+};
+
+}  // namespace internal
+
 template <int_t _Rank, typename _Fun>
 inline auto make_lambda(pointi<_Rank> ext, _Fun fun, device_t)
     -> decltype(cuda::make_lambda(ext, fun)) {
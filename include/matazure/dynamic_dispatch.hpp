@@ -0,0 +1,667 @@
+#pragma once
+
+#include <limits>
+#include <matazure/dynamic_tensor.hpp>
+
+namespace matazure {
+
+/// the elementwise binary operations of dynamic_tensor
+enum struct binary_op { add, sub, mul, div, min, max };
+
+/// the reductions of dynamic_tensor
+enum struct reduce_op { sum, prod, min, max };
+
+/// the collapsed ranks which have their own kernels, a larger one uses the general path
+static const int_t max_dispatch_rank = 4;
+
+/// the arithmetic type of a storage type, half and bfloat16 are computed in float
+template <typename _ValueType>
+struct compute_type {
+    typedef _ValueType type;
+};
+
+template <>
+struct compute_type<half> {
+    typedef float type;
+};
+
+template <>
+struct compute_type<bfloat16> {
+    typedef float type;
+};
+
+/// the accumulated type of sum and prod, integers are accumulated in 64 bits
+template <typename _ValueType, typename _Enable = void>
+struct accumulate_type {
+    typedef typename compute_type<_ValueType>::type type;
+};
+
+template <typename _ValueType>
+struct accumulate_type<_ValueType, enable_if_t<std::is_integral<_ValueType>::value>> {
+    typedef typename std::conditional<std::is_signed<_ValueType>::value, std::int64_t,
+                                      std::uint64_t>::type type;
+};
+
+/// converts a value by its compute type, it avoids two user defined conversions of half
+template <typename _DstType, typename _SrcType>
+inline MATAZURE_GENERAL _DstType convert_value(_SrcType v) {
+    return static_cast<_DstType>(static_cast<typename compute_type<_SrcType>::type>(v));
+}
+
+namespace internal {
+
+static const int_t data_type_count = static_cast<int_t>(data_type::dt_bfloat16) + 1;
+static const int_t dispatch_chunk_size = 16384;
+static const int_t max_elementwise_operands = 3;
+
+/// the slot 0 of a kernel table is the general path, the ranks 1 ~ max_dispatch_rank have theirs
+inline int_t dispatch_rank_slot(int_t rank) {
+    return (rank >= 1 && rank <= max_dispatch_rank) ? rank : 0;
+}
+
+inline int_t dispatch_type_slot(data_type type) {
+    auto slot = static_cast<int_t>(type);
+    if (slot <= 0 || slot >= data_type_count) throw invalid_data_type{};
+    return slot;
+}
+
+/**
+ * @brief the collapsed shape and element strides of the operands of an elementwise kernel
+ *
+ * the dims of size 1 are dropped, and a dim is merged into its previous dim when they are
+ * contiguous in all operands, so a contiguous tensor of any rank is collapsed to one dim, and
+ * only the truly strided tensors use the higher rank kernels.
+ */
+struct elementwise_layout {
+    int_t rank;
+    dynamic_shape shape;
+    dynamic_shape strides[max_elementwise_operands];
+
+    /// the element stride of the last dim of the operand
+    int_t inner_stride(int_t k) const { return strides[k][rank - 1]; }
+};
+
+inline elementwise_layout make_elementwise_layout(const dynamic_tensor* p_operands,
+                                                  int_t operand_count) {
+    auto ts_shape = p_operands[0].shape();
+    elementwise_layout layout;
+    layout.rank = 0;
+    layout.shape = dynamic_shape(std::max<int_t>(ts_shape.size(), 1));
+    for (int_t k = 0; k < max_elementwise_operands; ++k) {
+        layout.strides[k] = dynamic_shape(layout.shape.size());
+    }
+
+    for (int_t d = 0; d < ts_shape.size(); ++d) {
+        if (ts_shape[d] == 1) continue;
+
+        bool mergeable = layout.rank > 0;
+        for (int_t k = 0; k < operand_count && mergeable; ++k) {
+            mergeable = layout.strides[k][layout.rank - 1] ==
+                        p_operands[k].stride(d) * ts_shape[d];
+        }
+
+        if (mergeable) {
+            layout.shape[layout.rank - 1] *= ts_shape[d];
+        } else {
+            layout.shape[layout.rank] = ts_shape[d];
+            ++layout.rank;
+        }
+        for (int_t k = 0; k < operand_count; ++k) {
+            layout.strides[k][layout.rank - 1] = p_operands[k].stride(d);
+        }
+    }
+
+    // a tensor of one element(or rank 0)
+    if (layout.rank == 0) {
+        layout.rank = 1;
+        layout.shape[0] = 1;
+        for (int_t k = 0; k < operand_count; ++k) layout.strides[k][0] = 1;
+    }
+
+    return layout;
+}
+
+typedef point<int_t, max_elementwise_operands> operand_offsets;
+
+/// the rank 1 path, the row is split to chunks, the row index is the chunk index
+template <typename _ExecutionPolicy, typename _Fun>
+inline void for_each_row(integral_constant<int_t, 1>, _ExecutionPolicy policy,
+                         const elementwise_layout& layout, _Fun fun) {
+    auto size = layout.shape[0];
+    for_index(policy, 0, (size + dispatch_chunk_size - 1) / dispatch_chunk_size,
+              [&](int_t chunk_i) {
+                  auto begin = chunk_i * dispatch_chunk_size;
+                  operand_offsets offsets;
+                  for (int_t k = 0; k < max_elementwise_operands; ++k) {
+                      offsets[k] = begin * layout.strides[k][0];
+                  }
+                  fun(chunk_i, offsets, std::min(dispatch_chunk_size, size - begin));
+              });
+}
+
+/// the rank 2 ~ max_dispatch_rank path, the outer dims are iterated by the typed index
+template <int_t _Rank, typename _ExecutionPolicy, typename _Fun>
+inline void for_each_row(integral_constant<int_t, _Rank>, _ExecutionPolicy policy,
+                         const elementwise_layout& layout, _Fun fun) {
+    pointi<_Rank - 1> outer_shape;
+    pointi<_Rank - 1> strides[max_elementwise_operands];
+    for (int_t d = 0; d < _Rank - 1; ++d) {
+        outer_shape[d] = layout.shape[d];
+        for (int_t k = 0; k < max_elementwise_operands; ++k) strides[k][d] = layout.strides[k][d];
+    }
+    row_major_layout<_Rank - 1> row_layout(outer_shape);
+    auto length = layout.shape[_Rank - 1];
+
+    for_index(policy, zero<pointi<_Rank - 1>>::value(), outer_shape, [&](pointi<_Rank - 1> idx) {
+        operand_offsets offsets;
+        for (int_t k = 0; k < max_elementwise_operands; ++k) {
+            offsets[k] = 0;
+            for (int_t d = 0; d < _Rank - 1; ++d) offsets[k] += idx[d] * strides[k][d];
+        }
+        fun(row_layout.index2offset(idx), offsets, length);
+    });
+}
+
+/// the general path of a larger rank, the outer index of a row is decomposed from the row index
+template <typename _ExecutionPolicy, typename _Fun>
+inline void for_each_row(integral_constant<int_t, 0>, _ExecutionPolicy policy,
+                         const elementwise_layout& layout, _Fun fun) {
+    int_t row_count = 1;
+    for (int_t d = 0; d < layout.rank - 1; ++d) row_count *= layout.shape[d];
+
+    for_index(policy, 0, row_count, [&](int_t row) {
+        operand_offsets offsets;
+        for (int_t k = 0; k < max_elementwise_operands; ++k) offsets[k] = 0;
+        auto rest = row;
+        for (int_t d = layout.rank - 2; d >= 0; --d) {
+            auto i = rest % layout.shape[d];
+            rest /= layout.shape[d];
+            for (int_t k = 0; k < max_elementwise_operands; ++k) {
+                offsets[k] += i * layout.strides[k][d];
+            }
+        }
+        fun(row, offsets, layout.shape[layout.rank - 1]);
+    });
+}
+
+/// the row count of the path, it's the size of the partial results of a reduction
+inline int_t row_count(int_t rank_slot, const elementwise_layout& layout) {
+    if (rank_slot == 1) return (layout.shape[0] + dispatch_chunk_size - 1) / dispatch_chunk_size;
+
+    int_t count = 1;
+    for (int_t d = 0; d < layout.rank - 1; ++d) count *= layout.shape[d];
+    return count;
+}
+
+template <typename _ValueType, int_t _Rank, typename _ExecutionPolicy>
+inline void copy_kernel(_ExecutionPolicy policy, const elementwise_layout& layout,
+                        dynamic_tensor ts_src, dynamic_tensor ts_dst) {
+    auto p_src = ts_src.data<_ValueType>();
+    auto p_dst = ts_dst.data<_ValueType>();
+    auto src_stride = layout.inner_stride(0);
+    auto dst_stride = layout.inner_stride(1);
+    for_each_row(integral_constant<int_t, _Rank>{}, policy, layout,
+                 [=](int_t, operand_offsets offsets, int_t length) {
+                     auto p_row_src = p_src + offsets[0];
+                     auto p_row_dst = p_dst + offsets[1];
+                     if (src_stride == 1 && dst_stride == 1) {
+                         for (int_t i = 0; i < length; ++i) p_row_dst[i] = p_row_src[i];
+                     } else {
+                         for (int_t i = 0; i < length; ++i) {
+                             p_row_dst[i * dst_stride] = p_row_src[i * src_stride];
+                         }
+                     }
+                 });
+}
+
+/// the value is a dynamic_tensor of one element which has the type of the filled tensor
+template <typename _ValueType, int_t _Rank, typename _ExecutionPolicy>
+inline void fill_kernel(_ExecutionPolicy policy, const elementwise_layout& layout,
+                        dynamic_tensor ts, dynamic_tensor ts_value) {
+    auto p_dst = ts.data<_ValueType>();
+    auto v = ts_value.data<_ValueType>()[0];
+    auto stride = layout.inner_stride(0);
+    for_each_row(integral_constant<int_t, _Rank>{}, policy, layout,
+                 [=](int_t, operand_offsets offsets, int_t length) {
+                     auto p_row = p_dst + offsets[0];
+                     if (stride == 1) {
+                         for (int_t i = 0; i < length; ++i) p_row[i] = v;
+                     } else {
+                         for (int_t i = 0; i < length; ++i) p_row[i * stride] = v;
+                     }
+                 });
+}
+
+template <typename _ValueType>
+struct dispatch_functors {
+    typedef typename compute_type<_ValueType>::type value_type;
+
+    struct add {
+        MATAZURE_GENERAL value_type operator()(value_type x0, value_type x1) const {
+            return x0 + x1;
+        }
+    };
+    struct sub {
+        MATAZURE_GENERAL value_type operator()(value_type x0, value_type x1) const {
+            return x0 - x1;
+        }
+    };
+    struct mul {
+        MATAZURE_GENERAL value_type operator()(value_type x0, value_type x1) const {
+            return x0 * x1;
+        }
+    };
+    struct div {
+        MATAZURE_GENERAL value_type operator()(value_type x0, value_type x1) const {
+            return x0 / x1;
+        }
+    };
+    struct min {
+        MATAZURE_GENERAL value_type operator()(value_type x0, value_type x1) const {
+            return x1 < x0 ? x1 : x0;
+        }
+    };
+    struct max {
+        MATAZURE_GENERAL value_type operator()(value_type x0, value_type x1) const {
+            return x0 < x1 ? x1 : x0;
+        }
+    };
+};
+
+template <int_t _Rank, typename _ValueType, typename _ExecutionPolicy, typename _Fun>
+inline void binary_apply(_ExecutionPolicy policy, const elementwise_layout& layout,
+                         const _ValueType* p_lhs, const _ValueType* p_rhs, _ValueType* p_dst,
+                         _Fun fun) {
+    auto lhs_stride = layout.inner_stride(0);
+    auto rhs_stride = layout.inner_stride(1);
+    auto dst_stride = layout.inner_stride(2);
+    for_each_row(
+        integral_constant<int_t, _Rank>{}, policy, layout,
+        [=](int_t, operand_offsets offsets, int_t length) {
+            auto p_row_lhs = p_lhs + offsets[0];
+            auto p_row_rhs = p_rhs + offsets[1];
+            auto p_row_dst = p_dst + offsets[2];
+            if (lhs_stride == 1 && rhs_stride == 1 && dst_stride == 1) {
+                for (int_t i = 0; i < length; ++i) {
+                    p_row_dst[i] = convert_value<_ValueType>(fun(p_row_lhs[i], p_row_rhs[i]));
+                }
+            } else {
+                for (int_t i = 0; i < length; ++i) {
+                    p_row_dst[i * dst_stride] = convert_value<_ValueType>(
+                        fun(p_row_lhs[i * lhs_stride], p_row_rhs[i * rhs_stride]));
+                }
+            }
+        });
+}
+
+template <typename _ValueType, int_t _Rank, typename _ExecutionPolicy>
+inline void binary_kernel(_ExecutionPolicy policy, const elementwise_layout& layout,
+                          dynamic_tensor ts_lhs, dynamic_tensor ts_rhs, dynamic_tensor ts_dst,
+                          binary_op op) {
+    typedef dispatch_functors<_ValueType> functors;
+    auto p_lhs = ts_lhs.data<_ValueType>();
+    auto p_rhs = ts_rhs.data<_ValueType>();
+    auto p_dst = ts_dst.data<_ValueType>();
+    // the switch is out of the loop, each case has its own vectorized loop
+    switch (op) {
+        case binary_op::add:
+            binary_apply<_Rank>(policy, layout, p_lhs, p_rhs, p_dst, typename functors::add{});
+            break;
+        case binary_op::sub:
+            binary_apply<_Rank>(policy, layout, p_lhs, p_rhs, p_dst, typename functors::sub{});
+            break;
+        case binary_op::mul:
+            binary_apply<_Rank>(policy, layout, p_lhs, p_rhs, p_dst, typename functors::mul{});
+            break;
+        case binary_op::div:
+            binary_apply<_Rank>(policy, layout, p_lhs, p_rhs, p_dst, typename functors::div{});
+            break;
+        case binary_op::min:
+            binary_apply<_Rank>(policy, layout, p_lhs, p_rhs, p_dst, typename functors::min{});
+            break;
+        case binary_op::max:
+            binary_apply<_Rank>(policy, layout, p_lhs, p_rhs, p_dst, typename functors::max{});
+            break;
+    }
+}
+
+/// reduces the rows by the policy, then reduces the partial results of the rows sequentially
+template <int_t _Rank, typename _AccType, typename _ValueType, typename _ExecutionPolicy,
+          typename _Fun>
+inline _AccType reduce_values(_ExecutionPolicy policy, const elementwise_layout& layout,
+                              const _ValueType* p_src, _AccType init, _Fun fun) {
+    tensor<_AccType, 1> ts_partial(row_count(_Rank, layout));
+    auto p_partial = ts_partial.data();
+    auto stride = layout.inner_stride(0);
+    for_each_row(integral_constant<int_t, _Rank>{}, policy, layout,
+                 [=](int_t row, operand_offsets offsets, int_t length) {
+                     auto p_row = p_src + offsets[0];
+                     auto re = init;
+                     if (stride == 1) {
+                         for (int_t i = 0; i < length; ++i) {
+                             re = fun(re, convert_value<_AccType>(p_row[i]));
+                         }
+                     } else {
+                         for (int_t i = 0; i < length; ++i) {
+                             re = fun(re, convert_value<_AccType>(p_row[i * stride]));
+                         }
+                     }
+                     p_partial[row] = re;
+                 });
+
+    auto re = init;
+    for (int_t i = 0; i < ts_partial.size(); ++i) {
+        re = fun(re, p_partial[i]);
+    }
+    return re;
+}
+
+template <typename _ValueType>
+inline dynamic_tensor make_scalar_dynamic_tensor(_ValueType v) {
+    dynamic_tensor ts(get_data_type_traits<_ValueType>::value, dynamic_shape{1});
+    ts.data<_ValueType>()[0] = v;
+    return ts;
+}
+
+/**
+ * @brief the reduce kernel
+ *
+ * sum and prod are accumulated in int64/uint64 for integers, float for float/half/bfloat16 and
+ * double for double, the result has the accumulated type. min and max have the source type.
+ */
+template <typename _ValueType, int_t _Rank, typename _ExecutionPolicy>
+inline dynamic_tensor reduce_kernel(_ExecutionPolicy policy, const elementwise_layout& layout,
+                                    dynamic_tensor ts, reduce_op op) {
+    typedef typename accumulate_type<_ValueType>::type acc_type;
+    typedef typename compute_type<_ValueType>::type value_type;
+    typedef dispatch_functors<acc_type> acc_functors;
+    typedef dispatch_functors<_ValueType> functors;
+    auto p_src = ts.data<_ValueType>();
+
+    switch (op) {
+        case reduce_op::sum:
+            return make_scalar_dynamic_tensor(reduce_values<_Rank>(
+                policy, layout, p_src, acc_type(0), typename acc_functors::add{}));
+        case reduce_op::prod:
+            return make_scalar_dynamic_tensor(reduce_values<_Rank>(
+                policy, layout, p_src, acc_type(1), typename acc_functors::mul{}));
+        case reduce_op::min:
+            return make_scalar_dynamic_tensor(convert_value<_ValueType>(
+                reduce_values<_Rank>(policy, layout, p_src,
+                                     std::numeric_limits<value_type>::max(),
+                                     typename functors::min{})));
+        case reduce_op::max:
+            return make_scalar_dynamic_tensor(convert_value<_ValueType>(
+                reduce_values<_Rank>(policy, layout, p_src,
+                                     std::numeric_limits<value_type>::lowest(),
+                                     typename functors::max{})));
+    }
+
+    return dynamic_tensor{};
+}
+
+template <typename _SrcType, typename _DstType>
+inline void cast_bulk(const _SrcType* p_src, _DstType* p_dst, int_t size) {
+    for (int_t i = 0; i < size; ++i) {
+        p_dst[i] = convert_value<_DstType>(p_src[i]);
+    }
+}
+
+inline void cast_bulk(const float* p_src, half* p_dst, int_t size) {
+    convert_values(p_src, p_dst, size);
+}
+
+inline void cast_bulk(const half* p_src, float* p_dst, int_t size) {
+    convert_values(p_src, p_dst, size);
+}
+
+inline void cast_bulk(const float* p_src, bfloat16* p_dst, int_t size) {
+    convert_values(p_src, p_dst, size);
+}
+
+inline void cast_bulk(const bfloat16* p_src, float* p_dst, int_t size) {
+    convert_values(p_src, p_dst, size);
+}
+
+template <int_t _Rank, typename _SrcType, typename _DstType, typename _ExecutionPolicy>
+inline void cast_rows(_ExecutionPolicy policy, const elementwise_layout& layout,
+                      const _SrcType* p_src, _DstType* p_dst) {
+    auto src_stride = layout.inner_stride(0);
+    auto dst_stride = layout.inner_stride(1);
+    for_each_row(integral_constant<int_t, _Rank>{}, policy, layout,
+                 [=](int_t, operand_offsets offsets, int_t length) {
+                     auto p_row_src = p_src + offsets[0];
+                     auto p_row_dst = p_dst + offsets[1];
+                     if (src_stride == 1 && dst_stride == 1) {
+                         cast_bulk(p_row_src, p_row_dst, length);
+                     } else {
+                         for (int_t i = 0; i < length; ++i) {
+                             p_row_dst[i * dst_stride] =
+                                 convert_value<_DstType>(p_row_src[i * src_stride]);
+                         }
+                     }
+                 });
+}
+
+/// the cast table is not indexed by the rank, the contiguous one uses the rank 1 path
+template <typename _SrcType, typename _DstType, typename _ExecutionPolicy>
+inline void cast_kernel(_ExecutionPolicy policy, const elementwise_layout& layout,
+                        dynamic_tensor ts_src, dynamic_tensor ts_dst) {
+    auto p_src = ts_src.data<_SrcType>();
+    auto p_dst = ts_dst.data<_DstType>();
+    if (layout.rank == 1) {
+        cast_rows<1>(policy, layout, p_src, p_dst);
+    } else {
+        cast_rows<0>(policy, layout, p_src, p_dst);
+    }
+}
+
+// the kernels of all data types in the order of data_type, the undefined type has no kernel
+#define MATAZURE_DATA_TYPE_KERNELS(kernel, ...)                                               \
+    {                                                                                         \
+        nullptr, &kernel<std::uint8_t, __VA_ARGS__>, &kernel<std::uint16_t, __VA_ARGS__>,     \
+            &kernel<std::uint32_t, __VA_ARGS__>, &kernel<std::uint64_t, __VA_ARGS__>,         \
+            &kernel<std::int8_t, __VA_ARGS__>, &kernel<std::int16_t, __VA_ARGS__>,            \
+            &kernel<std::int32_t, __VA_ARGS__>, &kernel<std::int64_t, __VA_ARGS__>,           \
+            &kernel<half, __VA_ARGS__>, &kernel<float, __VA_ARGS__>,                          \
+            &kernel<double, __VA_ARGS__>, &kernel<bfloat16, __VA_ARGS__>                      \
+    }
+
+// the kernels of all ranks, the slot 0 is the general path
+#define MATAZURE_DATA_TYPE_RANK_KERNELS(kernel, policy)                                       \
+    {                                                                                         \
+        MATAZURE_DATA_TYPE_KERNELS(kernel, 0, policy),                                        \
+            MATAZURE_DATA_TYPE_KERNELS(kernel, 1, policy),                                    \
+            MATAZURE_DATA_TYPE_KERNELS(kernel, 2, policy),                                    \
+            MATAZURE_DATA_TYPE_KERNELS(kernel, 3, policy),                                    \
+            MATAZURE_DATA_TYPE_KERNELS(kernel, 4, policy)                                     \
+    }
+
+/**
+ * @brief the kernel tables of the execution policy
+ *
+ * a kernel is looked up by the (collapsed rank, data type), the tables are instantiated once for
+ * a policy, a missing kernel throws invalid_data_type.
+ */
+template <typename _ExecutionPolicy>
+struct dynamic_kernels {
+    typedef void (*copy_type)(_ExecutionPolicy, const elementwise_layout&, dynamic_tensor,
+                              dynamic_tensor);
+    typedef void (*fill_type)(_ExecutionPolicy, const elementwise_layout&, dynamic_tensor,
+                              dynamic_tensor);
+    typedef void (*binary_type)(_ExecutionPolicy, const elementwise_layout&, dynamic_tensor,
+                                dynamic_tensor, dynamic_tensor, binary_op);
+    typedef dynamic_tensor (*reduce_type)(_ExecutionPolicy, const elementwise_layout&,
+                                          dynamic_tensor, reduce_op);
+    typedef void (*cast_type)(_ExecutionPolicy, const elementwise_layout&, dynamic_tensor,
+                              dynamic_tensor);
+
+    static copy_type copy(int_t rank, data_type type) {
+        static const copy_type kernels[max_dispatch_rank + 1][data_type_count] =
+            MATAZURE_DATA_TYPE_RANK_KERNELS(copy_kernel, _ExecutionPolicy);
+        return kernels[dispatch_rank_slot(rank)][dispatch_type_slot(type)];
+    }
+
+    static fill_type fill(int_t rank, data_type type) {
+        static const fill_type kernels[max_dispatch_rank + 1][data_type_count] =
+            MATAZURE_DATA_TYPE_RANK_KERNELS(fill_kernel, _ExecutionPolicy);
+        return kernels[dispatch_rank_slot(rank)][dispatch_type_slot(type)];
+    }
+
+    static binary_type binary(int_t rank, data_type type) {
+        static const binary_type kernels[max_dispatch_rank + 1][data_type_count] =
+            MATAZURE_DATA_TYPE_RANK_KERNELS(binary_kernel, _ExecutionPolicy);
+        return kernels[dispatch_rank_slot(rank)][dispatch_type_slot(type)];
+    }
+
+    static reduce_type reduce(int_t rank, data_type type) {
+        static const reduce_type kernels[max_dispatch_rank + 1][data_type_count] =
+            MATAZURE_DATA_TYPE_RANK_KERNELS(reduce_kernel, _ExecutionPolicy);
+        return kernels[dispatch_rank_slot(rank)][dispatch_type_slot(type)];
+    }
+
+    /// the rows of the table are the destination types, the columns are the source types
+    static cast_type cast(data_type src_type, data_type dst_type) {
+        static const cast_type kernels[data_type_count][data_type_count] = {
+            {},
+            MATAZURE_DATA_TYPE_KERNELS(cast_kernel, std::uint8_t, _ExecutionPolicy),
+            MATAZURE_DATA_TYPE_KERNELS(cast_kernel, std::uint16_t, _ExecutionPolicy),
+            MATAZURE_DATA_TYPE_KERNELS(cast_kernel, std::uint32_t, _ExecutionPolicy),
+            MATAZURE_DATA_TYPE_KERNELS(cast_kernel, std::uint64_t, _ExecutionPolicy),
+            MATAZURE_DATA_TYPE_KERNELS(cast_kernel, std::int8_t, _ExecutionPolicy),
+            MATAZURE_DATA_TYPE_KERNELS(cast_kernel, std::int16_t, _ExecutionPolicy),
+            MATAZURE_DATA_TYPE_KERNELS(cast_kernel, std::int32_t, _ExecutionPolicy),
+            MATAZURE_DATA_TYPE_KERNELS(cast_kernel, std::int64_t, _ExecutionPolicy),
+            MATAZURE_DATA_TYPE_KERNELS(cast_kernel, half, _ExecutionPolicy),
+            MATAZURE_DATA_TYPE_KERNELS(cast_kernel, float, _ExecutionPolicy),
+            MATAZURE_DATA_TYPE_KERNELS(cast_kernel, double, _ExecutionPolicy),
+            MATAZURE_DATA_TYPE_KERNELS(cast_kernel, bfloat16, _ExecutionPolicy)};
+        return kernels[dispatch_type_slot(dst_type)][dispatch_type_slot(src_type)];
+    }
+};
+
+#undef MATAZURE_DATA_TYPE_RANK_KERNELS
+#undef MATAZURE_DATA_TYPE_KERNELS
+
+}  // namespace internal
+
+/**
+ * @brief copies a dynamic_tensor by the typed kernel of its (collapsed rank, data type)
+ *
+ * the data types and the shapes should be matched, otherwise it throws invalid_data_type or
+ * invalid_shape. the source and destination could be strided views.
+ */
+template <typename _ExecutionPolicy>
+inline void copy(_ExecutionPolicy policy, const dynamic_tensor& ts_src, dynamic_tensor& ts_dst) {
+    if (ts_src.type() != ts_dst.type()) throw invalid_data_type{};
+    if (ts_src.shape() != ts_dst.shape()) throw invalid_shape{};
+    const dynamic_tensor operands[] = {ts_src, ts_dst};
+    auto layout = internal::make_elementwise_layout(operands, 2);
+    internal::dynamic_kernels<_ExecutionPolicy>::copy(layout.rank, ts_dst.type())(policy, layout,
+                                                                                  ts_src, ts_dst);
+}
+
+inline void copy(const dynamic_tensor& ts_src, dynamic_tensor& ts_dst) {
+    copy(sequence_policy{}, ts_src, ts_dst);
+}
+
+/// returns the tensor itself if it's contiguous, otherwise a contiguous copy of it
+template <typename _ExecutionPolicy>
+inline dynamic_tensor contiguous(_ExecutionPolicy policy, const dynamic_tensor& ts) {
+    if (ts.is_contiguous()) return ts;
+
+    dynamic_tensor ts_re(ts.type(), ts.shape());
+    copy(policy, ts, ts_re);
+    return ts_re;
+}
+
+inline dynamic_tensor contiguous(const dynamic_tensor& ts) {
+    return contiguous(sequence_policy{}, ts);
+}
+
+/**
+ * @brief casts a dynamic_tensor to the data type of the destination
+ *
+ * float <-> half/bfloat16 uses the bulk conversions, others are converted by the compute type.
+ */
+template <typename _ExecutionPolicy>
+inline void cast(_ExecutionPolicy policy, const dynamic_tensor& ts_src, dynamic_tensor& ts_dst) {
+    if (ts_src.shape() != ts_dst.shape()) throw invalid_shape{};
+    const dynamic_tensor operands[] = {ts_src, ts_dst};
+    auto layout = internal::make_elementwise_layout(operands, 2);
+    internal::dynamic_kernels<_ExecutionPolicy>::cast(ts_src.type(), ts_dst.type())(
+        policy, layout, ts_src, ts_dst);
+}
+
+inline void cast(const dynamic_tensor& ts_src, dynamic_tensor& ts_dst) {
+    cast(sequence_policy{}, ts_src, ts_dst);
+}
+
+/// casts a dynamic_tensor to a new dynamic_tensor of the data type
+inline dynamic_tensor cast(const dynamic_tensor& ts_src, data_type type) {
+    dynamic_tensor ts_dst(type, ts_src.shape());
+    cast(ts_src, ts_dst);
+    return ts_dst;
+}
+
+/**
+ * @brief fills a dynamic_tensor by the value
+ *
+ * the value is converted to the data type of the tensor once, then the typed kernel fills it.
+ */
+template <typename _ExecutionPolicy, typename _ValueType>
+inline void fill(_ExecutionPolicy policy, dynamic_tensor& ts, _ValueType v) {
+    dynamic_tensor ts_value(ts.type(), dynamic_shape{1});
+    cast(internal::make_scalar_dynamic_tensor(v), ts_value);
+    auto layout = internal::make_elementwise_layout(&ts, 1);
+    internal::dynamic_kernels<_ExecutionPolicy>::fill(layout.rank, ts.type())(policy, layout, ts,
+                                                                              ts_value);
+}
+
+template <typename _ValueType>
+inline void fill(dynamic_tensor& ts, _ValueType v) {
+    fill(sequence_policy{}, ts, v);
+}
+
+/**
+ * @brief applies the elementwise binary operation of two dynamic_tensor
+ *
+ * the three tensors should have the same data type and shape, half and bfloat16 are computed in
+ * float.
+ */
+template <typename _ExecutionPolicy>
+inline void transform(_ExecutionPolicy policy, const dynamic_tensor& ts_lhs,
+                      const dynamic_tensor& ts_rhs, dynamic_tensor& ts_dst, binary_op op) {
+    if (ts_lhs.type() != ts_dst.type() || ts_rhs.type() != ts_dst.type()) {
+        throw invalid_data_type{};
+    }
+    if (ts_lhs.shape() != ts_dst.shape() || ts_rhs.shape() != ts_dst.shape()) {
+        throw invalid_shape{};
+    }
+    const dynamic_tensor operands[] = {ts_lhs, ts_rhs, ts_dst};
+    auto layout = internal::make_elementwise_layout(operands, 3);
+    internal::dynamic_kernels<_ExecutionPolicy>::binary(layout.rank, ts_dst.type())(
+        policy, layout, ts_lhs, ts_rhs, ts_dst, op);
+}
+
+inline void transform(const dynamic_tensor& ts_lhs, const dynamic_tensor& ts_rhs,
+                      dynamic_tensor& ts_dst, binary_op op) {
+    transform(sequence_policy{}, ts_lhs, ts_rhs, ts_dst, op);
+}
+
+/**
+ * @brief reduces all elements of a dynamic_tensor
+ * @return a dynamic_tensor of one element, @see internal::reduce_kernel for its data type
+ */
+template <typename _ExecutionPolicy>
+inline dynamic_tensor reduce(_ExecutionPolicy policy, const dynamic_tensor& ts, reduce_op op) {
+    auto layout = internal::make_elementwise_layout(&ts, 1);
+    return internal::dynamic_kernels<_ExecutionPolicy>::reduce(layout.rank, ts.type())(
+        policy, layout, ts, op);
+}
+
+inline dynamic_tensor reduce(const dynamic_tensor& ts, reduce_op op) {
+    return reduce(sequence_policy{}, ts, op);
+}
+
+}  // namespace matazure
@@ -1,5 +1,7 @@
 ﻿#pragma once
 
+#include <matazure/allocator.hpp>
+#include <matazure/half.hpp>
 #include <matazure/lambda_tensor.hpp>
 #include <matazure/tensor.hpp>
 
@@ -17,7 +19,8 @@ enum struct data_type {
     dt_int64,
     dt_float16,
     dt_float32,
-    dt_float64
+    dt_float64,
+    dt_bfloat16
 };
 
 template <typename _T>
@@ -55,8 +58,14 @@ struct get_data_type_traits<std::int64_t> {
     const static data_type value = data_type::dt_int64;
 };
 
-// template <> struct get_data_type_traits<std::float> { const static data_type value =
-// data_type::dt_float16; };
+template <>
+struct get_data_type_traits<half> {
+    const static data_type value = data_type::dt_float16;
+};
+template <>
+struct get_data_type_traits<bfloat16> {
+    const static data_type value = data_type::dt_bfloat16;
+};
 template <>
 struct get_data_type_traits<float> {
     const static data_type value = data_type::dt_float32;
@@ -80,8 +89,14 @@ inline int_t get_data_type_size(data_type type) {
             return 4;
         case data_type::dt_int32:
             return 4;
+        case data_type::dt_uint64:
+            return 8;
+        case data_type::dt_int64:
+            return 8;
         case data_type::dt_float16:
             return 2;
+        case data_type::dt_bfloat16:
+            return 2;
         case data_type::dt_float32:
             return 4;
         case data_type::dt_float64:
@@ -93,89 +108,236 @@ inline int_t get_data_type_size(data_type type) {
     return 0;
 }
 
+/**
+ * @brief the shape(or strides) of a dynamic_tensor
+ *
+ * the dims are stored inline when the rank is not greater than inline_rank, so a dynamic_tensor
+ * doesn't allocate its shape and strides usually. notes dynamic_shape{4} is a rank 1 shape by the
+ * initializer list, dynamic_shape(4) is a rank 4 shape of zeros.
+ */
+class dynamic_shape {
+   public:
+    static const int_t inline_rank = 6;
+
+    dynamic_shape() : dynamic_shape(0) {}
+
+    explicit dynamic_shape(int_t rank) : rank_(rank) {
+        if (rank_ > inline_rank) heap_dims_.resize(rank_);
+        for (int_t i = 0; i < rank_; ++i) (*this)[i] = 0;
+    }
+
+    dynamic_shape(std::initializer_list<int_t> dims)
+        : dynamic_shape(static_cast<int_t>(dims.size())) {
+        std::copy(dims.begin(), dims.end(), data());
+    }
+
+    template <int_t _Rank>
+    explicit dynamic_shape(const pointi<_Rank>& dims) : dynamic_shape(_Rank) {
+        for (int_t i = 0; i < _Rank; ++i) (*this)[i] = dims[i];
+    }
+
+    int_t size() const { return rank_; }
+
+    int_t& operator[](int_t i) { return data()[i]; }
+
+    const int_t& operator[](int_t i) const { return data()[i]; }
+
+    int_t* data() { return rank_ > inline_rank ? heap_dims_.data() : inline_dims_; }
+
+    const int_t* data() const { return rank_ > inline_rank ? heap_dims_.data() : inline_dims_; }
+
+   private:
+    int_t rank_;
+    int_t inline_dims_[inline_rank];
+    std::vector<int_t> heap_dims_;
+};
+
+inline bool operator==(const dynamic_shape& lhs, const dynamic_shape& rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.data(), lhs.data() + lhs.size(), rhs.data());
+}
+
+inline bool operator!=(const dynamic_shape& lhs, const dynamic_shape& rhs) { return !(lhs == rhs); }
+
+namespace internal {
+
+/// the elements count of the shape
+inline int_t shape_size(const dynamic_shape& shape) {
+    int_t size = 1;
+    for (int_t i = 0; i < shape.size(); ++i) size *= shape[i];
+    return size;
+}
+
+}  // namespace internal
+
+/**
+ * @brief the tensor which has a runtime data type and rank
+ *
+ * the storage is aligned by the alignment(or the allocator), the elements are accessed by the
+ * element strides, so slice and permute are views of the same storage. a contiguous one could be
+ * viewed as a typed tensor by as_tensor without copying.
+ */
 class dynamic_tensor {
    public:
-    using shape_type = tensor<int_t, 1>;
+    typedef dynamic_shape shape_type;
+    typedef host_t runtime_type;
+    typedef linear_index index_type;
+
+    /// the alignment of the default storage, it's the cache line size and enough for AVX-512
+    static const int_t alignment = 64;
 
-    dynamic_tensor() {}
+    dynamic_tensor() : type_(data_type::undefined), data_(nullptr), size_(0) {}
 
     dynamic_tensor(data_type type, shape_type ts_shape)
+        : dynamic_tensor(type, ts_shape, aligned_allocator<byte, alignment>{}) {}
+
+    /**
+     * @brief constructs by the shape and allocates the storage by the allocator
+     * @param allocator a byte allocator, e.g. aligned_allocator<byte, 4096>
+     */
+    template <typename _Allocator, typename _Tmp = enable_if_t<
+                                       !std::is_convertible<_Allocator, shared_ptr<void>>::value>>
+    dynamic_tensor(data_type type, shape_type ts_shape, _Allocator allocator)
         : type_(type),
-          ts_shape_(ts_shape),
-          size_(reduce(ts_shape_, 1, [](int_t x0, int_t x1) { return x0 * x1; })) {
-        auto p_mem_ = new byte[size_ * element_size()];
-        sp_mem_.reset(p_mem_, [](byte* p) { delete[] p; });
+          shape_(ts_shape),
+          strides_(row_major_strides(ts_shape)),
+          size_(internal::shape_size(ts_shape)) {
+        auto bytes = static_cast<size_t>(size_ * element_size());
+        data_ = allocator.allocate(bytes);
+        sp_mem_.reset(data_,
+                      [allocator, bytes](byte* p) mutable { allocator.deallocate(p, bytes); });
     }
 
+    /// constructs by the contiguous memory
     dynamic_tensor(data_type type, shape_type ts_shape, shared_ptr<void> sp_mem)
+        : dynamic_tensor(type, ts_shape, row_major_strides(ts_shape), sp_mem) {}
+
+    /// constructs by the memory of the element strides
+    dynamic_tensor(data_type type, shape_type ts_shape, shape_type strides,
+                   shared_ptr<void> sp_mem)
         : type_(type),
-          ts_shape_(ts_shape),
-          size_(reduce(ts_shape_, 1, [](int_t x0, int_t x1) { return x0 * x1; })),
-          sp_mem_(std::static_pointer_cast<byte>(sp_mem)) {}
-
-    dynamic_tensor(const dynamic_tensor& other)
-        : type_(other.type_),
-          ts_shape_(other.ts_shape_),
-          size_(other.size_),
-          sp_mem_(other.sp_mem_) {}
-
-    dynamic_tensor& operator=(const dynamic_tensor& other) {
-        type_ = other.type_;
-        ts_shape_ = other.ts_shape_;
-        size_ = other.size_;
-        sp_mem_ = other.sp_mem_;
-        return *this;
+          shape_(ts_shape),
+          strides_(strides),
+          sp_mem_(std::static_pointer_cast<byte>(sp_mem)),
+          data_(sp_mem_.get()),
+          size_(internal::shape_size(ts_shape)) {
+        MATAZURE_ASSERT(strides_.size() == shape_.size(), "the strides is not matched");
     }
 
     data_type type() const { return type_; }
 
-    shape_type shape() const { return ts_shape_; }
+    shape_type shape() const { return shape_; }
+
+    int_t shape(int_t i) const { return shape_[i]; }
+
+    /// the element strides
+    shape_type strides() const { return strides_; }
 
-    int_t shape(int_t i) const { return ts_shape_[i]; }
+    int_t stride(int_t i) const { return strides_[i]; }
 
-    int_t rank() const { return ts_shape_.size(); }
+    int_t rank() const { return shape_.size(); }
 
     int_t size() const { return size_; }
 
-    template <typename _Type = byte>
-    shared_ptr<_Type> shared_data() {
-        auto sp_mem = sp_mem_;
-        shared_ptr<_Type> sp_tmp(data<_Type>(), [sp_mem](_Type* p) {});
-        return sp_tmp;
+    /// whether the elements are stored in row major without gaps
+    bool is_contiguous() const {
+        int_t stride = 1;
+        for (int_t i = rank() - 1; i >= 0; --i) {
+            if (shape_[i] != 1 && strides_[i] != stride) return false;
+            stride *= shape_[i];
+        }
+        return true;
     }
 
+    /// the shared pointer of the first element, it shares the ownership of the storage
     template <typename _Type = byte>
-    shared_ptr<const _Type> shared_data() const {
-        auto sp_mem = sp_mem_;
-        shared_ptr<const _Type> sp_tmp(data<_Type>(), [sp_mem](const _Type* p) {});
-        return sp_tmp;
+    shared_ptr<_Type> shared_data() const {
+        return shared_ptr<_Type>(sp_mem_, data<_Type>());
     }
 
     template <typename _Type = byte>
-    _Type* data() {
-        return reinterpret_cast<_Type*>(sp_mem_.get());
+    _Type* data() const {
+        return static_cast<_Type*>(static_cast<void*>(data_));
     }
 
-    template <typename _Type = byte>
-    const _Type* data() const {
-        return reinterpret_cast<_Type*>(sp_mem_.get());
+    int_t element_size() const { return get_data_type_size(type_); }
+
+    /**
+     * @brief the subsection view, it shares the storage
+     * @param origin the origin index of the subsection
+     * @param ts_shape the shape of the subsection
+     */
+    dynamic_tensor slice(const shape_type& origin, const shape_type& ts_shape) const {
+        if (origin.size() != rank() || ts_shape.size() != rank()) throw invalid_shape{};
+        auto re = *this;
+        int_t offset = 0;
+        for (int_t i = 0; i < rank(); ++i) {
+            if (origin[i] < 0 || ts_shape[i] < 0 || origin[i] + ts_shape[i] > shape_[i]) {
+                throw invalid_shape{};
+            }
+            offset += origin[i] * strides_[i];
+        }
+        re.shape_ = ts_shape;
+        re.size_ = internal::shape_size(ts_shape);
+        re.data_ = data_ + offset * element_size();
+        return re;
     }
 
-    int_t element_size() const { return get_data_type_size(type_); }
+    /**
+     * @brief the view of the permuted axes, it shares the storage
+     * @param dims the axis i of the view is the axis dims[i] of the tensor
+     */
+    dynamic_tensor permute(const shape_type& dims) const {
+        if (dims.size() != rank()) throw invalid_shape{};
+        auto re = *this;
+        std::vector<bool> used(rank(), false);
+        for (int_t i = 0; i < rank(); ++i) {
+            if (dims[i] < 0 || dims[i] >= rank() || used[dims[i]]) throw invalid_shape{};
+            used[dims[i]] = true;
+            re.shape_[i] = shape_[dims[i]];
+            re.strides_[i] = strides_[dims[i]];
+        }
+        return re;
+    }
+
+    /**
+     * @brief views the dynamic_tensor as a typed tensor without copying
+     *
+     * the tensor should be contiguous and matched with the type and rank, otherwise it throws
+     * invalid_data_type or invalid_shape.
+     */
+    template <typename _ValueType, int_t _Rank>
+    tensor<_ValueType, _Rank> as_tensor() const {
+        if (get_data_type_traits<decay_t<_ValueType>>::value != type_) throw invalid_data_type{};
+        if (rank() != _Rank || !is_contiguous()) throw invalid_shape{};
+        pointi<_Rank> ts_shape;
+        for (int_t i = 0; i < _Rank; ++i) ts_shape[i] = shape_[i];
+        return tensor<_ValueType, _Rank>(ts_shape, shared_data<_ValueType>());
+    }
+
+   private:
+    static shape_type row_major_strides(const shape_type& ts_shape) {
+        shape_type strides(ts_shape.size());
+        int_t stride = 1;
+        for (int_t i = ts_shape.size() - 1; i >= 0; --i) {
+            strides[i] = stride;
+            stride *= ts_shape[i];
+        }
+        return strides;
+    }
 
    private:
     data_type type_;
-    shared_ptr<byte> sp_mem_ = nullptr;
-    shape_type ts_shape_;
+    shape_type shape_;
+    shape_type strides_;
+    shared_ptr<byte> sp_mem_;
+    byte* data_;
     int_t size_;
 };
 
 template <typename _Tensor>
 dynamic_tensor dynamic_tensor_wrap(_Tensor ts) {
-    auto rank = _Tensor::rank;
-    dynamic_tensor::shape_type shape(rank);
-    copy(ts.shape(), shape);
-    shared_ptr<byte> sp_tmp(reinterpret_cast<byte*>(ts.data()), [ts](byte* p) {});
+    dynamic_tensor::shape_type shape(ts.shape());
+    shared_ptr<byte> sp_tmp(ts.shared_data(), reinterpret_cast<byte*>(ts.data()));
     return dynamic_tensor(get_data_type_traits<typename _Tensor::value_type>::value, shape, sp_tmp);
 }
 
@@ -7,4 +7,14 @@ class invalid_shape : public std::runtime_error {
     invalid_shape() : std::runtime_error("the shape is inavlid") {}
 };
 
+class invalid_data_type : public std::runtime_error {
+   public:
+    invalid_data_type() : std::runtime_error("the data type is invalid") {}
+};
+
+class invalid_file_format : public std::runtime_error {
+   public:
+    invalid_file_format() : std::runtime_error("the file format is invalid") {}
+};
+
 }  // namespace matazure
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <matazure/point.hpp>
+#include <matazure/trace.hpp>
 #include <matazure/type_traits.hpp>
 
 namespace matazure {
@@ -19,7 +20,8 @@ struct _Is_linear_array<point<_Type, _Rank>> : bool_constant<true> {};
  */
 MATAZURE_NV_EXE_CHECK_DISABLE
 template <typename _Fun>
-MATAZURE_GENERAL inline void for_index(sequence_policy, int_t first, int_t last, _Fun fun) {
+MATAZURE_GENERAL inline void for_index(sequence_policy policy, int_t first, int_t last, _Fun fun) {
+    MATAZURE_TRACE_SCOPE("for_index", policy, trace::extent(first, last), 0, 0, 0);
     for (int_t i = first; i < last; ++i) {
         fun(i);
     }
@@ -55,7 +57,9 @@ MATAZURE_GENERAL inline void for_index(int_t last, _Fun fun) {
  */
 MATAZURE_NV_EXE_CHECK_DISABLE
 template <typename _Fun>
-MATAZURE_GENERAL inline void for_index(sequence_policy, pointi<1> origin, pointi<1> end, _Fun fun) {
+MATAZURE_GENERAL inline void for_index(sequence_policy policy, pointi<1> origin, pointi<1> end,
+                                       _Fun fun) {
+    MATAZURE_TRACE_SCOPE("for_index", policy, trace::extent(origin, end), 0, 0, 0);
     for (int_t i = origin[0]; i < end[0]; ++i) {
         fun(pointi<1>{{i}});
     }
@@ -69,7 +73,9 @@ MATAZURE_GENERAL inline void for_index(sequence_policy, pointi<1> origin, pointi
  */
 MATAZURE_NV_EXE_CHECK_DISABLE
 template <typename _Fun>
-MATAZURE_GENERAL inline void for_index(sequence_policy, pointi<2> origin, pointi<2> end, _Fun fun) {
+MATAZURE_GENERAL inline void for_index(sequence_policy policy, pointi<2> origin, pointi<2> end,
+                                       _Fun fun) {
+    MATAZURE_TRACE_SCOPE("for_index", policy, trace::extent(origin, end), 0, 0, 0);
     for (int_t i = origin[0]; i < end[0]; ++i) {
         for (int_t j = origin[1]; j < end[1]; ++j) {
             fun(pointi<2>{{i, j}});
@@ -85,7 +91,9 @@ MATAZURE_GENERAL inline void for_index(sequence_policy, pointi<2> origin, pointi
  */
 MATAZURE_NV_EXE_CHECK_DISABLE
 template <typename _Fun>
-MATAZURE_GENERAL inline void for_index(sequence_policy, pointi<3> origin, pointi<3> end, _Fun fun) {
+MATAZURE_GENERAL inline void for_index(sequence_policy policy, pointi<3> origin, pointi<3> end,
+                                       _Fun fun) {
+    MATAZURE_TRACE_SCOPE("for_index", policy, trace::extent(origin, end), 0, 0, 0);
     for (int_t i = origin[0]; i < end[0]; ++i) {
         for (int_t j = origin[1]; j < end[1]; ++j) {
             for (int_t k = origin[2]; k < end[2]; ++k) {
@@ -103,7 +111,9 @@ MATAZURE_GENERAL inline void for_index(sequence_policy, pointi<3> origin, pointi
  */
 MATAZURE_NV_EXE_CHECK_DISABLE
 template <typename _Fun>
-MATAZURE_GENERAL inline void for_index(sequence_policy, pointi<4> origin, pointi<4> end, _Fun fun) {
+MATAZURE_GENERAL inline void for_index(sequence_policy policy, pointi<4> origin, pointi<4> end,
+                                       _Fun fun) {
+    MATAZURE_TRACE_SCOPE("for_index", policy, trace::extent(origin, end), 0, 0, 0);
     for (int_t i = origin[0]; i < end[0]; ++i) {
         for (int_t j = origin[1]; j < end[1]; ++j) {
             for (int_t k = origin[2]; k < end[2]; ++k) {
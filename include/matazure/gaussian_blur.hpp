@@ -0,0 +1,195 @@
+#pragma once
+
+#include <matazure/separable.hpp>
+
+namespace matazure {
+
+/// the gaussian_blur uses the fir kernel when sigma is less than it, otherwise the iir filter
+const float gaussian_blur_iir_sigma_threshold = 3.0f;
+
+namespace internal {
+
+/// the radius of the truncated gaussian kernel
+inline int_t gaussian_kernel_radius(float sigma) {
+    return static_cast<int_t>(std::ceil(3.0f * sigma));
+}
+
+/// the normalized 1-dim gaussian kernel, its size is 2 * radius + 1
+template <typename _ValueType>
+inline std::vector<_ValueType> make_gaussian_kernel(float sigma) {
+    auto radius = gaussian_kernel_radius(sigma);
+    std::vector<_ValueType> kernel(2 * radius + 1);
+    double sum = 0;
+    for (int_t i = -radius; i <= radius; ++i) {
+        auto w = std::exp(-0.5 * i * i / (static_cast<double>(sigma) * sigma));
+        kernel[i + radius] = static_cast<_ValueType>(w);
+        sum += w;
+    }
+    for (auto& w : kernel) {
+        w = static_cast<_ValueType>(w / sum);
+    }
+
+    return kernel;
+}
+
+/**
+ * @brief the fir gaussian of interleaved lines
+ * @param in the padded input, [n + 2 * radius][lanes]
+ * @param out the output, [n][lanes]
+ */
+template <typename _ValueType>
+inline void gaussian_fir(const _ValueType* in, _ValueType* out, int_t n, int_t lanes,
+                         const std::vector<_ValueType>& kernel) {
+    auto kernel_size = static_cast<int_t>(kernel.size());
+    for (int_t i = 0; i < n; ++i) {
+        auto p_out = out + i * lanes;
+        for (int_t l = 0; l < lanes; ++l) p_out[l] = _ValueType(0);
+        for (int_t k = 0; k < kernel_size; ++k) {
+            auto w = kernel[k];
+            auto p_in = in + (i + k) * lanes;
+            for (int_t l = 0; l < lanes; ++l) p_out[l] += w * p_in[l];
+        }
+    }
+}
+
+/// the coefficients of the Young-van Vliet recursive gaussian
+template <typename _ValueType>
+struct young_van_vliet_coefficients {
+    _ValueType b;
+    _ValueType a1;
+    _ValueType a2;
+    _ValueType a3;
+
+    young_van_vliet_coefficients(float sigma) {
+        double q = sigma >= 2.5f ? 0.98711 * sigma - 0.96330
+                                 : 3.97156 - 4.14554 * std::sqrt(1.0 - 0.26891 * sigma);
+        double q2 = q * q;
+        double q3 = q2 * q;
+        double b0 = 1.57825 + 2.44413 * q + 1.4281 * q2 + 0.422205 * q3;
+        double b1 = 2.44413 * q + 2.85619 * q2 + 1.26661 * q3;
+        double b2 = -(1.4281 * q2 + 1.26661 * q3);
+        double b3 = 0.422205 * q3;
+
+        a1 = static_cast<_ValueType>(b1 / b0);
+        a2 = static_cast<_ValueType>(b2 / b0);
+        a3 = static_cast<_ValueType>(b3 / b0);
+        b = static_cast<_ValueType>(1.0 - (b1 + b2 + b3) / b0);
+    }
+};
+
+/// the margin of the iir filter, the response of the recursion decays enough out of it
+inline int_t gaussian_iir_margin(float sigma) {
+    return static_cast<int_t>(std::ceil(4.0f * sigma));
+}
+
+/**
+ * @brief the Young-van Vliet recursive gaussian of interleaved lines
+ *
+ * a causal and an anti-causal third order recursion, the cost per element is independent of
+ * sigma. the recursion runs along the lines, the lanes are independent and vectorized.
+ *
+ * @param in the padded input, [n + 2 * margin][lanes]
+ * @param out the output, [n][lanes]
+ */
+template <typename _ValueType>
+inline void gaussian_iir(const _ValueType* in, _ValueType* out, int_t n, int_t lanes,
+                         int_t margin, const young_van_vliet_coefficients<_ValueType>& c) {
+    auto padded_n = n + 2 * margin;
+    std::vector<_ValueType> w((padded_n + 6) * lanes);
+    // three steady state elements before and after the padded line
+    auto p_w = w.data() + 3 * lanes;
+
+    for (int_t j = -3; j < 0; ++j) {
+        for (int_t l = 0; l < lanes; ++l) p_w[j * lanes + l] = in[l];
+    }
+    for (int_t j = 0; j < padded_n; ++j) {
+        auto p_in = in + j * lanes;
+        auto p = p_w + j * lanes;
+        for (int_t l = 0; l < lanes; ++l) {
+            p[l] = c.b * p_in[l] + c.a1 * p[l - lanes] + c.a2 * p[l - 2 * lanes] +
+                   c.a3 * p[l - 3 * lanes];
+        }
+    }
+
+    for (int_t j = padded_n; j < padded_n + 3; ++j) {
+        for (int_t l = 0; l < lanes; ++l) p_w[j * lanes + l] = p_w[(padded_n - 1) * lanes + l];
+    }
+    for (int_t j = padded_n - 1; j >= 0; --j) {
+        auto p = p_w + j * lanes;
+        for (int_t l = 0; l < lanes; ++l) {
+            p[l] = c.b * p[l] + c.a1 * p[l + lanes] + c.a2 * p[l + 2 * lanes] +
+                   c.a3 * p[l + 3 * lanes];
+        }
+    }
+
+    for (int_t i = 0; i < n; ++i) {
+        auto p_out = out + i * lanes;
+        auto p = p_w + (i + margin) * lanes;
+        for (int_t l = 0; l < lanes; ++l) p_out[l] = p[l];
+    }
+}
+
+}  // namespace internal
+
+/**
+ * @brief the gaussian blur along an axis of a dense tensor
+ *
+ * a small sigma uses a truncated fir kernel, a large sigma uses the Young-van Vliet recursive
+ * filter whose cost is independent of sigma, the kernel is never materialized in the tensor.
+ *
+ * @param policy the execution policy, the lines are distributed by it
+ * @param ts_src the source tensor, the value type should be floating point
+ * @param ts_dst the dest tensor, could be ts_src itself
+ * @param axis the axis of the blur
+ * @param sigma the standard deviation of the gaussian
+ * @param mode the border mode
+ */
+template <typename _ExecutionPolicy, typename _TensorSrc, typename _TensorDst>
+inline void gaussian_blur(_ExecutionPolicy policy, const _TensorSrc& ts_src, _TensorDst&& ts_dst,
+                          int_t axis, float sigma, border_mode mode = border_mode::reflect) {
+    typedef typename _TensorSrc::value_type value_type;
+    static_assert(std::is_floating_point<value_type>::value,
+                  "the value type should be floating point");
+    MATAZURE_ASSERT(sigma > 0, "sigma should be greater than zero");
+
+    if (sigma < gaussian_blur_iir_sigma_threshold) {
+        auto kernel = internal::make_gaussian_kernel<value_type>(sigma);
+        auto radius = internal::gaussian_kernel_radius(sigma);
+        internal::for_each_line_batch(
+            policy, ts_src, ts_dst, axis, radius, radius, mode, value_type(0),
+            [&kernel](const value_type* in, value_type* out, int_t n, int_t lanes) {
+                internal::gaussian_fir(in, out, n, lanes, kernel);
+            });
+    } else {
+        internal::young_van_vliet_coefficients<value_type> coefficients(sigma);
+        auto margin = internal::gaussian_iir_margin(sigma);
+        internal::for_each_line_batch(
+            policy, ts_src, ts_dst, axis, margin, margin, mode, value_type(0),
+            [&coefficients, margin](const value_type* in, value_type* out, int_t n, int_t lanes) {
+                internal::gaussian_iir(in, out, n, lanes, margin, coefficients);
+            });
+    }
+}
+
+/**
+ * @brief the isotropic gaussian blur of a dense tensor, it's separated along each axis
+ * @see gaussian_blur
+ */
+template <typename _ExecutionPolicy, typename _TensorSrc, typename _TensorDst>
+inline void gaussian_blur(_ExecutionPolicy policy, const _TensorSrc& ts_src, _TensorDst&& ts_dst,
+                          float sigma, border_mode mode = border_mode::reflect) {
+    gaussian_blur(policy, ts_src, ts_dst, 0, sigma, mode);
+    for (int_t axis = 1; axis < _TensorSrc::rank; ++axis) {
+        gaussian_blur(policy, ts_dst, ts_dst, axis, sigma, mode);
+    }
+}
+
+/// the isotropic gaussian blur of a dense tensor by the sequence policy
+template <typename _TensorSrc, typename _TensorDst>
+inline void gaussian_blur(const _TensorSrc& ts_src, _TensorDst&& ts_dst, float sigma,
+                          enable_if_t<is_tensor<_TensorSrc>::value>* = 0) {
+    sequence_policy policy{};
+    gaussian_blur(policy, ts_src, std::forward<_TensorDst>(ts_dst), sigma);
+}
+
+}  // namespace matazure
@@ -22,6 +22,39 @@ inline MATAZURE_GENERAL bool inside_rect(point<int_t, _Rank> idx, point<int_t, _
     return true;
 }
 
+/**
+ * @brief the ways to extrapolate the elements out of a tensor's border
+ *
+ * constant:  vvv|abcd|vvv, v is a given border value
+ * replicate: aaa|abcd|ddd
+ * reflect:   cba|abcd|dcb
+ */
+enum struct border_mode { constant, replicate, reflect };
+
+/**
+ * @brief maps an index of a 1-dim range to the inside of the range by the border mode
+ * @param i the index, may be out of [0, size)
+ * @param size the size of the range
+ * @param mode the border mode
+ * @return the index inside [0, size), or -1 if the element is a constant border value
+ */
+inline MATAZURE_GENERAL int_t border_index(int_t i, int_t size, border_mode mode) {
+    if (MATAZURE_LIKELY(static_cast<uint_t>(i) < static_cast<uint_t>(size))) return i;
+
+    switch (mode) {
+        case border_mode::replicate:
+            return i < 0 ? 0 : size - 1;
+        case border_mode::reflect: {
+            auto period = 2 * size;
+            i = i % period;
+            if (i < 0) i += period;
+            return i < size ? i : period - 1 - i;
+        }
+        default:
+            return -1;
+    }
+}
+
 template <typename _Fun>
 inline void for_border(const pointi<2>& extent, const pointi<2>& origin_padding,
                        const pointi<2>& end_padding, _Fun fun) {
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <cstdint>
+
+#include <matazure/config.hpp>
+
+#if defined(__F16C__) && !defined(__CUDA_ARCH__)
+#include <immintrin.h>
+#define MATAZURE_HALF_F16C
+#endif
+
+#if defined(__AVX512F__) && !defined(__CUDA_ARCH__)
+#include <immintrin.h>
+#define MATAZURE_HALF_AVX512
+#endif
+
+namespace matazure {
+
+namespace internal {
+
+inline MATAZURE_GENERAL std::uint32_t float_as_bits(float v) {
+    std::uint32_t re;
+    memcpy(&re, &v, sizeof(re));
+    return re;
+}
+
+inline MATAZURE_GENERAL float bits_as_float(std::uint32_t v) {
+    float re;
+    memcpy(&re, &v, sizeof(re));
+    return re;
+}
+
+/// converts a float to the IEEE 754 binary16 bits, rounds to nearest even
+inline MATAZURE_GENERAL std::uint16_t float_to_half_bits(float v) {
+    auto x = float_as_bits(v);
+    auto sign = static_cast<std::uint16_t>((x >> 16) & 0x8000u);
+    x &= 0x7fffffffu;
+
+    // inf or nan, keeps the nan quiet
+    if (x >= 0x7f800000u) {
+        return sign | (x > 0x7f800000u ? 0x7e00u : 0x7c00u);
+    }
+    // rounds to inf, the threshold is 65520
+    if (x >= 0x477ff000u) {
+        return sign | 0x7c00u;
+    }
+    // the subnormal half, adding 0.5f aligns the mantissa and rounds it by the fpu
+    if (x < 0x38800000u) {
+        auto denorm = bits_as_float(x) + 0.5f;
+        return sign | static_cast<std::uint16_t>(float_as_bits(denorm) - 0x3f000000u);
+    }
+
+    // rebiases the exponent and rounds the mantissa to nearest even
+    auto mant_odd = (x >> 13) & 1u;
+    x += 0xc8000fffu + mant_odd;
+    return sign | static_cast<std::uint16_t>(x >> 13);
+}
+
+/// converts the IEEE 754 binary16 bits to a float
+inline MATAZURE_GENERAL float half_bits_to_float(std::uint16_t h) {
+    std::uint32_t o = static_cast<std::uint32_t>(h & 0x7fffu) << 13;
+    auto exp = o & 0x0f800000u;
+    o += (127u - 15u) << 23;
+
+    if (exp == 0x0f800000u) {
+        // inf or nan
+        o += (128u - 16u) << 23;
+    } else if (exp == 0) {
+        // zero or subnormal, renormalizes by the fpu
+        o += 1u << 23;
+        o = float_as_bits(bits_as_float(o) - bits_as_float(113u << 23));
+    }
+
+    return bits_as_float(o | (static_cast<std::uint32_t>(h & 0x8000u) << 16));
+}
+
+/// converts a float to the bfloat16 bits, rounds to nearest even
+inline MATAZURE_GENERAL std::uint16_t float_to_bfloat16_bits(float v) {
+    auto x = float_as_bits(v);
+    if ((x & 0x7fffffffu) > 0x7f800000u) {
+        return static_cast<std::uint16_t>((x >> 16) | 0x40u);
+    }
+
+    x += 0x7fffu + ((x >> 16) & 1u);
+    return static_cast<std::uint16_t>(x >> 16);
+}
+
+/// converts the bfloat16 bits to a float, it's the high half of the float
+inline MATAZURE_GENERAL float bfloat16_bits_to_float(std::uint16_t b) {
+    return bits_as_float(static_cast<std::uint32_t>(b) << 16);
+}
+
+}  // namespace internal
+
+/**
+ * @brief the IEEE 754 half precision floating point
+ *
+ * it's a storage type, the arithmetic is promoted to float, e.g. half + half is a float, and
+ * the float is converted to half when it's assigned to half.
+ */
+struct half {
+    std::uint16_t bits;
+
+    half() = default;
+
+    MATAZURE_GENERAL half(float v) : bits(internal::float_to_half_bits(v)) {}
+
+    MATAZURE_GENERAL operator float() const { return internal::half_bits_to_float(bits); }
+
+    MATAZURE_GENERAL static half from_bits(std::uint16_t bits) {
+        half re;
+        re.bits = bits;
+        return re;
+    }
+
+    MATAZURE_GENERAL half& operator+=(float v) { return *this = float(*this) + v; }
+    MATAZURE_GENERAL half& operator-=(float v) { return *this = float(*this) - v; }
+    MATAZURE_GENERAL half& operator*=(float v) { return *this = float(*this) * v; }
+    MATAZURE_GENERAL half& operator/=(float v) { return *this = float(*this) / v; }
+};
+
+/**
+ * @brief the brain floating point, the high 16 bits of a float
+ *
+ * it has the range of float and 8 bits precision, the arithmetic is promoted to float as half.
+ */
+struct bfloat16 {
+    std::uint16_t bits;
+
+    bfloat16() = default;
+
+    MATAZURE_GENERAL bfloat16(float v) : bits(internal::float_to_bfloat16_bits(v)) {}
+
+    MATAZURE_GENERAL operator float() const { return internal::bfloat16_bits_to_float(bits); }
+
+    MATAZURE_GENERAL static bfloat16 from_bits(std::uint16_t bits) {
+        bfloat16 re;
+        re.bits = bits;
+        return re;
+    }
+
+    MATAZURE_GENERAL bfloat16& operator+=(float v) { return *this = float(*this) + v; }
+    MATAZURE_GENERAL bfloat16& operator-=(float v) { return *this = float(*this) - v; }
+    MATAZURE_GENERAL bfloat16& operator*=(float v) { return *this = float(*this) * v; }
+    MATAZURE_GENERAL bfloat16& operator/=(float v) { return *this = float(*this) / v; }
+};
+
+static_assert(sizeof(half) == 2 && sizeof(bfloat16) == 2, "the size should be 2 bytes");
+
+namespace internal {
+
+/**
+ * @brief converts an array of float to half
+ *
+ * it uses the F16C(or AVX-512) conversion instructions when they are enabled, otherwise the bits
+ * conversion of each element.
+ */
+inline void convert_values(const float* src, half* dst, int_t size) {
+    int_t i = 0;
+#ifdef MATAZURE_HALF_AVX512
+    for (; i + 16 <= size; i += 16) {
+        auto v = _mm512_loadu_ps(src + i);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            _mm512_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+    }
+#endif
+#ifdef MATAZURE_HALF_F16C
+    for (; i + 8 <= size; i += 8) {
+        auto v = _mm256_loadu_ps(src + i);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+    }
+#endif
+    for (; i < size; ++i) {
+        dst[i] = half(src[i]);
+    }
+}
+
+/// converts an array of half to float
+inline void convert_values(const half* src, float* dst, int_t size) {
+    int_t i = 0;
+#ifdef MATAZURE_HALF_AVX512
+    for (; i + 16 <= size; i += 16) {
+        auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm512_storeu_ps(dst + i, _mm512_cvtph_ps(v));
+    }
+#endif
+#ifdef MATAZURE_HALF_F16C
+    for (; i + 8 <= size; i += 8) {
+        auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(v));
+    }
+#endif
+    for (; i < size; ++i) {
+        dst[i] = float(src[i]);
+    }
+}
+
+/// converts an array of float to bfloat16, the bits loop is vectorized by the compiler
+inline void convert_values(const float* src, bfloat16* dst, int_t size) {
+    for (int_t i = 0; i < size; ++i) {
+        dst[i].bits = float_to_bfloat16_bits(src[i]);
+    }
+}
+
+/// converts an array of bfloat16 to float
+inline void convert_values(const bfloat16* src, float* dst, int_t size) {
+    for (int_t i = 0; i < size; ++i) {
+        dst[i] = bfloat16_bits_to_float(src[i].bits);
+    }
+}
+
+}  // namespace internal
+
+}  // namespace matazure
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <matazure/allocator.hpp>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace matazure {
+
+/// how the pages of a huge_page_allocator allocation are backed
+enum struct huge_page_kind {
+    /// explicit huge pages of the hugetlbfs pool, by MAP_HUGETLB
+    hugetlb,
+    /// transparent huge pages, by madvise(MADV_HUGEPAGE)
+    transparent,
+    /// normal pages, the allocation is small or the huge pages are unavailable
+    normal
+};
+
+/// the live allocations of all huge_page_allocator, in bytes
+struct huge_page_stats {
+    size_t allocated_bytes;
+    size_t hugetlb_bytes;
+    size_t transparent_bytes;
+    size_t normal_bytes;
+    /// the bytes actually backed by huge pages now, by /proc/self/smaps
+    size_t huge_page_backed_bytes;
+};
+
+namespace huge_page {
+
+/// the size and the alignment of the huge pages, the 2MiB of x86-64 and aarch64
+static const size_t page_size = size_t(2) << 20;
+
+struct region {
+    size_t bytes;
+    huge_page_kind kind;
+};
+
+/// the live regions of the allocators by their address, they are only used by the stats
+class registry {
+   public:
+    static registry& instance() {
+        static registry reg;
+        return reg;
+    }
+
+    void insert(void* p, region r) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        regions_[reinterpret_cast<uintptr_t>(p)] = r;
+    }
+
+    void erase(void* p) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        regions_.erase(reinterpret_cast<uintptr_t>(p));
+    }
+
+    std::map<uintptr_t, region> regions() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return regions_;
+    }
+
+   private:
+    std::mutex mutex_;
+    std::map<uintptr_t, region> regions_;
+};
+
+/**
+ * @brief the bytes of the regions which are backed by huge pages, by /proc/self/smaps
+ *
+ * a mapping of smaps may be merged with its neighbours, its huge page bytes are counted up to its
+ * overlap with the regions.
+ */
+inline size_t backed_bytes(const std::map<uintptr_t, region>& regions) {
+    size_t re = 0;
+    std::ifstream ifs("/proc/self/smaps");
+    std::string line;
+    uintptr_t begin = 0;
+    uintptr_t end = 0;
+    while (std::getline(ifs, line)) {
+        uintptr_t first, last;
+        char dash;
+        std::istringstream iss(line);
+        if (std::isxdigit(static_cast<unsigned char>(line[0])) &&
+            (iss >> std::hex >> first >> dash >> last) && dash == '-') {
+            begin = first;
+            end = last;
+            continue;
+        }
+
+        auto colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        auto field = line.substr(0, colon);
+        if (field != "AnonHugePages" && field != "Private_Hugetlb" && field != "Shared_Hugetlb") {
+            continue;
+        }
+        auto kbytes = std::strtoull(line.c_str() + colon + 1, nullptr, 10);
+        if (kbytes == 0) continue;
+
+        size_t overlap = 0;
+        for (auto& item : regions) {
+            auto region_end = item.first + item.second.bytes;
+            if (item.first < end && begin < region_end) {
+                overlap += std::min(end, region_end) - std::max(begin, item.first);
+            }
+        }
+        re += std::min(static_cast<size_t>(kbytes) << 10, overlap);
+    }
+    return re;
+}
+
+}  // namespace huge_page
+
+/// the stats of the live allocations of all huge_page_allocator
+inline huge_page_stats get_huge_page_stats() {
+    auto regions = huge_page::registry::instance().regions();
+    huge_page_stats re = {0, 0, 0, 0, 0};
+    for (auto& item : regions) {
+        re.allocated_bytes += item.second.bytes;
+        switch (item.second.kind) {
+            case huge_page_kind::hugetlb:
+                re.hugetlb_bytes += item.second.bytes;
+                break;
+            case huge_page_kind::transparent:
+                re.transparent_bytes += item.second.bytes;
+                break;
+            default:
+                re.normal_bytes += item.second.bytes;
+        }
+    }
+#ifdef __linux__
+    re.huge_page_backed_bytes = huge_page::backed_bytes(regions);
+#endif
+    return re;
+}
+
+/**
+ * @brief an allocator which backs the large tensors by 2MiB huge pages
+ *
+ * an allocation of at least a huge page is rounded up to huge pages and mapped by MAP_HUGETLB
+ * from the hugetlbfs pool, or, when the pool is empty, mapped 2MiB aligned and advised by
+ * madvise(MADV_HUGEPAGE) for the transparent huge pages. the smaller allocations, and all of them
+ * on a non linux host, are aligned to 64 bytes on normal pages. get_huge_page_stats reports how
+ * much is backed by huge pages.
+ *
+ * @tparam _Type the value type
+ * @tparam _FirstTouchPolicy the policy the elements are constructed by, see numa_allocator
+ */
+template <typename _Type, typename _FirstTouchPolicy = sequence_policy>
+class huge_page_allocator : public std::allocator<_Type> {
+   public:
+    typedef _FirstTouchPolicy first_touch_policy;
+
+    huge_page_allocator() {}
+
+    _Type* allocate(size_t size) {
+        auto bytes = size * sizeof(_Type);
+        huge_page::region r = {bytes, huge_page_kind::normal};
+        _Type* data = nullptr;
+        if (is_mapped(bytes)) {
+            r.bytes = mapped_bytes(bytes);
+            data = static_cast<_Type*>(map_huge_pages(r.bytes, r.kind));
+        } else {
+            data = aligned_allocator_.allocate(size);
+            if (!data && bytes) throw std::bad_alloc{};
+        }
+
+        huge_page::registry::instance().insert(data, r);
+        return data;
+    }
+
+    void deallocate(_Type* p, size_t size) {
+        huge_page::registry::instance().erase(p);
+        auto bytes = size * sizeof(_Type);
+        if (!is_mapped(bytes)) return aligned_allocator_.deallocate(p, size);
+
+#ifdef __linux__
+        munmap(p, mapped_bytes(bytes));
+#endif
+    }
+
+   private:
+    static bool is_mapped(size_t bytes) {
+#ifdef __linux__
+        return bytes >= huge_page::page_size;
+#else
+        return false;
+#endif
+    }
+
+    static size_t mapped_bytes(size_t bytes) {
+        return (bytes + huge_page::page_size - 1) / huge_page::page_size * huge_page::page_size;
+    }
+
+    static void* map_huge_pages(size_t bytes, huge_page_kind& kind) {
+#ifdef __linux__
+        const int prot = PROT_READ | PROT_WRITE;
+        const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_HUGETLB
+        void* data = mmap(nullptr, bytes, prot, flags | MAP_HUGETLB, -1, 0);
+        if (data != MAP_FAILED) {
+            kind = huge_page_kind::hugetlb;
+            return data;
+        }
+#endif
+        // maps a huge page more, and trims it to the 2MiB aligned region
+        auto size = bytes + huge_page::page_size;
+        auto p = static_cast<char*>(mmap(nullptr, size, prot, flags, -1, 0));
+        if (p == MAP_FAILED) throw std::bad_alloc{};
+        auto offset = reinterpret_cast<uintptr_t>(p) % huge_page::page_size;
+        auto head = offset ? huge_page::page_size - offset : 0;
+        if (head) munmap(p, head);
+        munmap(p + head + bytes, huge_page::page_size - head);
+
+        kind = huge_page_kind::normal;
+#ifdef MADV_HUGEPAGE
+        if (madvise(p + head, bytes, MADV_HUGEPAGE) == 0) kind = huge_page_kind::transparent;
+#endif
+        return p + head;
+#else
+        return nullptr;
+#endif
+    }
+
+    aligned_allocator<_Type, 64> aligned_allocator_;
+};
+
+}  // namespace matazure
@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <matazure/layout.hpp>
 #include <matazure/local_tensor.hpp>
 #include <matazure/tensor.hpp>
@@ -24,6 +25,108 @@ struct get_functor_accessor_type {
         type;
 };
 
+/// whether a capture of a view may read the memory [first, last), @see alias_traits
+template <typename _Capture>
+inline bool may_alias(const _Capture& capture, const void* first, const void* last);
+
+/// whether the memory [first0, last0) and [first1, last1) are overlapped
+inline bool ranges_overlap(const void* first0, const void* last0, const void* first1,
+                           const void* last1) {
+    return reinterpret_cast<uintptr_t>(first0) < reinterpret_cast<uintptr_t>(last1) &&
+           reinterpret_cast<uintptr_t>(first1) < reinterpret_cast<uintptr_t>(last0);
+}
+
+/// whether a capture has a may_alias(first, last) member, e.g. a view functor
+template <typename _Capture, typename _Enable = void>
+struct has_may_alias_member : bool_constant<false> {};
+
+template <typename _Capture>
+struct has_may_alias_member<_Capture, decltype(void(std::declval<const _Capture&>().may_alias(
+                                          std::declval<const void*>(),
+                                          std::declval<const void*>())))>
+    : bool_constant<true> {};
+
+/**
+ * @brief the memory a capture of a view reads, it decides whether persist_into needs a buffer
+ *
+ * a tensor or tensor_ref reads its data range, an empty functor, a scalar and a local_tensor
+ * read no external memory, a lambda_tensor reads the memory of its functor, a view functor lists
+ * its captures by a may_alias(first, last) member, the member wins even if the functor is empty
+ * (e.g. it reads a global). the others (e.g. a lambda capturing a pointer) are unknown, they're
+ * treated as aliased, a false positive only costs a copy.
+ */
+template <typename _Capture, typename _Enable = void>
+struct alias_traits {
+    static bool may_alias(const _Capture&, const void*, const void*) { return true; }
+};
+
+template <typename _Capture>
+struct alias_traits<_Capture, enable_if_t<!has_may_alias_member<_Capture>::value &&
+                                          (std::is_empty<_Capture>::value ||
+                                           std::is_arithmetic<_Capture>::value)>> {
+    static bool may_alias(const _Capture&, const void*, const void*) { return false; }
+};
+
+template <typename _Capture>
+struct alias_traits<_Capture, enable_if_t<has_may_alias_member<_Capture>::value>> {
+    static bool may_alias(const _Capture& capture, const void* first, const void* last) {
+        return capture.may_alias(first, last);
+    }
+};
+
+template <typename _ValueType, int_t _Rank, typename _Layout, typename _Allocator>
+struct alias_traits<tensor<_ValueType, _Rank, _Layout, _Allocator>> {
+    static bool may_alias(const tensor<_ValueType, _Rank, _Layout, _Allocator>& ts,
+                          const void* first, const void* last) {
+        return ranges_overlap(ts.data(), ts.data() + ts.size(), first, last);
+    }
+};
+
+template <typename _ValueType, int_t _Rank, typename _Layout>
+struct alias_traits<tensor_ref<_ValueType, _Rank, _Layout>> {
+    static bool may_alias(const tensor_ref<_ValueType, _Rank, _Layout>& ts, const void* first,
+                          const void* last) {
+        return ranges_overlap(ts.data(), ts.data() + ts.size(), first, last);
+    }
+};
+
+template <typename _Tensor>
+struct alias_traits<owned_tensor<_Tensor>> : alias_traits<_Tensor> {};
+
+template <typename _ValueType, typename _Shape, typename _Layout>
+struct alias_traits<local_tensor<_ValueType, _Shape, _Layout>> {
+    static bool may_alias(const local_tensor<_ValueType, _Shape, _Layout>&, const void*,
+                          const void*) {
+        return false;
+    }
+};
+
+template <typename... _Captures>
+struct alias_traits<tuple<_Captures...>> {
+    static bool may_alias(const tuple<_Captures...>& captures, const void* first,
+                          const void* last) {
+        return may_alias_imp(captures, first, last,
+                             make_integer_sequence<int_t, sizeof...(_Captures)>{});
+    }
+
+   private:
+    template <int_t... _Indices>
+    static bool may_alias_imp(const tuple<_Captures...>& captures, const void* first,
+                              const void* last, integer_sequence<int_t, _Indices...>) {
+        bool re = false;
+        // expands the captures in order
+        int_t expand[] = {
+            0, (re = re || internal::may_alias(get<_Indices>(captures), first, last), 0)...};
+        static_cast<void>(expand);
+        return re;
+    }
+};
+
+template <typename _Capture>
+inline bool may_alias(const _Capture& capture, const void* first, const void* last) {
+    return alias_traits<_Capture>::may_alias(capture, first, last);
+}
+
 }  // namespace internal
 
 /**
@@ -40,10 +143,10 @@ class lambda_tensor : public tensor_expression<lambda_tensor<_Rank, _Fun, _Layou
     static const int_t rank = _Rank;
     typedef _Fun functor_type;
     typedef typename function_traits_t::result_type reference;
-    /// the value type of lambdd_tensor, it's the result type of functor_type
+    /// the value type of lambda_tensor, it's the result type of functor_type
     typedef remove_reference_t<reference> value_type;
     /**
-     * @brief the access mode of lambdd_tensor, it's decided by the argument pattern.
+     * @brief the access mode of lambda_tensor, it's decided by the argument pattern.
      *
      * when the functor is int_t -> value pattern, the access mode is linear access.
      * when the functor is pointi<rank> -> value pattern, the access mode is array access.
@@ -55,9 +158,9 @@ class lambda_tensor : public tensor_expression<lambda_tensor<_Rank, _Fun, _Layou
 
    public:
     /**
-     * @brief constructs a lambdd_tensor by the shape and fun
+     * @brief constructs a lambda_tensor by the shape and fun
      * @param ext the shape of tensor
-     * @param fun the functor of lambdd_tensor, should be Index -> Value pattern
+     * @param fun the functor of lambda_tensor, should be Index -> Value pattern
      */
     lambda_tensor(const pointi<rank>& ext, _Fun fun) : shape_(ext), layout_(ext), functor_(fun) {}
 
@@ -107,23 +210,80 @@ class lambda_tensor : public tensor_expression<lambda_tensor<_Rank, _Fun, _Layou
     int_t size() const { return layout_.size(); }
 
     /**
-     * @brief perisits a lambdd_tensor to a tensor with memory
+     * @brief perisits a lambda_tensor to a tensor with memory
      * @param policy the execution policy
-     * @return a tensor which copys elements value from lambdd_tensor
+     * @return a tensor which copys elements value from lambda_tensor
      */
     template <typename _ExecutionPolicy>
     MATAZURE_GENERAL tensor<decay_t<value_type>, rank> persist(_ExecutionPolicy policy) const {
+        MATAZURE_TRACE_SCOPE("persist", policy, this->shape(), trace::element_size(*this),
+                             trace::tensor_bytes(*this), trace::tensor_bytes(*this));
         tensor<decay_t<value_type>, rank> re(this->shape());
         copy(policy, *this, re);
         return re;
     }
 
-    /// persists a lambdd_tensor to a tensor by sequence policy
+    /// persists a lambda_tensor to a tensor by sequence policy
     MATAZURE_GENERAL tensor<decay_t<value_type>, rank> persist() const {
         sequence_policy policy{};
         return persist(policy);
     }
 
+    /**
+     * @brief persists a lambda_tensor into an existing tensor, reuses its memory
+     *
+     * when the lambda_tensor may read the memory of ts_dst, it's evaluated into a ping-pong buffer
+     * and then copied back, so a stencil such as view::conv(ts, kernel) could be persisted into ts.
+     * the captures are checked by internal::alias_traits, an unknown capture takes the buffer.
+     * the buffer is allocated by each aliased call, pass a scratch tensor to reuse one in a loop.
+     *
+     * @param policy the execution policy
+     * @param ts_dst the dest tensor with memory, a tensor or tensor_ref of the same shape
+     */
+    template <typename _ExecutionPolicy, typename _TensorDst>
+    void persist_into(_ExecutionPolicy policy, const _TensorDst& ts_dst) const {
+        MATAZURE_ASSERT(equal(this->shape(), ts_dst.shape()), "the shapes are not matched");
+        MATAZURE_TRACE_SCOPE("persist_into", policy, this->shape(), trace::element_size(*this),
+                             trace::tensor_bytes(*this), trace::tensor_bytes(*this));
+        if (internal::may_alias(functor_, ts_dst.data(), ts_dst.data() + ts_dst.size())) {
+            tensor<decay_t<value_type>, rank> ts_pingpong(this->shape());
+            copy(policy, *this, ts_pingpong);
+            copy(policy, ts_pingpong, ts_dst);
+        } else {
+            copy(policy, *this, ts_dst);
+        }
+    }
+
+    /**
+     * @brief persists a lambda_tensor into an existing tensor, ts_scratch is the ping-pong buffer
+     *
+     * @param policy the execution policy
+     * @param ts_dst the dest tensor with memory, a tensor or tensor_ref of the same shape
+     * @param ts_scratch the buffer used when the lambda_tensor may read ts_dst, it has the same
+     * shape and the lambda_tensor mustn't read it
+     */
+    template <typename _ExecutionPolicy, typename _TensorDst, typename _TensorScratch>
+    void persist_into(_ExecutionPolicy policy, const _TensorDst& ts_dst,
+                      const _TensorScratch& ts_scratch) const {
+        MATAZURE_ASSERT(equal(this->shape(), ts_dst.shape()), "the shapes are not matched");
+        MATAZURE_ASSERT(equal(this->shape(), ts_scratch.shape()), "the shapes are not matched");
+        MATAZURE_TRACE_SCOPE("persist_into", policy, this->shape(), trace::element_size(*this),
+                             trace::tensor_bytes(*this), trace::tensor_bytes(*this));
+        if (internal::may_alias(functor_, ts_dst.data(), ts_dst.data() + ts_dst.size())) {
+            copy(policy, *this, ts_scratch);
+            copy(policy, ts_scratch, ts_dst);
+        } else {
+            copy(policy, *this, ts_dst);
+        }
+    }
+
+    /// persists a lambda_tensor into an existing tensor by sequence policy
+    template <typename _TensorDst>
+    void persist_into(const _TensorDst& ts_dst) const {
+        sequence_policy policy{};
+        persist_into(policy, ts_dst);
+    }
+
     layout_type layout() const { return layout_; }
 
     constexpr runtime_type runtime() const { return runtime_type{}; }
@@ -157,6 +317,18 @@ class lambda_tensor : public tensor_expression<lambda_tensor<_Rank, _Fun, _Layou
     const _Fun functor_;
 };
 
+namespace internal {
+
+template <int_t _Rank, typename _Fun, typename _Layout>
+struct alias_traits<lambda_tensor<_Rank, _Fun, _Layout>> {
+    static bool may_alias(const lambda_tensor<_Rank, _Fun, _Layout>& ts, const void* first,
+                          const void* last) {
+        return internal::may_alias(ts.functor(), first, last);
+    }
+};
+
+}  // namespace internal
+
 /**
  * @brief make a lambda_tensor
  * @param the shape
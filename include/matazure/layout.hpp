@@ -1,8 +1,14 @@
 #pragma once
 
 #include <matazure/config.hpp>
+#include <matazure/meta.hpp>
 #include <matazure/point.hpp>
 
+#if defined(__BMI2__) && !defined(__CUDA_ARCH__)
+#include <immintrin.h>
+#define MATAZURE_LAYOUT_BMI2
+#endif
+
 namespace matazure {
 
 /**
@@ -24,14 +30,9 @@ class column_major_layout {
         }
     }
 
-    MATAZURE_GENERAL column_major_layout(const column_major_layout& rhs)
-        : column_major_layout(rhs.shape()) {}
+    column_major_layout(const column_major_layout& rhs) = default;
 
-    MATAZURE_GENERAL column_major_layout& operator=(const column_major_layout& rhs) {
-        shape_ = rhs.shape();
-        stride_ = rhs.stride();
-        return *this;
-    }
+    column_major_layout& operator=(const column_major_layout& rhs) = default;
 
     MATAZURE_GENERAL int_t index2offset(const pointi<rank>& id) const {
         int_t offset = id[0];
@@ -59,7 +60,7 @@ class column_major_layout {
 
     MATAZURE_GENERAL int_t size() const { return stride_[rank - 1]; };
 
-    MATAZURE_GENERAL ~column_major_layout() {}
+    ~column_major_layout() = default;
 
    private:
     pointi<rank> shape_;
@@ -81,14 +82,9 @@ class row_major_layout {
         }
     }
 
-    MATAZURE_GENERAL row_major_layout(const row_major_layout& rhs)
-        : row_major_layout(rhs.shape()) {}
+    row_major_layout(const row_major_layout& rhs) = default;
 
-    MATAZURE_GENERAL row_major_layout& operator=(const row_major_layout& rhs) {
-        shape_ = rhs.shape();
-        stride_ = rhs.stride();
-        return *this;
-    }
+    row_major_layout& operator=(const row_major_layout& rhs) = default;
 
     MATAZURE_GENERAL int_t index2offset(const pointi<rank>& id) const {
         typename pointi<rank>::value_type offset = id[rank - 1];
@@ -115,13 +111,244 @@ class row_major_layout {
 
     MATAZURE_GENERAL pointi<rank> stride() const { return stride_; }
 
-    MATAZURE_GENERAL ~row_major_layout() {}
+    ~row_major_layout() = default;
 
    private:
     pointi<rank> shape_;
     pointi<rank> stride_;
 };
 
+template <int_t... _Values>
+using dim = meta::array<_Values...>;
+
+/**
+ * @brief the blocked layout, the tensor is stored by tiles(bricks)
+ *
+ * the tiles are in row major order, the elements of a tile are in row major order too, so the
+ * neighbours along all axes of an element are near in memory. the shape is padded to the
+ * multiple of the tile shape.
+ *
+ * @tparam _Rank the rank
+ * @tparam _Tile the tile shape, a dim<...>, e.g. dim<8, 8, 8>
+ */
+template <int_t _Rank, typename _Tile>
+class tiled_layout {
+   public:
+    const static int_t rank = _Rank;
+    typedef _Tile tile_type;
+
+    static_assert(_Tile::rank == _Rank, "the tile rank should be equal to the layout rank");
+
+    MATAZURE_GENERAL tiled_layout() : tiled_layout(pointi<rank>{0}){};
+
+    MATAZURE_GENERAL tiled_layout(const pointi<rank>& shape) : shape_(shape) {
+        auto tile = tile_shape();
+        size_ = tile_size();
+        for (int_t i = 0; i < rank; ++i) {
+            grid_shape_[i] = (shape[i] + tile[i] - 1) / tile[i];
+            size_ *= grid_shape_[i];
+        }
+    }
+
+    tiled_layout(const tiled_layout& rhs) = default;
+
+    tiled_layout& operator=(const tiled_layout& rhs) = default;
+
+    MATAZURE_GENERAL int_t index2offset(const pointi<rank>& id) const {
+        auto tile = tile_shape();
+        int_t tile_offset = 0;
+        int_t inner_offset = 0;
+        for (int_t i = 0; i < rank; ++i) {
+            tile_offset = tile_offset * grid_shape_[i] + id[i] / tile[i];
+            inner_offset = inner_offset * tile[i] + id[i] % tile[i];
+        }
+
+        return tile_offset * tile_size() + inner_offset;
+    }
+
+    MATAZURE_GENERAL pointi<rank> offset2index(int_t offset) const {
+        auto tile = tile_shape();
+        auto tile_offset = offset / tile_size();
+        auto inner_offset = offset % tile_size();
+        pointi<rank> id;
+        for (int_t i = rank - 1; i >= 0; --i) {
+            id[i] = (tile_offset % grid_shape_[i]) * tile[i] + inner_offset % tile[i];
+            tile_offset /= grid_shape_[i];
+            inner_offset /= tile[i];
+        }
+
+        return id;
+    }
+
+    /**
+     * @brief the offset of the neighbour id + delta * e(axis)
+     *
+     * when the neighbour is in the same tile, it's a constant stride from the offset of id.
+     */
+    MATAZURE_GENERAL int_t neighbor_offset(const pointi<rank>& id, int_t offset, int_t axis,
+                                           int_t delta) const {
+        auto tile = tile_shape();
+        auto inner_i = id[axis] % tile[axis] + delta;
+        if (MATAZURE_LIKELY(inner_i >= 0 && inner_i < tile[axis])) {
+            int_t inner_stride = 1;
+            for (int_t i = axis + 1; i < rank; ++i) inner_stride *= tile[i];
+            return offset + delta * inner_stride;
+        }
+
+        auto neighbor_id = id;
+        neighbor_id[axis] += delta;
+        return index2offset(neighbor_id);
+    }
+
+    /// the shape of a tile
+    MATAZURE_GENERAL static constexpr pointi<rank> tile_shape() { return _Tile::value(); }
+
+    /// the elements number of a tile
+    MATAZURE_GENERAL static int_t tile_size() {
+        auto tile = tile_shape();
+        int_t re = 1;
+        for (int_t i = 0; i < rank; ++i) re *= tile[i];
+        return re;
+    }
+
+    /// the tiles number along each axis
+    MATAZURE_GENERAL pointi<rank> grid_shape() const { return grid_shape_; }
+
+    MATAZURE_GENERAL int_t size() const { return size_; }
+
+    MATAZURE_GENERAL pointi<rank> shape() const { return shape_; }
+
+    ~tiled_layout() = default;
+
+   private:
+    pointi<rank> shape_;
+    pointi<rank> grid_shape_;
+    int_t size_;
+};
+
+namespace internal {
+
+/// scatters the low bits of value to the set bits of mask
+inline MATAZURE_GENERAL uint_t deposit_bits(uint_t value, uint_t mask) {
+#ifdef MATAZURE_LAYOUT_BMI2
+    return _pdep_u32(value, mask);
+#else
+    uint_t re = 0;
+    for (uint_t bit = 1; mask; bit <<= 1) {
+        if (value & bit) re |= mask & (0u - mask);
+        mask &= mask - 1;
+    }
+    return re;
+#endif
+}
+
+/// gathers the set bits of mask in value to the low bits
+inline MATAZURE_GENERAL uint_t extract_bits(uint_t value, uint_t mask) {
+#ifdef MATAZURE_LAYOUT_BMI2
+    return _pext_u32(value, mask);
+#else
+    uint_t re = 0;
+    for (uint_t bit = 1; mask; bit <<= 1) {
+        if (value & mask & (0u - mask)) re |= bit;
+        mask &= mask - 1;
+    }
+    return re;
+#endif
+}
+
+}  // namespace internal
+
+/**
+ * @brief the Morton(Z-order) layout
+ *
+ * the offset interleaves the bits of the index of each axis, the last axis has the lowest bit.
+ * each axis is padded to a power of two, when an axis has more bits than the others, its high
+ * bits are appended after the interleaved bits, so an elongated shape is not padded to a cube.
+ */
+template <int_t _Rank>
+class morton_layout {
+   public:
+    const static int_t rank = _Rank;
+
+    MATAZURE_GENERAL morton_layout() : morton_layout(pointi<rank>{0}){};
+
+    MATAZURE_GENERAL morton_layout(const pointi<rank>& shape) : shape_(shape) {
+        pointi<rank> bits;
+        int_t max_bits = 0;
+        bool is_empty = false;
+        for (int_t i = 0; i < rank; ++i) {
+            bits[i] = 0;
+            while ((1 << bits[i]) < shape[i]) ++bits[i];
+            max_bits = bits[i] > max_bits ? bits[i] : max_bits;
+            is_empty = is_empty || shape[i] <= 0;
+            masks_[i] = 0;
+        }
+
+        int_t position = 0;
+        for (int_t level = 0; level < max_bits; ++level) {
+            for (int_t i = rank - 1; i >= 0; --i) {
+                if (level < bits[i]) {
+                    masks_[i] |= 1 << position;
+                    ++position;
+                }
+            }
+        }
+        MATAZURE_ASSERT(position < 31, "the shape is too large for morton layout");
+
+        size_ = is_empty ? 0 : 1 << position;
+    }
+
+    morton_layout(const morton_layout& rhs) = default;
+
+    morton_layout& operator=(const morton_layout& rhs) = default;
+
+    MATAZURE_GENERAL int_t index2offset(const pointi<rank>& id) const {
+        uint_t offset = 0;
+        for (int_t i = 0; i < rank; ++i) {
+            offset |= internal::deposit_bits(static_cast<uint_t>(id[i]), masks_[i]);
+        }
+
+        return static_cast<int_t>(offset);
+    }
+
+    MATAZURE_GENERAL pointi<rank> offset2index(int_t offset) const {
+        pointi<rank> id;
+        for (int_t i = 0; i < rank; ++i) {
+            auto bits = internal::extract_bits(static_cast<uint_t>(offset), masks_[i]);
+            id[i] = static_cast<int_t>(bits);
+        }
+
+        return id;
+    }
+
+    /**
+     * @brief the offset of the neighbour id + delta * e(axis), offset is the offset of id
+     *
+     * the bits of the axis are added in place by masked arithmetic, it doesn't decode the index.
+     */
+    MATAZURE_GENERAL int_t neighbor_offset(int_t offset, int_t axis, int_t delta) const {
+        auto mask = static_cast<uint_t>(masks_[axis]);
+        auto o = static_cast<uint_t>(offset);
+        auto d = internal::deposit_bits(static_cast<uint_t>(delta >= 0 ? delta : -delta), mask);
+        auto moved = delta >= 0 ? ((o | ~mask) + d) & mask : ((o & mask) - d) & mask;
+        return static_cast<int_t>((o & ~mask) | moved);
+    }
+
+    /// the offset bits of each axis
+    MATAZURE_GENERAL pointi<rank> masks() const { return masks_; }
+
+    MATAZURE_GENERAL int_t size() const { return size_; }
+
+    MATAZURE_GENERAL pointi<rank> shape() const { return shape_; }
+
+    ~morton_layout() = default;
+
+   private:
+    pointi<rank> shape_;
+    pointi<rank> masks_;
+    int_t size_;
+};
+
 struct global_t {};
 
 template <typename _T, int_t _Rank>
@@ -142,6 +369,16 @@ struct layout_getter<column_major_layout<M>, N> {
     typedef column_major_layout<N> type;
 };
 
+template <int_t M, typename _Tile, int_t N>
+struct layout_getter<tiled_layout<M, _Tile>, N> {
+    typedef row_major_layout<N> type;
+};
+
+template <int_t M, int_t N>
+struct layout_getter<morton_layout<M>, N> {
+    typedef row_major_layout<N> type;
+};
+
 namespace internal {
 template <int_t _Rank>
 inline constexpr pointi<_Rank> get_array_index_by_layout(pointi<_Rank> pt,
@@ -155,6 +392,17 @@ inline constexpr pointi<_Rank> get_array_index_by_layout(pointi<_Rank> pt,
     return pt;
 }
 
+template <int_t _Rank, typename _Tile>
+inline constexpr pointi<_Rank> get_array_index_by_layout(pointi<_Rank> pt,
+                                                         tiled_layout<_Rank, _Tile>) {
+    return pt;
+}
+
+template <int_t _Rank>
+inline constexpr pointi<_Rank> get_array_index_by_layout(pointi<_Rank> pt, morton_layout<_Rank>) {
+    return pt;
+}
+
 }  // namespace internal
 
 }  // namespace matazure
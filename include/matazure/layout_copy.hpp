@@ -0,0 +1,150 @@
+#pragma once
+
+#include <matazure/algorithm.hpp>
+#include <matazure/tensor.hpp>
+
+namespace matazure {
+
+/// whether the layout stores the neighbours along all axes near, tiled_layout or morton_layout
+template <typename _Layout>
+struct is_blocked_layout : bool_constant<false> {};
+
+template <int_t _Rank, typename _Tile>
+struct is_blocked_layout<tiled_layout<_Rank, _Tile>> : bool_constant<true> {};
+
+template <int_t _Rank>
+struct is_blocked_layout<morton_layout<_Rank>> : bool_constant<true> {};
+
+namespace internal {
+
+/**
+ * @brief copies between a row major tensor and a tiled tensor tile by tile
+ *
+ * a row of a tile is contiguous in both layouts, so it's copied as a block. the tiles are
+ * distributed by the policy.
+ */
+template <typename _ExecutionPolicy, int_t _Rank, typename _RowMajorTensor,
+          typename _TiledTensor>
+inline void copy_tiles(_ExecutionPolicy policy, const _RowMajorTensor& ts_row_major,
+                       const _TiledTensor& ts_tiled, bool is_to_tiled) {
+    auto layout = ts_tiled.layout();
+    auto shape = layout.shape();
+    auto tile = layout.tile_shape();
+    auto tile_size = layout.tile_size();
+    row_major_layout<_Rank> grid_layout(layout.grid_shape());
+    row_major_layout<_Rank> tile_layout(tile);
+
+    for_index(policy, 0, grid_layout.size(), [&](int_t tile_i) {
+        auto tile_id = grid_layout.offset2index(tile_i);
+        pointi<_Rank> origin;
+        pointi<_Rank> rows_extent;
+        for (int_t i = 0; i < _Rank; ++i) {
+            origin[i] = tile_id[i] * tile[i];
+            rows_extent[i] = std::min(tile[i], shape[i] - origin[i]);
+        }
+        auto row_length = rows_extent[_Rank - 1];
+        rows_extent[_Rank - 1] = 1;
+
+        auto p_tile = ts_tiled.data() + tile_i * tile_size;
+        for_index(sequence_policy{}, zero<pointi<_Rank>>::value(), rows_extent,
+                  [&](pointi<_Rank> inner_id) {
+                      pointi<_Rank> id;
+                      for (int_t i = 0; i < _Rank; ++i) id[i] = origin[i] + inner_id[i];
+                      auto p_row = &ts_row_major(id);
+                      auto p_tile_row = p_tile + tile_layout.index2offset(inner_id);
+                      if (is_to_tiled) {
+                          std::copy(p_row, p_row + row_length, p_tile_row);
+                      } else {
+                          std::copy(p_tile_row, p_tile_row + row_length, p_row);
+                      }
+                  });
+    });
+}
+
+/**
+ * @brief copies between a row major tensor and a morton tensor row by row
+ *
+ * the morton offset of the next element of a row is incremented in place by
+ * morton_layout::neighbor_offset, the rows are distributed by the policy.
+ */
+template <typename _ExecutionPolicy, int_t _Rank, typename _RowMajorTensor,
+          typename _MortonTensor>
+inline void copy_morton_rows(_ExecutionPolicy policy, const _RowMajorTensor& ts_row_major,
+                             const _MortonTensor& ts_morton, bool is_to_morton) {
+    auto layout = ts_morton.layout();
+    auto shape = ts_row_major.shape();
+    auto row_length = shape[_Rank - 1];
+    auto rows_shape = shape;
+    rows_shape[_Rank - 1] = 1;
+    row_major_layout<_Rank> rows_layout(rows_shape);
+
+    for_index(policy, 0, row_length > 0 ? rows_layout.size() : 0, [&](int_t row_i) {
+        auto id = rows_layout.offset2index(row_i);
+        auto p_row = &ts_row_major(id);
+        auto offset = layout.index2offset(id);
+        for (int_t j = 0; j < row_length; ++j) {
+            if (is_to_morton) {
+                ts_morton[offset] = p_row[j];
+            } else {
+                p_row[j] = ts_morton[offset];
+            }
+            offset = layout.neighbor_offset(offset, _Rank - 1, 1);
+        }
+    });
+}
+
+template <typename _ExecutionPolicy, int_t _Rank, typename _Tile, typename _RowMajorTensor,
+          typename _TiledTensor>
+inline void copy_blocked(_ExecutionPolicy policy, const _RowMajorTensor& ts_row_major,
+                         const _TiledTensor& ts_blocked, bool is_to_blocked,
+                         tiled_layout<_Rank, _Tile>) {
+    copy_tiles<_ExecutionPolicy, _Rank>(policy, ts_row_major, ts_blocked, is_to_blocked);
+}
+
+template <typename _ExecutionPolicy, int_t _Rank, typename _RowMajorTensor,
+          typename _MortonTensor>
+inline void copy_blocked(_ExecutionPolicy policy, const _RowMajorTensor& ts_row_major,
+                         const _MortonTensor& ts_blocked, bool is_to_blocked,
+                         morton_layout<_Rank>) {
+    copy_morton_rows<_ExecutionPolicy, _Rank>(policy, ts_row_major, ts_blocked, is_to_blocked);
+}
+
+}  // namespace internal
+
+/**
+ * @brief converts a row major tensor to a tiled or morton tensor
+ *
+ * the generic copy copies the elements by linear index, which is the storage order, so the copy
+ * between different layouts is overloaded by the array index semantic.
+ *
+ * @param policy the execution policy
+ * @param ts_src the row major source tensor
+ * @param ts_dst the dest tensor of tiled_layout or morton_layout
+ */
+template <typename _ExecutionPolicy, typename _ValueType, int_t _Rank, typename _Allocator,
+          typename _TensorDst>
+inline void copy(_ExecutionPolicy policy,
+                 const tensor<_ValueType, _Rank, row_major_layout<_Rank>, _Allocator>& ts_src,
+                 _TensorDst&& ts_dst,
+                 enable_if_t<is_blocked_layout<layout_t<decay_t<_TensorDst>>>::value>* = 0) {
+    MATAZURE_STATIC_ASSERT_DIM_MATCHED(decay_t<decltype(ts_src)>, decay_t<_TensorDst>);
+    MATAZURE_ASSERT(equal(ts_src.shape(), ts_dst.shape()), "the shapes is not matched");
+    internal::copy_blocked(policy, ts_src, ts_dst, true, ts_dst.layout());
+}
+
+/**
+ * @brief converts a tiled or morton tensor to a row major tensor
+ * @see copy
+ */
+template <typename _ExecutionPolicy, typename _ValueType, int_t _Rank, typename _Layout,
+          typename _Allocator, typename _TensorDst>
+inline void copy(_ExecutionPolicy policy,
+                 const tensor<_ValueType, _Rank, _Layout, _Allocator>& ts_src, _TensorDst&& ts_dst,
+                 enable_if_t<is_blocked_layout<_Layout>::value &&
+                             is_same<layout_t<decay_t<_TensorDst>>,
+                                     row_major_layout<_Rank>>::value>* = 0) {
+    MATAZURE_ASSERT(equal(ts_src.shape(), ts_dst.shape()), "the shapes is not matched");
+    internal::copy_blocked(policy, ts_dst, ts_src, false, ts_src.layout());
+}
+
+}  // namespace matazure
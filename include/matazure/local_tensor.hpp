@@ -35,9 +35,6 @@ inline MATAZURE_GENERAL typename pointi<rank>::value_type index2offset(const poi
     return offset;
 };
 
-template <int_t... _Values>
-using dim = meta::array<_Values...>;
-
 /**
  * @brief a compile time tensor which uses static memory
  * @tparam _ValueType element value type, must be pod
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <matazure/separable.hpp>
+
+namespace matazure {
+
+namespace internal {
+
+struct min_op {
+    template <typename _T>
+    MATAZURE_GENERAL _T operator()(_T lhs, _T rhs) const {
+        return rhs < lhs ? rhs : lhs;
+    }
+};
+
+struct max_op {
+    template <typename _T>
+    MATAZURE_GENERAL _T operator()(_T lhs, _T rhs) const {
+        return lhs < rhs ? rhs : lhs;
+    }
+};
+
+/**
+ * @brief the van Herk/Gil-Werman running min/max of interleaved lines
+ *
+ * the padded input is split into blocks of the window size, g is the prefix scan and h is the
+ * suffix scan in each block, a window [i, i + size) covers the tail of one block and the head of
+ * the next one, so out[i] = op(h[i], g[i + size - 1]). it costs three ops per element whatever
+ * the window size is.
+ *
+ * @param in the padded input, [n + size - 1][lanes]
+ * @param out the output, [n][lanes]
+ */
+template <typename _ValueType, typename _Op>
+inline void van_herk_gil_werman(const _ValueType* in, _ValueType* out, int_t n, int_t lanes,
+                                int_t size, _Op op) {
+    auto padded_n = n + size - 1;
+    std::vector<_ValueType> g(padded_n * lanes);
+    std::vector<_ValueType> h(padded_n * lanes);
+
+    for (int_t j = 0; j < padded_n; ++j) {
+        auto p_in = in + j * lanes;
+        auto p_g = g.data() + j * lanes;
+        if (j % size == 0) {
+            for (int_t l = 0; l < lanes; ++l) p_g[l] = p_in[l];
+        } else {
+            auto p_g_prev = p_g - lanes;
+            for (int_t l = 0; l < lanes; ++l) p_g[l] = op(p_g_prev[l], p_in[l]);
+        }
+    }
+
+    for (int_t j = padded_n - 1; j >= 0; --j) {
+        auto p_in = in + j * lanes;
+        auto p_h = h.data() + j * lanes;
+        if (j % size == size - 1 || j == padded_n - 1) {
+            for (int_t l = 0; l < lanes; ++l) p_h[l] = p_in[l];
+        } else {
+            auto p_h_next = p_h + lanes;
+            for (int_t l = 0; l < lanes; ++l) p_h[l] = op(p_h_next[l], p_in[l]);
+        }
+    }
+
+    for (int_t i = 0; i < n; ++i) {
+        auto p_out = out + i * lanes;
+        auto p_h = h.data() + i * lanes;
+        auto p_g = g.data() + (i + size - 1) * lanes;
+        for (int_t l = 0; l < lanes; ++l) p_out[l] = op(p_h[l], p_g[l]);
+    }
+}
+
+/// the window of out[i] is [i - padding_before, i - padding_before + size)
+template <typename _ExecutionPolicy, typename _TensorSrc, typename _TensorDst, typename _Op>
+inline void rank_filter(_ExecutionPolicy policy, const _TensorSrc& ts_src, _TensorDst& ts_dst,
+                        int_t axis, int_t size, int_t padding_before, border_mode mode,
+                        typename _TensorSrc::value_type border_value, _Op op) {
+    MATAZURE_ASSERT(size > 0, "the window size should be greater than zero");
+    auto padding_after = size - 1 - padding_before;
+    for_each_line_batch(policy, ts_src, ts_dst, axis, padding_before, padding_after, mode,
+                        border_value,
+                        [=](const typename _TensorSrc::value_type* in,
+                            typename _TensorSrc::value_type* out, int_t n, int_t lanes) {
+                            van_herk_gil_werman(in, out, n, lanes, size, op);
+                        });
+}
+
+/**
+ * @brief the rank filter by a rectangular structuring element, separated into each axis
+ *
+ * the window of an axis is [idx - size / 2, idx - size / 2 + size), the reflected one is
+ * [idx - (size - 1 - size / 2), idx + size / 2 + 1). they're the same for an odd size, the second
+ * pass of opening and closing uses the reflected one, so an even size is anti-extensive or
+ * extensive too.
+ */
+template <typename _ExecutionPolicy, typename _TensorSrc, typename _TensorDst, typename _Op>
+inline void separable_rank_filter(_ExecutionPolicy policy, const _TensorSrc& ts_src,
+                                  _TensorDst& ts_dst, pointi<_TensorSrc::rank> size,
+                                  bool reflected, border_mode mode,
+                                  typename _TensorSrc::value_type border_value, _Op op) {
+    static_assert(_TensorSrc::rank == 2 || _TensorSrc::rank == 3, "only support rank 2 or 3");
+    bool is_first = true;
+    for (int_t axis = 0; axis < _TensorSrc::rank; ++axis) {
+        if (size[axis] <= 1) continue;
+
+        auto padding_before = reflected ? size[axis] - 1 - size[axis] / 2 : size[axis] / 2;
+        if (is_first) {
+            rank_filter(policy, ts_src, ts_dst, axis, size[axis], padding_before, mode,
+                        border_value, op);
+            is_first = false;
+        } else {
+            rank_filter(policy, ts_dst, ts_dst, axis, size[axis], padding_before, mode,
+                        border_value, op);
+        }
+    }
+
+    if (is_first) copy(policy, ts_src, ts_dst);
+}
+
+}  // namespace internal
+
+/**
+ * @brief the min filter along an axis of a dense tensor
+ *
+ * the cost per element is independent of the window size.
+ *
+ * @param policy the execution policy, the lines are distributed by it
+ * @param ts_src the source tensor
+ * @param ts_dst the dest tensor, could be ts_src itself
+ * @param axis the axis of the filter
+ * @param size the window size, the window of idx is [idx - size / 2, idx - size / 2 + size)
+ * @param mode the border mode
+ * @param border_value the border value of border_mode::constant
+ */
+template <typename _ExecutionPolicy, typename _TensorSrc, typename _TensorDst>
+inline void min_filter(_ExecutionPolicy policy, const _TensorSrc& ts_src, _TensorDst&& ts_dst,
+                       int_t axis, int_t size, border_mode mode = border_mode::replicate,
+                       typename _TensorSrc::value_type border_value =
+                           numeric_limits<typename _TensorSrc::value_type>::max()) {
+    internal::rank_filter(policy, ts_src, ts_dst, axis, size, size / 2, mode, border_value,
+                          internal::min_op{});
+}
+
+/**
+ * @brief the max filter along an axis of a dense tensor
+ * @see min_filter
+ */
+template <typename _ExecutionPolicy, typename _TensorSrc, typename _TensorDst>
+inline void max_filter(_ExecutionPolicy policy, const _TensorSrc& ts_src, _TensorDst&& ts_dst,
+                       int_t axis, int_t size, border_mode mode = border_mode::replicate,
+                       typename _TensorSrc::value_type border_value =
+                           numeric_limits<typename _TensorSrc::value_type>::lowest()) {
+    internal::rank_filter(policy, ts_src, ts_dst, axis, size, size / 2, mode, border_value,
+                          internal::max_op{});
+}
+
+/**
+ * @brief erodes a dense tensor by a rectangular structuring element
+ *
+ * the erosion is separated into min filters along each axis.
+ *
+ * @param policy the execution policy
+ * @param ts_src the source tensor
+ * @param ts_dst the dest tensor, could be ts_src itself
+ * @param size the shape of the structuring element
+ * @param mode the border mode
+ */
+template <typename _ExecutionPolicy, typename _TensorSrc, typename _TensorDst>
+inline void erode(_ExecutionPolicy policy, const _TensorSrc& ts_src, _TensorDst&& ts_dst,
+                  pointi<_TensorSrc::rank> size, border_mode mode = border_mode::replicate,
+                  typename _TensorSrc::value_type border_value =
+                      numeric_limits<typename _TensorSrc::value_type>::max()) {
+    internal::separable_rank_filter(policy, ts_src, ts_dst, size, false, mode, border_value,
+                                    internal::min_op{});
+}
+
+/**
+ * @brief dilates a dense tensor by a rectangular structuring element
+ * @see erode
+ */
+template <typename _ExecutionPolicy, typename _TensorSrc, typename _TensorDst>
+inline void dilate(_ExecutionPolicy policy, const _TensorSrc& ts_src, _TensorDst&& ts_dst,
+                   pointi<_TensorSrc::rank> size, border_mode mode = border_mode::replicate,
+                   typename _TensorSrc::value_type border_value =
+                       numeric_limits<typename _TensorSrc::value_type>::lowest()) {
+    internal::separable_rank_filter(policy, ts_src, ts_dst, size, false, mode, border_value,
+                                    internal::max_op{});
+}
+
+/**
+ * @brief the morphological opening, dilates the erosion by the reflected structuring element
+ * @see erode
+ */
+template <typename _ExecutionPolicy, typename _TensorSrc, typename _TensorDst>
+inline void opening(_ExecutionPolicy policy, const _TensorSrc& ts_src, _TensorDst&& ts_dst,
+                    pointi<_TensorSrc::rank> size, border_mode mode = border_mode::replicate) {
+    typedef typename _TensorSrc::value_type value_type;
+    internal::separable_rank_filter(policy, ts_src, ts_dst, size, false, mode,
+                                    numeric_limits<value_type>::max(), internal::min_op{});
+    internal::separable_rank_filter(policy, ts_dst, ts_dst, size, true, mode,
+                                    numeric_limits<value_type>::lowest(), internal::max_op{});
+}
+
+/**
+ * @brief the morphological opening with the border value of border_mode::constant
+ *
+ * the border value is used by both the erosion and the dilation.
+ *
+ * @see erode
+ */
+template <typename _ExecutionPolicy, typename _TensorSrc, typename _TensorDst>
+inline void opening(_ExecutionPolicy policy, const _TensorSrc& ts_src, _TensorDst&& ts_dst,
+                    pointi<_TensorSrc::rank> size, border_mode mode,
+                    typename _TensorSrc::value_type border_value) {
+    internal::separable_rank_filter(policy, ts_src, ts_dst, size, false, mode, border_value,
+                                    internal::min_op{});
+    internal::separable_rank_filter(policy, ts_dst, ts_dst, size, true, mode, border_value,
+                                    internal::max_op{});
+}
+
+/**
+ * @brief the morphological closing, erodes the dilation by the reflected structuring element
+ * @see erode
+ */
+template <typename _ExecutionPolicy, typename _TensorSrc, typename _TensorDst>
+inline void closing(_ExecutionPolicy policy, const _TensorSrc& ts_src, _TensorDst&& ts_dst,
+                    pointi<_TensorSrc::rank> size, border_mode mode = border_mode::replicate) {
+    typedef typename _TensorSrc::value_type value_type;
+    internal::separable_rank_filter(policy, ts_src, ts_dst, size, false, mode,
+                                    numeric_limits<value_type>::lowest(), internal::max_op{});
+    internal::separable_rank_filter(policy, ts_dst, ts_dst, size, true, mode,
+                                    numeric_limits<value_type>::max(), internal::min_op{});
+}
+
+/**
+ * @brief the morphological closing with the border value of border_mode::constant
+ * @see opening
+ */
+template <typename _ExecutionPolicy, typename _TensorSrc, typename _TensorDst>
+inline void closing(_ExecutionPolicy policy, const _TensorSrc& ts_src, _TensorDst&& ts_dst,
+                    pointi<_TensorSrc::rank> size, border_mode mode,
+                    typename _TensorSrc::value_type border_value) {
+    internal::separable_rank_filter(policy, ts_src, ts_dst, size, false, mode, border_value,
+                                    internal::max_op{});
+    internal::separable_rank_filter(policy, ts_dst, ts_dst, size, true, mode, border_value,
+                                    internal::min_op{});
+}
+
+/// erodes a dense tensor by the sequence policy
+template <typename _TensorSrc, typename _TensorDst>
+inline void erode(const _TensorSrc& ts_src, _TensorDst&& ts_dst, pointi<_TensorSrc::rank> size,
+                  enable_if_t<is_tensor<_TensorSrc>::value>* = 0) {
+    sequence_policy policy{};
+    erode(policy, ts_src, std::forward<_TensorDst>(ts_dst), size);
+}
+
+/// dilates a dense tensor by the sequence policy
+template <typename _TensorSrc, typename _TensorDst>
+inline void dilate(const _TensorSrc& ts_src, _TensorDst&& ts_dst, pointi<_TensorSrc::rank> size,
+                   enable_if_t<is_tensor<_TensorSrc>::value>* = 0) {
+    sequence_policy policy{};
+    dilate(policy, ts_src, std::forward<_TensorDst>(ts_dst), size);
+}
+
+/// the morphological opening by the sequence policy
+template <typename _TensorSrc, typename _TensorDst>
+inline void opening(const _TensorSrc& ts_src, _TensorDst&& ts_dst, pointi<_TensorSrc::rank> size,
+                    enable_if_t<is_tensor<_TensorSrc>::value>* = 0) {
+    sequence_policy policy{};
+    opening(policy, ts_src, std::forward<_TensorDst>(ts_dst), size);
+}
+
+/// the morphological closing by the sequence policy
+template <typename _TensorSrc, typename _TensorDst>
+inline void closing(const _TensorSrc& ts_src, _TensorDst&& ts_dst, pointi<_TensorSrc::rank> size,
+                    enable_if_t<is_tensor<_TensorSrc>::value>* = 0) {
+    sequence_policy policy{};
+    closing(policy, ts_src, std::forward<_TensorDst>(ts_dst), size);
+}
+
+}  // namespace matazure
@@ -0,0 +1,596 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <matazure/dynamic_dispatch.hpp>
+#include <sstream>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace matazure {
+
+/// the files which are not smaller than it are mapped by load_npy
+static const int_t npy_map_threshold = 64 << 20;
+
+namespace internal {
+
+static const char npy_magic[6] = {'\x93', 'N', 'U', 'M', 'P', 'Y'};
+/// numpy pads the header to 64 bytes, so the mapped data is aligned
+static const int_t npy_header_alignment = 64;
+
+inline bool is_little_endian() {
+    const std::uint16_t v = 1;
+    return *reinterpret_cast<const byte*>(&v) == 1;
+}
+
+inline std::string npy_descr(data_type type) {
+    auto order = is_little_endian() ? "<" : ">";
+    switch (type) {
+        case data_type::dt_uint8:
+            return "|u1";
+        case data_type::dt_int8:
+            return "|i1";
+        case data_type::dt_uint16:
+            return order + std::string("u2");
+        case data_type::dt_uint32:
+            return order + std::string("u4");
+        case data_type::dt_uint64:
+            return order + std::string("u8");
+        case data_type::dt_int16:
+            return order + std::string("i2");
+        case data_type::dt_int32:
+            return order + std::string("i4");
+        case data_type::dt_int64:
+            return order + std::string("i8");
+        case data_type::dt_float16:
+            return order + std::string("f2");
+        case data_type::dt_float32:
+            return order + std::string("f4");
+        case data_type::dt_float64:
+            return order + std::string("f8");
+        default:
+            // bfloat16 has no numpy type
+            throw invalid_data_type{};
+    }
+}
+
+/// the numpy header of an array
+struct npy_header {
+    data_type type;
+    dynamic_shape shape;
+    bool fortran_order;
+    /// the data is in the other byte order
+    bool swapped;
+    /// the offset of the data from the magic
+    int_t data_offset;
+};
+
+inline std::string npy_dict_value(const std::string& dict, const std::string& key) {
+    auto pos = dict.find("'" + key + "'");
+    if (pos == std::string::npos) throw invalid_file_format{};
+    pos = dict.find(':', pos);
+    if (pos == std::string::npos) throw invalid_file_format{};
+    ++pos;
+    while (pos < dict.size() && dict[pos] == ' ') ++pos;
+    if (pos >= dict.size()) throw invalid_file_format{};
+
+    std::string::size_type end;
+    if (dict[pos] == '\'' || dict[pos] == '"') {
+        end = dict.find(dict[pos], pos + 1);
+        if (end == std::string::npos) throw invalid_file_format{};
+        return dict.substr(pos + 1, end - pos - 1);
+    }
+    if (dict[pos] == '(') {
+        end = dict.find(')', pos);
+        if (end == std::string::npos) throw invalid_file_format{};
+        return dict.substr(pos + 1, end - pos - 1);
+    }
+    end = dict.find_first_of(",}", pos);
+    return dict.substr(pos, end - pos);
+}
+
+/**
+ * @brief parses the npy header
+ * @param p the beginning of the npy, it has the 10(or 12 of the version 2 and 3) fixed bytes
+ * @param read reads the dict string of the size after the fixed fields
+ */
+template <typename _Read>
+inline npy_header parse_npy_header(const byte* p, _Read read) {
+    if (std::memcmp(p, npy_magic, 6) != 0) throw invalid_file_format{};
+    auto major = p[6];
+    int_t fixed_size = major == 1 ? 10 : 12;
+    int_t dict_size = 0;
+    if (major == 1) {
+        dict_size = p[8] | (p[9] << 8);
+    } else if (major == 2 || major == 3) {
+        dict_size = p[8] | (p[9] << 8) | (p[10] << 16) | (p[11] << 24);
+    } else {
+        throw invalid_file_format{};
+    }
+    auto dict = read(fixed_size, dict_size);
+
+    npy_header header;
+    auto descr = npy_dict_value(dict, "descr");
+    if (descr.size() != 3) throw invalid_data_type{};
+    auto little_endian = is_little_endian();
+    header.swapped = (descr[0] == '<' && !little_endian) || (descr[0] == '>' && little_endian);
+    auto kind = descr.substr(1);
+    std::map<std::string, data_type> types = {
+        {"u1", data_type::dt_uint8},  {"u2", data_type::dt_uint16}, {"u4", data_type::dt_uint32},
+        {"u8", data_type::dt_uint64}, {"i1", data_type::dt_int8},   {"i2", data_type::dt_int16},
+        {"i4", data_type::dt_int32},  {"i8", data_type::dt_int64},  {"f2", data_type::dt_float16},
+        {"f4", data_type::dt_float32}, {"f8", data_type::dt_float64}};
+    auto it = types.find(kind);
+    if (it == types.end()) throw invalid_data_type{};
+    header.type = it->second;
+
+    header.fortran_order = npy_dict_value(dict, "fortran_order") == "True";
+
+    // the elements count should be representable by int_t, it's checked before any allocation
+    std::vector<int_t> dims;
+    std::int64_t elements = 1;
+    std::istringstream shape_stream(npy_dict_value(dict, "shape"));
+    std::string dim;
+    while (std::getline(shape_stream, dim, ',')) {
+        if (dim.find_first_of("0123456789") == std::string::npos) continue;
+        auto extent = std::stoll(dim);
+        if (extent < 0) throw invalid_file_format{};
+        if (extent > std::numeric_limits<int_t>::max()) throw invalid_shape{};
+        elements *= extent;
+        if (elements > std::numeric_limits<int_t>::max()) throw invalid_shape{};
+        dims.push_back(static_cast<int_t>(extent));
+    }
+    header.shape = dynamic_shape(dims.size());
+    for (int_t i = 0; i < header.shape.size(); ++i) header.shape[i] = dims[i];
+
+    header.data_offset = fixed_size + dict_size;
+    return header;
+}
+
+inline npy_header parse_npy_header(const byte* p, std::int64_t size) {
+    if (size < 12) throw invalid_file_format{};
+    return parse_npy_header(p, [=](int_t offset, int_t dict_size) {
+        if (offset + static_cast<std::int64_t>(dict_size) > size) throw invalid_file_format{};
+        return std::string(reinterpret_cast<const char*>(p) + offset, dict_size);
+    });
+}
+
+inline npy_header read_npy_header(std::istream& istr) {
+    byte fixed[12] = {};
+    istr.read(reinterpret_cast<char*>(fixed), 10);
+    if (fixed[6] >= 2) istr.read(reinterpret_cast<char*>(fixed + 10), 2);
+    return parse_npy_header(fixed, [&](int_t, int_t dict_size) {
+        std::string dict(dict_size, ' ');
+        istr.read(&dict[0], dict_size);
+        return dict;
+    });
+}
+
+/// the whole npy bytes, the header is padded by spaces to npy_header_alignment
+inline std::string make_npy_header(data_type type, const dynamic_shape& shape,
+                                   bool fortran_order) {
+    std::ostringstream dict;
+    dict << "{'descr': '" << npy_descr(type)
+         << "', 'fortran_order': " << (fortran_order ? "True" : "False") << ", 'shape': (";
+    for (int_t i = 0; i < shape.size(); ++i) {
+        dict << shape[i] << (shape.size() == 1 ? "," : (i + 1 < shape.size() ? ", " : ""));
+    }
+    dict << "), }";
+
+    auto dict_str = dict.str();
+    bool large = dict_str.size() + 1 + 10 > 65535;
+    int_t fixed_size = large ? 12 : 10;
+    auto total = fixed_size + dict_str.size() + 1;
+    total = (total + npy_header_alignment - 1) / npy_header_alignment * npy_header_alignment;
+    dict_str.append(total - fixed_size - dict_str.size() - 1, ' ');
+    dict_str.push_back('\n');
+
+    std::string re(npy_magic, 6);
+    re.push_back(static_cast<char>(large ? 2 : 1));
+    re.push_back(0);
+    auto dict_size = dict_str.size();
+    for (int_t i = 0; i < fixed_size - 8; ++i) {
+        re.push_back(static_cast<char>((dict_size >> (8 * i)) & 0xff));
+    }
+    return re + dict_str;
+}
+
+inline dynamic_shape reversed_dims(int_t rank) {
+    dynamic_shape dims(rank);
+    for (int_t i = 0; i < rank; ++i) dims[i] = rank - 1 - i;
+    return dims;
+}
+
+/**
+ * @brief the dynamic_tensor of the npy data
+ *
+ * a fortran order array is the permuted view of the row major array of the reversed shape, so
+ * it's not copied.
+ */
+inline dynamic_tensor npy_tensor(const npy_header& header, shared_ptr<byte> sp_data) {
+    if (!header.fortran_order) return dynamic_tensor(header.type, header.shape, sp_data);
+
+    auto rank = header.shape.size();
+    dynamic_shape storage_shape(rank);
+    for (int_t i = 0; i < rank; ++i) storage_shape[i] = header.shape[rank - 1 - i];
+    return dynamic_tensor(header.type, storage_shape, sp_data).permute(reversed_dims(rank));
+}
+
+inline void swap_bytes(byte* p, int_t size, int_t element_size) {
+    for (std::int64_t i = 0; i < size; ++i) {
+        std::reverse(p + i * element_size, p + (i + 1) * element_size);
+    }
+}
+
+/// the bytes of the npy data, it's 64 bits since only the elements count is limited by int_t
+inline std::int64_t npy_data_bytes(const npy_header& header) {
+    return static_cast<std::int64_t>(shape_size(header.shape)) * get_data_type_size(header.type);
+}
+
+/// copies the npy data to the aligned storage
+inline dynamic_tensor copy_npy_tensor(const npy_header& header, const byte* p_data) {
+    auto size = shape_size(header.shape);
+    dynamic_tensor ts_storage(header.type, dynamic_shape{size});
+    std::memcpy(ts_storage.data(), p_data, npy_data_bytes(header));
+    if (header.swapped) swap_bytes(ts_storage.data(), size, ts_storage.element_size());
+    return npy_tensor(header, ts_storage.shared_data());
+}
+
+/**
+ * @brief maps a file to the memory
+ *
+ * the mapping is private and copy on write, the modifications are not written to the file. it
+ * reads the file to the memory if the mapping is not supported.
+ */
+inline shared_ptr<byte> map_file(const std::string& path, std::int64_t& size) {
+#ifndef _WIN32
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("failed to open " + path);
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("failed to stat " + path);
+    }
+    size = st.st_size;
+    if (size == 0) {
+        ::close(fd);
+        return shared_ptr<byte>(new byte[1], [](byte* p) { delete[] p; });
+    }
+    auto mapped_size = static_cast<std::size_t>(size);
+    auto p = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) throw std::runtime_error("failed to map " + path);
+    return shared_ptr<byte>(static_cast<byte*>(p),
+                            [mapped_size](byte* p) { ::munmap(p, mapped_size); });
+#else
+    std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+    ifs.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+    size = static_cast<std::int64_t>(ifs.tellg());
+    if (size > std::numeric_limits<int_t>::max()) {
+        throw std::runtime_error("failed to read " + path);
+    }
+    ifs.seekg(0);
+    dynamic_tensor ts(data_type::dt_uint8, dynamic_shape{static_cast<int_t>(size)});
+    ifs.read(ts.data<char>(), size);
+    return ts.shared_data();
+#endif
+}
+
+/// the tensor shares the mapping if the data is aligned by the element and in the native order
+inline dynamic_tensor mapped_npy_tensor(shared_ptr<byte> sp_map, std::int64_t offset,
+                                        std::int64_t size) {
+    auto p = sp_map.get() + offset;
+    auto header = parse_npy_header(p, size);
+    auto element_size = get_data_type_size(header.type);
+    if (header.data_offset + npy_data_bytes(header) > size) throw invalid_file_format{};
+
+    auto p_data = p + header.data_offset;
+    if (header.swapped || reinterpret_cast<std::uintptr_t>(p_data) % element_size != 0) {
+        return copy_npy_tensor(header, p_data);
+    }
+    return npy_tensor(header, shared_ptr<byte>(sp_map, p_data));
+}
+
+inline std::uint32_t crc32(const byte* p, int_t size) {
+    std::uint32_t crc = 0xffffffffu;
+    for (int_t i = 0; i < size; ++i) {
+        crc ^= p[i];
+        for (int_t k = 0; k < 8; ++k) crc = (crc >> 1) ^ (0xedb88320u & (0u - (crc & 1u)));
+    }
+    return ~crc;
+}
+
+inline std::uint32_t read_le(const byte* p, int_t bytes) {
+    std::uint32_t v = 0;
+    for (int_t i = bytes - 1; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+
+inline std::uint64_t read_le64(const byte* p) {
+    return read_le(p, 4) | (static_cast<std::uint64_t>(read_le(p + 4, 4)) << 32);
+}
+
+inline void write_le(std::ostream& ostr, std::uint64_t v, int_t bytes) {
+    for (int_t i = 0; i < bytes; ++i) ostr.put(static_cast<char>((v >> (8 * i)) & 0xff));
+}
+
+}  // namespace internal
+
+/**
+ * @brief saves a dynamic_tensor as a npy file
+ *
+ * a contiguous tensor is saved in C order, a transposed contiguous one(e.g. the one loaded
+ * from a fortran order file) is saved in fortran order, others are copied to C order first.
+ */
+inline void save_npy(std::ostream& ostr, const dynamic_tensor& ts) {
+    auto rank = ts.rank();
+    auto ts_transposed = ts.permute(internal::reversed_dims(rank));
+    bool fortran_order = rank > 1 && !ts.is_contiguous() && ts_transposed.is_contiguous();
+    auto ts_data = fortran_order ? ts_transposed : contiguous(ts);
+
+    // the exceptions mask of the caller's stream is not changed
+    auto header = internal::make_npy_header(ts.type(), ts.shape(), fortran_order);
+    ostr.write(header.data(), header.size());
+    ostr.write(ts_data.data<char>(),
+               static_cast<std::streamsize>(ts_data.size()) * ts_data.element_size());
+    if (ostr.fail()) throw std::ios_base::failure("failed to write the npy");
+}
+
+inline void save_npy(const std::string& path, const dynamic_tensor& ts) {
+    std::ofstream ofs(path, std::ios::binary);
+    save_npy(ofs, ts);
+}
+
+/// saves a row major tensor in C order
+template <typename _ValueType, int_t _Rank, typename _Allocator>
+inline void save_npy(const std::string& path,
+                     const tensor<_ValueType, _Rank, row_major_layout<_Rank>, _Allocator>& ts) {
+    save_npy(path, dynamic_tensor_wrap(ts));
+}
+
+/// saves a column major tensor in fortran order
+template <typename _ValueType, int_t _Rank, typename _Allocator>
+inline void save_npy(const std::string& path,
+                     const tensor<_ValueType, _Rank, column_major_layout<_Rank>, _Allocator>& ts) {
+    dynamic_shape storage_shape(_Rank);
+    for (int_t i = 0; i < _Rank; ++i) storage_shape[i] = ts.shape(_Rank - 1 - i);
+    shared_ptr<byte> sp_data(ts.shared_data(), reinterpret_cast<byte*>(ts.data()));
+    dynamic_tensor ts_storage(get_data_type_traits<decay_t<_ValueType>>::value, storage_shape,
+                              sp_data);
+    save_npy(path, ts_storage.permute(internal::reversed_dims(_Rank)));
+}
+
+/**
+ * @brief maps a npy file as a dynamic_tensor without copying
+ *
+ * the data is shared with the private mapping, a fortran order array is a permuted view. it's
+ * copied if the data is not aligned by the element or not in the native byte order.
+ */
+inline dynamic_tensor map_npy(const std::string& path) {
+    std::int64_t size = 0;
+    auto sp_map = internal::map_file(path, size);
+    return internal::mapped_npy_tensor(sp_map, 0, size);
+}
+
+/**
+ * @brief loads a npy file as a dynamic_tensor
+ *
+ * the file which is not smaller than npy_map_threshold is mapped by map_npy, others are read to
+ * the aligned storage.
+ */
+inline dynamic_tensor load_npy(const std::string& path) {
+    std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+    ifs.exceptions(std::ifstream::failbit | std::ifstream::badbit | std::ifstream::eofbit);
+    auto file_size = static_cast<std::int64_t>(ifs.tellg());
+#ifndef _WIN32
+    if (file_size >= npy_map_threshold) return map_npy(path);
+#endif
+
+    ifs.seekg(0);
+    auto header = internal::read_npy_header(ifs);
+    auto element_size = get_data_type_size(header.type);
+    auto size = internal::shape_size(header.shape);
+    auto data_bytes = internal::npy_data_bytes(header);
+    if (header.data_offset + data_bytes > file_size) throw invalid_file_format{};
+    dynamic_tensor ts_storage(header.type, dynamic_shape{size});
+    ifs.read(ts_storage.data<char>(), data_bytes);
+    if (header.swapped) internal::swap_bytes(ts_storage.data(), size, element_size);
+    return internal::npy_tensor(header, ts_storage.shared_data());
+}
+
+/**
+ * @brief loads a npy file as a typed tensor
+ *
+ * the data type and rank should be matched, the array is copied only if its order is not the
+ * layout.
+ * @tparam _Layout row_major_layout or column_major_layout
+ */
+template <typename _ValueType, int_t _Rank, typename _Layout = row_major_layout<_Rank>>
+inline tensor<_ValueType, _Rank, _Layout> load_npy(const std::string& path) {
+    static_assert(is_same<_Layout, row_major_layout<_Rank>>::value ||
+                      is_same<_Layout, column_major_layout<_Rank>>::value,
+                  "only the row major and column major layouts are supported");
+    auto ts = load_npy(path);
+    if (ts.type() != get_data_type_traits<_ValueType>::value) throw invalid_data_type{};
+    if (ts.rank() != _Rank) throw invalid_shape{};
+
+    pointi<_Rank> shape;
+    for (int_t i = 0; i < _Rank; ++i) shape[i] = ts.shape(i);
+    // the column major storage is the row major storage of the transposed one
+    dynamic_tensor ts_storage = is_same<_Layout, row_major_layout<_Rank>>::value
+                          ? contiguous(ts)
+                          : contiguous(ts.permute(internal::reversed_dims(_Rank)));
+    return tensor<_ValueType, _Rank, _Layout>(shape, ts_storage.shared_data<_ValueType>());
+}
+
+/**
+ * @brief loads the arrays of a npz archive
+ *
+ * the archive is mapped and the arrays are not extracted, they share the mapping as map_npy.
+ * only the stored(not compressed) entries are supported, e.g. the ones of numpy.savez.
+ * @return the arrays by the names without ".npy"
+ */
+inline std::map<std::string, dynamic_tensor> load_npz(const std::string& path) {
+    std::int64_t size = 0;
+    auto sp_map = internal::map_file(path, size);
+    auto p = sp_map.get();
+
+    // the end of central directory record is at the end, before a comment of 64K at most
+    std::int64_t eocd = size - 22;
+    while (eocd >= 0 && eocd >= size - 22 - 65535 && internal::read_le(p + eocd, 4) != 0x06054b50) {
+        --eocd;
+    }
+    if (eocd < 0 || eocd < size - 22 - 65535) throw invalid_file_format{};
+    std::uint64_t entry_count = internal::read_le(p + eocd + 10, 2);
+    std::uint64_t directory = internal::read_le(p + eocd + 16, 4);
+    // the zip64 end of central directory record is located by the locator before the record
+    if (eocd >= 20 && internal::read_le(p + eocd - 20, 4) == 0x07064b50) {
+        auto eocd64 = internal::read_le64(p + eocd - 20 + 8);
+        if (eocd64 + 56 > static_cast<std::uint64_t>(size)) throw invalid_file_format{};
+        entry_count = internal::read_le64(p + eocd64 + 32);
+        directory = internal::read_le64(p + eocd64 + 48);
+    }
+
+    std::map<std::string, dynamic_tensor> re;
+    for (std::uint64_t e = 0; e < entry_count; ++e) {
+        if (directory + 46 > static_cast<std::uint64_t>(size) ||
+            internal::read_le(p + directory, 4) != 0x02014b50) {
+            throw invalid_file_format{};
+        }
+        auto p_entry = p + directory;
+        auto method = internal::read_le(p_entry + 10, 2);
+        std::uint64_t entry_size = internal::read_le(p_entry + 20, 4);
+        auto name_size = internal::read_le(p_entry + 28, 2);
+        auto extra_size = internal::read_le(p_entry + 30, 2);
+        auto comment_size = internal::read_le(p_entry + 32, 2);
+        std::uint64_t local = internal::read_le(p_entry + 42, 4);
+        if (directory + 46 + name_size + extra_size > static_cast<std::uint64_t>(size)) {
+            throw invalid_file_format{};
+        }
+        std::string name(reinterpret_cast<const char*>(p_entry + 46), name_size);
+
+        // the zip64 extra field has the 64 bits sizes and offset which are 0xffffffff
+        auto p_extra = p_entry + 46 + name_size;
+        for (std::uint32_t k = 0; k + 4 <= extra_size;) {
+            auto id = internal::read_le(p_extra + k, 2);
+            auto field_size = internal::read_le(p_extra + k + 2, 2);
+            if (k + 4 + field_size > extra_size) throw invalid_file_format{};
+            if (id == 0x0001) {
+                auto p_field = p_extra + k + 4;
+                auto p_field_end = p_field + field_size;
+                if (internal::read_le(p_entry + 24, 4) == 0xffffffffu) p_field += 8;
+                if (entry_size == 0xffffffffu) {
+                    if (p_field + 8 > p_field_end) throw invalid_file_format{};
+                    entry_size = internal::read_le64(p_field);
+                    p_field += 8;
+                }
+                if (local == 0xffffffffu) {
+                    if (p_field + 8 > p_field_end) throw invalid_file_format{};
+                    local = internal::read_le64(p_field);
+                }
+            }
+            k += 4 + field_size;
+        }
+        if (method != 0) throw invalid_file_format{};
+        if (local + 30 > static_cast<std::uint64_t>(size)) throw invalid_file_format{};
+
+        auto p_local = p + local;
+        auto data = local + 30 + internal::read_le(p_local + 26, 2) +
+                    internal::read_le(p_local + 28, 2);
+        if (data + entry_size > static_cast<std::uint64_t>(size)) throw invalid_file_format{};
+        if (name.size() > 4 && name.substr(name.size() - 4) == ".npy") {
+            name = name.substr(0, name.size() - 4);
+        }
+        re[name] = internal::mapped_npy_tensor(sp_map, data, entry_size);
+
+        directory += 46 + name_size + extra_size + comment_size;
+    }
+
+    return re;
+}
+
+/**
+ * @brief saves the arrays as a npz archive of the stored entries
+ *
+ * the archive is not zip64, so it should be smaller than 4GB.
+ * @param arrays the arrays by the names, ".npy" is appended to the entry names
+ */
+inline void save_npz(const std::string& path, const std::map<std::string, dynamic_tensor>& arrays) {
+    std::ofstream ofs(path, std::ios::binary);
+    ofs.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+
+    struct entry {
+        std::string name;
+        std::uint32_t crc;
+        std::uint64_t size;
+        std::uint64_t offset;
+    };
+    std::vector<entry> entries;
+    std::uint64_t offset = 0;
+    for (auto& array : arrays) {
+        std::ostringstream npy;
+        save_npy(npy, array.second);
+        auto bytes = npy.str();
+        entry e{array.first + ".npy",
+                internal::crc32(reinterpret_cast<const byte*>(bytes.data()), bytes.size()),
+                bytes.size(), offset};
+        offset += 30 + e.name.size() + bytes.size();
+        if (offset >= 0xffffffffu) throw std::runtime_error("the npz archive exceeds 4GB");
+
+        internal::write_le(ofs, 0x04034b50, 4);
+        internal::write_le(ofs, 20, 2);  // the version needed to extract
+        internal::write_le(ofs, 0, 2);   // the flags
+        internal::write_le(ofs, 0, 2);   // stored
+        internal::write_le(ofs, 0, 4);   // the modification time and date
+        internal::write_le(ofs, e.crc, 4);
+        internal::write_le(ofs, e.size, 4);
+        internal::write_le(ofs, e.size, 4);
+        internal::write_le(ofs, e.name.size(), 2);
+        internal::write_le(ofs, 0, 2);
+        ofs.write(e.name.data(), e.name.size());
+        ofs.write(bytes.data(), bytes.size());
+        entries.push_back(e);
+    }
+
+    auto directory = offset;
+    for (auto& e : entries) {
+        internal::write_le(ofs, 0x02014b50, 4);
+        internal::write_le(ofs, 20, 2);  // the version made by
+        internal::write_le(ofs, 20, 2);  // the version needed to extract
+        internal::write_le(ofs, 0, 2);
+        internal::write_le(ofs, 0, 2);
+        internal::write_le(ofs, 0, 4);
+        internal::write_le(ofs, e.crc, 4);
+        internal::write_le(ofs, e.size, 4);
+        internal::write_le(ofs, e.size, 4);
+        internal::write_le(ofs, e.name.size(), 2);
+        internal::write_le(ofs, 0, 2);  // the extra field size
+        internal::write_le(ofs, 0, 2);  // the comment size
+        internal::write_le(ofs, 0, 2);  // the disk number
+        internal::write_le(ofs, 0, 2);  // the internal attributes
+        internal::write_le(ofs, 0, 4);  // the external attributes
+        internal::write_le(ofs, e.offset, 4);
+        ofs.write(e.name.data(), e.name.size());
+        offset += 46 + e.name.size();
+    }
+
+    internal::write_le(ofs, 0x06054b50, 4);
+    internal::write_le(ofs, 0, 2);
+    internal::write_le(ofs, 0, 2);
+    internal::write_le(ofs, entries.size(), 2);
+    internal::write_le(ofs, entries.size(), 2);
+    internal::write_le(ofs, offset - directory, 4);
+    internal::write_le(ofs, directory, 4);
+    internal::write_le(ofs, 0, 2);
+}
+
+}  // namespace matazure
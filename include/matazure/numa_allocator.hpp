@@ -0,0 +1,192 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <new>
+#include <matazure/allocator.hpp>
+#include <matazure/for_index.hpp>
+
+#ifdef MATAZURE_OPENMP
+#include <matazure/omp_for_index.hpp>
+#endif
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace matazure {
+
+/// a set of numa nodes, the nodes above 63 are not supported
+class numa_node_set {
+   public:
+    numa_node_set() : mask_(0) {}
+    explicit numa_node_set(uint64_t mask) : mask_(mask) {}
+
+    /**
+     * @brief parses a node list of the sysfs format, such as "0-3,6"
+     * @param list the node list
+     * @return the node set, the invalid items are skipped
+     */
+    static numa_node_set parse(const std::string& list) {
+        numa_node_set re;
+        std::string::size_type pos = 0;
+        while (pos < list.size()) {
+            auto comma = list.find(',', pos);
+            if (comma == std::string::npos) comma = list.size();
+            auto item = list.substr(pos, comma - pos);
+            pos = comma + 1;
+
+            char* end = nullptr;
+            auto first = std::strtol(item.c_str(), &end, 10);
+            if (end == item.c_str()) continue;
+            auto last = first;
+            if (*end == '-') last = std::strtol(end + 1, nullptr, 10);
+            for (auto node = first; node <= last; ++node) {
+                re.insert(static_cast<int_t>(node));
+            }
+        }
+        return re;
+    }
+
+    void insert(int_t node) {
+        if (node >= 0 && node < 64) mask_ |= uint64_t(1) << node;
+    }
+
+    bool contains(int_t node) const {
+        return node >= 0 && node < 64 && (mask_ >> node & 1);
+    }
+
+    int_t size() const {
+        int_t re = 0;
+        for (auto mask = mask_; mask; mask &= mask - 1) {
+            ++re;
+        }
+        return re;
+    }
+
+    bool empty() const { return mask_ == 0; }
+
+    uint64_t mask() const { return mask_; }
+
+   private:
+    uint64_t mask_;
+};
+
+namespace numa {
+
+/// the nodes in a node list file of /sys/devices/system/node, empty if it doesn't exist
+inline numa_node_set read_node_list(const std::string& path) {
+    std::ifstream ifs(path);
+    std::string list;
+    if (!std::getline(ifs, list)) return numa_node_set{};
+    return numa_node_set::parse(list);
+}
+
+/**
+ * @brief the nodes which have memory, they are detected once by sysfs
+ *
+ * a host without the sysfs node directory, or a non linux one, is taken as the single node 0
+ */
+inline const numa_node_set& memory_nodes() {
+    static const numa_node_set instance = []() {
+        auto re = read_node_list("/sys/devices/system/node/has_memory");
+        if (re.empty()) re = read_node_list("/sys/devices/system/node/online");
+        if (re.empty()) re.insert(0);
+        return re;
+    }();
+    return instance;
+}
+
+}  // namespace numa
+
+/**
+ * @brief the page placement of a numa_allocator
+ *
+ * interleave spreads the pages round robin over the nodes, bind restricts them to the nodes, and
+ * local leaves them on the node of the thread which first touches them.
+ */
+enum struct numa_mode { interleave, bind, local };
+
+#ifdef MATAZURE_OPENMP
+typedef omp_policy numa_first_touch_policy;
+#else
+typedef sequence_policy numa_first_touch_policy;
+#endif
+
+/**
+ * @brief an allocator which places the pages of a tensor on the numa nodes
+ *
+ * the memory is mapped and bound by the mbind syscall, libnuma isn't required. the tensor
+ * constructs the elements by _FirstTouchPolicy with the static partition of its for_index, so
+ * with the local mode a page lands on the node of the thread which later processes it. a small
+ * allocation or a non linux host falls back to the aligned allocation, and a failed mbind leaves
+ * the pages to the first touch.
+ *
+ * @tparam _Type the value type
+ * @tparam _FirstTouchPolicy the policy the elements are constructed by, it should be the policy
+ * of the loops over the tensor
+ */
+template <typename _Type, typename _FirstTouchPolicy = numa_first_touch_policy>
+class numa_allocator : public std::allocator<_Type> {
+   public:
+    typedef _FirstTouchPolicy first_touch_policy;
+
+    numa_allocator() : mode_(numa_mode::interleave), nodes_(numa::memory_nodes()) {}
+
+    explicit numa_allocator(numa_mode mode, numa_node_set nodes = numa::memory_nodes())
+        : mode_(mode), nodes_(nodes) {}
+
+    _Type* allocate(size_t size) {
+        auto bytes = size * sizeof(_Type);
+        if (!is_mapped(bytes)) return aligned_allocator_.allocate(size);
+
+#ifdef __linux__
+        void* data = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                          -1, 0);
+        if (data == MAP_FAILED) throw std::bad_alloc{};
+
+        if (mode_ != numa_mode::local && !nodes_.empty()) {
+            unsigned long mask = static_cast<unsigned long>(nodes_.mask());
+            int policy = mode_ == numa_mode::interleave ? MPOL_INTERLEAVE : MPOL_BIND;
+            // the kernel reads maxnode - 1 bits of the mask, a failure keeps the default policy
+            syscall(SYS_mbind, data, bytes, policy, &mask, sizeof(mask) * 8 + 1, 0);
+        }
+        return static_cast<_Type*>(data);
+#else
+        return nullptr;
+#endif
+    }
+
+    void deallocate(_Type* p, size_t size) {
+        auto bytes = size * sizeof(_Type);
+        if (!is_mapped(bytes)) return aligned_allocator_.deallocate(p, size);
+
+#ifdef __linux__
+        munmap(p, bytes);
+#endif
+    }
+
+    numa_mode mode() const { return mode_; }
+
+    numa_node_set nodes() const { return nodes_; }
+
+   private:
+    /// the allocations of at least a page are mapped
+    static bool is_mapped(size_t bytes) {
+#ifdef __linux__
+        static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return bytes >= page_size;
+#else
+        return false;
+#endif
+    }
+
+    numa_mode mode_;
+    numa_node_set nodes_;
+    aligned_allocator<_Type, 64> aligned_allocator_;
+};
+
+}  // namespace matazure
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <matazure/point.hpp>
+#include <matazure/trace.hpp>
 #include <matazure/type_traits.hpp>
 
 #define MATAZURE_STRINGIFY(a) #a
@@ -33,6 +34,7 @@ struct omp_policy {};
  */
 template <typename _Fun>
 inline void for_index(omp_policy policy, int_t first, int_t last, _Fun fun) {
+    MATAZURE_TRACE_SCOPE("for_index", policy, trace::extent(first, last), 0, 0, 0);
     MATAZURE_OPENMP_PARALLEL_FOR(1)
     for (int_t i = first; i < last; ++i) {
         fun(i);
@@ -46,7 +48,8 @@ inline void for_index(omp_policy policy, int_t first, int_t last, _Fun fun) {
  * @param fun the functor,  pointi<1> -> value pattern.
  */
 template <typename _Fun>
-inline void for_index(omp_policy, pointi<1> origin, pointi<1> end, _Fun fun) {
+inline void for_index(omp_policy policy, pointi<1> origin, pointi<1> end, _Fun fun) {
+    MATAZURE_TRACE_SCOPE("for_index", policy, trace::extent(origin, end), 0, 0, 0);
     MATAZURE_OPENMP_PARALLEL_FOR(1)
     for (int_t i = origin[0]; i < end[0]; ++i) {
         fun(pointi<1>{{i}});
@@ -60,7 +63,8 @@ inline void for_index(omp_policy, pointi<1> origin, pointi<1> end, _Fun fun) {
  * @param fun the functor,  pointi<2> -> value pattern.
  */
 template <typename _Fun>
-inline void for_index(omp_policy, pointi<2> origin, pointi<2> end, _Fun fun) {
+inline void for_index(omp_policy policy, pointi<2> origin, pointi<2> end, _Fun fun) {
+    MATAZURE_TRACE_SCOPE("for_index", policy, trace::extent(origin, end), 0, 0, 0);
     MATAZURE_OPENMP_PARALLEL_FOR(2)
     for (int_t i = origin[0]; i < end[0]; ++i) {
         for (int_t j = origin[1]; j < end[1]; ++j) {
@@ -76,7 +80,8 @@ inline void for_index(omp_policy, pointi<2> origin, pointi<2> end, _Fun fun) {
  * @param fun the functor,  pointi<3> -> value pattern.
  */
 template <typename _Fun>
-inline void for_index(omp_policy, pointi<3> origin, pointi<3> end, _Fun fun) {
+inline void for_index(omp_policy policy, pointi<3> origin, pointi<3> end, _Fun fun) {
+    MATAZURE_TRACE_SCOPE("for_index", policy, trace::extent(origin, end), 0, 0, 0);
     MATAZURE_OPENMP_PARALLEL_FOR(3)
     for (int_t i = origin[0]; i < end[0]; ++i) {
         for (int_t j = origin[1]; j < end[1]; ++j) {
@@ -94,7 +99,8 @@ inline void for_index(omp_policy, pointi<3> origin, pointi<3> end, _Fun fun) {
  * @param fun the functor,  pointi<4> -> value pattern.
  */
 template <typename _Fun>
-inline void for_index(omp_policy, pointi<4> origin, pointi<4> end, _Fun fun) {
+inline void for_index(omp_policy policy, pointi<4> origin, pointi<4> end, _Fun fun) {
+    MATAZURE_TRACE_SCOPE("for_index", policy, trace::extent(origin, end), 0, 0, 0);
     MATAZURE_OPENMP_PARALLEL_FOR(4)
     for (int_t i = origin[0]; i < end[0]; ++i) {
         for (int_t j = origin[1]; j < end[1]; ++j) {
@@ -385,4 +385,21 @@ MATAZURE_GENERAL inline constexpr pointi<sizeof...(_Idx)> permute_point(
     return pointi<sizeof...(_Idx)>{pt[_Idx]...};
 }
 
+/**
+ * @brief the channel traits of a pixel type, a pixel is an array of scalar channels
+ *
+ * a scalar type has one channel, a point<T, N> has N channels.
+ */
+template <typename _ValueType>
+struct channel_traits {
+    typedef _ValueType scalar_type;
+    static const int_t channels = 1;
+};
+
+template <typename _ValueType, int_t _Rank>
+struct channel_traits<point<_ValueType, _Rank>> {
+    typedef _ValueType scalar_type;
+    static const int_t channels = _Rank;
+};
+
 }  // namespace matazure
@@ -0,0 +1,479 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <matazure/algorithm.hpp>
+#include <matazure/tensor.hpp>
+#include <matazure/transpose.hpp>
+
+#if (defined(__AVX2__) || defined(__AVX512VNNI__)) && !defined(__CUDA_ARCH__)
+#include <immintrin.h>
+#endif
+
+namespace matazure {
+
+/**
+ * @brief an integer tensor with the affine quantization, real = scale * (value - zero_point)
+ *
+ * the scale and zero point are per tensor, or per axis, which have a pair of each index of the
+ * axis. the values are shared as tensor, the quantization parameters are shared too.
+ *
+ * @tparam _ValueType the integer value type, byte or std::int8_t usually
+ * @tparam _Rank the rank
+ */
+template <typename _ValueType, int_t _Rank>
+class quantized_tensor {
+   public:
+    static_assert(std::is_integral<_ValueType>::value, "the value type should be integral");
+
+    typedef _ValueType value_type;
+    const static int_t rank = _Rank;
+
+    quantized_tensor() : quantized_tensor(zero<pointi<rank>>::value(), 1.0f, 0) {}
+
+    /// constructs a per tensor quantized tensor
+    quantized_tensor(pointi<rank> shape, float scale, int_t zero_point)
+        : values_(shape), scales_(pointi<1>{1}), zero_points_(pointi<1>{1}), axis_(-1) {
+        scales_[0] = scale;
+        zero_points_[0] = zero_point;
+    }
+
+    /// constructs a per axis quantized tensor, the scales and zero points are of each index
+    quantized_tensor(pointi<rank> shape, int_t axis, tensor<float, 1> scales,
+                     tensor<int_t, 1> zero_points)
+        : values_(shape), scales_(scales), zero_points_(zero_points), axis_(axis) {
+        MATAZURE_ASSERT(axis >= 0 && axis < rank, "the axis is out of range");
+        MATAZURE_ASSERT(scales.size() == shape[axis] && zero_points.size() == shape[axis],
+                        "the quantization parameters size is not matched");
+    }
+
+    /// the quantized values
+    tensor<value_type, rank> values() const { return values_; }
+
+    pointi<rank> shape() const { return values_.shape(); }
+
+    int_t shape(int_t i) const { return values_.shape(i); }
+
+    /// the quantized axis, -1 means per tensor
+    int_t axis() const { return axis_; }
+
+    bool is_per_axis() const { return axis_ >= 0; }
+
+    float scale(int_t i = 0) const { return scales_[i]; }
+
+    int_t zero_point(int_t i = 0) const { return zero_points_[i]; }
+
+    tensor<float, 1> scales() const { return scales_; }
+
+    tensor<int_t, 1> zero_points() const { return zero_points_; }
+
+   private:
+    tensor<value_type, rank> values_;
+    tensor<float, 1> scales_;
+    tensor<int_t, 1> zero_points_;
+    int_t axis_;
+};
+
+namespace internal {
+
+/// saturates an accumulator to the quantized value type
+template <typename _ValueType>
+inline _ValueType saturate_quantized(std::int32_t v) {
+    const std::int32_t lowest = numeric_limits<_ValueType>::lowest();
+    const std::int32_t highest = numeric_limits<_ValueType>::max();
+    return static_cast<_ValueType>(v < lowest ? lowest : (v > highest ? highest : v));
+}
+
+/**
+ * @brief a real multiplier in fixed point, real = multiplier * 2^(shift - 31)
+ *
+ * the requantization multiplies the int32 accumulator by it in integer, so the integer kernels
+ * don't convert the accumulators to float.
+ */
+struct quantized_multiplier {
+    std::int32_t multiplier;
+    int_t shift;
+
+    quantized_multiplier() : multiplier(0), shift(0) {}
+
+    explicit quantized_multiplier(double real) : multiplier(0), shift(0) {
+        MATAZURE_ASSERT(real >= 0, "the multiplier should be non-negative");
+        if (real == 0) return;
+
+        int exp;
+        auto fraction = std::frexp(real, &exp);
+        auto q = static_cast<std::int64_t>(std::round(fraction * (1ll << 31)));
+        if (q == (1ll << 31)) {
+            q /= 2;
+            ++exp;
+        }
+        multiplier = static_cast<std::int32_t>(q);
+        shift = exp;
+        MATAZURE_ASSERT(shift < 31, "the multiplier is too large");
+    }
+
+    /// rounds x * real to nearest
+    std::int32_t operator()(std::int32_t x) const {
+        auto right_shift = 31 - shift;
+        if (right_shift > 62) return 0;
+        auto product = static_cast<std::int64_t>(x) * multiplier;
+        auto rounding = static_cast<std::int64_t>(1) << (right_shift - 1);
+        return static_cast<std::int32_t>((product + rounding) >> right_shift);
+    }
+};
+
+/// the index of the quantization parameters of the linear index i in a row major tensor
+class quantized_channel {
+   public:
+    template <typename _ValueType, int_t _Rank>
+    quantized_channel(const quantized_tensor<_ValueType, _Rank>& ts) : inner_(1), channels_(1) {
+        if (!ts.is_per_axis()) return;
+        channels_ = ts.shape(ts.axis());
+        for (int_t i = ts.axis() + 1; i < _Rank; ++i) inner_ *= ts.shape(i);
+    }
+
+    int_t operator()(int_t i) const { return (i / inner_) % channels_; }
+
+   private:
+    int_t inner_;
+    int_t channels_;
+};
+
+/// the elements number of an elementwise quantized task
+const int_t quantized_chunk_size = 4096;
+
+template <typename _ExecutionPolicy, typename _Fun>
+inline void for_each_quantized_chunk(_ExecutionPolicy policy, int_t size, _Fun fun) {
+    for_index(policy, 0, (size + quantized_chunk_size - 1) / quantized_chunk_size,
+              [&](int_t chunk_i) {
+                  auto begin = chunk_i * quantized_chunk_size;
+                  fun(begin, std::min(begin + quantized_chunk_size, size));
+              });
+}
+
+/// the integer dot product of two arrays
+template <typename _ValueTypeA, typename _ValueTypeB>
+inline std::int32_t dot(const _ValueTypeA* a, const _ValueTypeB* b, int_t size) {
+    std::int32_t re = 0;
+    for (int_t i = 0; i < size; ++i) {
+        re += static_cast<std::int32_t>(a[i]) * static_cast<std::int32_t>(b[i]);
+    }
+    return re;
+}
+
+/**
+ * @brief the dot product of unsigned and signed bytes
+ *
+ * it uses vpdpbusd of VNNI which accumulates the u8 x s8 products into int32 directly. without
+ * VNNI, the bytes are widened to int16 and accumulated by pmaddwd, pmaddubsw isn't used since its
+ * int16 sums saturate when both products are large.
+ */
+inline std::int32_t dot(const byte* a, const std::int8_t* b, int_t size) {
+    int_t i = 0;
+    std::int32_t re = 0;
+#if defined(__AVX512VNNI__) && defined(__AVX512BW__) && !defined(__CUDA_ARCH__)
+    auto acc512 = _mm512_setzero_si512();
+    for (; i + 64 <= size; i += 64) {
+        auto va = _mm512_loadu_si512(reinterpret_cast<const void*>(a + i));
+        auto vb = _mm512_loadu_si512(reinterpret_cast<const void*>(b + i));
+        acc512 = _mm512_dpbusd_epi32(acc512, va, vb);
+    }
+    re += _mm512_reduce_add_epi32(acc512);
+#endif
+#if defined(__AVX2__) && !defined(__CUDA_ARCH__)
+    auto acc = _mm256_setzero_si256();
+    for (; i + 16 <= size; i += 16) {
+        auto va = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+        auto vb = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(va, vb));
+    }
+    std::int32_t lanes[8];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    for (int_t l = 0; l < 8; ++l) re += lanes[l];
+#endif
+    for (; i < size; ++i) {
+        re += static_cast<std::int32_t>(a[i]) * static_cast<std::int32_t>(b[i]);
+    }
+    return re;
+}
+
+}  // namespace internal
+
+/**
+ * @brief quantizes a float tensor, value = round(real / scale) + zero_point saturated
+ * @param policy the execution policy
+ * @param ts_src the source float tensor
+ * @param ts_dst the dest quantized tensor, its quantization parameters are used
+ */
+template <typename _ExecutionPolicy, typename _TensorSrc, typename _ValueType, int_t _Rank>
+inline void quantize(_ExecutionPolicy policy, const _TensorSrc& ts_src,
+                     const quantized_tensor<_ValueType, _Rank>& ts_dst) {
+    MATAZURE_ASSERT(equal(ts_src.shape(), ts_dst.shape()), "the shapes is not matched");
+    internal::quantized_channel channel(ts_dst);
+    auto scales = ts_dst.scales();
+    auto zero_points = ts_dst.zero_points();
+    auto values = ts_dst.values();
+    internal::for_each_quantized_chunk(policy, values.size(), [&](int_t begin, int_t end) {
+        for (int_t i = begin; i < end; ++i) {
+            auto c = channel(i);
+            auto q = static_cast<std::int32_t>(std::lrint(ts_src[i] / scales[c])) + zero_points[c];
+            values[i] = internal::saturate_quantized<_ValueType>(q);
+        }
+    });
+}
+
+/// quantizes a float tensor by the sequence policy
+template <typename _TensorSrc, typename _ValueType, int_t _Rank>
+inline void quantize(const _TensorSrc& ts_src, const quantized_tensor<_ValueType, _Rank>& ts_dst) {
+    sequence_policy policy{};
+    quantize(policy, ts_src, ts_dst);
+}
+
+/**
+ * @brief dequantizes to a float tensor, real = scale * (value - zero_point)
+ * @param policy the execution policy
+ * @param ts_src the source quantized tensor
+ * @param ts_dst the dest float tensor
+ */
+template <typename _ExecutionPolicy, typename _ValueType, int_t _Rank, typename _TensorDst>
+inline void dequantize(_ExecutionPolicy policy, const quantized_tensor<_ValueType, _Rank>& ts_src,
+                       _TensorDst&& ts_dst) {
+    MATAZURE_ASSERT(equal(ts_src.shape(), ts_dst.shape()), "the shapes is not matched");
+    internal::quantized_channel channel(ts_src);
+    auto scales = ts_src.scales();
+    auto zero_points = ts_src.zero_points();
+    auto values = ts_src.values();
+    internal::for_each_quantized_chunk(policy, values.size(), [&](int_t begin, int_t end) {
+        for (int_t i = begin; i < end; ++i) {
+            auto c = channel(i);
+            ts_dst[i] = scales[c] * static_cast<float>(values[i] - zero_points[c]);
+        }
+    });
+}
+
+/// dequantizes to a float tensor by the sequence policy
+template <typename _ValueType, int_t _Rank, typename _TensorDst>
+inline void dequantize(const quantized_tensor<_ValueType, _Rank>& ts_src, _TensorDst&& ts_dst) {
+    sequence_policy policy{};
+    dequantize(policy, ts_src, std::forward<_TensorDst>(ts_dst));
+}
+
+/**
+ * @brief the quantized elementwise add with requantization
+ *
+ * the offset values are shifted left by 20 bits (15 bits for 16 bits values) and rescaled to the
+ * common scale 2 * max(scale_lhs, scale_rhs) by fixed point multipliers, the sum is requantized
+ * to ts_dst.
+ * the tensors should be per tensor quantized.
+ */
+template <typename _ExecutionPolicy, typename _ValueTypeLhs, typename _ValueTypeRhs,
+          typename _ValueTypeDst, int_t _Rank>
+inline void quantized_add(_ExecutionPolicy policy,
+                          const quantized_tensor<_ValueTypeLhs, _Rank>& ts_lhs,
+                          const quantized_tensor<_ValueTypeRhs, _Rank>& ts_rhs,
+                          const quantized_tensor<_ValueTypeDst, _Rank>& ts_dst) {
+    MATAZURE_ASSERT(equal(ts_lhs.shape(), ts_rhs.shape()) &&
+                        equal(ts_lhs.shape(), ts_dst.shape()),
+                    "the shapes is not matched");
+    MATAZURE_ASSERT(!ts_lhs.is_per_axis() && !ts_rhs.is_per_axis() && !ts_dst.is_per_axis(),
+                    "only support per tensor quantization");
+
+    static_assert(sizeof(_ValueTypeLhs) <= 2 && sizeof(_ValueTypeRhs) <= 2,
+                  "only support 8 bits and 16 bits values");
+    // the shifted offset values fit int32, a 16 bits offset value could be 65535
+    const int_t left_shift = (sizeof(_ValueTypeLhs) == 1 && sizeof(_ValueTypeRhs) == 1) ? 20 : 15;
+    double twice_max_scale = 2.0 * std::max(ts_lhs.scale(), ts_rhs.scale());
+    internal::quantized_multiplier lhs_multiplier(ts_lhs.scale() / twice_max_scale);
+    internal::quantized_multiplier rhs_multiplier(ts_rhs.scale() / twice_max_scale);
+    internal::quantized_multiplier dst_multiplier(twice_max_scale /
+                                                  ((1 << left_shift) * ts_dst.scale()));
+    auto lhs_zero_point = ts_lhs.zero_point();
+    auto rhs_zero_point = ts_rhs.zero_point();
+    auto dst_zero_point = ts_dst.zero_point();
+    auto lhs = ts_lhs.values();
+    auto rhs = ts_rhs.values();
+    auto dst = ts_dst.values();
+
+    internal::for_each_quantized_chunk(policy, dst.size(), [&](int_t begin, int_t end) {
+        for (int_t i = begin; i < end; ++i) {
+            auto l = lhs_multiplier((static_cast<std::int32_t>(lhs[i]) - lhs_zero_point) *
+                                    (1 << left_shift));
+            auto r = rhs_multiplier((static_cast<std::int32_t>(rhs[i]) - rhs_zero_point) *
+                                    (1 << left_shift));
+            dst[i] = internal::saturate_quantized<_ValueTypeDst>(dst_multiplier(l + r) +
+                                                                 dst_zero_point);
+        }
+    });
+}
+
+/**
+ * @brief the quantized elementwise multiply with requantization
+ *
+ * the int32 product of the offset values is requantized by scale_lhs * scale_rhs / scale_dst.
+ * the tensors should be per tensor quantized.
+ */
+template <typename _ExecutionPolicy, typename _ValueTypeLhs, typename _ValueTypeRhs,
+          typename _ValueTypeDst, int_t _Rank>
+inline void quantized_mul(_ExecutionPolicy policy,
+                          const quantized_tensor<_ValueTypeLhs, _Rank>& ts_lhs,
+                          const quantized_tensor<_ValueTypeRhs, _Rank>& ts_rhs,
+                          const quantized_tensor<_ValueTypeDst, _Rank>& ts_dst) {
+    MATAZURE_ASSERT(equal(ts_lhs.shape(), ts_rhs.shape()) &&
+                        equal(ts_lhs.shape(), ts_dst.shape()),
+                    "the shapes is not matched");
+    MATAZURE_ASSERT(!ts_lhs.is_per_axis() && !ts_rhs.is_per_axis() && !ts_dst.is_per_axis(),
+                    "only support per tensor quantization");
+
+    static_assert(sizeof(_ValueTypeLhs) + sizeof(_ValueTypeRhs) <= 3,
+                  "the product of the offset values should fit int32");
+    internal::quantized_multiplier multiplier(static_cast<double>(ts_lhs.scale()) *
+                                              ts_rhs.scale() / ts_dst.scale());
+    auto lhs_zero_point = ts_lhs.zero_point();
+    auto rhs_zero_point = ts_rhs.zero_point();
+    auto dst_zero_point = ts_dst.zero_point();
+    auto lhs = ts_lhs.values();
+    auto rhs = ts_rhs.values();
+    auto dst = ts_dst.values();
+
+    internal::for_each_quantized_chunk(policy, dst.size(), [&](int_t begin, int_t end) {
+        for (int_t i = begin; i < end; ++i) {
+            auto product = (lhs[i] - lhs_zero_point) * (rhs[i] - rhs_zero_point);
+            dst[i] = internal::saturate_quantized<_ValueTypeDst>(multiplier(product) +
+                                                                 dst_zero_point);
+        }
+    });
+}
+
+/**
+ * @brief the quantized matrix multiply, dst = lhs * rhs with int32 accumulation
+ *
+ * the rhs is transposed once, so each dst element is a contiguous dot product, the u8 x s8 dot
+ * product uses the VNNI or AVX2 kernel. the zero points are corrected by the row sums of lhs and
+ * the column sums of rhs: sum (a - za)(b - zb) = sum ab - zb sum a - za sum b + k za zb.
+ *
+ * @param policy the execution policy, the rows of dst are distributed by it
+ * @param ts_lhs the [m, k] lhs, per tensor quantized
+ * @param ts_rhs the [k, n] rhs, per tensor or per column(axis 1) quantized
+ * @param ts_dst the [m, n] dst, per tensor quantized
+ */
+template <typename _ExecutionPolicy, typename _ValueTypeLhs, typename _ValueTypeRhs,
+          typename _ValueTypeDst>
+inline void quantized_matmul(_ExecutionPolicy policy,
+                             const quantized_tensor<_ValueTypeLhs, 2>& ts_lhs,
+                             const quantized_tensor<_ValueTypeRhs, 2>& ts_rhs,
+                             const quantized_tensor<_ValueTypeDst, 2>& ts_dst) {
+    auto m = ts_lhs.shape(0);
+    auto k = ts_lhs.shape(1);
+    auto n = ts_rhs.shape(1);
+    MATAZURE_ASSERT(ts_rhs.shape(0) == k && ts_dst.shape(0) == m && ts_dst.shape(1) == n,
+                    "the shapes is not matched");
+    MATAZURE_ASSERT(!ts_lhs.is_per_axis() && !ts_dst.is_per_axis(),
+                    "the lhs and dst should be per tensor quantized");
+    MATAZURE_ASSERT(!ts_rhs.is_per_axis() || ts_rhs.axis() == 1,
+                    "the rhs should be quantized per tensor or per column");
+
+    tensor<_ValueTypeRhs, 2> rhs_t(pointi<2>{n, k});
+    transpose(policy, ts_rhs.values(), rhs_t);
+
+    auto lhs = ts_lhs.values();
+    auto dst = ts_dst.values();
+    auto lhs_zero_point = ts_lhs.zero_point();
+    auto dst_zero_point = ts_dst.zero_point();
+
+    std::vector<std::int32_t> rhs_sums(n);
+    std::vector<std::int32_t> rhs_zero_points(n);
+    std::vector<internal::quantized_multiplier> multipliers(n);
+    for (int_t j = 0; j < n; ++j) {
+        auto p_col = rhs_t.data() + j * k;
+        rhs_sums[j] = 0;
+        for (int_t i = 0; i < k; ++i) rhs_sums[j] += p_col[i];
+        auto c = ts_rhs.is_per_axis() ? j : 0;
+        rhs_zero_points[j] = ts_rhs.zero_point(c);
+        multipliers[j] = internal::quantized_multiplier(
+            static_cast<double>(ts_lhs.scale()) * ts_rhs.scale(c) / ts_dst.scale());
+    }
+
+    for_index(policy, 0, m, [&](int_t row) {
+        auto p_row = lhs.data() + row * k;
+        std::int32_t lhs_sum = 0;
+        for (int_t i = 0; i < k; ++i) lhs_sum += p_row[i];
+        auto p_dst = dst.data() + row * n;
+        for (int_t j = 0; j < n; ++j) {
+            auto acc = internal::dot(p_row, rhs_t.data() + j * k, k);
+            acc += -rhs_zero_points[j] * lhs_sum - lhs_zero_point * rhs_sums[j] +
+                   k * lhs_zero_point * rhs_zero_points[j];
+            p_dst[j] =
+                internal::saturate_quantized<_ValueTypeDst>(multipliers[j](acc) + dst_zero_point);
+        }
+    });
+}
+
+/**
+ * @brief the quantized 2-dim convolution with int32 accumulation
+ *
+ * dst(idx) = sum kernel(n) * src(idx + n - kernel.shape() / 2) as view::conv, the elements out of
+ * src are the real zero. each dst row is accumulated by the rows of the kernel, the inner loops
+ * are contiguous int32 multiply-add which are vectorized by the compiler.
+ *
+ * @param policy the execution policy, the rows of dst are distributed by it
+ * @param ts_src the source, per tensor quantized
+ * @param ts_kernel the kernel, per tensor quantized
+ * @param ts_dst the dest which has the shape of ts_src, per tensor quantized
+ */
+template <typename _ExecutionPolicy, typename _ValueTypeSrc, typename _ValueTypeKernel,
+          typename _ValueTypeDst>
+inline void quantized_conv(_ExecutionPolicy policy,
+                           const quantized_tensor<_ValueTypeSrc, 2>& ts_src,
+                           const quantized_tensor<_ValueTypeKernel, 2>& ts_kernel,
+                           const quantized_tensor<_ValueTypeDst, 2>& ts_dst) {
+    MATAZURE_ASSERT(equal(ts_src.shape(), ts_dst.shape()), "the shapes is not matched");
+    MATAZURE_ASSERT(!ts_src.is_per_axis() && !ts_kernel.is_per_axis() && !ts_dst.is_per_axis(),
+                    "only support per tensor quantization");
+
+    auto rows = ts_src.shape(0);
+    auto cols = ts_src.shape(1);
+    auto kernel_shape = ts_kernel.shape();
+    auto kernel_radius = kernel_shape / 2;
+    auto src = ts_src.values();
+    auto kernel = ts_kernel.values();
+    auto dst = ts_dst.values();
+    auto src_zero_point = ts_src.zero_point();
+    auto kernel_zero_point = ts_kernel.zero_point();
+    auto dst_zero_point = ts_dst.zero_point();
+    internal::quantized_multiplier multiplier(static_cast<double>(ts_src.scale()) *
+                                              ts_kernel.scale() / ts_dst.scale());
+
+    for_index(policy, 0, rows, [&](int_t row) {
+        std::vector<std::int32_t> acc(cols, 0);
+        std::vector<std::int32_t> src_row(cols);
+        for (int_t ky = 0; ky < kernel_shape[0]; ++ky) {
+            auto src_y = row + ky - kernel_radius[0];
+            if (src_y < 0 || src_y >= rows) continue;
+
+            auto p_src = src.data() + src_y * cols;
+            for (int_t x = 0; x < cols; ++x) src_row[x] = p_src[x] - src_zero_point;
+
+            for (int_t kx = 0; kx < kernel_shape[1]; ++kx) {
+                auto w = static_cast<std::int32_t>(kernel(ky, kx)) - kernel_zero_point;
+                if (w == 0) continue;
+                auto offset = kx - kernel_radius[1];
+                auto x_begin = std::max<int_t>(0, -offset);
+                auto x_end = std::min(cols, cols - offset);
+                if (x_begin >= x_end) continue;
+                // the pointers start at x_begin, so they're never out of the buffers
+                auto p_acc = acc.data() + x_begin;
+                auto p_src_row = src_row.data() + x_begin + offset;
+                for (int_t x = 0; x < x_end - x_begin; ++x) p_acc[x] += w * p_src_row[x];
+            }
+        }
+
+        auto p_dst = dst.data() + row * cols;
+        for (int_t x = 0; x < cols; ++x) {
+            p_dst[x] = internal::saturate_quantized<_ValueTypeDst>(multiplier(acc[x]) +
+                                                                   dst_zero_point);
+        }
+    });
+}
+
+}  // namespace matazure
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <cstdint>
+
+#include <matazure/algorithm.hpp>
+#include <matazure/point.hpp>
+#include <matazure/tensor.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MATAZURE_RANDOM_SSE2
+#endif
+
+namespace matazure {
+
+/**
+ * \defgroup Counter based random numbers
+ *
+ * the random numbers are generated by Philox4x32-10 (Salmon et al., "Parallel random numbers: as
+ * easy as 1, 2, 3"), a bijection of a 128 bits counter under a 64 bits key. the element i of a
+ * random tensor is the (i % 4) word of the block i / 4, whose counter is (i / 4, stream) and whose
+ * key is the seed, so it's a pure function of (seed, stream, i). the values are the same for any
+ * execution policy and thread count, the views and the dense fill kernels are matched too.
+ * @{
+ */
+
+/// the 128 bits counter or the result of Philox4x32
+typedef point<std::uint32_t, 4> philox4x32_counter;
+/// the 64 bits key of Philox4x32
+typedef point<std::uint32_t, 2> philox4x32_key;
+
+namespace internal {
+
+const std::uint32_t philox_m0 = 0xD2511F53u;
+const std::uint32_t philox_m1 = 0xCD9E8D57u;
+const std::uint32_t philox_w0 = 0x9E3779B9u;
+const std::uint32_t philox_w1 = 0xBB67AE85u;
+
+MATAZURE_GENERAL inline void philox_mulhilo(std::uint32_t a, std::uint32_t b, std::uint32_t& hi,
+                                            std::uint32_t& lo) {
+    std::uint64_t product = static_cast<std::uint64_t>(a) * b;
+    hi = static_cast<std::uint32_t>(product >> 32);
+    lo = static_cast<std::uint32_t>(product);
+}
+
+}  // namespace internal
+
+/// the Philox4x32-10 bijection, it's the same as philox4x32_R(10, ctr, key) of Random123
+MATAZURE_GENERAL inline philox4x32_counter philox4x32_10(philox4x32_counter ctr,
+                                                         philox4x32_key key) {
+    for (int_t r = 0; r < 10; ++r) {
+        std::uint32_t hi0, lo0, hi1, lo1;
+        internal::philox_mulhilo(internal::philox_m0, ctr[0], hi0, lo0);
+        internal::philox_mulhilo(internal::philox_m1, ctr[2], hi1, lo1);
+        ctr = philox4x32_counter{hi1 ^ ctr[1] ^ key[0], lo1, hi0 ^ ctr[3] ^ key[1], lo0};
+        key[0] += internal::philox_w0;
+        key[1] += internal::philox_w1;
+    }
+
+    return ctr;
+}
+
+/// the key of a seed
+MATAZURE_GENERAL inline philox4x32_key philox4x32_seed_key(std::uint64_t seed) {
+    return philox4x32_key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)};
+}
+
+/// the counter of the block of a stream, a block is 4 random values
+MATAZURE_GENERAL inline philox4x32_counter philox4x32_block_counter(std::uint64_t block,
+                                                                    std::uint64_t stream) {
+    return philox4x32_counter{static_cast<std::uint32_t>(block),
+                              static_cast<std::uint32_t>(block >> 32),
+                              static_cast<std::uint32_t>(stream),
+                              static_cast<std::uint32_t>(stream >> 32)};
+}
+
+/// maps the random bits to [0, 1), it keeps 24 bits which are exact in float and double
+template <typename _ValueType>
+MATAZURE_GENERAL inline _ValueType uniform_real(std::uint32_t x) {
+    return static_cast<_ValueType>(x >> 8) * static_cast<_ValueType>(1.0 / 16777216.0);
+}
+
+/// maps a pair of random bits to a pair of standard normal values by the Box-Muller transform
+template <typename _ValueType>
+MATAZURE_GENERAL inline point<_ValueType, 2> box_muller(std::uint32_t x0, std::uint32_t x1) {
+    // in (0, 1], the log is finite
+    auto u0 = static_cast<_ValueType>((x0 >> 8) + 1) * static_cast<_ValueType>(1.0 / 16777216.0);
+    auto u1 = uniform_real<_ValueType>(x1);
+    auto r = std::sqrt(_ValueType(-2) * std::log(u0));
+    auto theta = static_cast<_ValueType>(6.283185307179586) * u1;
+    return point<_ValueType, 2>{r * std::cos(theta), r * std::sin(theta)};
+}
+
+namespace internal {
+
+/// the random values of a philox group, 4 consecutive blocks
+const int_t philox_group_size = 16;
+
+/// generates the 16 random words of the blocks [block, block + 4) of a stream
+inline void philox4x32_10_x4(std::uint64_t block, std::uint64_t stream, philox4x32_key key,
+                             std::uint32_t* p_dst) {
+#ifdef MATAZURE_RANDOM_SSE2
+    // the structure of arrays, the lane j is the block + j
+    __m128i c0 = _mm_setr_epi32(static_cast<int>(block), static_cast<int>(block + 1),
+                                static_cast<int>(block + 2), static_cast<int>(block + 3));
+    __m128i c1 = _mm_setr_epi32(
+        static_cast<int>(block >> 32), static_cast<int>((block + 1) >> 32),
+        static_cast<int>((block + 2) >> 32), static_cast<int>((block + 3) >> 32));
+    __m128i c2 = _mm_set1_epi32(static_cast<int>(stream));
+    __m128i c3 = _mm_set1_epi32(static_cast<int>(stream >> 32));
+    const __m128i m0 = _mm_set1_epi32(static_cast<int>(philox_m0));
+    const __m128i m1 = _mm_set1_epi32(static_cast<int>(philox_m1));
+
+    // pmuludq multiplies the even lanes, the odd lanes are shifted to the even ones
+    auto mulhilo = [](__m128i a, __m128i m, __m128i& hi, __m128i& lo) {
+        __m128i even = _mm_mul_epu32(a, m);
+        __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), m);
+        lo = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+        hi = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 3, 1)),
+                                _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 3, 1)));
+    };
+
+    for (int_t r = 0; r < 10; ++r) {
+        __m128i hi0, lo0, hi1, lo1;
+        mulhilo(c0, m0, hi0, lo0);
+        mulhilo(c2, m1, hi1, lo1);
+        __m128i k0 = _mm_set1_epi32(static_cast<int>(key[0]));
+        __m128i k1 = _mm_set1_epi32(static_cast<int>(key[1]));
+        c0 = _mm_xor_si128(_mm_xor_si128(hi1, c1), k0);
+        c1 = lo1;
+        c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), k1);
+        c3 = lo0;
+        key[0] += philox_w0;
+        key[1] += philox_w1;
+    }
+
+    // transposes to the array of structures, the row j is the block + j
+    __m128i t0 = _mm_unpacklo_epi32(c0, c1);
+    __m128i t1 = _mm_unpacklo_epi32(c2, c3);
+    __m128i t2 = _mm_unpackhi_epi32(c0, c1);
+    __m128i t3 = _mm_unpackhi_epi32(c2, c3);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p_dst), _mm_unpacklo_epi64(t0, t1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p_dst + 4), _mm_unpackhi_epi64(t0, t1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p_dst + 8), _mm_unpacklo_epi64(t2, t3));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p_dst + 12), _mm_unpackhi_epi64(t2, t3));
+#else
+    for (int_t j = 0; j < 4; ++j) {
+        auto words = philox4x32_10(philox4x32_block_counter(block + j, stream), key);
+        for (int_t w = 0; w < 4; ++w) {
+            p_dst[j * 4 + w] = words[w];
+        }
+    }
+#endif
+}
+
+/// fills the memory of ts by the groups, fun(p_words, p_dst, count) converts a group
+template <typename _ExecutionPolicy, typename _Tensor, typename _Fun>
+inline void fill_random(_ExecutionPolicy policy, _Tensor& ts, std::uint64_t seed,
+                        std::uint64_t stream, _Fun fun) {
+    auto p_dst = ts.data();
+    auto size = ts.size();
+    auto key = philox4x32_seed_key(seed);
+    for_index(policy, 0, (size + philox_group_size - 1) / philox_group_size, [=](int_t group_i) {
+        std::uint32_t words[philox_group_size];
+        auto begin = group_i * philox_group_size;
+        philox4x32_10_x4(static_cast<std::uint64_t>(group_i) * 4, stream, key, words);
+        fun(words, p_dst + begin, std::min(philox_group_size, size - begin));
+    });
+}
+
+}  // namespace internal
+
+/**
+ * @brief fills a dense tensor by the uniform random values in [0, 1)
+ *
+ * it generates 16 values by a Philox call, the values are the same as view::random_uniform.
+ *
+ * @param policy the execution policy
+ * @param ts the dest tensor with memory
+ * @param seed the seed
+ * @param stream the stream, the different streams of a seed are independent
+ */
+template <typename _ExecutionPolicy, typename _Tensor>
+inline void fill_random_uniform(_ExecutionPolicy policy, _Tensor&& ts, std::uint64_t seed,
+                                std::uint64_t stream) {
+    typedef decay_t<typename decay_t<_Tensor>::value_type> value_type;
+    MATAZURE_TRACE_SCOPE("fill_random_uniform", policy, ts.shape(), trace::element_size(ts), 0,
+                         trace::tensor_bytes(ts));
+    internal::fill_random(policy, ts, seed, stream,
+                          [](const std::uint32_t* p_words, value_type* p_dst, int_t count) {
+                              for (int_t i = 0; i < count; ++i) {
+                                  p_dst[i] = uniform_real<value_type>(p_words[i]);
+                              }
+                          });
+}
+
+/// fills a dense tensor by the uniform random values in [0, 1) by the sequence policy
+template <typename _Tensor>
+inline void fill_random_uniform(_Tensor&& ts, std::uint64_t seed, std::uint64_t stream) {
+    sequence_policy policy{};
+    fill_random_uniform(policy, std::forward<_Tensor>(ts), seed, stream);
+}
+
+/**
+ * @brief fills a dense tensor by the standard normal random values
+ *
+ * the words (2k, 2k + 1) of a block are a Box-Muller pair, the values are the same as
+ * view::random_normal.
+ *
+ * @see fill_random_uniform
+ */
+template <typename _ExecutionPolicy, typename _Tensor>
+inline void fill_random_normal(_ExecutionPolicy policy, _Tensor&& ts, std::uint64_t seed,
+                               std::uint64_t stream) {
+    typedef decay_t<typename decay_t<_Tensor>::value_type> value_type;
+    MATAZURE_TRACE_SCOPE("fill_random_normal", policy, ts.shape(), trace::element_size(ts), 0,
+                         trace::tensor_bytes(ts));
+    internal::fill_random(policy, ts, seed, stream,
+                          [](const std::uint32_t* p_words, value_type* p_dst, int_t count) {
+                              for (int_t i = 0; i < count; i += 2) {
+                                  auto pair = box_muller<value_type>(p_words[i], p_words[i + 1]);
+                                  p_dst[i] = pair[0];
+                                  if (i + 1 < count) p_dst[i + 1] = pair[1];
+                              }
+                          });
+}
+
+/// fills a dense tensor by the standard normal random values by the sequence policy
+template <typename _Tensor>
+inline void fill_random_normal(_Tensor&& ts, std::uint64_t seed, std::uint64_t stream) {
+    sequence_policy policy{};
+    fill_random_normal(policy, std::forward<_Tensor>(ts), seed, stream);
+}
+
+/**@}*/
+
+}  // namespace matazure
@@ -0,0 +1,403 @@
+#pragma once
+
+#include <vector>
+
+#include <matazure/algorithm.hpp>
+#include <matazure/tensor.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MATAZURE_RESIZE_SSE2
+#endif
+
+namespace matazure {
+
+/// the interpolation methods of resizing
+enum struct interpolation { nearest, bilinear, bicubic, area };
+
+/// the accumulating type of the scalar channels of resizing
+template <typename _ValueType>
+struct accumulate_traits {
+    typedef float type;
+};
+
+template <>
+struct accumulate_traits<double> {
+    typedef double type;
+};
+
+template <typename _ValueType, int_t _Rank>
+struct accumulate_traits<point<_ValueType, _Rank>> {
+    typedef point<typename accumulate_traits<_ValueType>::type, _Rank> type;
+};
+
+namespace internal {
+
+/// converts an accumulated value to the scalar type, integers are rounded and saturated
+template <typename _ValueType, typename _AccType>
+MATAZURE_GENERAL inline enable_if_t<std::is_floating_point<_ValueType>::value, _ValueType>
+saturate_cast(_AccType v) {
+    return static_cast<_ValueType>(v);
+}
+
+template <typename _ValueType, typename _AccType>
+MATAZURE_GENERAL inline enable_if_t<std::is_integral<_ValueType>::value, _ValueType> saturate_cast(
+    _AccType v) {
+    const _AccType lowest = static_cast<_AccType>(numeric_limits<_ValueType>::lowest());
+    const _AccType highest = static_cast<_AccType>(numeric_limits<_ValueType>::max());
+    v = v < lowest ? lowest : (v > highest ? highest : v);
+    return static_cast<_ValueType>(v < 0 ? v - _AccType(0.5) : v + _AccType(0.5));
+}
+
+template <typename _ValueType, typename _AccType>
+MATAZURE_GENERAL inline enable_if_t<
+    !is_same<_ValueType, typename channel_traits<_ValueType>::scalar_type>::value, _ValueType>
+saturate_cast(_AccType v) {
+    _ValueType re;
+    for (int_t i = 0; i < re.size(); ++i) {
+        re[i] = saturate_cast<typename channel_traits<_ValueType>::scalar_type>(v[i]);
+    }
+    return re;
+}
+
+}  // namespace internal
+
+/// converts a pixel to its accumulate type
+template <typename _AccType, typename _ValueType>
+MATAZURE_GENERAL inline _AccType accumulate_cast(_ValueType v) {
+    return static_cast<_AccType>(v);
+}
+
+template <typename _AccType, typename _ValueType, int_t _Rank>
+MATAZURE_GENERAL inline _AccType accumulate_cast(const point<_ValueType, _Rank>& v) {
+    return point_cast<typename _AccType::value_type>(v);
+}
+
+/**
+ * @brief the precomputed source indices and weights of resizing an axis
+ *
+ * each dest index i is interpolated by taps() source elements, index(i, t) and weight(i, t).
+ * the indices are clamped into the source, so the border is replicated.
+ */
+class resize_coefficients {
+   public:
+    resize_coefficients() : resize_coefficients(0, 0, interpolation::nearest) {}
+
+    resize_coefficients(int_t src_size, int_t dst_size, interpolation method)
+        : src_size_(src_size), dst_size_(dst_size) {
+        auto scale = dst_size > 0 ? static_cast<double>(src_size) / dst_size : 1.0;
+        if (method == interpolation::area && scale <= 1.0) {
+            // the area interpolation of upsampling is the same as the bilinear
+            method = interpolation::bilinear;
+        }
+
+        switch (method) {
+            case interpolation::nearest:
+                taps_ = 1;
+                break;
+            case interpolation::bilinear:
+                taps_ = 2;
+                break;
+            case interpolation::bicubic:
+                taps_ = 4;
+                break;
+            case interpolation::area:
+                taps_ = static_cast<int_t>(std::ceil(scale)) + 1;
+                break;
+        }
+
+        indices_ = tensor<int_t, 1>(pointi<1>{dst_size * taps_});
+        weights_ = tensor<float, 1>(pointi<1>{dst_size * taps_});
+        fill(weights_, 0.0f);
+
+        for (int_t i = 0; i < dst_size; ++i) {
+            auto center = (i + 0.5) * scale - 0.5;
+            switch (method) {
+                case interpolation::nearest:
+                    set(i, 0, static_cast<int_t>(std::floor((i + 0.5) * scale)), 1.0);
+                    break;
+                case interpolation::bilinear: {
+                    auto x0 = static_cast<int_t>(std::floor(center));
+                    auto t = center - x0;
+                    set(i, 0, x0, 1.0 - t);
+                    set(i, 1, x0 + 1, t);
+                    break;
+                }
+                case interpolation::bicubic: {
+                    auto x0 = static_cast<int_t>(std::floor(center));
+                    auto t = center - x0;
+                    for (int_t k = 0; k < 4; ++k) {
+                        set(i, k, x0 - 1 + k, cubic_weight(t + 1 - k));
+                    }
+                    break;
+                }
+                case interpolation::area: {
+                    auto begin = i * scale;
+                    auto end = begin + scale;
+                    auto x0 = static_cast<int_t>(std::floor(begin));
+                    for (int_t k = 0; k < taps_; ++k) {
+                        auto x = x0 + k;
+                        auto overlap = std::min<double>(x + 1, end) - std::max<double>(x, begin);
+                        set(i, k, std::min(x, src_size - 1), std::max(overlap, 0.0) / scale);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    /// the source elements count of each dest element
+    MATAZURE_GENERAL int_t taps() const { return taps_; }
+
+    MATAZURE_GENERAL int_t src_size() const { return src_size_; }
+
+    MATAZURE_GENERAL int_t dst_size() const { return dst_size_; }
+
+    /// the t-th source index of dest index i
+    MATAZURE_GENERAL int_t index(int_t i, int_t t) const { return indices_[i * taps_ + t]; }
+
+    /// the t-th source weight of dest index i
+    MATAZURE_GENERAL float weight(int_t i, int_t t) const { return weights_[i * taps_ + t]; }
+
+   private:
+    void set(int_t i, int_t t, int_t src_i, double w) {
+        indices_[i * taps_ + t] = std::min(std::max(src_i, 0), src_size_ - 1);
+        weights_[i * taps_ + t] = static_cast<float>(w);
+    }
+
+    /// the cubic convolution kernel with a = -0.75
+    static double cubic_weight(double x) {
+        const double a = -0.75;
+        x = std::abs(x);
+        if (x <= 1) return ((a + 2) * x - (a + 3)) * x * x + 1;
+        if (x < 2) return ((a * x - 5 * a) * x + 8 * a) * x - 4 * a;
+        return 0;
+    }
+
+   private:
+    int_t src_size_;
+    int_t dst_size_;
+    int_t taps_;
+    tensor<int_t, 1> indices_;
+    tensor<float, 1> weights_;
+};
+
+/**
+ * @brief the precomputed coefficients of resizing a 2-dim shape to another, it could be reused
+ * for all the images of the same shape pair
+ */
+class resize_plan {
+   public:
+    resize_plan() {}
+
+    resize_plan(pointi<2> src_shape, pointi<2> dst_shape, interpolation method)
+        : src_shape_(src_shape),
+          dst_shape_(dst_shape),
+          rows_(src_shape[0], dst_shape[0], method),
+          cols_(src_shape[1], dst_shape[1], method) {}
+
+    MATAZURE_GENERAL pointi<2> src_shape() const { return src_shape_; }
+
+    MATAZURE_GENERAL pointi<2> dst_shape() const { return dst_shape_; }
+
+    /// the coefficients of axis 0
+    MATAZURE_GENERAL const resize_coefficients& rows() const { return rows_; }
+
+    /// the coefficients of axis 1
+    MATAZURE_GENERAL const resize_coefficients& cols() const { return cols_; }
+
+   private:
+    pointi<2> src_shape_;
+    pointi<2> dst_shape_;
+    resize_coefficients rows_;
+    resize_coefficients cols_;
+};
+
+namespace internal {
+
+/// the dest rows of a resize task, keep them enough to reuse the ring buffer
+const int_t resize_rows_per_task = 32;
+
+/**
+ * @brief the scalar horizontal pass of the dest columns [x_begin, dst_cols), out is
+ * [dst_cols][_Channels]
+ *
+ * the source pixels are gathered by the column indices, the channels are a compile time count,
+ * so the channel loops are unrolled.
+ */
+template <int_t _Channels, typename _ScalarType, typename _AccType>
+inline void resize_row_scalar(const _ScalarType* in, _AccType* out,
+                              const resize_coefficients& cols, int_t x_begin) {
+    auto taps = cols.taps();
+    for (int_t x = x_begin; x < cols.dst_size(); ++x) {
+        _AccType sum[_Channels] = {};
+        for (int_t t = 0; t < taps; ++t) {
+            auto w = static_cast<_AccType>(cols.weight(x, t));
+            auto p_in = in + cols.index(x, t) * _Channels;
+            for (int_t c = 0; c < _Channels; ++c) sum[c] += w * p_in[c];
+        }
+
+        auto p_out = out + x * _Channels;
+        for (int_t c = 0; c < _Channels; ++c) p_out[c] = sum[c];
+    }
+}
+
+/// the horizontal pass of a source row, out is [dst_cols][_Channels]
+template <int_t _Channels, typename _ScalarType, typename _AccType>
+inline void resize_row(const _ScalarType* in, _AccType* out, const resize_coefficients& cols) {
+    resize_row_scalar<_Channels>(in, out, cols, 0);
+}
+
+#ifdef MATAZURE_RESIZE_SSE2
+
+/**
+ * @brief the sse horizontal pass of byte and float rows, 4 dest columns a step
+ *
+ * the source elements of a tap are gathered to the lanes, then the taps are accumulated by the
+ * packed multiply and add, the tail columns are by the scalar pass.
+ */
+template <int_t _Channels, typename _ScalarType>
+inline enable_if_t<_Channels == 1 &&
+                   (is_same<_ScalarType, byte>::value || is_same<_ScalarType, float>::value)>
+resize_row(const _ScalarType* in, float* out, const resize_coefficients& cols) {
+    auto taps = cols.taps();
+    int_t x = 0;
+    for (; x + 4 <= cols.dst_size(); x += 4) {
+        auto sum = _mm_setzero_ps();
+        for (int_t t = 0; t < taps; ++t) {
+            auto v = _mm_setr_ps(in[cols.index(x, t)], in[cols.index(x + 1, t)],
+                                 in[cols.index(x + 2, t)], in[cols.index(x + 3, t)]);
+            auto w = _mm_setr_ps(cols.weight(x, t), cols.weight(x + 1, t),
+                                 cols.weight(x + 2, t), cols.weight(x + 3, t));
+            sum = _mm_add_ps(sum, _mm_mul_ps(v, w));
+        }
+        _mm_storeu_ps(out + x, sum);
+    }
+    resize_row_scalar<1>(in, out, cols, x);
+}
+
+/**
+ * @brief the sse horizontal pass of point<byte, 3> rows, a dest pixel a step
+ *
+ * the 3 channels of a source pixel are widened to the lanes of floats, the 4th lane is zero. the
+ * store of a pixel writes a float more, it's overwritten by the next pixel, so the last pixel is
+ * by the scalar pass.
+ */
+template <int_t _Channels>
+inline enable_if_t<_Channels == 3> resize_row(const byte* in, float* out,
+                                              const resize_coefficients& cols) {
+    auto taps = cols.taps();
+    auto zero = _mm_setzero_si128();
+    int_t x = 0;
+    for (; x + 1 < cols.dst_size(); ++x) {
+        auto sum = _mm_setzero_ps();
+        for (int_t t = 0; t < taps; ++t) {
+            auto p_in = in + cols.index(x, t) * 3;
+            auto v = _mm_cvtsi32_si128(p_in[0] | (p_in[1] << 8) | (p_in[2] << 16));
+            v = _mm_unpacklo_epi16(_mm_unpacklo_epi8(v, zero), zero);
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(cols.weight(x, t))));
+        }
+        _mm_storeu_ps(out + x * 3, sum);
+    }
+    resize_row_scalar<3>(in, out, cols, x);
+}
+
+#endif
+
+}  // namespace internal
+
+/**
+ * @brief resizes a dense 2-dim tensor by the precomputed plan
+ *
+ * the interpolation is separated, each source row is resampled horizontally once into a ring
+ * buffer of rows, the horizontal pass of byte, float and point<byte, 3> pixels has the sse paths
+ * when SSE2 is available. then the dest rows are the weighted sums of the ring rows, the channels
+ * of pixels are flattened, so the vertical pass is contiguous scalar loops which the compiler
+ * vectorizes alike. the dest rows are distributed by the policy.
+ *
+ * @param policy the execution policy
+ * @param ts_src the source tensor
+ * @param ts_dst the dest tensor, its shape should be plan.dst_shape()
+ * @param plan the resize plan
+ */
+template <typename _ExecutionPolicy, typename _TensorSrc, typename _TensorDst>
+inline void resize(_ExecutionPolicy policy, const _TensorSrc& ts_src, _TensorDst&& ts_dst,
+                   const resize_plan& plan) {
+    typedef typename _TensorSrc::value_type value_type;
+    typedef typename channel_traits<value_type>::scalar_type scalar_type;
+    typedef typename accumulate_traits<scalar_type>::type acc_type;
+    const int_t channels = channel_traits<value_type>::channels;
+    MATAZURE_STATIC_ASSERT_MATRIX_RANK(_TensorSrc);
+    MATAZURE_STATIC_ASSERT_VALUE_TYPE_MATCHED(_TensorSrc, decay_t<_TensorDst>);
+    static_assert(is_same<layout_t<_TensorSrc>, row_major_layout<2>>::value &&
+                      is_same<layout_t<decay_t<_TensorDst>>, row_major_layout<2>>::value,
+                  "only support row major dense tensor");
+    MATAZURE_ASSERT(equal(ts_src.shape(), plan.src_shape()), "the source shape is not matched");
+    MATAZURE_ASSERT(equal(ts_dst.shape(), plan.dst_shape()), "the dest shape is not matched");
+
+    auto p_src = reinterpret_cast<const scalar_type*>(ts_src.data());
+    auto p_dst = reinterpret_cast<scalar_type*>(ts_dst.data());
+    auto src_row_size = ts_src.shape(1) * channels;
+    auto dst_row_size = ts_dst.shape(1) * channels;
+    const auto& rows = plan.rows();
+    const auto& cols = plan.cols();
+    auto ring_size = rows.taps();
+    auto task_size = (ts_dst.shape(0) + internal::resize_rows_per_task - 1) /
+                     internal::resize_rows_per_task;
+
+    for_index(policy, 0, task_size, [&](int_t task_i) {
+        std::vector<acc_type> ring(ring_size * dst_row_size);
+        std::vector<int_t> ring_rows(ring_size, -1);
+        std::vector<acc_type> acc(dst_row_size);
+        std::vector<const acc_type*> p_taps(ring_size);
+
+        auto y_begin = task_i * internal::resize_rows_per_task;
+        auto y_end = std::min(y_begin + internal::resize_rows_per_task, ts_dst.shape(0));
+        for (int_t y = y_begin; y < y_end; ++y) {
+            for (int_t t = 0; t < ring_size; ++t) {
+                auto src_y = rows.index(y, t);
+                auto slot = src_y % ring_size;
+                auto p_ring = ring.data() + slot * dst_row_size;
+                if (ring_rows[slot] != src_y) {
+                    internal::resize_row<channels>(p_src + src_y * src_row_size, p_ring, cols);
+                    ring_rows[slot] = src_y;
+                }
+                p_taps[t] = p_ring;
+            }
+
+            for (int_t x = 0; x < dst_row_size; ++x) acc[x] = acc_type(0);
+            for (int_t t = 0; t < ring_size; ++t) {
+                auto w = static_cast<acc_type>(rows.weight(y, t));
+                auto p_ring = p_taps[t];
+                for (int_t x = 0; x < dst_row_size; ++x) acc[x] += w * p_ring[x];
+            }
+
+            auto p_dst_row = p_dst + y * dst_row_size;
+            for (int_t x = 0; x < dst_row_size; ++x) {
+                p_dst_row[x] = internal::saturate_cast<scalar_type>(acc[x]);
+            }
+        }
+    });
+}
+
+/**
+ * @brief resizes a dense 2-dim tensor to the shape of ts_dst
+ * @see resize
+ */
+template <typename _ExecutionPolicy, typename _TensorSrc, typename _TensorDst>
+inline void resize(_ExecutionPolicy policy, const _TensorSrc& ts_src, _TensorDst&& ts_dst,
+                   interpolation method) {
+    resize_plan plan(ts_src.shape(), ts_dst.shape(), method);
+    resize(policy, ts_src, std::forward<_TensorDst>(ts_dst), plan);
+}
+
+/// resizes a dense 2-dim tensor by the sequence policy
+template <typename _TensorSrc, typename _TensorDst>
+inline void resize(const _TensorSrc& ts_src, _TensorDst&& ts_dst,
+                   interpolation method = interpolation::bilinear,
+                   enable_if_t<is_tensor<_TensorSrc>::value>* = 0) {
+    sequence_policy policy{};
+    resize(policy, ts_src, std::forward<_TensorDst>(ts_dst), method);
+}
+
+}  // namespace matazure
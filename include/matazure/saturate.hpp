@@ -0,0 +1,404 @@
+#pragma once
+
+#include <cstdint>
+
+#include <matazure/algorithm.hpp>
+#include <matazure/tensor.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MATAZURE_SATURATE_SSE2
+#endif
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#define MATAZURE_SATURATE_SSSE3
+#endif
+
+namespace matazure {
+
+/**
+ * \defgroup Saturating and fixed point arithmetic
+ *
+ * the results are clamped to the range of the value type instead of wrapping around. the Q8
+ * values are unorm bytes, 255 is 1.0, the Q15 values are shorts, 32768 is 1.0.
+ * @{
+ */
+
+/// the saturating add
+template <typename _ValueType>
+MATAZURE_GENERAL inline _ValueType saturate_add(_ValueType lhs, _ValueType rhs) {
+    static_assert(sizeof(_ValueType) <= 2, "only support 8 bits and 16 bits integer");
+    std::int32_t re = static_cast<std::int32_t>(lhs) + static_cast<std::int32_t>(rhs);
+    const std::int32_t lowest = numeric_limits<_ValueType>::lowest();
+    const std::int32_t highest = numeric_limits<_ValueType>::max();
+    return static_cast<_ValueType>(re < lowest ? lowest : (re > highest ? highest : re));
+}
+
+/// the saturating subtract
+template <typename _ValueType>
+MATAZURE_GENERAL inline _ValueType saturate_sub(_ValueType lhs, _ValueType rhs) {
+    static_assert(sizeof(_ValueType) <= 2, "only support 8 bits and 16 bits integer");
+    std::int32_t re = static_cast<std::int32_t>(lhs) - static_cast<std::int32_t>(rhs);
+    const std::int32_t lowest = numeric_limits<_ValueType>::lowest();
+    const std::int32_t highest = numeric_limits<_ValueType>::max();
+    return static_cast<_ValueType>(re < lowest ? lowest : (re > highest ? highest : re));
+}
+
+namespace internal {
+
+/// x / 255 rounded to nearest, x is in [0, 65280]
+MATAZURE_GENERAL inline std::int32_t div255(std::int32_t x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+}  // namespace internal
+
+/// the Q8 multiply, lhs * rhs / 255 rounded
+MATAZURE_GENERAL inline byte mul_q8(byte lhs, byte rhs) {
+    return static_cast<byte>(internal::div255(lhs * rhs));
+}
+
+/// the Q8 blend, (lhs * (255 - alpha) + rhs * alpha) / 255 rounded
+MATAZURE_GENERAL inline byte blend_q8(byte lhs, byte rhs, byte alpha) {
+    return static_cast<byte>(internal::div255(lhs * (255 - alpha) + rhs * alpha));
+}
+
+/// the Q15 rounding multiply, it's pmulhrsw saturated, -1 * -1 is 32767
+MATAZURE_GENERAL inline short mul_q15(short lhs, short rhs) {
+    std::int32_t re = (static_cast<std::int32_t>(lhs) * rhs + 0x4000) >> 15;
+    return static_cast<short>(re > 32767 ? 32767 : re);
+}
+
+/// the Q15 blend, lhs + (rhs - lhs) * alpha rounded and saturated, alpha is in [0, 32767]
+MATAZURE_GENERAL inline short blend_q15(short lhs, short rhs, short alpha) {
+    std::int32_t diff = static_cast<std::int32_t>(rhs) - lhs;
+    std::int32_t re = lhs + ((diff * alpha + 0x4000) >> 15);
+    return static_cast<short>(re < -32768 ? -32768 : (re > 32767 ? 32767 : re));
+}
+
+template <typename _ValueType, int_t _Rank>
+MATAZURE_GENERAL inline point<_ValueType, _Rank> saturate_add(const point<_ValueType, _Rank>& lhs,
+                                                              const point<_ValueType, _Rank>& rhs) {
+    point<_ValueType, _Rank> re;
+    for (int_t i = 0; i < _Rank; ++i) re[i] = saturate_add(lhs[i], rhs[i]);
+    return re;
+}
+
+template <typename _ValueType, int_t _Rank>
+MATAZURE_GENERAL inline point<_ValueType, _Rank> saturate_sub(const point<_ValueType, _Rank>& lhs,
+                                                              const point<_ValueType, _Rank>& rhs) {
+    point<_ValueType, _Rank> re;
+    for (int_t i = 0; i < _Rank; ++i) re[i] = saturate_sub(lhs[i], rhs[i]);
+    return re;
+}
+
+template <int_t _Rank>
+MATAZURE_GENERAL inline point<byte, _Rank> mul_q8(const point<byte, _Rank>& lhs,
+                                                  const point<byte, _Rank>& rhs) {
+    point<byte, _Rank> re;
+    for (int_t i = 0; i < _Rank; ++i) re[i] = mul_q8(lhs[i], rhs[i]);
+    return re;
+}
+
+template <int_t _Rank>
+MATAZURE_GENERAL inline point<byte, _Rank> blend_q8(const point<byte, _Rank>& lhs,
+                                                    const point<byte, _Rank>& rhs, byte alpha) {
+    point<byte, _Rank> re;
+    for (int_t i = 0; i < _Rank; ++i) re[i] = blend_q8(lhs[i], rhs[i], alpha);
+    return re;
+}
+
+template <int_t _Rank>
+MATAZURE_GENERAL inline point<short, _Rank> mul_q15(const point<short, _Rank>& lhs,
+                                                    const point<short, _Rank>& rhs) {
+    point<short, _Rank> re;
+    for (int_t i = 0; i < _Rank; ++i) re[i] = mul_q15(lhs[i], rhs[i]);
+    return re;
+}
+
+template <int_t _Rank>
+MATAZURE_GENERAL inline point<short, _Rank> blend_q15(const point<short, _Rank>& lhs,
+                                                      const point<short, _Rank>& rhs,
+                                                      short alpha) {
+    point<short, _Rank> re;
+    for (int_t i = 0; i < _Rank; ++i) re[i] = blend_q15(lhs[i], rhs[i], alpha);
+    return re;
+}
+
+/**@}*/
+
+namespace internal {
+
+struct saturate_add_op {
+    template <typename _ValueType>
+    MATAZURE_GENERAL _ValueType operator()(const _ValueType& lhs, const _ValueType& rhs) const {
+        return saturate_add(lhs, rhs);
+    }
+};
+
+struct saturate_sub_op {
+    template <typename _ValueType>
+    MATAZURE_GENERAL _ValueType operator()(const _ValueType& lhs, const _ValueType& rhs) const {
+        return saturate_sub(lhs, rhs);
+    }
+};
+
+struct mul_q8_op {
+    template <typename _ValueType>
+    MATAZURE_GENERAL _ValueType operator()(const _ValueType& lhs, const _ValueType& rhs) const {
+        return mul_q8(lhs, rhs);
+    }
+};
+
+struct mul_q15_op {
+    template <typename _ValueType>
+    MATAZURE_GENERAL _ValueType operator()(const _ValueType& lhs, const _ValueType& rhs) const {
+        return mul_q15(lhs, rhs);
+    }
+};
+
+struct blend_q8_op {
+    byte alpha;
+
+    template <typename _ValueType>
+    MATAZURE_GENERAL _ValueType operator()(const _ValueType& lhs, const _ValueType& rhs) const {
+        return blend_q8(lhs, rhs, alpha);
+    }
+};
+
+struct blend_q15_op {
+    short alpha;
+
+    template <typename _ValueType>
+    MATAZURE_GENERAL _ValueType operator()(const _ValueType& lhs, const _ValueType& rhs) const {
+        return blend_q15(lhs, rhs, alpha);
+    }
+};
+
+/// the ops which are applied to the channels of a point independently
+template <typename _Op>
+struct is_saturate_op : bool_constant<false> {};
+template <>
+struct is_saturate_op<saturate_add_op> : bool_constant<true> {};
+template <>
+struct is_saturate_op<saturate_sub_op> : bool_constant<true> {};
+template <>
+struct is_saturate_op<mul_q8_op> : bool_constant<true> {};
+template <>
+struct is_saturate_op<mul_q15_op> : bool_constant<true> {};
+template <>
+struct is_saturate_op<blend_q8_op> : bool_constant<true> {};
+template <>
+struct is_saturate_op<blend_q15_op> : bool_constant<true> {};
+
+/// applies the op to arrays of scalars, the simd overloads process the head
+template <typename _Op, typename _ValueType>
+inline void saturate_bulk(_Op op, const _ValueType* lhs, const _ValueType* rhs, _ValueType* dst,
+                          int_t size) {
+    for (int_t i = 0; i < size; ++i) dst[i] = op(lhs[i], rhs[i]);
+}
+
+#ifdef MATAZURE_SATURATE_SSE2
+
+/// applies the sse op to 16 bytes blocks, the tail is applied by the scalar op
+template <typename _Op, typename _ValueType, typename _SimdOp>
+inline void saturate_bulk_sse(_Op op, const _ValueType* lhs, const _ValueType* rhs,
+                              _ValueType* dst, int_t size, _SimdOp simd_op) {
+    const int_t lanes = 16 / sizeof(_ValueType);
+    int_t i = 0;
+    for (; i + lanes <= size; i += lanes) {
+        auto l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+        auto r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), simd_op(l, r));
+    }
+    for (; i < size; ++i) dst[i] = op(lhs[i], rhs[i]);
+}
+
+inline void saturate_bulk(saturate_add_op op, const byte* lhs, const byte* rhs, byte* dst,
+                          int_t size) {
+    saturate_bulk_sse(op, lhs, rhs, dst, size, [](__m128i l, __m128i r) {
+        return _mm_adds_epu8(l, r);
+    });
+}
+
+inline void saturate_bulk(saturate_sub_op op, const byte* lhs, const byte* rhs, byte* dst,
+                          int_t size) {
+    saturate_bulk_sse(op, lhs, rhs, dst, size, [](__m128i l, __m128i r) {
+        return _mm_subs_epu8(l, r);
+    });
+}
+
+inline void saturate_bulk(saturate_add_op op, const short* lhs, const short* rhs, short* dst,
+                          int_t size) {
+    saturate_bulk_sse(op, lhs, rhs, dst, size, [](__m128i l, __m128i r) {
+        return _mm_adds_epi16(l, r);
+    });
+}
+
+inline void saturate_bulk(saturate_sub_op op, const short* lhs, const short* rhs, short* dst,
+                          int_t size) {
+    saturate_bulk_sse(op, lhs, rhs, dst, size, [](__m128i l, __m128i r) {
+        return _mm_subs_epi16(l, r);
+    });
+}
+
+inline void saturate_bulk(saturate_add_op op, const unsigned short* lhs,
+                          const unsigned short* rhs, unsigned short* dst, int_t size) {
+    saturate_bulk_sse(op, lhs, rhs, dst, size, [](__m128i l, __m128i r) {
+        return _mm_adds_epu16(l, r);
+    });
+}
+
+inline void saturate_bulk(saturate_sub_op op, const unsigned short* lhs,
+                          const unsigned short* rhs, unsigned short* dst, int_t size) {
+    saturate_bulk_sse(op, lhs, rhs, dst, size, [](__m128i l, __m128i r) {
+        return _mm_subs_epu16(l, r);
+    });
+}
+
+/// the rounded division by 255 of 16 bits lanes
+inline __m128i div255_epu16(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+inline void saturate_bulk(mul_q8_op op, const byte* lhs, const byte* rhs, byte* dst, int_t size) {
+    saturate_bulk_sse(op, lhs, rhs, dst, size, [](__m128i l, __m128i r) {
+        auto zero = _mm_setzero_si128();
+        auto lo = _mm_mullo_epi16(_mm_unpacklo_epi8(l, zero), _mm_unpacklo_epi8(r, zero));
+        auto hi = _mm_mullo_epi16(_mm_unpackhi_epi8(l, zero), _mm_unpackhi_epi8(r, zero));
+        return _mm_packus_epi16(div255_epu16(lo), div255_epu16(hi));
+    });
+}
+
+inline void saturate_bulk(blend_q8_op op, const byte* lhs, const byte* rhs, byte* dst,
+                          int_t size) {
+    auto alpha = _mm_set1_epi16(op.alpha);
+    auto inv_alpha = _mm_set1_epi16(static_cast<short>(255 - op.alpha));
+    saturate_bulk_sse(op, lhs, rhs, dst, size, [=](__m128i l, __m128i r) {
+        auto zero = _mm_setzero_si128();
+        auto lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(l, zero), inv_alpha),
+                                _mm_mullo_epi16(_mm_unpacklo_epi8(r, zero), alpha));
+        auto hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(l, zero), inv_alpha),
+                                _mm_mullo_epi16(_mm_unpackhi_epi8(r, zero), alpha));
+        return _mm_packus_epi16(div255_epu16(lo), div255_epu16(hi));
+    });
+}
+
+#endif
+
+#ifdef MATAZURE_SATURATE_SSSE3
+inline void saturate_bulk(mul_q15_op op, const short* lhs, const short* rhs, short* dst,
+                          int_t size) {
+    saturate_bulk_sse(op, lhs, rhs, dst, size, [](__m128i l, __m128i r) {
+        auto re = _mm_mulhrs_epi16(l, r);
+        // pmulhrsw wraps -1 * -1 to -32768, it's the only case of -32768
+        return _mm_xor_si128(re, _mm_cmpeq_epi16(re, _mm_set1_epi16(-32768)));
+    });
+}
+#endif
+
+/// the elements number of a saturating task
+const int_t saturate_chunk_size = 16384;
+
+/**
+ * @brief applies a saturating op to two dense tensors by chunks
+ *
+ * the points of bytes or shorts are processed as arrays of scalars, so they are vectorized too.
+ */
+template <typename _ExecutionPolicy, typename _Op, typename _TensorLhs, typename _TensorRhs,
+          typename _TensorDst>
+inline void saturate_transform(_ExecutionPolicy policy, _Op op, const _TensorLhs& ts_lhs,
+                               const _TensorRhs& ts_rhs, _TensorDst& ts_dst) {
+    typedef decay_t<typename _TensorLhs::value_type> value_type;
+    typedef typename channel_traits<value_type>::scalar_type scalar_type;
+    MATAZURE_STATIC_ASSERT_VALUE_TYPE_MATCHED(_TensorLhs, decay_t<_TensorDst>);
+    MATAZURE_STATIC_ASSERT_VALUE_TYPE_MATCHED(_TensorLhs, _TensorRhs);
+    static_assert(is_same<layout_t<_TensorLhs>, layout_t<_TensorRhs>>::value &&
+                      is_same<layout_t<_TensorLhs>, layout_t<decay_t<_TensorDst>>>::value,
+                  "the layouts is not matched");
+    MATAZURE_ASSERT(equal(ts_lhs.shape(), ts_rhs.shape()) &&
+                        equal(ts_lhs.shape(), ts_dst.shape()),
+                    "the shapes is not matched");
+
+    const int_t channels = sizeof(value_type) / sizeof(scalar_type);
+    auto p_lhs = reinterpret_cast<const scalar_type*>(ts_lhs.data());
+    auto p_rhs = reinterpret_cast<const scalar_type*>(ts_rhs.data());
+    auto p_dst = reinterpret_cast<scalar_type*>(ts_dst.data());
+    auto size = ts_dst.size() * channels;
+    for_index(policy, 0, (size + saturate_chunk_size - 1) / saturate_chunk_size,
+              [&](int_t chunk_i) {
+                  auto begin = chunk_i * saturate_chunk_size;
+                  auto chunk_size = std::min(saturate_chunk_size, size - begin);
+                  saturate_bulk(op, p_lhs + begin, p_rhs + begin, p_dst + begin, chunk_size);
+              });
+}
+
+}  // namespace internal
+
+/**
+ * @brief the saturating add of dense byte/short tensors, it uses paddusb/paddsw/paddusw
+ * @param policy the execution policy
+ * @param ts_lhs the lhs tensor
+ * @param ts_rhs the rhs tensor
+ * @param ts_dst the dest tensor, could be ts_lhs or ts_rhs
+ */
+template <typename _ExecutionPolicy, typename _TensorLhs, typename _TensorRhs, typename _TensorDst>
+inline void adds(_ExecutionPolicy policy, const _TensorLhs& ts_lhs, const _TensorRhs& ts_rhs,
+                 _TensorDst&& ts_dst) {
+    internal::saturate_transform(policy, internal::saturate_add_op{}, ts_lhs, ts_rhs, ts_dst);
+}
+
+/**
+ * @brief the saturating subtract of dense byte/short tensors, it uses psubusb/psubsw/psubusw
+ * @see adds
+ */
+template <typename _ExecutionPolicy, typename _TensorLhs, typename _TensorRhs, typename _TensorDst>
+inline void subs(_ExecutionPolicy policy, const _TensorLhs& ts_lhs, const _TensorRhs& ts_rhs,
+                 _TensorDst&& ts_dst) {
+    internal::saturate_transform(policy, internal::saturate_sub_op{}, ts_lhs, ts_rhs, ts_dst);
+}
+
+/**
+ * @brief the Q8 multiply of dense byte tensors, it uses 16 bits lanes
+ * @see mul_q8
+ */
+template <typename _ExecutionPolicy, typename _TensorLhs, typename _TensorRhs, typename _TensorDst>
+inline void mulq8(_ExecutionPolicy policy, const _TensorLhs& ts_lhs, const _TensorRhs& ts_rhs,
+                  _TensorDst&& ts_dst) {
+    internal::saturate_transform(policy, internal::mul_q8_op{}, ts_lhs, ts_rhs, ts_dst);
+}
+
+/**
+ * @brief the Q15 multiply of dense short tensors, it uses pmulhrsw
+ * @see mul_q15
+ */
+template <typename _ExecutionPolicy, typename _TensorLhs, typename _TensorRhs, typename _TensorDst>
+inline void mulq15(_ExecutionPolicy policy, const _TensorLhs& ts_lhs, const _TensorRhs& ts_rhs,
+                   _TensorDst&& ts_dst) {
+    internal::saturate_transform(policy, internal::mul_q15_op{}, ts_lhs, ts_rhs, ts_dst);
+}
+
+/**
+ * @brief the Q8 blend of dense byte tensors
+ * @see blend_q8
+ */
+template <typename _ExecutionPolicy, typename _TensorLhs, typename _TensorRhs, typename _TensorDst>
+inline void blendq8(_ExecutionPolicy policy, const _TensorLhs& ts_lhs, const _TensorRhs& ts_rhs,
+                    byte alpha, _TensorDst&& ts_dst) {
+    internal::saturate_transform(policy, internal::blend_q8_op{alpha}, ts_lhs, ts_rhs, ts_dst);
+}
+
+/**
+ * @brief the Q15 blend of dense short tensors
+ * @see blend_q15
+ */
+template <typename _ExecutionPolicy, typename _TensorLhs, typename _TensorRhs, typename _TensorDst>
+inline void blendq15(_ExecutionPolicy policy, const _TensorLhs& ts_lhs, const _TensorRhs& ts_rhs,
+                     short alpha, _TensorDst&& ts_dst) {
+    internal::saturate_transform(policy, internal::blend_q15_op{alpha}, ts_lhs, ts_rhs, ts_dst);
+}
+
+}  // namespace matazure
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <vector>
+
+#include <matazure/algorithm.hpp>
+#include <matazure/geometry.hpp>
+#include <matazure/tensor.hpp>
+
+namespace matazure {
+
+namespace internal {
+
+/**
+ * @brief a batch of 1-dim lines along an axis of a dense tensor
+ *
+ * the element (i, l) is the i-th element of the l-th line, its offset is
+ * base + i * line_stride + l * lane_stride
+ */
+struct line_batch {
+    int_t base;
+    int_t line_stride;
+    int_t lane_stride;
+    int_t lanes;
+};
+
+/// the max lines of a batch when the lines are contiguous in memory, they are transposed
+const int_t transposed_lane_size = 16;
+/// the max lines of a batch when the lines are interleaved in memory
+const int_t interleaved_lane_size = 256;
+
+/**
+ * @brief splits a row major shape into batches of lines along the axis
+ *
+ * when the axis is not the last one, the lines of a batch are adjacent in memory, the lanes
+ * could be processed by simd directly. when the axis is the last one, the lines are contiguous
+ * rows, a batch transposes some rows into lanes.
+ */
+template <int_t _Rank>
+class line_batch_partition {
+   public:
+    line_batch_partition(pointi<_Rank> shape, int_t axis) : length_(shape[axis]) {
+        MATAZURE_ASSERT(axis >= 0 && axis < _Rank, "the axis is out of range");
+        outer_ = 1;
+        for (int_t i = 0; i < axis; ++i) outer_ *= shape[i];
+        inner_ = 1;
+        for (int_t i = axis + 1; i < _Rank; ++i) inner_ *= shape[i];
+
+        if (inner_ > 1) {
+            lane_size_ = interleaved_lane_size;
+            chunks_ = (inner_ + lane_size_ - 1) / lane_size_;
+            size_ = outer_ * chunks_;
+        } else {
+            lane_size_ = transposed_lane_size;
+            chunks_ = 1;
+            size_ = (outer_ + lane_size_ - 1) / lane_size_;
+        }
+    }
+
+    /// the length of each line
+    int_t length() const { return length_; }
+
+    /// the max lanes of a batch
+    int_t lane_size() const { return lane_size_; }
+
+    /// the number of batches
+    int_t size() const { return length_ > 0 ? size_ : 0; }
+
+    line_batch operator[](int_t i) const {
+        line_batch re;
+        if (inner_ > 1) {
+            auto o = i / chunks_;
+            auto lane_origin = (i % chunks_) * lane_size_;
+            re.base = o * length_ * inner_ + lane_origin;
+            re.line_stride = inner_;
+            re.lane_stride = 1;
+            re.lanes = std::min(lane_size_, inner_ - lane_origin);
+        } else {
+            auto row_origin = i * lane_size_;
+            re.base = row_origin * length_;
+            re.line_stride = 1;
+            re.lane_stride = length_;
+            re.lanes = std::min(lane_size_, outer_ - row_origin);
+        }
+        return re;
+    }
+
+   private:
+    int_t length_;
+    int_t outer_;
+    int_t inner_;
+    int_t lane_size_;
+    int_t chunks_;
+    int_t size_;
+};
+
+/**
+ * @brief applies a 1-dim filter to all lines along an axis of a dense tensor
+ *
+ * each batch of lines is gathered into an interleaved buffer [padding_before + n +
+ * padding_after][lanes] with the border extrapolated, then fun(buf_in, buf_out, n, lanes) writes
+ * the filtered lines into an interleaved [n][lanes] buffer which is scattered back to ts_dst.
+ * the inner lane loops of fun are contiguous, so they could be vectorized by the compiler.
+ * the batches are distributed by the execution policy, ts_dst could be ts_src itself.
+ */
+template <typename _ExecutionPolicy, typename _TensorSrc, typename _TensorDst, typename _Fun>
+inline void for_each_line_batch(_ExecutionPolicy policy, const _TensorSrc& ts_src,
+                                _TensorDst& ts_dst, int_t axis, int_t padding_before,
+                                int_t padding_after, border_mode mode,
+                                typename _TensorSrc::value_type border_value, _Fun fun) {
+    typedef typename _TensorSrc::value_type value_type;
+    const static int_t rank = _TensorSrc::rank;
+    MATAZURE_STATIC_ASSERT_DIM_MATCHED(_TensorSrc, decay_t<_TensorDst>);
+    static_assert(is_same<layout_t<_TensorSrc>, row_major_layout<rank>>::value &&
+                      is_same<layout_t<decay_t<_TensorDst>>, row_major_layout<rank>>::value,
+                  "only support row major dense tensor");
+    MATAZURE_ASSERT(equal(ts_src.shape(), ts_dst.shape()), "the shapes is not matched");
+
+    line_batch_partition<rank> partition(ts_src.shape(), axis);
+    auto n = partition.length();
+    auto padded_n = padding_before + n + padding_after;
+    auto p_src = ts_src.data();
+    auto p_dst = ts_dst.data();
+
+    for_index(policy, 0, partition.size(), [&](int_t batch_i) {
+        auto batch = partition[batch_i];
+        auto lanes = batch.lanes;
+        std::vector<value_type> buf_in(padded_n * lanes);
+        std::vector<value_type> buf_out(n * lanes);
+
+        for (int_t j = 0; j < padded_n; ++j) {
+            auto i = border_index(j - padding_before, n, mode);
+            auto p_buf = buf_in.data() + j * lanes;
+            if (i < 0) {
+                for (int_t l = 0; l < lanes; ++l) p_buf[l] = border_value;
+            } else {
+                auto p_line = p_src + batch.base + i * batch.line_stride;
+                for (int_t l = 0; l < lanes; ++l) p_buf[l] = p_line[l * batch.lane_stride];
+            }
+        }
+
+        fun(buf_in.data(), buf_out.data(), n, lanes);
+
+        for (int_t i = 0; i < n; ++i) {
+            auto p_buf = buf_out.data() + i * lanes;
+            auto p_line = p_dst + batch.base + i * batch.line_stride;
+            for (int_t l = 0; l < lanes; ++l) p_line[l * batch.lane_stride] = p_buf[l];
+        }
+    });
+}
+
+}  // namespace internal
+
+}  // namespace matazure
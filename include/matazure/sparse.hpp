@@ -0,0 +1,598 @@
+#pragma once
+
+#include <algorithm>
+
+#include <matazure/algorithm.hpp>
+#include <matazure/tensor.hpp>
+
+namespace matazure {
+
+/**
+ * @brief the compressed sparse row(CSR) matrix
+ *
+ * the column indices and the values of the row i are in [row_offsets[i], row_offsets[i + 1]),
+ * the column indices of a row are sorted. the arrays are tensors, so the copy is shallow as the
+ * dense tensor.
+ *
+ * @tparam _ValueType the value type
+ */
+template <typename _ValueType>
+class sparse_matrix {
+   public:
+    const static int_t rank = 2;
+    typedef _ValueType value_type;
+
+    sparse_matrix() : sparse_matrix(pointi<2>{0, 0}, 0) {}
+
+    /// allocates the arrays of nnz elements, the row offsets are zero
+    sparse_matrix(pointi<2> shape, int_t nnz)
+        : sparse_matrix(shape, tensor<int_t, 1>(pointi<1>{shape[0] + 1}),
+                        tensor<int_t, 1>(pointi<1>{nnz}), tensor<value_type, 1>(pointi<1>{nnz})) {
+        fill(row_offsets_, 0);
+    }
+
+    sparse_matrix(pointi<2> shape, tensor<int_t, 1> row_offsets, tensor<int_t, 1> column_indices,
+                  tensor<value_type, 1> values)
+        : shape_(shape),
+          row_offsets_(row_offsets),
+          column_indices_(column_indices),
+          values_(values) {
+        MATAZURE_ASSERT(row_offsets.size() == shape[0] + 1, "the row offsets size is not matched");
+        MATAZURE_ASSERT(column_indices.size() == values.size(), "the nnz is not matched");
+    }
+
+    pointi<2> shape() const { return shape_; }
+    int_t rows() const { return shape_[0]; }
+    int_t cols() const { return shape_[1]; }
+    /// the number of the stored elements
+    int_t nnz() const { return values_.size(); }
+
+    tensor<int_t, 1> row_offsets() const { return row_offsets_; }
+    tensor<int_t, 1> column_indices() const { return column_indices_; }
+    tensor<value_type, 1> values() const { return values_; }
+
+   private:
+    pointi<2> shape_;
+    tensor<int_t, 1> row_offsets_;
+    tensor<int_t, 1> column_indices_;
+    tensor<value_type, 1> values_;
+};
+
+/**
+ * @brief the coordinate(COO) matrix, the triplets of row index, column index and value
+ *
+ * the triplets should be unique, they are sorted by row when it's converted from a
+ * sparse_matrix.
+ */
+template <typename _ValueType>
+class coo_matrix {
+   public:
+    const static int_t rank = 2;
+    typedef _ValueType value_type;
+
+    coo_matrix() : coo_matrix(pointi<2>{0, 0}, 0) {}
+
+    coo_matrix(pointi<2> shape, int_t nnz)
+        : coo_matrix(shape, tensor<int_t, 1>(pointi<1>{nnz}), tensor<int_t, 1>(pointi<1>{nnz}),
+                     tensor<value_type, 1>(pointi<1>{nnz})) {}
+
+    coo_matrix(pointi<2> shape, tensor<int_t, 1> row_indices, tensor<int_t, 1> column_indices,
+               tensor<value_type, 1> values)
+        : shape_(shape),
+          row_indices_(row_indices),
+          column_indices_(column_indices),
+          values_(values) {
+        MATAZURE_ASSERT(row_indices.size() == values.size() &&
+                            column_indices.size() == values.size(),
+                        "the nnz is not matched");
+    }
+
+    pointi<2> shape() const { return shape_; }
+    int_t rows() const { return shape_[0]; }
+    int_t cols() const { return shape_[1]; }
+    int_t nnz() const { return values_.size(); }
+
+    tensor<int_t, 1> row_indices() const { return row_indices_; }
+    tensor<int_t, 1> column_indices() const { return column_indices_; }
+    tensor<value_type, 1> values() const { return values_; }
+
+   private:
+    pointi<2> shape_;
+    tensor<int_t, 1> row_indices_;
+    tensor<int_t, 1> column_indices_;
+    tensor<value_type, 1> values_;
+};
+
+/**
+ * @brief the compressed sparse fiber(CSF) tensor
+ *
+ * it's a tree of _Rank levels, the level l stores the l-th coordinates of the nodes. the children
+ * of the node j of the level l are [pointers(l)[j], pointers(l)[j + 1]) of the level l + 1, the
+ * leaves are the values. the root nodes are all nodes of the level 0, the coordinates of siblings
+ * are sorted.
+ */
+template <typename _ValueType, int_t _Rank>
+class csf_tensor {
+   public:
+    const static int_t rank = _Rank;
+    typedef _ValueType value_type;
+
+    static_assert(_Rank >= 2, "the rank should be not less than 2");
+
+    csf_tensor() : shape_(zero<pointi<rank>>::value()) {
+        for (int_t l = 0; l < rank; ++l) indices_[l] = tensor<int_t, 1>(pointi<1>{0});
+        for (int_t l = 0; l < rank - 1; ++l) pointers_[l] = tensor<int_t, 1>(pointi<1>{1});
+        for (int_t l = 0; l < rank - 1; ++l) pointers_[l][0] = 0;
+    }
+
+    /// allocates the nodes, nodes[l] is the nodes number of the level l
+    csf_tensor(pointi<rank> shape, pointi<rank> nodes) : shape_(shape) {
+        for (int_t l = 0; l < rank; ++l) {
+            indices_[l] = tensor<int_t, 1>(pointi<1>{nodes[l]});
+        }
+        for (int_t l = 0; l < rank - 1; ++l) {
+            pointers_[l] = tensor<int_t, 1>(pointi<1>{nodes[l] + 1});
+        }
+        values_ = tensor<value_type, 1>(pointi<1>{nodes[rank - 1]});
+    }
+
+    pointi<rank> shape() const { return shape_; }
+    int_t nnz() const { return values_.size(); }
+
+    /// the coordinates of the nodes of the level
+    tensor<int_t, 1> indices(int_t level) const { return indices_[level]; }
+    /// the children ranges of the nodes of the level, the level is less than rank - 1
+    tensor<int_t, 1> pointers(int_t level) const { return pointers_[level]; }
+    tensor<value_type, 1> values() const { return values_; }
+
+   private:
+    pointi<rank> shape_;
+    tensor<int_t, 1> indices_[rank];
+    tensor<int_t, 1> pointers_[rank - 1];
+    tensor<value_type, 1> values_;
+};
+
+namespace internal {
+
+/// whether the value is stored, |v| > threshold
+template <typename _ValueType>
+inline bool is_above_threshold(_ValueType v, _ValueType threshold) {
+    return v > threshold || (v < _ValueType(0) && _ValueType(0) - v > threshold);
+}
+
+/// the first position in [first, last) whose value is not less than the value
+MATAZURE_GENERAL inline int_t lower_bound_index(const int_t* p, int_t first, int_t last,
+                                                int_t value) {
+    while (first < last) {
+        auto mid = first + (last - first) / 2;
+        if (p[mid] < value) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+    return first;
+}
+
+/// converts the counts of [1, size] to the exclusive prefix sum in place, p[0] is 0
+inline void exclusive_scan_counts(tensor<int_t, 1> counts) {
+    auto p = counts.data();
+    p[0] = 0;
+    for (int_t i = 1; i < counts.size(); ++i) p[i] += p[i - 1];
+}
+
+/// the nnz of a partition of a sparse product
+const int_t sparse_partition_nnz = 8192;
+
+/**
+ * @brief applies fun(row_begin, row_end) to the row partitions which have the same nnz
+ *
+ * the boundaries are searched in the row offsets, so a few dense rows don't imbalance the
+ * threads as the even row partitions do.
+ */
+template <typename _ExecutionPolicy, typename _Fun>
+inline void for_each_row_partition(_ExecutionPolicy policy, tensor<int_t, 1> row_offsets,
+                                   _Fun fun) {
+    auto rows = row_offsets.size() - 1;
+    auto p_offsets = row_offsets.data();
+    auto work = p_offsets[rows] + rows;
+    auto partitions = std::max<int_t>(1, (work + sparse_partition_nnz - 1) / sparse_partition_nnz);
+    partitions = std::min(partitions, std::max<int_t>(1, rows));
+    // the work of the rows [0, i) is offsets[i] + i, it's monotonic
+    auto partition_boundary = [=](int_t part_i) -> int_t {
+        if (part_i == partitions) return rows;
+        auto target = static_cast<int_t>(static_cast<long long>(work) * part_i / partitions);
+        int_t first = 0, last = rows;
+        while (first < last) {
+            auto mid = first + (last - first) / 2;
+            if (p_offsets[mid] + mid < target) {
+                first = mid + 1;
+            } else {
+                last = mid;
+            }
+        }
+        return first;
+    };
+    for_index(policy, 0, partitions, [=](int_t part_i) {
+        fun(partition_boundary(part_i), partition_boundary(part_i + 1));
+    });
+}
+
+}  // namespace internal
+
+/**
+ * @brief converts a dense matrix to a sparse_matrix, the elements whose |v| > threshold are stored
+ *
+ * the rows are counted and filled in parallel by the policy.
+ *
+ * @param policy the execution policy
+ * @param ts the dense matrix
+ * @param threshold the elements which are not greater than it are dropped
+ */
+template <typename _ExecutionPolicy, typename _Tensor>
+inline sparse_matrix<decay_t<typename _Tensor::value_type>> to_sparse(
+    _ExecutionPolicy policy, const _Tensor& ts,
+    decay_t<typename _Tensor::value_type> threshold = decay_t<typename _Tensor::value_type>(0)) {
+    typedef decay_t<typename _Tensor::value_type> value_type;
+    static_assert(_Tensor::rank == 2, "the rank should be 2");
+
+    auto shape = ts.shape();
+    tensor<int_t, 1> row_offsets(pointi<1>{shape[0] + 1});
+    for_index(policy, 0, shape[0], [=](int_t i) {
+        int_t count = 0;
+        for (int_t j = 0; j < shape[1]; ++j) {
+            count += internal::is_above_threshold<value_type>(ts(pointi<2>{i, j}), threshold);
+        }
+        row_offsets[i + 1] = count;
+    });
+    internal::exclusive_scan_counts(row_offsets);
+
+    auto nnz = row_offsets[shape[0]];
+    tensor<int_t, 1> column_indices(pointi<1>{nnz});
+    tensor<value_type, 1> values(pointi<1>{nnz});
+    for_index(policy, 0, shape[0], [=](int_t i) {
+        auto k = row_offsets[i];
+        for (int_t j = 0; j < shape[1]; ++j) {
+            value_type v = ts(pointi<2>{i, j});
+            if (internal::is_above_threshold(v, threshold)) {
+                column_indices[k] = j;
+                values[k] = v;
+                ++k;
+            }
+        }
+    });
+
+    return sparse_matrix<value_type>(shape, row_offsets, column_indices, values);
+}
+
+template <typename _Tensor>
+inline sparse_matrix<decay_t<typename _Tensor::value_type>> to_sparse(
+    const _Tensor& ts,
+    decay_t<typename _Tensor::value_type> threshold = decay_t<typename _Tensor::value_type>(0)) {
+    return to_sparse(sequence_policy{}, ts, threshold);
+}
+
+/// converts a sparse_matrix to a coo_matrix, the column indices and the values are shared
+template <typename _ExecutionPolicy, typename _ValueType>
+inline coo_matrix<_ValueType> to_coo(_ExecutionPolicy policy, const sparse_matrix<_ValueType>& sp) {
+    tensor<int_t, 1> row_indices(pointi<1>{sp.nnz()});
+    auto row_offsets = sp.row_offsets();
+    for_index(policy, 0, sp.rows(), [=](int_t i) {
+        for (int_t k = row_offsets[i]; k < row_offsets[i + 1]; ++k) row_indices[k] = i;
+    });
+    return coo_matrix<_ValueType>(sp.shape(), row_indices, sp.column_indices(), sp.values());
+}
+
+template <typename _ValueType>
+inline coo_matrix<_ValueType> to_coo(const sparse_matrix<_ValueType>& sp) {
+    return to_coo(sequence_policy{}, sp);
+}
+
+/**
+ * @brief converts a coo_matrix to a sparse_matrix
+ *
+ * the triplets are bucketed by row with a counting sort, then each row is sorted by column in
+ * parallel, so the triplets could be in any order.
+ */
+template <typename _ExecutionPolicy, typename _ValueType>
+inline sparse_matrix<_ValueType> to_csr(_ExecutionPolicy policy,
+                                        const coo_matrix<_ValueType>& coo) {
+    auto rows = coo.rows();
+    auto nnz = coo.nnz();
+    auto row_indices = coo.row_indices();
+    auto coo_column_indices = coo.column_indices();
+    auto coo_values = coo.values();
+
+    tensor<int_t, 1> row_offsets(pointi<1>{rows + 1});
+    fill(row_offsets, 0);
+    for (int_t k = 0; k < nnz; ++k) ++row_offsets[row_indices[k] + 1];
+    internal::exclusive_scan_counts(row_offsets);
+
+    tensor<int_t, 1> column_indices(pointi<1>{nnz});
+    tensor<_ValueType, 1> values(pointi<1>{nnz});
+    tensor<int_t, 1> cursors(pointi<1>{rows});
+    std::copy(row_offsets.data(), row_offsets.data() + rows, cursors.data());
+    for (int_t k = 0; k < nnz; ++k) {
+        auto pos = cursors[row_indices[k]]++;
+        column_indices[pos] = coo_column_indices[k];
+        values[pos] = coo_values[k];
+    }
+
+    for_index(policy, 0, rows, [=](int_t i) {
+        auto first = row_offsets[i];
+        auto last = row_offsets[i + 1];
+        // insertion sort, the rows are short and mostly sorted
+        for (int_t k = first + 1; k < last; ++k) {
+            auto col = column_indices[k];
+            auto v = values[k];
+            auto m = k;
+            for (; m > first && column_indices[m - 1] > col; --m) {
+                column_indices[m] = column_indices[m - 1];
+                values[m] = values[m - 1];
+            }
+            column_indices[m] = col;
+            values[m] = v;
+        }
+    });
+
+    return sparse_matrix<_ValueType>(coo.shape(), row_offsets, column_indices, values);
+}
+
+template <typename _ValueType>
+inline sparse_matrix<_ValueType> to_csr(const coo_matrix<_ValueType>& coo) {
+    return to_csr(sequence_policy{}, coo);
+}
+
+/// converts a sparse_matrix to a dense matrix
+template <typename _ExecutionPolicy, typename _ValueType>
+inline tensor<_ValueType, 2> to_dense(_ExecutionPolicy policy,
+                                      const sparse_matrix<_ValueType>& sp) {
+    tensor<_ValueType, 2> re(sp.shape());
+    auto row_offsets = sp.row_offsets();
+    auto column_indices = sp.column_indices();
+    auto values = sp.values();
+    auto cols = sp.cols();
+    for_index(policy, 0, sp.rows(), [=](int_t i) {
+        auto p_row = re.data() + i * cols;
+        std::fill(p_row, p_row + cols, zero<_ValueType>::value());
+        for (int_t k = row_offsets[i]; k < row_offsets[i + 1]; ++k) {
+            p_row[column_indices[k]] = values[k];
+        }
+    });
+    return re;
+}
+
+template <typename _ValueType>
+inline tensor<_ValueType, 2> to_dense(const sparse_matrix<_ValueType>& sp) {
+    return to_dense(sequence_policy{}, sp);
+}
+
+/// converts a coo_matrix to a dense matrix
+template <typename _ExecutionPolicy, typename _ValueType>
+inline tensor<_ValueType, 2> to_dense(_ExecutionPolicy policy, const coo_matrix<_ValueType>& coo) {
+    tensor<_ValueType, 2> re(coo.shape());
+    fill(policy, re, zero<_ValueType>::value());
+    auto row_indices = coo.row_indices();
+    auto column_indices = coo.column_indices();
+    auto values = coo.values();
+    for_index(policy, 0, coo.nnz(), [=](int_t k) {
+        re(pointi<2>{row_indices[k], column_indices[k]}) = values[k];
+    });
+    return re;
+}
+
+template <typename _ValueType>
+inline tensor<_ValueType, 2> to_dense(const coo_matrix<_ValueType>& coo) {
+    return to_dense(sequence_policy{}, coo);
+}
+
+/**
+ * @brief converts a dense tensor to a csf_tensor, the elements whose |v| > threshold are stored
+ *
+ * the stored elements of each slice of the first axis are gathered in parallel, then the levels
+ * are built by comparing the coordinates of the adjacent elements.
+ */
+template <typename _ExecutionPolicy, typename _Tensor>
+inline csf_tensor<decay_t<typename _Tensor::value_type>, _Tensor::rank> to_csf(
+    _ExecutionPolicy policy, const _Tensor& ts,
+    decay_t<typename _Tensor::value_type> threshold = decay_t<typename _Tensor::value_type>(0)) {
+    typedef decay_t<typename _Tensor::value_type> value_type;
+    const int_t rank = _Tensor::rank;
+
+    auto shape = ts.shape();
+    auto slice_shape = shape;
+    slice_shape[0] = 1;
+    row_major_layout<rank> slice_layout(slice_shape);
+    auto slice_size = slice_layout.size();
+
+    tensor<int_t, 1> slice_offsets(pointi<1>{shape[0] + 1});
+    for_index(policy, 0, shape[0], [=](int_t i) {
+        int_t count = 0;
+        for (int_t j = 0; j < slice_size; ++j) {
+            auto idx = slice_layout.offset2index(j);
+            idx[0] = i;
+            count += internal::is_above_threshold<value_type>(ts(idx), threshold);
+        }
+        slice_offsets[i + 1] = count;
+    });
+    internal::exclusive_scan_counts(slice_offsets);
+
+    auto nnz = slice_offsets[shape[0]];
+    tensor<pointi<rank>, 1> coords(pointi<1>{nnz});
+    tensor<value_type, 1> values(pointi<1>{nnz});
+    for_index(policy, 0, shape[0], [=](int_t i) {
+        auto k = slice_offsets[i];
+        for (int_t j = 0; j < slice_size; ++j) {
+            auto idx = slice_layout.offset2index(j);
+            idx[0] = i;
+            value_type v = ts(idx);
+            if (internal::is_above_threshold(v, threshold)) {
+                coords[k] = idx;
+                values[k] = v;
+                ++k;
+            }
+        }
+    });
+
+    // the element k starts a new node of the level l when its prefix [0, l] differs
+    pointi<rank> nodes = zero<pointi<rank>>::value();
+    for (int_t k = 0; k < nnz; ++k) {
+        bool is_new = (k == 0);
+        for (int_t l = 0; l < rank; ++l) {
+            is_new = is_new || coords[k][l] != coords[k - 1][l];
+            nodes[l] += is_new;
+        }
+    }
+
+    csf_tensor<value_type, rank> re(shape, nodes);
+    tensor<int_t, 1> indices[rank];
+    tensor<int_t, 1> pointers[rank];
+    for (int_t l = 0; l < rank; ++l) {
+        indices[l] = re.indices(l);
+        if (l < rank - 1) pointers[l] = re.pointers(l);
+    }
+
+    pointi<rank> cursors = zero<pointi<rank>>::value();
+    for (int_t k = 0; k < nnz; ++k) {
+        bool is_new = (k == 0);
+        for (int_t l = 0; l < rank; ++l) {
+            is_new = is_new || coords[k][l] != coords[k - 1][l];
+            if (is_new) {
+                indices[l][cursors[l]] = coords[k][l];
+                if (l < rank - 1) pointers[l][cursors[l]] = cursors[l + 1];
+                ++cursors[l];
+            }
+        }
+    }
+    for (int_t l = 0; l < rank - 1; ++l) pointers[l][nodes[l]] = nodes[l + 1];
+    std::copy(values.data(), values.data() + nnz, re.values().data());
+
+    return re;
+}
+
+template <typename _Tensor>
+inline csf_tensor<decay_t<typename _Tensor::value_type>, _Tensor::rank> to_csf(
+    const _Tensor& ts,
+    decay_t<typename _Tensor::value_type> threshold = decay_t<typename _Tensor::value_type>(0)) {
+    return to_csf(sequence_policy{}, ts, threshold);
+}
+
+namespace internal {
+
+template <typename _ValueType, int_t _Rank>
+inline void scatter_csf_node(const csf_tensor<_ValueType, _Rank>& csf, int_t level, int_t node,
+                             pointi<_Rank> idx, tensor<_ValueType, _Rank>& ts) {
+    idx[level] = csf.indices(level)[node];
+    if (level == _Rank - 1) {
+        ts(idx) = csf.values()[node];
+        return;
+    }
+
+    auto pointers = csf.pointers(level);
+    for (int_t child = pointers[node]; child < pointers[node + 1]; ++child) {
+        scatter_csf_node(csf, level + 1, child, idx, ts);
+    }
+}
+
+}  // namespace internal
+
+/// converts a csf_tensor to a dense tensor, the root nodes are distributed by the policy
+template <typename _ExecutionPolicy, typename _ValueType, int_t _Rank>
+inline tensor<_ValueType, _Rank> to_dense(_ExecutionPolicy policy,
+                                          const csf_tensor<_ValueType, _Rank>& csf) {
+    tensor<_ValueType, _Rank> re(csf.shape());
+    fill(policy, re, zero<_ValueType>::value());
+    for_index(policy, 0, csf.indices(0).size(), [=](int_t node) {
+        auto ts = re;
+        internal::scatter_csf_node(csf, 0, node, zero<pointi<_Rank>>::value(), ts);
+    });
+    return re;
+}
+
+template <typename _ValueType, int_t _Rank>
+inline tensor<_ValueType, _Rank> to_dense(const csf_tensor<_ValueType, _Rank>& csf) {
+    return to_dense(sequence_policy{}, csf);
+}
+
+/**
+ * @brief the sparse matrix vector product, y = A * x
+ *
+ * the rows are partitioned by the nnz and the partitions are distributed by the policy, each
+ * element of y is written by one thread only.
+ *
+ * @param policy the execution policy
+ * @param sp the sparse matrix A
+ * @param ts_x the dense vector x, its size is the columns of A
+ * @param ts_y the dense vector y, its size is the rows of A
+ */
+template <typename _ExecutionPolicy, typename _ValueType, typename _VectorX, typename _VectorY>
+inline void spmv(_ExecutionPolicy policy, const sparse_matrix<_ValueType>& sp,
+                 const _VectorX& ts_x, _VectorY&& ts_y) {
+    MATAZURE_ASSERT(ts_x.size() == sp.cols() && ts_y.size() == sp.rows(),
+                    "the shapes is not matched");
+    typedef decay_t<typename decay_t<_VectorY>::value_type> result_type;
+    auto p_offsets = sp.row_offsets().data();
+    auto p_columns = sp.column_indices().data();
+    auto p_values = sp.values().data();
+    internal::for_each_row_partition(policy, sp.row_offsets(), [&](int_t first, int_t last) {
+        for (int_t i = first; i < last; ++i) {
+            auto sum = zero<result_type>::value();
+            for (int_t k = p_offsets[i]; k < p_offsets[i + 1]; ++k) {
+                sum += p_values[k] * ts_x[p_columns[k]];
+            }
+            ts_y[i] = sum;
+        }
+    });
+}
+
+template <typename _ValueType, typename _VectorX, typename _VectorY>
+inline void spmv(const sparse_matrix<_ValueType>& sp, const _VectorX& ts_x, _VectorY&& ts_y) {
+    spmv(sequence_policy{}, sp, ts_x, std::forward<_VectorY>(ts_y));
+}
+
+/**
+ * @brief the sparse dense matrix product, C = A * B
+ *
+ * the rows of B scaled by the stored elements of a row of A are accumulated to the row of C, the
+ * inner loop is contiguous, the rows are partitioned as spmv.
+ *
+ * @param policy the execution policy
+ * @param sp the sparse matrix A
+ * @param ts_b the row major dense matrix B
+ * @param ts_c the row major dense matrix C
+ */
+template <typename _ExecutionPolicy, typename _ValueType, typename _MatrixB, typename _MatrixC>
+inline void spmm(_ExecutionPolicy policy, const sparse_matrix<_ValueType>& sp,
+                 const _MatrixB& ts_b, _MatrixC&& ts_c) {
+    static_assert(is_same<layout_t<_MatrixB>, row_major_layout<2>>::value &&
+                      is_same<layout_t<decay_t<_MatrixC>>, row_major_layout<2>>::value,
+                  "the dense matrices should be row major");
+    MATAZURE_ASSERT(ts_b.shape()[0] == sp.cols() && ts_c.shape()[0] == sp.rows() &&
+                        ts_b.shape()[1] == ts_c.shape()[1],
+                    "the shapes is not matched");
+    typedef decay_t<typename decay_t<_MatrixC>::value_type> result_type;
+    auto n = ts_c.shape()[1];
+    auto p_b = ts_b.data();
+    auto p_c = ts_c.data();
+    auto p_offsets = sp.row_offsets().data();
+    auto p_columns = sp.column_indices().data();
+    auto p_values = sp.values().data();
+    internal::for_each_row_partition(policy, sp.row_offsets(), [&](int_t first, int_t last) {
+        for (int_t i = first; i < last; ++i) {
+            auto p_c_row = p_c + i * n;
+            std::fill(p_c_row, p_c_row + n, zero<result_type>::value());
+            for (int_t k = p_offsets[i]; k < p_offsets[i + 1]; ++k) {
+                auto v = p_values[k];
+                auto p_b_row = p_b + p_columns[k] * n;
+                for (int_t j = 0; j < n; ++j) p_c_row[j] += v * p_b_row[j];
+            }
+        }
+    });
+}
+
+template <typename _ValueType, typename _MatrixB, typename _MatrixC>
+inline void spmm(const sparse_matrix<_ValueType>& sp, const _MatrixB& ts_b, _MatrixC&& ts_c) {
+    spmm(sequence_policy{}, sp, ts_b, std::forward<_MatrixC>(ts_c));
+}
+
+}  // namespace matazure
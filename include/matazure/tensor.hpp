@@ -39,8 +39,9 @@ class tensor_expression {
     tensor_type& operator()() { return *static_cast<tensor_type*>(this); }
 
    protected:
-    MATAZURE_GENERAL tensor_expression() {}
-    MATAZURE_GENERAL ~tensor_expression() {}
+    // defaulted, so the trivially copyable models are kept trivially copyable
+    tensor_expression() = default;
+    ~tensor_expression() = default;
 };
 
 /**
@@ -84,6 +85,18 @@ class tensor : public tensor_expression<tensor<_ValueType, _Rank, _Layout, _Allo
           sp_data_(malloc_shared_memory(layout_.size())),
           data_(sp_data_.get()) {}
 
+    /**
+     * @brief constructs by the shape and the allocator
+     * @param ext the shape of tensor
+     * @param alloc the allocator, for a stateful one such as numa_allocator
+     */
+    explicit tensor(pointi<rank> ext, const allocator_type& alloc)
+        : allocator_(alloc),
+          shape_(ext),
+          layout_(ext),
+          sp_data_(malloc_shared_memory(layout_.size())),
+          data_(sp_data_.get()) {}
+
     /**
      * @brief constructs by the shape
      * @prama ext the packed shape parameters
@@ -128,6 +141,23 @@ class tensor : public tensor_expression<tensor<_ValueType, _Rank, _Layout, _Allo
           sp_data_(ts.shared_data()),
           data_(ts.data()) {}
 
+    /// shallowly copy constructor, shares the memory of ts
+    tensor(const tensor& ts) = default;
+
+    /**
+     * @brief move constructor
+     *
+     * it steals the memory of ts without touching the reference count, ts becomes an empty tensor
+     */
+    tensor(tensor&& ts) noexcept
+        : allocator_(std::move(ts.allocator_)),
+          shape_(ts.shape_),
+          layout_(ts.layout_),
+          sp_data_(std::move(ts.sp_data_)),
+          data_(ts.data_) {
+        ts.reset_empty();
+    }
+
     tensor(typename nested_initializer_list<value_type, rank>::type init)
         : tensor(nested_initializer_list<value_type, rank>::shape(init)) {
         for_index(shape(), [&](pointi<rank> idx) {
@@ -155,6 +185,23 @@ class tensor : public tensor_expression<tensor<_ValueType, _Rank, _Layout, _Allo
         return *this;
     }
 
+    /// shallowly assign operator, shares the memory of ts
+    tensor& operator=(const tensor& ts) = default;
+
+    /// move assign operator, it steals the memory of ts, ts becomes an empty tensor
+    tensor& operator=(tensor&& ts) noexcept {
+        if (this != &ts) {
+            allocator_ = std::move(ts.allocator_);
+            shape_ = ts.shape_;
+            layout_ = ts.layout_;
+            sp_data_ = std::move(ts.sp_data_);
+            data_ = ts.data_;
+            ts.reset_empty();
+        }
+
+        return *this;
+    }
+
     /**
      * @brief accesses element by linear access mode
      * @param i linear index
@@ -212,16 +259,43 @@ class tensor : public tensor_expression<tensor<_ValueType, _Rank, _Layout, _Allo
     allocator_type get_allocator() const { return allocator_; }
 
    private:
+    void reset_empty() {
+        shape_ = zero<pointi<rank>>::value();
+        layout_ = layout_type(shape_);
+        data_ = nullptr;
+    }
+
     shared_ptr<value_type> malloc_shared_memory(int_t size) {
         value_type* data = allocator_.allocate(size);
+        construct_elements(typename allocator_first_touch_policy<allocator_type>::type{}, data,
+                           size);
+        // the deleter owns a copy of the allocator, the memory may outlive this tensor
+        auto alloc = allocator_;
+        return shared_ptr<value_type>(data, [=](value_type* ptr) mutable {
+            for (int_t i = 0; i < size; ++i) {
+                alloc.destroy(data + i);
+            }
+            alloc.deallocate(data, size);
+        });
+    }
+
+    void construct_elements(sequence_policy, value_type* data, int_t size) {
         for (int_t i = 0; i < size; ++i) {
             allocator_.construct(data + i);
         }
-        return shared_ptr<value_type>(data, [=](value_type* ptr) {
-            for (int_t i = 0; i < size; ++i) {
-                allocator_.destroy(data + i);
+    }
+
+    /// first touches by the rows, the same static partition as for_index of the policy on shape
+    template <typename _Policy>
+    void construct_elements(_Policy policy, value_type* data, int_t size) {
+        auto rows = shape_[0];
+        if (rows <= 0 || size % rows != 0) rows = size;
+        auto row_size = rows > 0 ? size / rows : 0;
+        auto& alloc = allocator_;
+        for_index(policy, 0, rows, [=, &alloc](int_t i) {
+            for (int_t j = i * row_size, end = j + row_size; j < end; ++j) {
+                alloc.construct(data + j);
             }
-            allocator_.deallocate(data, size);
         });
     }
 
@@ -239,6 +313,136 @@ auto make_tensor(pointi<_Rank> ext, _Type* p_data) -> tensor<_Type, _Rank, _Layo
     return tensor<_Type, _Rank, _Layout>(ext, sp_data);
 }
 
+/**
+ * @brief a non owning reference of a host tensor, it's only the data pointer and the layout
+ *
+ * it's trivially copyable, copying it doesn't touch the reference count of the tensor, so the
+ * views capture a tensor by it. the referenced tensor should outlive it, as a span.
+ *
+ * @tparam _ValueType the value type of elements, a const one is readable only
+ * @tparam _Rank the rank
+ * @tparam _Layout the memory layout
+ */
+template <typename _ValueType, int_t _Rank, typename _Layout = row_major_layout<_Rank>>
+class tensor_ref : public tensor_expression<tensor_ref<_ValueType, _Rank, _Layout>> {
+   public:
+    static const int_t rank = _Rank;
+    typedef _ValueType value_type;
+    typedef _ValueType& reference;
+    typedef _Layout layout_type;
+    typedef linear_index index_type;
+    typedef host_t runtime_type;
+
+   public:
+    tensor_ref() : data_(nullptr) {}
+
+    tensor_ref(value_type* data, const layout_type& layout) : data_(data), layout_(layout) {}
+
+    /// references a tensor, a tensor_ref<const int, 2> references a tensor<int, 2> too
+    template <typename _VT, typename _Allocator>
+    tensor_ref(const tensor<_VT, rank, layout_type, _Allocator>& ts)
+        : data_(ts.data()), layout_(ts.layout()) {}
+
+    template <typename _VT>
+    tensor_ref(const tensor_ref<_VT, rank, layout_type>& ts)
+        : data_(ts.data()), layout_(ts.layout()) {}
+
+    reference operator[](int_t i) const { return data_[i]; }
+
+    reference operator()(const pointi<rank>& idx) const {
+        return data_[layout_.index2offset(idx)];
+    }
+
+    template <typename... _Idx>
+    reference operator()(_Idx... idx) const {
+        return (*this)(pointi<rank>{idx...});
+    }
+
+    pointi<rank> shape() const { return layout_.shape(); }
+
+    int_t shape(int_t i) const { return shape()[i]; }
+
+    int_t size() const { return layout_.size(); }
+
+    value_type* data() const { return data_; }
+
+    constexpr int_t element_size() const { return sizeof(value_type); }
+
+    layout_type layout() const { return layout_; }
+
+    constexpr runtime_type runtime() const { return runtime_type{}; }
+
+   private:
+    value_type* data_;
+    layout_type layout_;
+};
+
+/// @return the tensor_ref of a tensor, e.g. to capture it in a lambda
+template <typename _ValueType, int_t _Rank, typename _Layout, typename _Allocator>
+inline tensor_ref<_ValueType, _Rank, _Layout> make_tensor_ref(
+    const tensor<_ValueType, _Rank, _Layout, _Allocator>& ts) {
+    return tensor_ref<_ValueType, _Rank, _Layout>(ts);
+}
+
+/// the type a view captures its source tensor by, a host tensor is captured by its tensor_ref
+template <typename _Tensor>
+struct view_capture {
+    typedef _Tensor type;
+};
+
+template <typename _ValueType, int_t _Rank, typename _Layout, typename _Allocator>
+struct view_capture<tensor<_ValueType, _Rank, _Layout, _Allocator>> {
+    typedef tensor_ref<_ValueType, _Rank, _Layout> type;
+};
+
+/**
+ * @brief a host tensor which is passed to a view as an rvalue
+ *
+ * the view captures it by value, so the temporary's memory is owned by the view instead of
+ * being referenced after the temporary is destroyed.
+ */
+template <typename _Tensor>
+class owned_tensor : public _Tensor {
+   public:
+    owned_tensor(const _Tensor& ts) : _Tensor(ts) {}
+};
+
+template <typename _Tensor>
+struct view_capture<owned_tensor<_Tensor>> {
+    typedef _Tensor type;
+};
+
+template <typename _Tensor>
+using view_capture_t = typename view_capture<decay_t<_Tensor>>::type;
+
+/// the source type of a view functor of a forwarded tensor, an rvalue host tensor is owned
+template <typename _Tensor>
+struct view_source {
+    typedef decay_t<_Tensor> type;
+};
+
+template <typename _ValueType, int_t _Rank, typename _Layout, typename _Allocator>
+struct view_source<tensor<_ValueType, _Rank, _Layout, _Allocator>> {
+    typedef owned_tensor<tensor<_ValueType, _Rank, _Layout, _Allocator>> type;
+};
+
+template <typename _ValueType, int_t _Rank, typename _Layout, typename _Allocator>
+struct view_source<tensor<_ValueType, _Rank, _Layout, _Allocator>&&>
+    : view_source<tensor<_ValueType, _Rank, _Layout, _Allocator>> {};
+
+template <typename _Tensor>
+using view_source_t = typename view_source<_Tensor>::type;
+
+/// whether a tensor is a host tensor with memory, e.g. the capture a fast copy of a view reads
+template <typename _Tensor>
+struct is_dense_tensor : bool_constant<false> {};
+
+template <typename _ValueType, int_t _Rank, typename _Layout, typename _Allocator>
+struct is_dense_tensor<tensor<_ValueType, _Rank, _Layout, _Allocator>> : bool_constant<true> {};
+
+template <typename _ValueType, int_t _Rank, typename _Layout>
+struct is_dense_tensor<tensor_ref<_ValueType, _Rank, _Layout>> : bool_constant<true> {};
+
 #ifndef MATAZURE_DISABLE_MATRIX_VECTOR_ALIAS
 template <typename _ValueType, typename _Layout = row_major_layout<1>>
 using vector = tensor<_ValueType, 1, _Layout>;
@@ -0,0 +1,424 @@
+#pragma once
+
+#include <matazure/point.hpp>
+
+/**
+ * opt-in instrumentation of the algorithm entry points, lambda_tensor::persist and the for_index
+ * overloads of every host policy. everything is compiled out unless MATAZURE_TRACE is defined
+ * before the first matazure header, in which case each hooked call records a scoped event into a
+ * buffer owned by the calling thread. the events are exported as Chrome trace_event json
+ * (chrome://tracing, perfetto) or aggregated into a summary table.
+ *
+ * MATAZURE_TRACE must be defined consistently in all translation units of a program, the hooked
+ * functions are inline templates and would otherwise differ between them.
+ */
+#if defined(MATAZURE_TRACE) && !defined(__CUDA_ARCH__)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// records a scoped event until the end of the enclosing block
+#define MATAZURE_TRACE_SCOPE(name, policy, shape, element_size, bytes_read, bytes_written)     \
+    ::matazure::trace::scope matazure_trace_scope_(                                            \
+        name, ::matazure::trace::policy_name<::matazure::decay_t<decltype(policy)>>::value(), \
+        shape, element_size, bytes_read, bytes_written)
+
+namespace matazure {
+
+struct sequence_policy;
+struct omp_policy;
+
+namespace trace {
+
+/// the max rank of the shape stored in an event, higher dims are folded into the last one
+static const int_t max_event_rank = 8;
+
+/// a finished scoped event
+struct event {
+    const char* name;
+    const char* policy;
+    int_t rank;
+    int_t shape[max_event_rank];
+    int_t element_size;
+    int64_t bytes_read;
+    int64_t bytes_written;
+    int_t thread;
+    int64_t begin_ns;
+    int64_t end_ns;
+};
+
+/// the name of an execution policy in the trace, specialize it for custom policies
+template <typename _Policy>
+struct policy_name {
+    static const char* value() { return "custom"; }
+};
+
+template <>
+struct policy_name<sequence_policy> {
+    static const char* value() { return "sequence"; }
+};
+
+template <>
+struct policy_name<omp_policy> {
+    static const char* value() { return "omp"; }
+};
+
+/// monotonic time in nanoseconds
+inline int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/// globally enables or disables recording at runtime, recording is enabled by default
+inline std::atomic<bool>& enabled_flag() {
+    static std::atomic<bool> flag(true);
+    return flag;
+}
+
+inline void set_enabled(bool enabled) { enabled_flag().store(enabled, std::memory_order_relaxed); }
+
+inline bool enabled() { return enabled_flag().load(std::memory_order_relaxed); }
+
+/**
+ * @brief an append only event buffer written by a single thread.
+ *
+ * events live in fixed size blocks, the owner thread publishes each event with a release store of
+ * the block size, so readers on other threads never take a lock and never see a partial event.
+ */
+class thread_buffer {
+   public:
+    static const int_t block_size = 1024;
+
+    explicit thread_buffer(int_t thread) : thread_(thread), tail_(&head_) {}
+
+    ~thread_buffer() { release_blocks(); }
+
+    thread_buffer(const thread_buffer&) = delete;
+    thread_buffer& operator=(const thread_buffer&) = delete;
+
+    int_t thread() const { return thread_; }
+
+    /// appends an event, only called by the owner thread
+    void push(const event& e) {
+        auto size = tail_->size.load(std::memory_order_relaxed);
+        if (size == block_size) {
+            auto p_block = new block;
+            tail_->next.store(p_block, std::memory_order_release);
+            tail_ = p_block;
+            size = 0;
+        }
+
+        tail_->events[size] = e;
+        tail_->size.store(size + 1, std::memory_order_release);
+    }
+
+    /// visits the published events, safe while the owner thread keeps recording
+    template <typename _Fun>
+    void visit(_Fun fun) const {
+        for (auto p_block = &head_; p_block;
+             p_block = p_block->next.load(std::memory_order_acquire)) {
+            auto size = p_block->size.load(std::memory_order_acquire);
+            for (int_t i = 0; i < size; ++i) {
+                fun(p_block->events[i]);
+            }
+        }
+    }
+
+    /// drops all events, the owner thread must not be recording
+    void clear() {
+        release_blocks();
+        head_.size.store(0, std::memory_order_release);
+        tail_ = &head_;
+    }
+
+   private:
+    struct block {
+        block() : size(0), next(nullptr) {}
+
+        std::atomic<int_t> size;
+        std::atomic<block*> next;
+        event events[block_size];
+    };
+
+    void release_blocks() {
+        auto p_block = head_.next.exchange(nullptr, std::memory_order_acq_rel);
+        while (p_block) {
+            auto p_next = p_block->next.load(std::memory_order_relaxed);
+            delete p_block;
+            p_block = p_next;
+        }
+    }
+
+    int_t thread_;
+    block head_;
+    block* tail_;
+};
+
+/// owns the buffers of all threads, they outlive their threads so late exports see every event
+class registry {
+   public:
+    static registry& instance() {
+        static registry reg;
+        return reg;
+    }
+
+    std::shared_ptr<thread_buffer> add() {
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto sp_buffer = std::make_shared<thread_buffer>(static_cast<int_t>(buffers_.size()));
+        buffers_.push_back(sp_buffer);
+        return sp_buffer;
+    }
+
+    std::vector<std::shared_ptr<thread_buffer>> buffers() {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return buffers_;
+    }
+
+   private:
+    std::mutex mtx_;
+    std::vector<std::shared_ptr<thread_buffer>> buffers_;
+};
+
+/// the buffer of the calling thread, registered on first use
+inline thread_buffer& local_buffer() {
+    static thread_local std::shared_ptr<thread_buffer> sp_buffer = registry::instance().add();
+    return *sp_buffer;
+}
+
+/// records an event from construction to destruction
+class scope {
+   public:
+    template <int_t _Rank>
+    scope(const char* name, const char* policy, pointi<_Rank> shape, int_t element_size,
+          int64_t bytes_read, int64_t bytes_written)
+        : active_(enabled()) {
+        if (!active_) return;
+
+        e_.name = name;
+        e_.policy = policy;
+        e_.rank = _Rank < max_event_rank ? _Rank : max_event_rank;
+        for (int_t i = 0; i < _Rank; ++i) {
+            if (i < max_event_rank) {
+                e_.shape[i] = shape[i];
+            } else {
+                e_.shape[max_event_rank - 1] *= shape[i];
+            }
+        }
+        e_.element_size = element_size;
+        e_.bytes_read = bytes_read;
+        e_.bytes_written = bytes_written;
+        e_.thread = 0;
+        e_.end_ns = 0;
+        e_.begin_ns = now_ns();
+    }
+
+    ~scope() {
+        if (!active_) return;
+
+        e_.end_ns = now_ns();
+        auto& buffer = local_buffer();
+        e_.thread = buffer.thread();
+        buffer.push(e_);
+    }
+
+    scope(const scope&) = delete;
+    scope& operator=(const scope&) = delete;
+
+   private:
+    bool active_;
+    event e_;
+};
+
+/// the element size of a tensor in bytes
+template <typename _Tensor>
+inline int_t element_size(const _Tensor&) {
+    return static_cast<int_t>(sizeof(decay_t<typename _Tensor::value_type>));
+}
+
+/// the logical size of a tensor in bytes
+template <typename _Tensor>
+inline int64_t tensor_bytes(const _Tensor& ts) {
+    return static_cast<int64_t>(ts.size()) * element_size(ts);
+}
+
+/// the extent of an index range
+template <int_t _Rank>
+inline pointi<_Rank> extent(pointi<_Rank> origin, pointi<_Rank> end) {
+    pointi<_Rank> re;
+    for (int_t i = 0; i < _Rank; ++i) {
+        re[i] = end[i] - origin[i];
+    }
+    return re;
+}
+
+inline pointi<1> extent(int_t first, int_t last) { return pointi<1>{{last - first}}; }
+
+/// collects the events of all threads sorted by begin time
+inline std::vector<event> collect() {
+    std::vector<event> events;
+    for (auto& sp_buffer : registry::instance().buffers()) {
+        sp_buffer->visit([&events](const event& e) { events.push_back(e); });
+    }
+
+    std::stable_sort(events.begin(), events.end(), [](const event& lhs, const event& rhs) {
+        return lhs.begin_ns < rhs.begin_ns;
+    });
+    return events;
+}
+
+/// drops the recorded events, no thread may be inside a traced call
+inline void clear() {
+    for (auto& sp_buffer : registry::instance().buffers()) {
+        sp_buffer->clear();
+    }
+}
+
+namespace internal {
+
+inline void write_json_string(std::ostream& os, const char* str) {
+    os << '"';
+    for (; *str; ++str) {
+        auto c = *str;
+        if (c == '"' || c == '\\') {
+            os << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int_t(c) << std::dec
+               << std::setfill(' ');
+        } else {
+            os << c;
+        }
+    }
+    os << '"';
+}
+
+inline void write_microseconds(std::ostream& os, int64_t ns) {
+    os << ns / 1000 << '.' << std::setw(3) << std::setfill('0') << ns % 1000
+       << std::setfill(' ');
+}
+
+}  // namespace internal
+
+/**
+ * @brief exports the recorded events as Chrome trace_event json, one complete event per call
+ * @param os the output stream
+ */
+inline void export_chrome_trace(std::ostream& os) {
+    auto events = collect();
+    auto origin = events.empty() ? 0 : events.front().begin_ns;
+
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    for (size_t i = 0; i < events.size(); ++i) {
+        auto& e = events[i];
+        os << (i ? ",\n" : "\n") << "{\"name\":";
+        internal::write_json_string(os, e.name);
+        os << ",\"cat\":";
+        internal::write_json_string(os, e.policy);
+        os << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << e.thread << ",\"ts\":";
+        internal::write_microseconds(os, e.begin_ns - origin);
+        os << ",\"dur\":";
+        internal::write_microseconds(os, e.end_ns - e.begin_ns);
+        os << ",\"args\":{\"shape\":[";
+        for (int_t j = 0; j < e.rank; ++j) {
+            os << (j ? "," : "") << e.shape[j];
+        }
+        os << "],\"element_size\":" << e.element_size << ",\"bytes_read\":" << e.bytes_read
+           << ",\"bytes_written\":" << e.bytes_written << "}}";
+    }
+    os << "\n]}\n";
+}
+
+/**
+ * @brief exports the recorded events as Chrome trace_event json to a file
+ * @param path the output file path
+ */
+inline void export_chrome_trace(const std::string& path) {
+    std::ofstream ofs(path, std::ios::binary);
+    export_chrome_trace(ofs);
+}
+
+/// the aggregated events of one name and policy, the times are inclusive of nested events
+struct summary_row {
+    std::string name;
+    std::string policy;
+    int64_t count;
+    int64_t total_ns;
+    int64_t min_ns;
+    int64_t max_ns;
+    int64_t bytes_read;
+    int64_t bytes_written;
+};
+
+/// aggregates the recorded events by name and policy, sorted by descending total time
+inline std::vector<summary_row> summarize() {
+    std::map<std::pair<std::string, std::string>, summary_row> rows;
+    for (auto& e : collect()) {
+        auto duration = e.end_ns - e.begin_ns;
+        auto it = rows.find(std::make_pair(std::string(e.name), std::string(e.policy)));
+        if (it == rows.end()) {
+            summary_row row{e.name, e.policy, 0, 0, duration, duration, 0, 0};
+            it = rows.insert(std::make_pair(std::make_pair(row.name, row.policy), row)).first;
+        }
+
+        auto& row = it->second;
+        ++row.count;
+        row.total_ns += duration;
+        row.min_ns = std::min(row.min_ns, duration);
+        row.max_ns = std::max(row.max_ns, duration);
+        row.bytes_read += e.bytes_read;
+        row.bytes_written += e.bytes_written;
+    }
+
+    std::vector<summary_row> re;
+    for (auto& item : rows) {
+        re.push_back(item.second);
+    }
+    std::stable_sort(re.begin(), re.end(), [](const summary_row& lhs, const summary_row& rhs) {
+        return lhs.total_ns > rhs.total_ns;
+    });
+    return re;
+}
+
+/**
+ * @brief prints the aggregated events as a table
+ * @param os the output stream
+ */
+inline void print_summary(std::ostream& os) {
+    auto flags = os.flags();
+    os << std::left << std::setw(16) << "name" << std::setw(10) << "policy" << std::right
+       << std::setw(10) << "calls" << std::setw(14) << "total(ms)" << std::setw(12) << "mean(us)"
+       << std::setw(12) << "min(us)" << std::setw(12) << "max(us)" << std::setw(12) << "GB/s"
+       << "\n";
+    os << std::fixed << std::setprecision(3);
+    for (auto& row : summarize()) {
+        auto bytes = static_cast<double>(row.bytes_read + row.bytes_written);
+        os << std::left << std::setw(16) << row.name << std::setw(10) << row.policy << std::right
+           << std::setw(10) << row.count << std::setw(14) << row.total_ns * 1e-6 << std::setw(12)
+           << row.total_ns * 1e-3 / row.count << std::setw(12) << row.min_ns * 1e-3
+           << std::setw(12) << row.max_ns * 1e-3 << std::setw(12)
+           << (row.total_ns > 0 ? bytes / row.total_ns : 0.0) << "\n";
+    }
+    os.flags(flags);
+}
+
+}  // namespace trace
+}  // namespace matazure
+
+#else
+
+// the policy is used to avoid the unused parameter warnings, the other arguments aren't evaluated
+#define MATAZURE_TRACE_SCOPE(name, policy, shape, element_size, bytes_read, bytes_written) \
+    static_cast<void>(policy)
+
+#endif
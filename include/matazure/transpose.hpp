@@ -0,0 +1,232 @@
+#pragma once
+
+#include <matazure/algorithm.hpp>
+#include <matazure/tensor.hpp>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define MATAZURE_TRANSPOSE_SSE
+#endif
+
+namespace matazure {
+
+/// whether the tensor is a dense host tensor of row major layout
+template <typename _Tensor>
+struct is_row_major_tensor : bool_constant<false> {};
+
+template <typename _ValueType, int_t _Rank, typename _Allocator>
+struct is_row_major_tensor<tensor<_ValueType, _Rank, row_major_layout<_Rank>, _Allocator>>
+    : bool_constant<true> {};
+
+template <typename _ValueType, int_t _Rank>
+struct is_row_major_tensor<tensor_ref<_ValueType, _Rank, row_major_layout<_Rank>>>
+    : bool_constant<true> {};
+
+/**
+ * @brief the shape of a permuted tensor
+ *
+ * the element idx of the permuted tensor is the element permute_point<_Idx...>(idx) of the source,
+ * so the axis _Idx[i] of the permuted tensor is the axis i of the source.
+ */
+template <int_t... _Idx>
+MATAZURE_GENERAL inline pointi<sizeof...(_Idx)> permute_shape(pointi<sizeof...(_Idx)> shape) {
+    const int_t indices[] = {_Idx...};
+    pointi<sizeof...(_Idx)> re;
+    for (int_t i = 0; i < static_cast<int_t>(sizeof...(_Idx)); ++i) {
+        re[indices[i]] = shape[i];
+    }
+    return re;
+}
+
+namespace internal {
+
+/// the tile edge of the blocked transpose, a tile of 4 bytes elements fits in the L1 cache
+const int_t transpose_tile_size = 32;
+
+/**
+ * @brief transposes a rows x cols block, dst[c * dst_stride + r] = src[r * src_stride + c]
+ */
+template <typename _ValueType>
+inline void transpose_block(const _ValueType* src, int_t src_stride, _ValueType* dst,
+                            int_t dst_stride, int_t rows, int_t cols) {
+    for (int_t c = 0; c < cols; ++c) {
+        for (int_t r = 0; r < rows; ++r) {
+            dst[c * dst_stride + r] = src[r * src_stride + c];
+        }
+    }
+}
+
+#ifdef MATAZURE_TRANSPOSE_SSE
+/// transposes 4x4 sub blocks of 4 bytes elements in sse registers
+inline void transpose_block_4bytes(const float* src, int_t src_stride, float* dst,
+                                   int_t dst_stride, int_t rows, int_t cols) {
+    auto rows4 = rows & ~3;
+    auto cols4 = cols & ~3;
+    for (int_t r = 0; r < rows4; r += 4) {
+        for (int_t c = 0; c < cols4; c += 4) {
+            auto p_src = src + r * src_stride + c;
+            __m128 row0 = _mm_loadu_ps(p_src);
+            __m128 row1 = _mm_loadu_ps(p_src + src_stride);
+            __m128 row2 = _mm_loadu_ps(p_src + 2 * src_stride);
+            __m128 row3 = _mm_loadu_ps(p_src + 3 * src_stride);
+            _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+            auto p_dst = dst + c * dst_stride + r;
+            _mm_storeu_ps(p_dst, row0);
+            _mm_storeu_ps(p_dst + dst_stride, row1);
+            _mm_storeu_ps(p_dst + 2 * dst_stride, row2);
+            _mm_storeu_ps(p_dst + 3 * dst_stride, row3);
+        }
+    }
+
+    transpose_block(src + cols4, src_stride, dst + cols4 * dst_stride, dst_stride, rows4,
+                    cols - cols4);
+    transpose_block(src + rows4 * src_stride, src_stride, dst + rows4, dst_stride, rows - rows4,
+                    cols);
+}
+
+inline void transpose_block(const float* src, int_t src_stride, float* dst, int_t dst_stride,
+                            int_t rows, int_t cols) {
+    transpose_block_4bytes(src, src_stride, dst, dst_stride, rows, cols);
+}
+
+inline void transpose_block(const int_t* src, int_t src_stride, int_t* dst, int_t dst_stride,
+                            int_t rows, int_t cols) {
+    transpose_block_4bytes(reinterpret_cast<const float*>(src), src_stride,
+                           reinterpret_cast<float*>(dst), dst_stride, rows, cols);
+}
+
+inline void transpose_block(const uint_t* src, int_t src_stride, uint_t* dst, int_t dst_stride,
+                            int_t rows, int_t cols) {
+    transpose_block_4bytes(reinterpret_cast<const float*>(src), src_stride,
+                           reinterpret_cast<float*>(dst), dst_stride, rows, cols);
+}
+#endif
+
+/**
+ * @brief copies a strided tensor to a dense one, dst[sum(idx * dst_stride)] =
+ * src[sum(idx * src_stride)] for all idx in shape
+ *
+ * when the contiguous axes of src and dst differ, the two axes are copied by tiles of
+ * transpose_tile_size, the other axes are batches. the tiles are distributed by the policy.
+ */
+template <typename _ExecutionPolicy, typename _ValueType, int_t _Rank>
+inline void strided_copy(_ExecutionPolicy policy, const _ValueType* src,
+                         pointi<_Rank> src_stride, _ValueType* dst, pointi<_Rank> dst_stride,
+                         pointi<_Rank> shape, int_t src_inner_axis) {
+    const int_t dst_inner_axis = _Rank - 1;
+    int_t batch_size = 1;
+    for (int_t i = 0; i < _Rank; ++i) {
+        if (i != src_inner_axis && i != dst_inner_axis) batch_size *= shape[i];
+    }
+
+    auto batch_offsets = [=](int_t batch_i, int_t& src_offset, int_t& dst_offset) {
+        src_offset = 0;
+        dst_offset = 0;
+        for (int_t i = _Rank - 1; i >= 0; --i) {
+            if (i == src_inner_axis || i == dst_inner_axis) continue;
+            auto id = batch_i % shape[i];
+            batch_i /= shape[i];
+            src_offset += id * src_stride[i];
+            dst_offset += id * dst_stride[i];
+        }
+    };
+
+    if (src_inner_axis == dst_inner_axis) {
+        auto length = shape[dst_inner_axis];
+        for_index(policy, 0, batch_size, [&](int_t batch_i) {
+            int_t src_offset, dst_offset;
+            batch_offsets(batch_i, src_offset, dst_offset);
+            std::copy(src + src_offset, src + src_offset + length, dst + dst_offset);
+        });
+        return;
+    }
+
+    // the tile rows are along the dst inner axis, the tile cols are along the src inner axis
+    auto rows = shape[dst_inner_axis];
+    auto cols = shape[src_inner_axis];
+    auto tile_rows = (rows + transpose_tile_size - 1) / transpose_tile_size;
+    auto tile_cols = (cols + transpose_tile_size - 1) / transpose_tile_size;
+    auto src_row_stride = src_stride[dst_inner_axis];
+    auto dst_col_stride = dst_stride[src_inner_axis];
+
+    for_index(policy, 0, batch_size * tile_rows, [&](int_t task_i) {
+        int_t src_offset, dst_offset;
+        batch_offsets(task_i / tile_rows, src_offset, dst_offset);
+        auto r = (task_i % tile_rows) * transpose_tile_size;
+        auto block_rows = std::min(transpose_tile_size, rows - r);
+        for (int_t tile_c = 0; tile_c < tile_cols; ++tile_c) {
+            auto c = tile_c * transpose_tile_size;
+            auto block_cols = std::min(transpose_tile_size, cols - c);
+            transpose_block(src + src_offset + r * src_row_stride + c, src_row_stride,
+                            dst + dst_offset + c * dst_col_stride + r, dst_col_stride, block_rows,
+                            block_cols);
+        }
+    });
+}
+
+}  // namespace internal
+
+/**
+ * @brief materializes a permuted dense tensor, ts_dst(idx) = ts_src(permute_point<_Idx...>(idx))
+ *
+ * unlike copying view::permute elementwise, which reads the source by large strides, the axes
+ * are copied by cache sized tiles, and the 4 bytes elements are transposed by 4x4 sse blocks.
+ * copy(policy, view::permute<_Idx...>(ts_src), ts_dst) dispatches to it.
+ *
+ * @param policy the execution policy, the tiles are distributed by it
+ * @param ts_src the source dense tensor
+ * @param ts_dst the dest dense tensor, its shape is permute_shape<_Idx...>(ts_src.shape())
+ */
+template <int_t... _Idx, typename _ExecutionPolicy, typename _TensorSrc, typename _TensorDst>
+inline void permute_copy(_ExecutionPolicy policy, const _TensorSrc& ts_src, _TensorDst&& ts_dst) {
+    const static int_t rank = _TensorSrc::rank;
+    static_assert(sizeof...(_Idx) == rank, "the permutation size is not matched");
+    static_assert(is_row_major_tensor<_TensorSrc>::value &&
+                      is_row_major_tensor<decay_t<_TensorDst>>::value,
+                  "only support row major dense tensor");
+    MATAZURE_ASSERT(equal(permute_shape<_Idx...>(ts_src.shape()), ts_dst.shape()),
+                    "the dest shape is not the permuted shape");
+
+    const int_t indices[] = {_Idx...};
+    auto src_layout_stride = ts_src.layout().stride();
+    auto dst_layout_stride = ts_dst.layout().stride();
+    // the stride of the axis i is the element count of the axes after it
+    pointi<rank> src_stride;
+    pointi<rank> dst_stride;
+    for (int_t i = 0; i < rank; ++i) {
+        auto src_i_stride = i + 1 < rank ? src_layout_stride[i + 1] : 1;
+        src_stride[indices[i]] = src_i_stride;
+        dst_stride[i] = i + 1 < rank ? dst_layout_stride[i + 1] : 1;
+    }
+
+    internal::strided_copy(policy, ts_src.data(), src_stride, ts_dst.data(), dst_stride,
+                           ts_dst.shape(), indices[rank - 1]);
+}
+
+/// materializes a permuted dense tensor by the sequence policy
+template <int_t... _Idx, typename _TensorSrc, typename _TensorDst>
+inline void permute_copy(const _TensorSrc& ts_src, _TensorDst&& ts_dst,
+                         enable_if_t<is_tensor<_TensorSrc>::value>* = 0) {
+    sequence_policy policy{};
+    permute_copy<_Idx...>(policy, ts_src, std::forward<_TensorDst>(ts_dst));
+}
+
+/**
+ * @brief transposes a dense matrix by the blocked transpose
+ * @see permute_copy
+ */
+template <typename _ExecutionPolicy, typename _TensorSrc, typename _TensorDst>
+inline void transpose(_ExecutionPolicy policy, const _TensorSrc& ts_src, _TensorDst&& ts_dst) {
+    MATAZURE_STATIC_ASSERT_MATRIX_RANK(_TensorSrc);
+    permute_copy<1, 0>(policy, ts_src, std::forward<_TensorDst>(ts_dst));
+}
+
+/// transposes a dense matrix by the sequence policy
+template <typename _TensorSrc, typename _TensorDst>
+inline void transpose(const _TensorSrc& ts_src, _TensorDst&& ts_dst,
+                      enable_if_t<is_tensor<_TensorSrc>::value>* = 0) {
+    sequence_policy policy{};
+    transpose(policy, ts_src, std::forward<_TensorDst>(ts_dst));
+}
+
+}  // namespace matazure
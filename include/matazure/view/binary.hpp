@@ -10,15 +10,22 @@ struct binary_functor {
     _Fun fun;
 
     MATAZURE_GENERAL bool operator()(_ValueType v) const { return fun(v); }
+
+    /// whether the predicate may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(fun, first, last);
+    }
 };
 
 template <typename _Tensor, typename _Fun>
-inline auto binary(_Tensor tensor, _Fun fun)
-    -> decltype(map(tensor, binary_functor<typename _Tensor::value_type, _Fun>{fun})) {
+inline auto binary(_Tensor&& tensor, _Fun fun)
+    -> decltype(map(std::forward<_Tensor>(tensor),
+                    binary_functor<typename decay_t<_Tensor>::value_type, _Fun>{fun})) {
     static_assert(is_same<bool, typename function_traits<_Fun>::result_type>::value,
                   "_Fun result type should be bool");
 
-    return map(tensor, binary_functor<typename _Tensor::value_type, _Fun>{fun});
+    return map(std::forward<_Tensor>(tensor),
+               binary_functor<typename decay_t<_Tensor>::value_type, _Fun>{fun});
 }
 
 }  // namespace view
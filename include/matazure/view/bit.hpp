@@ -0,0 +1,678 @@
+#pragma once
+
+#include <cstdint>
+
+#include <matazure/view/map.hpp>
+#include <matazure/view/mask.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MATAZURE_BIT_SSE2
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MATAZURE_BIT_AVX2
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace matazure {
+
+namespace internal {
+
+/// the number of the set bits, it's popcnt when it's enabled
+inline int_t popcount64(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<int_t>(__popcnt64(x));
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<int_t>((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+/// the number of the trailing zero bits of a nonzero x, it's tzcnt when BMI is enabled
+inline int_t count_trailing_zeros64(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long re;
+    _BitScanForward64(&re, x);
+    return static_cast<int_t>(re);
+#else
+    int_t re = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        ++re;
+    }
+    return re;
+#endif
+}
+
+}  // namespace internal
+
+/**
+ * @brief the proxy reference of a bit of bit_tensor
+ *
+ * the assignment is a read-modify-write of the word, so the writes of the bits of a same word
+ * should not be concurrent, the algorithms of bit_tensor process the words instead.
+ */
+class bit_reference {
+   public:
+    bit_reference(std::uint64_t* p_word, std::uint64_t mask) : p_word_(p_word), mask_(mask) {}
+
+    operator bool() const { return (*p_word_ & mask_) != 0; }
+
+    bit_reference& operator=(bool v) {
+        if (v) {
+            *p_word_ |= mask_;
+        } else {
+            *p_word_ &= ~mask_;
+        }
+        return *this;
+    }
+
+    bit_reference& operator=(const bit_reference& rhs) { return *this = static_cast<bool>(rhs); }
+
+    void flip() { *p_word_ ^= mask_; }
+
+   private:
+    std::uint64_t* p_word_;
+    std::uint64_t mask_;
+};
+
+/**
+ * @brief the bit packed bool tensor, 64 elements are stored in a word
+ *
+ * the elements are in row major order, the element i is the bit i % 64 of the word i / 64, the
+ * bits after the size in the last word are always zero. the copy is shallow as tensor.
+ */
+template <int_t _Rank>
+class bit_tensor : public tensor_expression<bit_tensor<_Rank>> {
+   public:
+    static const int_t rank = _Rank;
+    static const int_t word_bits = 64;
+    typedef bool value_type;
+    typedef bit_reference reference;
+    typedef row_major_layout<_Rank> layout_type;
+    typedef linear_index index_type;
+    typedef host_t runtime_type;
+
+    bit_tensor() : bit_tensor(zero<pointi<rank>>::value()) {}
+
+    /// constructs a bit_tensor whose elements are false
+    explicit bit_tensor(pointi<rank> shape)
+        : shape_(shape),
+          layout_(shape),
+          words_(pointi<1>{(layout_.size() + word_bits - 1) / word_bits}) {
+        std::fill(words_.data(), words_.data() + words_.size(), std::uint64_t(0));
+    }
+
+    reference operator[](int_t i) const {
+        return reference(words_.data() + i / word_bits, std::uint64_t(1) << (i % word_bits));
+    }
+
+    reference operator()(const pointi<rank>& idx) const {
+        return (*this)[layout_.index2offset(idx)];
+    }
+
+    pointi<rank> shape() const { return shape_; }
+    int_t size() const { return layout_.size(); }
+    layout_type layout() const { return layout_; }
+
+    /// the words, the last one is partial when the size is not a multiple of 64
+    tensor<std::uint64_t, 1> words() const { return words_; }
+    int_t word_count() const { return words_.size(); }
+    std::uint64_t* data() const { return words_.data(); }
+
+    /// the valid bits of the word i
+    std::uint64_t word_mask(int_t i) const {
+        auto tail = size() - i * word_bits;
+        return tail >= word_bits ? ~std::uint64_t(0) : (std::uint64_t(1) << tail) - 1;
+    }
+
+   private:
+    pointi<rank> shape_;
+    layout_type layout_;
+    tensor<std::uint64_t, 1> words_;
+};
+
+namespace internal {
+
+/// applies fun(lhs_word, rhs_word) to the words of the bit tensors, the tail bits are cleared
+template <typename _ExecutionPolicy, int_t _Rank, typename _Fun>
+inline void transform_words(_ExecutionPolicy policy, const bit_tensor<_Rank>& ts_lhs,
+                            const bit_tensor<_Rank>& ts_rhs, bit_tensor<_Rank>& ts_dst, _Fun fun) {
+    MATAZURE_ASSERT(equal(ts_lhs.shape(), ts_rhs.shape()) &&
+                        equal(ts_lhs.shape(), ts_dst.shape()),
+                    "the shapes is not matched");
+    auto p_lhs = ts_lhs.data();
+    auto p_rhs = ts_rhs.data();
+    auto p_dst = ts_dst.data();
+    auto word_count = ts_dst.word_count();
+    for_index(policy, 0, word_count, [=](int_t i) { p_dst[i] = fun(p_lhs[i], p_rhs[i]); });
+    if (word_count > 0) p_dst[word_count - 1] &= ts_dst.word_mask(word_count - 1);
+}
+
+struct bit_and_op {
+    std::uint64_t operator()(std::uint64_t lhs, std::uint64_t rhs) const { return lhs & rhs; }
+};
+
+struct bit_or_op {
+    std::uint64_t operator()(std::uint64_t lhs, std::uint64_t rhs) const { return lhs | rhs; }
+};
+
+struct bit_xor_op {
+    std::uint64_t operator()(std::uint64_t lhs, std::uint64_t rhs) const { return lhs ^ rhs; }
+};
+
+struct bit_not_op {
+    std::uint64_t operator()(std::uint64_t lhs, std::uint64_t) const { return ~lhs; }
+};
+
+}  // namespace internal
+
+/**
+ * @brief the word parallel and of two bit tensors
+ * @param policy the execution policy
+ * @param ts_lhs the lhs bit tensor
+ * @param ts_rhs the rhs bit tensor
+ * @param ts_dst the dest bit tensor, could be ts_lhs or ts_rhs
+ */
+template <typename _ExecutionPolicy, int_t _Rank>
+inline void bit_and(_ExecutionPolicy policy, const bit_tensor<_Rank>& ts_lhs,
+                    const bit_tensor<_Rank>& ts_rhs, bit_tensor<_Rank>& ts_dst) {
+    internal::transform_words(policy, ts_lhs, ts_rhs, ts_dst, internal::bit_and_op{});
+}
+
+/// the word parallel or of two bit tensors, @see bit_and
+template <typename _ExecutionPolicy, int_t _Rank>
+inline void bit_or(_ExecutionPolicy policy, const bit_tensor<_Rank>& ts_lhs,
+                   const bit_tensor<_Rank>& ts_rhs, bit_tensor<_Rank>& ts_dst) {
+    internal::transform_words(policy, ts_lhs, ts_rhs, ts_dst, internal::bit_or_op{});
+}
+
+/// the word parallel xor of two bit tensors, @see bit_and
+template <typename _ExecutionPolicy, int_t _Rank>
+inline void bit_xor(_ExecutionPolicy policy, const bit_tensor<_Rank>& ts_lhs,
+                    const bit_tensor<_Rank>& ts_rhs, bit_tensor<_Rank>& ts_dst) {
+    internal::transform_words(policy, ts_lhs, ts_rhs, ts_dst, internal::bit_xor_op{});
+}
+
+/// the word parallel not of a bit tensor, the bits after the size are kept zero
+template <typename _ExecutionPolicy, int_t _Rank>
+inline void bit_not(_ExecutionPolicy policy, const bit_tensor<_Rank>& ts_src,
+                    bit_tensor<_Rank>& ts_dst) {
+    internal::transform_words(policy, ts_src, ts_src, ts_dst, internal::bit_not_op{});
+}
+
+template <int_t _Rank>
+inline bit_tensor<_Rank> operator&(const bit_tensor<_Rank>& ts_lhs,
+                                   const bit_tensor<_Rank>& ts_rhs) {
+    bit_tensor<_Rank> re(ts_lhs.shape());
+    bit_and(sequence_policy{}, ts_lhs, ts_rhs, re);
+    return re;
+}
+
+template <int_t _Rank>
+inline bit_tensor<_Rank> operator|(const bit_tensor<_Rank>& ts_lhs,
+                                   const bit_tensor<_Rank>& ts_rhs) {
+    bit_tensor<_Rank> re(ts_lhs.shape());
+    bit_or(sequence_policy{}, ts_lhs, ts_rhs, re);
+    return re;
+}
+
+template <int_t _Rank>
+inline bit_tensor<_Rank> operator^(const bit_tensor<_Rank>& ts_lhs,
+                                   const bit_tensor<_Rank>& ts_rhs) {
+    bit_tensor<_Rank> re(ts_lhs.shape());
+    bit_xor(sequence_policy{}, ts_lhs, ts_rhs, re);
+    return re;
+}
+
+template <int_t _Rank>
+inline bit_tensor<_Rank> operator~(const bit_tensor<_Rank>& ts) {
+    bit_tensor<_Rank> re(ts.shape());
+    bit_not(sequence_policy{}, ts, re);
+    return re;
+}
+
+/// the number of the true elements, it's the popcount of the words
+template <typename _ExecutionPolicy, int_t _Rank>
+inline int_t count(_ExecutionPolicy policy, const bit_tensor<_Rank>& ts) {
+    auto p_words = ts.data();
+    auto word_count = ts.word_count();
+    const int_t words_per_task = 1024;
+    auto tasks = (word_count + words_per_task - 1) / words_per_task;
+    tensor<int_t, 1> task_counts(pointi<1>{tasks});
+    for_index(policy, 0, tasks, [=](int_t task_i) {
+        auto last = std::min(word_count, (task_i + 1) * words_per_task);
+        int_t re = 0;
+        for (int_t i = task_i * words_per_task; i < last; ++i) {
+            re += internal::popcount64(p_words[i]);
+        }
+        task_counts[task_i] = re;
+    });
+
+    int_t re = 0;
+    for (int_t i = 0; i < tasks; ++i) re += task_counts[i];
+    return re;
+}
+
+template <int_t _Rank>
+inline int_t count(const bit_tensor<_Rank>& ts) {
+    return count(sequence_policy{}, ts);
+}
+
+/// whether any element is true, it stops at the first nonzero word
+template <int_t _Rank>
+inline bool any(const bit_tensor<_Rank>& ts) {
+    auto p_words = ts.data();
+    for (int_t i = 0; i < ts.word_count(); ++i) {
+        if (p_words[i]) return true;
+    }
+    return false;
+}
+
+/// whether all elements are true, it stops at the first word which has a zero bit
+template <int_t _Rank>
+inline bool all(const bit_tensor<_Rank>& ts) {
+    auto p_words = ts.data();
+    for (int_t i = 0; i < ts.word_count(); ++i) {
+        if (p_words[i] != ts.word_mask(i)) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief applies fun to the row major offset of each true element
+ *
+ * the set bits of a word are iterated by tzcnt and clearing the lowest set bit, so the false
+ * elements are skipped by words. the words are distributed by the policy.
+ *
+ * @param fun the functor, (int_t offset) -> none pattern
+ */
+template <typename _ExecutionPolicy, int_t _Rank, typename _Fun>
+inline void for_each_set_bit(_ExecutionPolicy policy, const bit_tensor<_Rank>& ts, _Fun fun) {
+    auto p_words = ts.data();
+    for_index(policy, 0, ts.word_count(), [&](int_t i) {
+        auto word = p_words[i];
+        while (word) {
+            fun(i * bit_tensor<_Rank>::word_bits + internal::count_trailing_zeros64(word));
+            word &= word - 1;
+        }
+    });
+}
+
+template <int_t _Rank, typename _Fun>
+inline void for_each_set_bit(const bit_tensor<_Rank>& ts, _Fun fun) {
+    for_each_set_bit(sequence_policy{}, ts, fun);
+}
+
+/**
+ * @brief packs the bool values of a tensor to a bit tensor
+ *
+ * each word is packed by one task, so it's safe to be parallel.
+ */
+template <typename _ExecutionPolicy, typename _TensorSrc, int_t _Rank>
+inline void copy(_ExecutionPolicy policy, const _TensorSrc& ts_src, bit_tensor<_Rank>& ts_dst) {
+    MATAZURE_ASSERT(equal(ts_src.shape(), ts_dst.shape()), "the shapes is not matched");
+    auto layout = ts_dst.layout();
+    auto size = ts_dst.size();
+    auto p_words = ts_dst.data();
+    const int_t word_bits = bit_tensor<_Rank>::word_bits;
+    for_index(policy, 0, ts_dst.word_count(), [&](int_t i) {
+        auto first = i * word_bits;
+        auto bits_size = std::min(word_bits, size - first);
+        std::uint64_t word = 0;
+        for (int_t b = 0; b < bits_size; ++b) {
+            bool v = internal::masked_element(ts_src, first + b, layout);
+            word |= std::uint64_t(v) << b;
+        }
+        p_words[i] = word;
+    });
+}
+
+/// copies the words of a bit tensor
+template <typename _ExecutionPolicy, int_t _Rank>
+inline void copy(_ExecutionPolicy policy, const bit_tensor<_Rank>& ts_src,
+                 bit_tensor<_Rank>& ts_dst) {
+    MATAZURE_ASSERT(equal(ts_src.shape(), ts_dst.shape()), "the shapes is not matched");
+    auto p_src = ts_src.data();
+    auto p_dst = ts_dst.data();
+    for_index(policy, 0, ts_dst.word_count(), [=](int_t i) { p_dst[i] = p_src[i]; });
+}
+
+/// packs a bool tensor(or a comparison view) to a new bit tensor
+template <typename _ExecutionPolicy, typename _Tensor>
+inline bit_tensor<_Tensor::rank> to_bit_tensor(_ExecutionPolicy policy, const _Tensor& ts) {
+    bit_tensor<_Tensor::rank> re(ts.shape());
+    copy(policy, ts, re);
+    return re;
+}
+
+template <typename _Tensor>
+inline bit_tensor<_Tensor::rank> to_bit_tensor(const _Tensor& ts) {
+    return to_bit_tensor(sequence_policy{}, ts);
+}
+
+namespace internal {
+
+/// the comparison kinds, the simd kernels are selected by them
+enum compare_kind { compare_gt, compare_lt, compare_ge, compare_le, compare_eq, compare_ne };
+
+struct greater_op {
+    static const int_t kind = compare_gt;
+    template <typename _ValueType>
+    MATAZURE_GENERAL bool operator()(const _ValueType& lhs, const _ValueType& rhs) const {
+        return lhs > rhs;
+    }
+};
+
+struct less_op {
+    static const int_t kind = compare_lt;
+    template <typename _ValueType>
+    MATAZURE_GENERAL bool operator()(const _ValueType& lhs, const _ValueType& rhs) const {
+        return lhs < rhs;
+    }
+};
+
+struct greater_equal_op {
+    static const int_t kind = compare_ge;
+    template <typename _ValueType>
+    MATAZURE_GENERAL bool operator()(const _ValueType& lhs, const _ValueType& rhs) const {
+        return lhs >= rhs;
+    }
+};
+
+struct less_equal_op {
+    static const int_t kind = compare_le;
+    template <typename _ValueType>
+    MATAZURE_GENERAL bool operator()(const _ValueType& lhs, const _ValueType& rhs) const {
+        return lhs <= rhs;
+    }
+};
+
+struct equal_to_op {
+    static const int_t kind = compare_eq;
+    template <typename _ValueType>
+    MATAZURE_GENERAL bool operator()(const _ValueType& lhs, const _ValueType& rhs) const {
+        return lhs == rhs;
+    }
+};
+
+struct not_equal_to_op {
+    static const int_t kind = compare_ne;
+    template <typename _ValueType>
+    MATAZURE_GENERAL bool operator()(const _ValueType& lhs, const _ValueType& rhs) const {
+        return lhs != rhs;
+    }
+};
+
+#ifdef MATAZURE_BIT_AVX2
+
+/// the float comparison, the predicates are ordered except !=, as the c++ operators
+template <int_t _Kind>
+inline int_t compare_mask(__m256 lhs, __m256 rhs) {
+    switch (_Kind) {
+        case compare_gt:
+            return _mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_GT_OQ));
+        case compare_lt:
+            return _mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_LT_OQ));
+        case compare_ge:
+            return _mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_GE_OQ));
+        case compare_le:
+            return _mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_LE_OQ));
+        case compare_eq:
+            return _mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_EQ_OQ));
+        default:
+            return _mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_NEQ_UQ));
+    }
+}
+
+/// the int comparison, >=, <= and != are the negations of <, > and ==
+template <int_t _Kind>
+inline int_t compare_mask(__m256i lhs, __m256i rhs) {
+    __m256i re;
+    switch (_Kind) {
+        case compare_gt:
+        case compare_le:
+            re = _mm256_cmpgt_epi32(lhs, rhs);
+            break;
+        case compare_lt:
+        case compare_ge:
+            re = _mm256_cmpgt_epi32(rhs, lhs);
+            break;
+        default:
+            re = _mm256_cmpeq_epi32(lhs, rhs);
+            break;
+    }
+    auto mask = _mm256_movemask_ps(_mm256_castsi256_ps(re));
+    bool is_negated = _Kind == compare_le || _Kind == compare_ge || _Kind == compare_ne;
+    return is_negated ? ~mask & 0xff : mask;
+}
+
+#elif defined(MATAZURE_BIT_SSE2)
+
+template <int_t _Kind>
+inline int_t compare_mask(__m128 lhs, __m128 rhs) {
+    switch (_Kind) {
+        case compare_gt:
+            return _mm_movemask_ps(_mm_cmpgt_ps(lhs, rhs));
+        case compare_lt:
+            return _mm_movemask_ps(_mm_cmplt_ps(lhs, rhs));
+        case compare_ge:
+            return _mm_movemask_ps(_mm_cmpge_ps(lhs, rhs));
+        case compare_le:
+            return _mm_movemask_ps(_mm_cmple_ps(lhs, rhs));
+        case compare_eq:
+            return _mm_movemask_ps(_mm_cmpeq_ps(lhs, rhs));
+        default:
+            return _mm_movemask_ps(_mm_cmpneq_ps(lhs, rhs));
+    }
+}
+
+template <int_t _Kind>
+inline int_t compare_mask(__m128i lhs, __m128i rhs) {
+    __m128i re;
+    switch (_Kind) {
+        case compare_gt:
+        case compare_le:
+            re = _mm_cmpgt_epi32(lhs, rhs);
+            break;
+        case compare_lt:
+        case compare_ge:
+            re = _mm_cmplt_epi32(lhs, rhs);
+            break;
+        default:
+            re = _mm_cmpeq_epi32(lhs, rhs);
+            break;
+    }
+    auto mask = _mm_movemask_ps(_mm_castsi128_ps(re));
+    bool is_negated = _Kind == compare_le || _Kind == compare_ge || _Kind == compare_ne;
+    return is_negated ? ~mask & 0xf : mask;
+}
+
+#endif
+
+/// compares size(<= 64) values with v, the result bit i is op(p[i], v)
+template <typename _Op, typename _ValueType>
+inline std::uint64_t compare_word(_Op op, const _ValueType* p, _ValueType v, int_t size) {
+    std::uint64_t re = 0;
+    for (int_t i = 0; i < size; ++i) re |= std::uint64_t(op(p[i], v)) << i;
+    return re;
+}
+
+template <typename _Op>
+inline std::uint64_t compare_word(_Op op, const float* p, float v, int_t size) {
+    std::uint64_t re = 0;
+    int_t i = 0;
+#if defined(MATAZURE_BIT_AVX2)
+    auto vv = _mm256_set1_ps(v);
+    for (; i + 8 <= size; i += 8) {
+        auto mask = compare_mask<_Op::kind>(_mm256_loadu_ps(p + i), vv);
+        re |= std::uint64_t(mask) << i;
+    }
+#elif defined(MATAZURE_BIT_SSE2)
+    auto vv = _mm_set1_ps(v);
+    for (; i + 4 <= size; i += 4) {
+        re |= std::uint64_t(compare_mask<_Op::kind>(_mm_loadu_ps(p + i), vv)) << i;
+    }
+#endif
+    for (; i < size; ++i) re |= std::uint64_t(op(p[i], v)) << i;
+    return re;
+}
+
+template <typename _Op>
+inline std::uint64_t compare_word(_Op op, const int_t* p, int_t v, int_t size) {
+    std::uint64_t re = 0;
+    int_t i = 0;
+#if defined(MATAZURE_BIT_AVX2)
+    auto vv = _mm256_set1_epi32(v);
+    for (; i + 8 <= size; i += 8) {
+        auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        re |= std::uint64_t(compare_mask<_Op::kind>(x, vv)) << i;
+    }
+#elif defined(MATAZURE_BIT_SSE2)
+    auto vv = _mm_set1_epi32(v);
+    for (; i + 4 <= size; i += 4) {
+        auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        re |= std::uint64_t(compare_mask<_Op::kind>(x, vv)) << i;
+    }
+#endif
+    for (; i < size; ++i) re |= std::uint64_t(op(p[i], v)) << i;
+    return re;
+}
+
+}  // namespace internal
+
+namespace view {
+
+template <typename _Op, typename _ValueType>
+struct compare_functor {
+   private:
+    _ValueType v_;
+
+   public:
+    compare_functor(_ValueType v) : v_(v) {}
+
+    MATAZURE_GENERAL bool operator()(const _ValueType& x) const { return _Op{}(x, v_); }
+
+    /// the compared value
+    MATAZURE_GENERAL _ValueType value() const { return v_; }
+
+    /// the compared value is held by value, it reads no memory
+    bool may_alias(const void*, const void*) const { return false; }
+};
+
+/**
+ * @brief the elementwise ts > v view of bool
+ *
+ * packing the comparison view of a dense float or int tensor to a bit_tensor by copy or
+ * to_bit_tensor compares the elements by simd and packs the masks by movemask.
+ */
+template <typename _Tensor>
+inline auto greater(_Tensor&& ts, decay_t<typename decay_t<_Tensor>::value_type> v)
+    -> decltype(map(std::forward<_Tensor>(ts),
+                    compare_functor<matazure::internal::greater_op,
+                                    decay_t<typename decay_t<_Tensor>::value_type>>(v))) {
+    return map(std::forward<_Tensor>(ts),
+               compare_functor<matazure::internal::greater_op,
+                               decay_t<typename decay_t<_Tensor>::value_type>>(v));
+}
+
+/// the elementwise ts < v view, @see greater
+template <typename _Tensor>
+inline auto less(_Tensor&& ts, decay_t<typename decay_t<_Tensor>::value_type> v)
+    -> decltype(map(std::forward<_Tensor>(ts),
+                    compare_functor<matazure::internal::less_op,
+                                    decay_t<typename decay_t<_Tensor>::value_type>>(v))) {
+    return map(std::forward<_Tensor>(ts),
+               compare_functor<matazure::internal::less_op,
+                               decay_t<typename decay_t<_Tensor>::value_type>>(v));
+}
+
+/// the elementwise ts >= v view, @see greater
+template <typename _Tensor>
+inline auto greater_equal(_Tensor&& ts, decay_t<typename decay_t<_Tensor>::value_type> v)
+    -> decltype(map(std::forward<_Tensor>(ts),
+                    compare_functor<matazure::internal::greater_equal_op,
+                                    decay_t<typename decay_t<_Tensor>::value_type>>(v))) {
+    return map(std::forward<_Tensor>(ts),
+               compare_functor<matazure::internal::greater_equal_op,
+                               decay_t<typename decay_t<_Tensor>::value_type>>(v));
+}
+
+/// the elementwise ts <= v view, @see greater
+template <typename _Tensor>
+inline auto less_equal(_Tensor&& ts, decay_t<typename decay_t<_Tensor>::value_type> v)
+    -> decltype(map(std::forward<_Tensor>(ts),
+                    compare_functor<matazure::internal::less_equal_op,
+                                    decay_t<typename decay_t<_Tensor>::value_type>>(v))) {
+    return map(std::forward<_Tensor>(ts),
+               compare_functor<matazure::internal::less_equal_op,
+                               decay_t<typename decay_t<_Tensor>::value_type>>(v));
+}
+
+/// the elementwise ts == v view, @see greater
+template <typename _Tensor>
+inline auto equal_to(_Tensor&& ts, decay_t<typename decay_t<_Tensor>::value_type> v)
+    -> decltype(map(std::forward<_Tensor>(ts),
+                    compare_functor<matazure::internal::equal_to_op,
+                                    decay_t<typename decay_t<_Tensor>::value_type>>(v))) {
+    return map(std::forward<_Tensor>(ts),
+               compare_functor<matazure::internal::equal_to_op,
+                               decay_t<typename decay_t<_Tensor>::value_type>>(v));
+}
+
+/// the elementwise ts != v view, @see greater
+template <typename _Tensor>
+inline auto not_equal_to(_Tensor&& ts, decay_t<typename decay_t<_Tensor>::value_type> v)
+    -> decltype(map(std::forward<_Tensor>(ts),
+                    compare_functor<matazure::internal::not_equal_to_op,
+                                    decay_t<typename decay_t<_Tensor>::value_type>>(v))) {
+    return map(std::forward<_Tensor>(ts),
+               compare_functor<matazure::internal::not_equal_to_op,
+                               decay_t<typename decay_t<_Tensor>::value_type>>(v));
+}
+
+}  // namespace view
+
+/**
+ * @brief packs a comparison view of a dense row major tensor to a bit tensor by simd
+ *
+ * a word is 64 elements compared by 8(AVX2) or 4(SSE2) lanes, the words are distributed by the
+ * policy. the source is captured by a tensor_ref or owned by the view.
+ */
+template <typename _ExecutionPolicy, int_t _Rank, typename _Tensor, typename _Op,
+          typename _ValueType>
+inline void copy(
+    _ExecutionPolicy policy,
+    const lambda_tensor<_Rank,
+                        view::linear_map_functor<_Tensor, view::compare_functor<_Op, _ValueType>>,
+                        row_major_layout<_Rank>>& ts_src,
+    bit_tensor<_Rank>& ts_dst,
+    enable_if_t<is_dense_tensor<view_capture_t<_Tensor>>::value &&
+                is_same<layout_t<_Tensor>, row_major_layout<_Rank>>::value &&
+                is_same<decay_t<typename _Tensor::value_type>, _ValueType>::value>* = 0) {
+    MATAZURE_ASSERT(equal(ts_src.shape(), ts_dst.shape()), "the shapes is not matched");
+    auto functor = ts_src.functor();
+    const _ValueType* p_src = functor.tensor().data();
+    auto v = functor.functor().value();
+    auto size = ts_dst.size();
+    auto p_words = ts_dst.data();
+    const int_t word_bits = bit_tensor<_Rank>::word_bits;
+    for_index(policy, 0, ts_dst.word_count(), [=](int_t i) {
+        auto first = i * word_bits;
+        p_words[i] =
+            internal::compare_word(_Op{}, p_src + first, v, std::min(word_bits, size - first));
+    });
+}
+
+}  // namespace matazure
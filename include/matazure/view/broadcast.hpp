@@ -14,7 +14,7 @@ namespace view {
 template <typename _Tensor, int_t _Rank>
 struct broadcast_functor {
    private:
-    _Tensor ts_;
+    view_capture_t<_Tensor> ts_;
     pointi<_Rank> shape_;
 
    public:
@@ -34,6 +34,11 @@ struct broadcast_functor {
         return access_imp(idx, make_integer_sequence<int_t, _Tensor::rank>{});
     }
 
+    /// whether the source may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(ts_, first, last);
+    }
+
    private:
     template <int_t... _Indices>
     MATAZURE_GENERAL reference_t<_Tensor> access_imp(pointi<_Rank> idx,
@@ -43,12 +48,13 @@ struct broadcast_functor {
 };
 
 template <typename _Tensor, int_t _Rank>
-inline auto broadcast(_Tensor ts, pointi<_Rank> shape)
-    -> decltype(make_lambda(shape, broadcast_functor<_Tensor, _Rank>(ts, shape),
-                            runtime_t<_Tensor>{},
-                            typename layout_getter<layout_t<_Tensor>, _Rank>::type{})) {
-    return make_lambda(shape, broadcast_functor<_Tensor, _Rank>(ts, shape), runtime_t<_Tensor>{},
-                       typename layout_getter<layout_t<_Tensor>, _Rank>::type{});
+inline auto broadcast(_Tensor&& ts, pointi<_Rank> shape)
+    -> decltype(make_lambda(shape, broadcast_functor<view_source_t<_Tensor>, _Rank>(ts, shape),
+                            runtime_t<decay_t<_Tensor>>{},
+                            typename layout_getter<layout_t<decay_t<_Tensor>>, _Rank>::type{})) {
+    return make_lambda(shape, broadcast_functor<view_source_t<_Tensor>, _Rank>(ts, shape),
+                       runtime_t<decay_t<_Tensor>>{},
+                       typename layout_getter<layout_t<decay_t<_Tensor>>, _Rank>::type{});
 }
 
 }  // namespace view
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <matazure/half.hpp>
 #include <matazure/view/map.hpp>
 
 namespace matazure {
@@ -24,17 +25,72 @@ struct cast_functor<point<_OutPointValueType, _Rank>> {
 /**
  * @brief cast a tensor to another value_type lambda_tensor
  *
- * support primitive type static_cast and point_cast.
+ * support primitive type static_cast and point_cast. the half and bfloat16 are converted from and
+ * to float, copying a cast view of a dense tensor to a dense tensor uses the bulk conversion.
  *
  * @param tensor the source tensor
  * @tparam _ValueType the dest tensor value type
  * @return a lambda_tensor whose value_type is _ValueType
  */
 template <typename _ValueType, typename _Tensor>
-inline auto cast(_Tensor tensor, enable_if_t<is_tensor<_Tensor>::value>* = 0)
-    -> decltype(map(tensor, cast_functor<_ValueType>())) {
-    return map(tensor, cast_functor<_ValueType>());
+inline auto cast(_Tensor&& tensor, enable_if_t<is_tensor<decay_t<_Tensor>>::value>* = 0)
+    -> decltype(map(std::forward<_Tensor>(tensor), cast_functor<_ValueType>())) {
+    return map(std::forward<_Tensor>(tensor), cast_functor<_ValueType>());
 }
 
 }  // namespace view
+
+namespace internal {
+
+/// whether there is a bulk conversion kernel from _InValueType to _OutValueType
+template <typename _InValueType, typename _OutValueType>
+struct has_bulk_conversion : bool_constant<false> {};
+
+template <>
+struct has_bulk_conversion<float, half> : bool_constant<true> {};
+template <>
+struct has_bulk_conversion<half, float> : bool_constant<true> {};
+template <>
+struct has_bulk_conversion<float, bfloat16> : bool_constant<true> {};
+template <>
+struct has_bulk_conversion<bfloat16, float> : bool_constant<true> {};
+
+/// the elements number of a bulk conversion task
+const int_t bulk_conversion_chunk_size = 4096;
+
+}  // namespace internal
+
+/**
+ * @brief copies a cast view of a dense tensor to a dense tensor by the bulk conversion
+ *
+ * it's selected for the float from/to half and bfloat16 conversion of a tensor captured by a
+ * tensor_ref or owned by the view, the chunks are distributed by the policy.
+ */
+template <typename _ExecutionPolicy, int_t _Rank, typename _Tensor, typename _Layout,
+          typename _OutValueType, typename _TensorDst>
+inline void copy(
+    _ExecutionPolicy policy,
+    const lambda_tensor<
+        _Rank, view::linear_map_functor<_Tensor, view::cast_functor<_OutValueType>>, _Layout>&
+        ts_src,
+    _TensorDst&& ts_dst,
+    enable_if_t<is_dense_tensor<view_capture_t<_Tensor>>::value &&
+                is_same<layout_t<_Tensor>, _Layout>::value &&
+                internal::has_bulk_conversion<decay_t<typename _Tensor::value_type>,
+                                              _OutValueType>::value &&
+                is_same<decay_t<_TensorDst>,
+                        tensor<_OutValueType, _Rank, _Layout,
+                               typename decay_t<_TensorDst>::allocator_type>>::value>* = 0) {
+    MATAZURE_ASSERT(equal(ts_src.shape(), ts_dst.shape()), "the shapes is not matched");
+    auto ts_in = ts_src.functor().tensor();
+    auto p_in = ts_in.data();
+    auto p_out = ts_dst.data();
+    auto size = ts_in.size();
+    auto chunk_size = internal::bulk_conversion_chunk_size;
+    for_index(policy, 0, (size + chunk_size - 1) / chunk_size, [&](int_t chunk_i) {
+        auto begin = chunk_i * chunk_size;
+        internal::convert_values(p_in + begin, p_out + begin, std::min(chunk_size, size - begin));
+    });
+}
+
 }  // namespace matazure
@@ -14,7 +14,7 @@ namespace view {
 template <typename _Tensor>
 struct clamp_zero_functor {
    private:
-    _Tensor ts_;
+    view_capture_t<_Tensor> ts_;
 
    public:
     clamp_zero_functor(_Tensor ts) : ts_(ts) {}
@@ -27,6 +27,11 @@ struct clamp_zero_functor {
             return zero<typename _Tensor::value_type>::value();
         }
     }
+
+    /// whether the source may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(ts_, first, last);
+    }
 };
 
 /**
@@ -35,11 +40,11 @@ struct clamp_zero_functor {
  * @return a clamped indexing lambda_tensor
  */
 template <typename _Tensor>
-inline auto clamp_zero(_Tensor ts)
-    -> decltype(make_lambda(ts.shape(), clamp_zero_functor<decay_t<_Tensor>>(ts),
-                            runtime_t<_Tensor>{}, layout_t<_Tensor>{})) {
-    return make_lambda(ts.shape(), clamp_zero_functor<decay_t<_Tensor>>(ts), runtime_t<_Tensor>{},
-                       layout_t<_Tensor>{});
+inline auto clamp_zero(_Tensor&& ts)
+    -> decltype(make_lambda(ts.shape(), clamp_zero_functor<view_source_t<_Tensor>>(ts),
+                            runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{})) {
+    return make_lambda(ts.shape(), clamp_zero_functor<view_source_t<_Tensor>>(ts),
+                       runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{});
 }
 
 }  // namespace view
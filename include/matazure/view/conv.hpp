@@ -19,8 +19,8 @@ struct conv_functor<_Tensor, _Kernel, false> {
     typedef typename _Tensor::value_type value_type;
     static const int_t rank = _Tensor::rank;
 
-    _Tensor ts_;
-    _Kernel kernel_;
+    view_capture_t<_Tensor> ts_;
+    view_capture_t<_Kernel> kernel_;
     pointi<rank> kernel_shape_;
 
    public:
@@ -35,6 +35,12 @@ struct conv_functor<_Tensor, _Kernel, false> {
 
         return re;
     }
+
+    /// whether the source or the kernel may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(ts_, first, last) ||
+               matazure::internal::may_alias(kernel_, first, last);
+    }
 };
 
 template <typename _Tensor, typename _Kernel>
@@ -43,8 +49,8 @@ struct conv_functor<_Tensor, _Kernel, true> {
     typedef typename _Tensor::value_type value_type;
     static const int_t rank = _Tensor::rank;
 
-    const _Tensor ts_;
-    const _Kernel kernel_;
+    const view_capture_t<_Tensor> ts_;
+    const view_capture_t<_Kernel> kernel_;
     const pointi<rank> kernel_shape_;
     const pointi<rank> kernel_radius_;
 
@@ -63,6 +69,12 @@ struct conv_functor<_Tensor, _Kernel, true> {
 
         return re;
     }
+
+    /// whether the source or the kernel may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(ts_, first, last) ||
+               matazure::internal::may_alias(kernel_, first, last);
+    }
 };
 
 // add 3x3 unroll special,
@@ -74,7 +86,7 @@ struct conv_functor<_Tensor, local_tensor<_ValueType, dim<3, 3>, _Layout>, true>
 
     typedef local_tensor<_ValueType, dim<3, 3>, _Layout> kernel_type;
 
-    _Tensor ts_;
+    view_capture_t<_Tensor> ts_;
     kernel_type kernel_;
     pointi<rank> kernel_shape_;
     pointi<rank> kernel_radius_;
@@ -102,6 +114,12 @@ struct conv_functor<_Tensor, local_tensor<_ValueType, dim<3, 3>, _Layout>, true>
 
         return re;
     }
+
+    /// whether the source or the kernel may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(ts_, first, last) ||
+               matazure::internal::may_alias(kernel_, first, last);
+    }
 };
 
 template <typename _Tensor>
@@ -111,7 +129,7 @@ struct conv_neighbors_weights_functor {
     static const int_t rank = _Tensor::rank;
     typedef tensor<tuple<pointi<_Tensor::rank>, typename _Tensor::value_type>, 1> weights_type;
 
-    _Tensor ts_;
+    view_capture_t<_Tensor> ts_;
     weights_type neighbors_weights_;
 
    public:
@@ -129,28 +147,43 @@ struct conv_neighbors_weights_functor {
 
         return re;
     }
+
+    /// whether the source or the weights may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(ts_, first, last) ||
+               matazure::internal::may_alias(neighbors_weights_, first, last);
+    }
 };
 
 template <typename _Tensor, typename _Kernel>
-inline auto conv(_Tensor ts, _Kernel kernel) -> decltype(make_lambda(
-    ts.shape(), conv_functor<_Tensor, _Kernel, is_local_tensor<_Kernel>::value>(ts, kernel),
-    runtime_t<_Tensor>{}, layout_t<_Tensor>{})) {
-    static_assert(is_same<typename _Tensor::value_type, typename _Kernel::value_type>::value,
+inline auto conv(_Tensor&& ts, _Kernel&& kernel)
+    -> decltype(make_lambda(ts.shape(),
+                            conv_functor<view_source_t<_Tensor>, view_source_t<_Kernel>,
+                                         is_local_tensor<decay_t<_Kernel>>::value>(ts, kernel),
+                            runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{})) {
+    static_assert(is_same<typename decay_t<_Tensor>::value_type,
+                          typename decay_t<_Kernel>::value_type>::value,
                   "the value types is not matched");
     return make_lambda(ts.shape(),
-                       conv_functor<_Tensor, _Kernel, is_local_tensor<_Kernel>::value>(ts, kernel),
-                       runtime_t<_Tensor>{}, layout_t<_Tensor>{});
+                       conv_functor<view_source_t<_Tensor>, view_source_t<_Kernel>,
+                                    is_local_tensor<decay_t<_Kernel>>::value>(ts, kernel),
+                       runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{});
 }
 
 template <typename _Tensor>
 [[deprecated]] inline auto conv(
-    _Tensor ts,
-    tensor<tuple<pointi<_Tensor::rank>, typename _Tensor::value_type>, 1> neighbors_weights)
+    _Tensor&& ts, tensor<tuple<pointi<decay_t<_Tensor>::rank>,
+                               typename decay_t<_Tensor>::value_type>,
+                         1>
+                      neighbors_weights)
     -> decltype(make_lambda(ts.shape(),
-                            conv_neighbors_weights_functor<_Tensor>(ts, neighbors_weights),
-                            runtime_t<_Tensor>{}, layout_t<_Tensor>{})) {
-    return make_lambda(ts.shape(), conv_neighbors_weights_functor<_Tensor>(ts, neighbors_weights),
-                       runtime_t<_Tensor>{}, layout_t<_Tensor>{});
+                            conv_neighbors_weights_functor<view_source_t<_Tensor>>(
+                                ts, neighbors_weights),
+                            runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{})) {
+    return make_lambda(ts.shape(),
+                       conv_neighbors_weights_functor<view_source_t<_Tensor>>(
+                           ts, neighbors_weights),
+                       runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{});
 }
 
 }  // namespace view
@@ -14,7 +14,7 @@ namespace view {
 template <typename _Tensor, int_t _Axis>
 struct gather_scalar_functor {
    private:
-    _Tensor ts_;
+    view_capture_t<_Tensor> ts_;
     int_t axis_i_;
 
    public:
@@ -24,13 +24,18 @@ struct gather_scalar_functor {
         -> decltype((ts_(scatter_point<_Axis>(idx, axis_i_)))) {
         return ts_(scatter_point<_Axis>(idx, axis_i_));
     }
+
+    /// whether the source may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(ts_, first, last);
+    }
 };
 
 template <typename _Tensor, typename _Vector, int_t _Axis>
 struct gather_vector_functor {
    private:
-    _Tensor ts_;
-    _Vector indices_;
+    view_capture_t<_Tensor> ts_;
+    view_capture_t<_Vector> indices_;
 
    public:
     gather_vector_functor(_Tensor ts, _Vector indices) : ts_(ts), indices_(indices) {}
@@ -39,6 +44,12 @@ struct gather_vector_functor {
         idx[_Axis] = indices_[idx[_Axis]];
         return ts_(idx);
     }
+
+    /// whether the source or the indices may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(ts_, first, last) ||
+               matazure::internal::may_alias(indices_, first, last);
+    }
 };
 
 namespace internal {
@@ -51,26 +62,33 @@ inline pointi<_Rank> get_gather_vector_shape(const pointi<_Rank>& shape, int_t s
 }  // namespace internal
 
 template <int_t _Axis, typename _Tensor, typename _Vector>
-inline auto gather(_Tensor ts, _Vector indices)
-    -> decltype(make_lambda(internal::get_gather_vector_shape<_Axis>(ts.shape(), indices.size()),
-                            gather_vector_functor<_Tensor, _Vector, _Axis>(ts, indices),
-                            runtime_t<_Tensor>{}, layout_t<_Tensor>{})) {
-    static_assert(_Axis >= 0 && _Axis < _Tensor::rank, "_Axis must be >=0 or < _Tensor::rank");
-    return make_lambda(internal::get_gather_vector_shape<_Axis>(ts.shape(), indices.size()),
-                       gather_vector_functor<_Tensor, _Vector, _Axis>(ts, indices),
-                       runtime_t<_Tensor>{}, layout_t<_Tensor>{});
+inline auto gather(_Tensor&& ts, _Vector&& indices)
+    -> decltype(make_lambda(
+        internal::get_gather_vector_shape<_Axis>(ts.shape(), indices.size()),
+        gather_vector_functor<view_source_t<_Tensor>, view_source_t<_Vector>, _Axis>(ts, indices),
+        runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{})) {
+    static_assert(_Axis >= 0 && _Axis < decay_t<_Tensor>::rank,
+                  "_Axis must be >=0 or < _Tensor::rank");
+    return make_lambda(
+        internal::get_gather_vector_shape<_Axis>(ts.shape(), indices.size()),
+        gather_vector_functor<view_source_t<_Tensor>, view_source_t<_Vector>, _Axis>(ts, indices),
+        runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{});
 }
 
 template <int_t _Axis, typename _Tensor>
-inline auto gather(_Tensor ts, int_t positon_index)
+inline auto gather(_Tensor&& ts, int_t positon_index)
     -> decltype(make_lambda(gather_point<_Axis>(ts.shape()),
-                            gather_scalar_functor<_Tensor, _Axis>(ts, positon_index),
-                            runtime_t<_Tensor>{},
-                            typename layout_getter<layout_t<_Tensor>, _Tensor::rank - 1>::type{})) {
-    static_assert(_Axis >= 0 && _Axis < _Tensor::rank, "_Axis must be >=0 or < _Tensor::rank");
+                            gather_scalar_functor<view_source_t<_Tensor>, _Axis>(ts, positon_index),
+                            runtime_t<decay_t<_Tensor>>{},
+                            typename layout_getter<layout_t<decay_t<_Tensor>>,
+                                                   decay_t<_Tensor>::rank - 1>::type{})) {
+    static_assert(_Axis >= 0 && _Axis < decay_t<_Tensor>::rank,
+                  "_Axis must be >=0 or < _Tensor::rank");
     return make_lambda(
-        gather_point<_Axis>(ts.shape()), gather_scalar_functor<_Tensor, _Axis>(ts, positon_index),
-        runtime_t<_Tensor>{}, typename layout_getter<layout_t<_Tensor>, _Tensor::rank - 1>::type{});
+        gather_point<_Axis>(ts.shape()),
+        gather_scalar_functor<view_source_t<_Tensor>, _Axis>(ts, positon_index),
+        runtime_t<decay_t<_Tensor>>{},
+        typename layout_getter<layout_t<decay_t<_Tensor>>, decay_t<_Tensor>::rank - 1>::type{});
 }
 
 }  // namespace view
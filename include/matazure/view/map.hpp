@@ -15,7 +15,7 @@ namespace view {
 template <typename _Tensor, typename _Fun>
 struct linear_map_functor {
    private:
-    const _Tensor ts_;
+    const view_capture_t<_Tensor> ts_;
     const _Fun functor_;
 
    public:
@@ -24,12 +24,23 @@ struct linear_map_functor {
     MATAZURE_GENERAL auto operator()(int_t i) const -> decltype((functor_(ts_[i]))) {
         return functor_(ts_[i]);
     }
+
+    /// the source tensor
+    MATAZURE_GENERAL view_capture_t<_Tensor> tensor() const { return ts_; }
+    /// the mapped functor
+    MATAZURE_GENERAL _Fun functor() const { return functor_; }
+
+    /// whether the source or the functor may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(ts_, first, last) ||
+               matazure::internal::may_alias(functor_, first, last);
+    }
 };
 
 template <typename _Tensor, typename _Fun>
 struct array_map_functor {
    private:
-    const _Tensor ts_;
+    const view_capture_t<_Tensor> ts_;
     const _Fun functor_;
 
    public:
@@ -39,6 +50,12 @@ struct array_map_functor {
         -> decltype((functor_(ts_(idx)))) {
         return functor_(ts_(idx));
     }
+
+    /// whether the source or the functor may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(ts_, first, last) ||
+               matazure::internal::may_alias(functor_, first, last);
+    }
 };
 
 /**
@@ -47,10 +64,10 @@ struct array_map_functor {
  * @param fun the functor, element -> value  pattern
  */
 template <typename _Tensor, typename _Fun>
-inline auto map(_Tensor ts, _Fun fun,
-                enable_if_t<is_same<linear_index, index_t<_Tensor>>::value>* = 0)
-    -> decltype(make_lambda(ts.shape(), linear_map_functor<_Tensor, _Fun>(ts, fun),
-                            runtime_t<_Tensor>{}, layout_t<_Tensor>{})) {
+inline auto map(_Tensor&& ts, _Fun fun,
+                enable_if_t<is_same<linear_index, index_t<decay_t<_Tensor>>>::value>* = 0)
+    -> decltype(make_lambda(ts.shape(), linear_map_functor<view_source_t<_Tensor>, _Fun>(ts, fun),
+                            runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{})) {
     // typedef function_traits<_Fun> trais_t;
     // std::result_of<_Fun>
     // static_assert(trais_t::arguments_size == 1, "_Fun arguments size must be 1");
@@ -60,8 +77,8 @@ inline auto map(_Tensor ts, _Fun fun,
     //                    typename function_traits<_Fun>::template arguments<0>::type>::value,
     //     "_Fun arguments size must be 1");
 
-    return make_lambda(ts.shape(), linear_map_functor<_Tensor, _Fun>(ts, fun), runtime_t<_Tensor>{},
-                       layout_t<_Tensor>{});
+    return make_lambda(ts.shape(), linear_map_functor<view_source_t<_Tensor>, _Fun>(ts, fun),
+                       runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{});
 }
 
 /**
@@ -70,12 +87,12 @@ inline auto map(_Tensor ts, _Fun fun,
  * @param fun the functor, element -> value  pattern
  */
 template <typename _Tensor, typename _Fun>
-inline auto map(_Tensor ts, _Fun fun,
-                enable_if_t<is_same<array_index, index_t<_Tensor>>::value>* = 0)
-    -> decltype(make_lambda(ts.shape(), array_map_functor<_Tensor, _Fun>(ts, fun),
-                            runtime_t<_Tensor>{}, layout_t<_Tensor>{})) {
-    return make_lambda(ts.shape(), array_map_functor<_Tensor, _Fun>(ts, fun), runtime_t<_Tensor>{},
-                       layout_t<_Tensor>{});
+inline auto map(_Tensor&& ts, _Fun fun,
+                enable_if_t<is_same<array_index, index_t<decay_t<_Tensor>>>::value>* = 0)
+    -> decltype(make_lambda(ts.shape(), array_map_functor<view_source_t<_Tensor>, _Fun>(ts, fun),
+                            runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{})) {
+    return make_lambda(ts.shape(), array_map_functor<view_source_t<_Tensor>, _Fun>(ts, fun),
+                       runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{});
 }
 
 }  // namespace view
@@ -7,8 +7,8 @@ namespace view {
 
 template <typename _T1, typename _T2>
 struct mask_value {
-    _T1 ts1;
-    _T2 ts2;
+    view_capture_t<_T1> ts1;
+    view_capture_t<_T2> ts2;
     pointi<_T1::rank> idx;
 
     template <typename _V>
@@ -26,24 +26,341 @@ struct mask_value {
 template <typename _T1, typename _T2>
 struct mask_functor {
     // MATAZURE_GENERAL bool operator()(_Reference v) const { return _Fun(v); }
-    _T1 ts1;
-    _T2 ts2;
+    view_capture_t<_T1> ts1;
+    view_capture_t<_T2> ts2;
 
     MATAZURE_GENERAL mask_value<_T1, _T2> operator()(pointi<_T1::rank> idx) const {
         return mask_value<_T1, _T2>{ts1, ts2, idx};
     }
+
+    /// whether the tensor or the mask may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(ts1, first, last) ||
+               matazure::internal::may_alias(ts2, first, last);
+    }
 };
 
 template <typename _T1, typename _T2>
-inline auto mask(_T1 ts1, _T2 ts2)
-    -> decltype(make_lambda(ts1.shape(), mask_functor<_T1, _T2>{ts1, ts2})) {
-    static_assert(_T1::rank == _T2::rank, "the ranks is not matched");
-    static_assert(std::is_same<runtime_t<_T1>, runtime_t<_T2>>::value,
+inline auto mask(_T1&& ts1, _T2&& ts2)
+    -> decltype(make_lambda(ts1.shape(),
+                            mask_functor<view_source_t<_T1>, view_source_t<_T2>>{ts1, ts2})) {
+    static_assert(decay_t<_T1>::rank == decay_t<_T2>::rank, "the ranks is not matched");
+    static_assert(std::is_same<runtime_t<decay_t<_T1>>, runtime_t<decay_t<_T2>>>::value,
                   "the runtime types is not matched");
     MATAZURE_ASSERT(equal(ts1.shape(), ts2.shape()), "the shapes is not matched");
 
-    return make_lambda(ts1.shape(), mask_functor<_T1, _T2>{ts1, ts2});
+    return make_lambda(ts1.shape(), mask_functor<view_source_t<_T1>, view_source_t<_T2>>{ts1, ts2});
 }
 
+/**
+ * @brief the row major offsets of the true elements of a mask
+ *
+ * it's built by a stream compaction of the mask, the masked algorithms over it only visit the
+ * active elements, so a sparse mask doesn't cost the whole domain.
+ */
+template <int_t _Rank>
+class mask_index_list {
+   public:
+    const static int_t rank = _Rank;
+    // the tags of the tensor traits, the list is a host array of the active elements
+    typedef host_t runtime_type;
+    typedef linear_index index_type;
+
+    mask_index_list()
+        : mask_index_list(zero<pointi<rank>>::value(), tensor<int_t, 1>(pointi<1>{0})) {}
+
+    mask_index_list(pointi<rank> shape, tensor<int_t, 1> offsets)
+        : layout_(shape), offsets_(offsets) {}
+
+    /// the number of the active elements
+    int_t size() const { return offsets_.size(); }
+
+    /// the array index of the i-th active element
+    pointi<rank> operator[](int_t i) const { return layout_.offset2index(offsets_[i]); }
+
+    tensor<int_t, 1> offsets() const { return offsets_; }
+    pointi<rank> shape() const { return layout_.shape(); }
+    row_major_layout<rank> layout() const { return layout_; }
+
+   private:
+    row_major_layout<rank> layout_;
+    tensor<int_t, 1> offsets_;
+};
+
+/**
+ * @brief the run length encoded mask, the spans of the consecutive true elements
+ *
+ * the span i covers the row major offsets [begins[i], begins[i] + lengths[i]), the masked
+ * algorithms over it run a contiguous inner loop in each span.
+ */
+template <int_t _Rank>
+class mask_span_list {
+   public:
+    const static int_t rank = _Rank;
+    // the tags of the tensor traits, the list is a host array of the active elements
+    typedef host_t runtime_type;
+    typedef linear_index index_type;
+
+    mask_span_list()
+        : mask_span_list(zero<pointi<rank>>::value(), tensor<int_t, 1>(pointi<1>{0}),
+                         tensor<int_t, 1>(pointi<1>{0})) {}
+
+    mask_span_list(pointi<rank> shape, tensor<int_t, 1> begins, tensor<int_t, 1> lengths)
+        : layout_(shape), begins_(begins), lengths_(lengths) {}
+
+    /// the number of the spans
+    int_t size() const { return begins_.size(); }
+
+    /// the number of the active elements
+    int_t active_size() const {
+        int_t re = 0;
+        for (int_t i = 0; i < lengths_.size(); ++i) re += lengths_[i];
+        return re;
+    }
+
+    tensor<int_t, 1> begins() const { return begins_; }
+    tensor<int_t, 1> lengths() const { return lengths_; }
+    pointi<rank> shape() const { return layout_.shape(); }
+    row_major_layout<rank> layout() const { return layout_; }
+
+   private:
+    row_major_layout<rank> layout_;
+    tensor<int_t, 1> begins_;
+    tensor<int_t, 1> lengths_;
+};
+
 }  // namespace view
+
+namespace internal {
+
+/// the elements number of a mask compaction task
+const int_t mask_scan_chunk_size = 4096;
+
+/// whether the linear index of the tensor is the row major offset
+template <typename _Tensor>
+struct is_row_major_linear
+    : bool_constant<are_linear_index<_Tensor>::value &&
+                    is_same<layout_t<_Tensor>, row_major_layout<_Tensor::rank>>::value> {};
+
+/// the element of the row major offset, it's indexed by the offset directly when it could
+template <typename _Tensor, int_t _Rank>
+inline auto masked_element(_Tensor& ts, int_t offset, const row_major_layout<_Rank>&,
+                           enable_if_t<is_row_major_linear<decay_t<_Tensor>>::value>* = 0)
+    -> decltype((ts[offset])) {
+    return ts[offset];
+}
+
+template <typename _Tensor, int_t _Rank>
+inline auto masked_element(_Tensor& ts, int_t offset, const row_major_layout<_Rank>& layout,
+                           enable_if_t<!is_row_major_linear<decay_t<_Tensor>>::value>* = 0)
+    -> decltype((ts(layout.offset2index(offset)))) {
+    return ts(layout.offset2index(offset));
+}
+
+/**
+ * @brief counts the chunks of [0, size) in parallel and scans the counts
+ *
+ * it's the first pass of the stream compaction, the chunk i writes its outputs from
+ * positions[i] in the second pass, positions[chunks] is the total count.
+ *
+ * @param count the functor, (first, last) -> count pattern
+ */
+template <typename _ExecutionPolicy, typename _Count>
+inline tensor<int_t, 1> scan_chunk_counts(_ExecutionPolicy policy, int_t size, _Count count) {
+    auto chunks = (size + mask_scan_chunk_size - 1) / mask_scan_chunk_size;
+    tensor<int_t, 1> positions(pointi<1>{chunks + 1});
+    for_index(policy, 0, chunks, [&](int_t chunk_i) {
+        auto first = chunk_i * mask_scan_chunk_size;
+        positions[chunk_i + 1] = count(first, std::min(first + mask_scan_chunk_size, size));
+    });
+    positions[0] = 0;
+    for (int_t i = 1; i <= chunks; ++i) positions[i] += positions[i - 1];
+    return positions;
+}
+
+}  // namespace internal
+
+namespace view {
+
+/**
+ * @brief builds the index list of the true elements of a mask by the stream compaction
+ * @param policy the execution policy
+ * @param ts_mask the mask tensor, its value is convertible to bool
+ */
+template <typename _ExecutionPolicy, typename _Mask>
+inline mask_index_list<_Mask::rank> make_mask_index_list(_ExecutionPolicy policy,
+                                                          const _Mask& ts_mask) {
+    row_major_layout<_Mask::rank> layout(ts_mask.shape());
+    auto is_active = [&](int_t offset) -> bool {
+        return matazure::internal::masked_element(ts_mask, offset, layout);
+    };
+
+    auto size = layout.size();
+    auto positions = matazure::internal::scan_chunk_counts(policy, size, [&](int_t first,
+                                                                              int_t last) {
+        int_t re = 0;
+        for (int_t i = first; i < last; ++i) re += is_active(i);
+        return re;
+    });
+
+    tensor<int_t, 1> offsets(pointi<1>{positions[positions.size() - 1]});
+    for_index(policy, 0, positions.size() - 1, [&](int_t chunk_i) {
+        auto first = chunk_i * matazure::internal::mask_scan_chunk_size;
+        auto last = std::min(first + matazure::internal::mask_scan_chunk_size, size);
+        auto p = offsets.data() + positions[chunk_i];
+        for (int_t i = first; i < last; ++i) {
+            if (is_active(i)) *p++ = i;
+        }
+    });
+
+    return mask_index_list<_Mask::rank>(ts_mask.shape(), offsets);
+}
+
+template <typename _Mask>
+inline mask_index_list<_Mask::rank> make_mask_index_list(const _Mask& ts_mask) {
+    return make_mask_index_list(sequence_policy{}, ts_mask);
+}
+
+/**
+ * @brief builds the span list of the true elements of a mask
+ *
+ * a span belongs to the chunk of its first element, so it's counted once even if it crosses the
+ * chunks, and its length is measured past the chunk end.
+ */
+template <typename _ExecutionPolicy, typename _Mask>
+inline mask_span_list<_Mask::rank> make_mask_span_list(_ExecutionPolicy policy,
+                                                        const _Mask& ts_mask) {
+    row_major_layout<_Mask::rank> layout(ts_mask.shape());
+    auto is_active = [&](int_t offset) -> bool {
+        return matazure::internal::masked_element(ts_mask, offset, layout);
+    };
+    auto is_span_begin = [&](int_t offset) -> bool {
+        return is_active(offset) && (offset == 0 || !is_active(offset - 1));
+    };
+
+    auto size = layout.size();
+    auto positions = matazure::internal::scan_chunk_counts(policy, size, [&](int_t first,
+                                                                              int_t last) {
+        int_t re = 0;
+        for (int_t i = first; i < last; ++i) re += is_span_begin(i);
+        return re;
+    });
+
+    auto spans = positions[positions.size() - 1];
+    tensor<int_t, 1> begins(pointi<1>{spans});
+    tensor<int_t, 1> lengths(pointi<1>{spans});
+    for_index(policy, 0, positions.size() - 1, [&](int_t chunk_i) {
+        auto first = chunk_i * matazure::internal::mask_scan_chunk_size;
+        auto last = std::min(first + matazure::internal::mask_scan_chunk_size, size);
+        auto k = positions[chunk_i];
+        for (int_t i = first; i < last; ++i) {
+            if (!is_span_begin(i)) continue;
+            auto end = i + 1;
+            while (end < size && is_active(end)) ++end;
+            begins[k] = i;
+            lengths[k] = end - i;
+            ++k;
+            i = end - 1;
+        }
+    });
+
+    return mask_span_list<_Mask::rank>(ts_mask.shape(), begins, lengths);
+}
+
+template <typename _Mask>
+inline mask_span_list<_Mask::rank> make_mask_span_list(const _Mask& ts_mask) {
+    return make_mask_span_list(sequence_policy{}, ts_mask);
+}
+
+}  // namespace view
+
+namespace internal {
+
+/// applies fun(offset) to the active elements of the index list
+template <typename _ExecutionPolicy, int_t _Rank, typename _Fun>
+inline void for_each_active(_ExecutionPolicy policy, const view::mask_index_list<_Rank>& indices,
+                            _Fun fun) {
+    auto p_offsets = indices.offsets().data();
+    for_index(policy, 0, indices.size(), [&](int_t i) { fun(p_offsets[i]); });
+}
+
+/// applies fun(offset) to the active elements of the span list, the span is an inner loop
+template <typename _ExecutionPolicy, int_t _Rank, typename _Fun>
+inline void for_each_active(_ExecutionPolicy policy, const view::mask_span_list<_Rank>& spans,
+                            _Fun fun) {
+    auto p_begins = spans.begins().data();
+    auto p_lengths = spans.lengths().data();
+    for_index(policy, 0, spans.size(), [&](int_t i) {
+        auto last = p_begins[i] + p_lengths[i];
+        for (int_t offset = p_begins[i]; offset < last; ++offset) fun(offset);
+    });
+}
+
+template <typename _List>
+struct is_mask_list : bool_constant<false> {};
+template <int_t _Rank>
+struct is_mask_list<view::mask_index_list<_Rank>> : bool_constant<true> {};
+template <int_t _Rank>
+struct is_mask_list<view::mask_span_list<_Rank>> : bool_constant<true> {};
+
+}  // namespace internal
+
+/**
+ * @brief for each active element of a mask list, apply fun
+ * @param policy the execution policy
+ * @param mask_list the mask_index_list or mask_span_list of the tensor shape
+ * @param ts the tensor
+ * @param fun the functor, (element &) -> none pattern
+ */
+template <typename _ExecutionPolicy, typename _MaskList, typename _Tensor, typename _Fun>
+inline void for_each(_ExecutionPolicy policy, const _MaskList& mask_list, _Tensor&& ts, _Fun fun,
+                     enable_if_t<internal::is_mask_list<_MaskList>::value>* = 0) {
+    MATAZURE_ASSERT(equal(mask_list.shape(), ts.shape()), "the shapes is not matched");
+    auto layout = mask_list.layout();
+    internal::for_each_active(policy, mask_list, [&](int_t offset) {
+        fun(internal::masked_element(ts, offset, layout));
+    });
+}
+
+/// fills the active elements of a mask list
+template <typename _ExecutionPolicy, typename _MaskList, typename _Tensor, typename _ValueType>
+inline void fill(_ExecutionPolicy policy, const _MaskList& mask_list, _Tensor&& ts, _ValueType v,
+                 enable_if_t<internal::is_mask_list<_MaskList>::value>* = 0) {
+    MATAZURE_ASSERT(equal(mask_list.shape(), ts.shape()), "the shapes is not matched");
+    auto layout = mask_list.layout();
+    internal::for_each_active(policy, mask_list, [&](int_t offset) {
+        internal::masked_element(ts, offset, layout) = v;
+    });
+}
+
+/// copies the active elements of a mask list
+template <typename _ExecutionPolicy, typename _MaskList, typename _TensorSrc, typename _TensorDst>
+inline void copy(_ExecutionPolicy policy, const _MaskList& mask_list, const _TensorSrc& ts_src,
+                 _TensorDst&& ts_dst, enable_if_t<internal::is_mask_list<_MaskList>::value>* = 0) {
+    MATAZURE_ASSERT(equal(mask_list.shape(), ts_src.shape()) &&
+                        equal(mask_list.shape(), ts_dst.shape()),
+                    "the shapes is not matched");
+    auto layout = mask_list.layout();
+    internal::for_each_active(policy, mask_list, [&](int_t offset) {
+        internal::masked_element(ts_dst, offset, layout) =
+            internal::masked_element(ts_src, offset, layout);
+    });
+}
+
+/// transforms the active elements of a mask list
+template <typename _ExecutionPolicy, typename _MaskList, typename _TensorSrc, typename _TensorDst,
+          typename _Fun>
+inline void transform(_ExecutionPolicy policy, const _MaskList& mask_list,
+                      const _TensorSrc& ts_src, _TensorDst&& ts_dst, _Fun fun,
+                      enable_if_t<internal::is_mask_list<_MaskList>::value>* = 0) {
+    MATAZURE_ASSERT(equal(mask_list.shape(), ts_src.shape()) &&
+                        equal(mask_list.shape(), ts_dst.shape()),
+                    "the shapes is not matched");
+    auto layout = mask_list.layout();
+    internal::for_each_active(policy, mask_list, [&](int_t offset) {
+        internal::masked_element(ts_dst, offset, layout) =
+            fun(internal::masked_element(ts_src, offset, layout));
+    });
+}
+
 }  // namespace matazure
@@ -23,6 +23,11 @@ struct meshgrid_functor {
         return access_imp(idx, make_integer_sequence<int_t, sizeof...(_Axes)>{});
     }
 
+    /// whether the axes may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(axes_, first, last);
+    }
+
    private:
     template <int_t... _Indices>
     MATAZURE_GENERAL point<value_type, rank> access_imp(
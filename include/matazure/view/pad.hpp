@@ -6,9 +6,12 @@ namespace matazure {
 namespace view {
 
 template <typename _Tensor>
-inline auto pad(_Tensor ts, int_t padding)
-    -> decltype(view::slice(ts, pointi<_Tensor::rank>::all(padding), ts.shape() - 2 * padding)) {
-    return view::slice(ts, pointi<_Tensor::rank>::all(padding), ts.shape() - 2 * padding);
+inline auto pad(_Tensor&& ts, int_t padding)
+    -> decltype(view::slice(std::forward<_Tensor>(ts),
+                            pointi<decay_t<_Tensor>::rank>::all(padding),
+                            ts.shape() - 2 * padding)) {
+    return view::slice(std::forward<_Tensor>(ts), pointi<decay_t<_Tensor>::rank>::all(padding),
+                       ts.shape() - 2 * padding);
 }
 
 }  // namespace view
@@ -1,9 +1,9 @@
-
 #pragma once
 
 #include <matazure/algorithm.hpp>
 #include <matazure/lambda_tensor.hpp>
 #include <matazure/tensor.hpp>
+#include <matazure/transpose.hpp>
 
 #ifdef MATAZURE_CUDA
 #include <matazure/cuda/tensor.hpp>
@@ -15,7 +15,7 @@ namespace view {
 template <typename _Tensor, int_t... _Idx>
 struct permute_functor {
    private:
-    const _Tensor ts_;
+    const view_capture_t<_Tensor> ts_;
 
    public:
     permute_functor(_Tensor ts) : ts_(ts) {}
@@ -23,15 +23,47 @@ struct permute_functor {
     MATAZURE_GENERAL typename _Tensor::value_type operator()(pointi<_Tensor::rank> idx) const {
         return ts_(permute_point<_Idx...>(idx));
     }
+
+    /// the source tensor
+    MATAZURE_GENERAL view_capture_t<_Tensor> tensor() const { return ts_; }
+
+    /// whether the source may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(ts_, first, last);
+    }
 };
 
+/**
+ * @brief permutes the axes of a tensor, the element idx is ts(permute_point<_Idx...>(idx))
+ * @see permute_shape
+ */
 template <int_t... _Idx, typename _Tensor>
-inline auto permute(_Tensor ts)
-    -> decltype(make_lambda(ts.shape(), permute_functor<_Tensor, _Idx...>(ts), runtime_t<_Tensor>{},
-                            layout_t<_Tensor>{})) {
-    return make_lambda(ts.shape(), permute_functor<_Tensor, _Idx...>(ts), runtime_t<_Tensor>{},
-                       layout_t<_Tensor>{});
+inline auto permute(_Tensor&& ts)
+    -> decltype(make_lambda(ts.shape(), permute_functor<view_source_t<_Tensor>, _Idx...>(ts),
+                            runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{})) {
+    return make_lambda(permute_shape<_Idx...>(ts.shape()),
+                       permute_functor<view_source_t<_Tensor>, _Idx...>(ts),
+                       runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{});
 }
 
 }  // namespace view
+
+/**
+ * @brief copies a permuted dense tensor to a dense tensor by the blocked permute_copy
+ *
+ * the source is captured by a tensor_ref or owned by the view, both are matched.
+ *
+ * @see permute_copy
+ */
+template <typename _ExecutionPolicy, int_t _Rank, typename _Tensor, int_t... _Idx,
+          typename _Layout, typename _TensorDst>
+inline void copy(
+    _ExecutionPolicy policy,
+    const lambda_tensor<_Rank, view::permute_functor<_Tensor, _Idx...>, _Layout>& ts_src,
+    _TensorDst&& ts_dst,
+    enable_if_t<is_row_major_tensor<view_capture_t<_Tensor>>::value &&
+                is_row_major_tensor<decay_t<_TensorDst>>::value>* = 0) {
+    permute_copy<_Idx...>(policy, ts_src.functor().tensor(), std::forward<_TensorDst>(ts_dst));
+}
+
 }  // namespace matazure
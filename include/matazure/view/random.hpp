@@ -0,0 +1,95 @@
+#pragma once
+
+#include <matazure/lambda_tensor.hpp>
+#include <matazure/random.hpp>
+
+#ifdef MATAZURE_CUDA
+#include <matazure/cuda/lambda_tensor.hpp>
+#endif
+
+namespace matazure {
+namespace view {
+
+template <typename _ValueType>
+struct random_uniform_functor {
+   private:
+    philox4x32_key key_;
+    std::uint64_t stream_;
+
+   public:
+    random_uniform_functor(std::uint64_t seed, std::uint64_t stream)
+        : key_(philox4x32_seed_key(seed)), stream_(stream) {}
+
+    MATAZURE_GENERAL _ValueType operator()(int_t i) const {
+        auto words = philox4x32_10(philox4x32_block_counter(i / 4, stream_), key_);
+        return uniform_real<_ValueType>(words[i % 4]);
+    }
+
+    /// the values are generated, they read no memory
+    bool may_alias(const void*, const void*) const { return false; }
+};
+
+template <typename _ValueType>
+struct random_normal_functor {
+   private:
+    philox4x32_key key_;
+    std::uint64_t stream_;
+
+   public:
+    random_normal_functor(std::uint64_t seed, std::uint64_t stream)
+        : key_(philox4x32_seed_key(seed)), stream_(stream) {}
+
+    MATAZURE_GENERAL _ValueType operator()(int_t i) const {
+        auto words = philox4x32_10(philox4x32_block_counter(i / 4, stream_), key_);
+        auto first = i % 4 / 2 * 2;
+        return box_muller<_ValueType>(words[first], words[first + 1])[i % 2];
+    }
+
+    /// the values are generated, they read no memory
+    bool may_alias(const void*, const void*) const { return false; }
+};
+
+/**
+ * @brief a view of the uniform random values in [0, 1)
+ *
+ * the element i is a pure function of (seed, stream, i), persisting it by any policy gives the
+ * same values, fill_random_uniform is its dense kernel.
+ *
+ * @param shape the shape
+ * @param seed the seed
+ * @param stream the stream, the different streams of a seed are independent
+ */
+template <typename _ValueType, int_t _Rank, typename _RuntimeType>
+inline auto random_uniform(pointi<_Rank> shape, std::uint64_t seed, std::uint64_t stream,
+                           _RuntimeType)
+    -> decltype(make_lambda(shape, random_uniform_functor<_ValueType>(seed, stream),
+                            _RuntimeType{})) {
+    return make_lambda(shape, random_uniform_functor<_ValueType>(seed, stream), _RuntimeType{});
+}
+
+template <typename _ValueType, int_t _Rank>
+inline auto random_uniform(pointi<_Rank> shape, std::uint64_t seed, std::uint64_t stream)
+    -> decltype(random_uniform<_ValueType>(shape, seed, stream, host_t{})) {
+    return random_uniform<_ValueType>(shape, seed, stream, host_t{});
+}
+
+/**
+ * @brief a view of the standard normal random values, they're generated by Box-Muller
+ * @see random_uniform, fill_random_normal
+ */
+template <typename _ValueType, int_t _Rank, typename _RuntimeType>
+inline auto random_normal(pointi<_Rank> shape, std::uint64_t seed, std::uint64_t stream,
+                          _RuntimeType)
+    -> decltype(make_lambda(shape, random_normal_functor<_ValueType>(seed, stream),
+                            _RuntimeType{})) {
+    return make_lambda(shape, random_normal_functor<_ValueType>(seed, stream), _RuntimeType{});
+}
+
+template <typename _ValueType, int_t _Rank>
+inline auto random_normal(pointi<_Rank> shape, std::uint64_t seed, std::uint64_t stream)
+    -> decltype(random_normal<_ValueType>(shape, seed, stream, host_t{})) {
+    return random_normal<_ValueType>(shape, seed, stream, host_t{});
+}
+
+}  // namespace view
+}  // namespace matazure
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <matazure/algorithm.hpp>
+#include <matazure/lambda_tensor.hpp>
+#include <matazure/resize.hpp>
+#include <matazure/tensor.hpp>
+
+namespace matazure {
+namespace view {
+
+template <typename _Tensor>
+struct resize_functor {
+   private:
+    typedef decay_t<typename _Tensor::value_type> value_type;
+    typedef typename accumulate_traits<value_type>::type acc_type;
+
+    view_capture_t<_Tensor> ts_;
+    resize_plan plan_;
+
+   public:
+    resize_functor(_Tensor ts, resize_plan plan) : ts_(ts), plan_(plan) {}
+
+    MATAZURE_GENERAL value_type operator()(pointi<2> idx) const {
+        const auto& rows = plan_.rows();
+        const auto& cols = plan_.cols();
+        auto re = zero<acc_type>::value();
+        for (int_t ty = 0; ty < rows.taps(); ++ty) {
+            auto src_y = rows.index(idx[0], ty);
+            auto wy = rows.weight(idx[0], ty);
+            for (int_t tx = 0; tx < cols.taps(); ++tx) {
+                auto w = wy * cols.weight(idx[1], tx);
+                re += accumulate_cast<acc_type>(ts_(src_y, cols.index(idx[1], tx))) * w;
+            }
+        }
+
+        return matazure::internal::saturate_cast<value_type>(re);
+    }
+
+    /// whether the source may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(ts_, first, last);
+    }
+};
+
+/**
+ * @brief produces a resized lambda_tensor of a 2-dim tensor
+ *
+ * the source indices and weights of each row and column are precomputed in the plan, persist or
+ * copy it to a dense tensor by the policy, use matazure::resize for the faster separable kernel.
+ *
+ * @param ts the source tensor
+ * @param plan the resize plan
+ * @return a lambda_tensor whose shape is plan.dst_shape()
+ */
+template <typename _Tensor>
+inline auto resize(_Tensor&& ts, resize_plan plan)
+    -> decltype(make_lambda(plan.dst_shape(), resize_functor<view_source_t<_Tensor>>(ts, plan),
+                            runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{})) {
+    MATAZURE_STATIC_ASSERT_MATRIX_RANK(decay_t<_Tensor>);
+    MATAZURE_ASSERT(equal(ts.shape(), plan.src_shape()), "the source shape is not matched");
+    return make_lambda(plan.dst_shape(), resize_functor<view_source_t<_Tensor>>(ts, plan),
+                       runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{});
+}
+
+/**
+ * @brief produces a resized lambda_tensor of a 2-dim tensor
+ * @param ts the source tensor
+ * @param shape the new shape
+ * @param method the interpolation method
+ * @return a lambda_tensor whose shape is shape
+ */
+template <typename _Tensor>
+inline auto resize(_Tensor&& ts, pointi<2> shape, interpolation method = interpolation::bilinear)
+    -> decltype(resize(std::forward<_Tensor>(ts), resize_plan(ts.shape(), shape, method))) {
+    return resize(std::forward<_Tensor>(ts), resize_plan(ts.shape(), shape, method));
+}
+
+}  // namespace view
+}  // namespace matazure
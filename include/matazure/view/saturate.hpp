@@ -0,0 +1,187 @@
+#pragma once
+
+#include <matazure/saturate.hpp>
+#include <matazure/view/map.hpp>
+
+namespace matazure {
+namespace view {
+
+template <typename _TensorLhs, typename _TensorRhs, typename _Op>
+struct linear_saturate_functor {
+   private:
+    const view_capture_t<_TensorLhs> ts_lhs_;
+    const view_capture_t<_TensorRhs> ts_rhs_;
+    const _Op op_;
+
+   public:
+    typedef decay_t<typename _TensorLhs::value_type> value_type;
+
+    linear_saturate_functor(_TensorLhs ts_lhs, _TensorRhs ts_rhs, _Op op)
+        : ts_lhs_(ts_lhs), ts_rhs_(ts_rhs), op_(op) {}
+
+    MATAZURE_GENERAL value_type operator()(int_t i) const {
+        return op_(static_cast<value_type>(ts_lhs_[i]), static_cast<value_type>(ts_rhs_[i]));
+    }
+
+    /// the lhs source tensor
+    MATAZURE_GENERAL view_capture_t<_TensorLhs> lhs() const { return ts_lhs_; }
+    /// the rhs source tensor
+    MATAZURE_GENERAL view_capture_t<_TensorRhs> rhs() const { return ts_rhs_; }
+    /// the saturating op
+    MATAZURE_GENERAL _Op op() const { return op_; }
+
+    /// whether the sources or the op may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(ts_lhs_, first, last) ||
+               matazure::internal::may_alias(ts_rhs_, first, last) ||
+               matazure::internal::may_alias(op_, first, last);
+    }
+};
+
+template <typename _TensorLhs, typename _TensorRhs, typename _Op>
+struct array_saturate_functor {
+   private:
+    const view_capture_t<_TensorLhs> ts_lhs_;
+    const view_capture_t<_TensorRhs> ts_rhs_;
+    const _Op op_;
+
+   public:
+    typedef decay_t<typename _TensorLhs::value_type> value_type;
+
+    array_saturate_functor(_TensorLhs ts_lhs, _TensorRhs ts_rhs, _Op op)
+        : ts_lhs_(ts_lhs), ts_rhs_(ts_rhs), op_(op) {}
+
+    MATAZURE_GENERAL value_type operator()(pointi<_TensorLhs::rank> idx) const {
+        return op_(static_cast<value_type>(ts_lhs_(idx)), static_cast<value_type>(ts_rhs_(idx)));
+    }
+
+    /// whether the sources or the op may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(ts_lhs_, first, last) ||
+               matazure::internal::may_alias(ts_rhs_, first, last) ||
+               matazure::internal::may_alias(op_, first, last);
+    }
+};
+
+template <typename _TensorLhs, typename _TensorRhs, typename _Op>
+inline auto saturate_map(
+    _TensorLhs&& ts_lhs, _TensorRhs&& ts_rhs, _Op op,
+    enable_if_t<are_linear_index<decay_t<_TensorLhs>, decay_t<_TensorRhs>>::value>* = 0)
+    -> decltype(make_lambda(ts_lhs.shape(),
+                            linear_saturate_functor<view_source_t<_TensorLhs>,
+                                                    view_source_t<_TensorRhs>, _Op>(ts_lhs, ts_rhs,
+                                                                                    op),
+                            runtime_t<decay_t<_TensorLhs>>{}, layout_t<decay_t<_TensorLhs>>{})) {
+    MATAZURE_STATIC_ASSERT_VALUE_TYPE_MATCHED(decay_t<_TensorLhs>, decay_t<_TensorRhs>);
+    MATAZURE_ASSERT(equal(ts_lhs.shape(), ts_rhs.shape()), "the shapes is not matched");
+    return make_lambda(ts_lhs.shape(),
+                       linear_saturate_functor<view_source_t<_TensorLhs>, view_source_t<_TensorRhs>,
+                                               _Op>(ts_lhs, ts_rhs, op),
+                       runtime_t<decay_t<_TensorLhs>>{}, layout_t<decay_t<_TensorLhs>>{});
+}
+
+template <typename _TensorLhs, typename _TensorRhs, typename _Op>
+inline auto saturate_map(
+    _TensorLhs&& ts_lhs, _TensorRhs&& ts_rhs, _Op op,
+    enable_if_t<!are_linear_index<decay_t<_TensorLhs>, decay_t<_TensorRhs>>::value>* = 0)
+    -> decltype(make_lambda(ts_lhs.shape(),
+                            array_saturate_functor<view_source_t<_TensorLhs>,
+                                                   view_source_t<_TensorRhs>, _Op>(ts_lhs, ts_rhs,
+                                                                                   op),
+                            runtime_t<decay_t<_TensorLhs>>{}, layout_t<decay_t<_TensorLhs>>{})) {
+    MATAZURE_STATIC_ASSERT_VALUE_TYPE_MATCHED(decay_t<_TensorLhs>, decay_t<_TensorRhs>);
+    MATAZURE_ASSERT(equal(ts_lhs.shape(), ts_rhs.shape()), "the shapes is not matched");
+    return make_lambda(ts_lhs.shape(),
+                       array_saturate_functor<view_source_t<_TensorLhs>, view_source_t<_TensorRhs>,
+                                              _Op>(ts_lhs, ts_rhs, op),
+                       runtime_t<decay_t<_TensorLhs>>{}, layout_t<decay_t<_TensorLhs>>{});
+}
+
+/**
+ * @brief the saturating add view of two byte/short(or point of them) tensors
+ *
+ * copying the view of two dense tensors to a dense tensor uses the packed saturating kernel.
+ */
+template <typename _TensorLhs, typename _TensorRhs>
+inline auto adds(_TensorLhs&& ts_lhs, _TensorRhs&& ts_rhs)
+    -> decltype(saturate_map(std::forward<_TensorLhs>(ts_lhs), std::forward<_TensorRhs>(ts_rhs),
+                             matazure::internal::saturate_add_op{})) {
+    return saturate_map(std::forward<_TensorLhs>(ts_lhs), std::forward<_TensorRhs>(ts_rhs),
+                        matazure::internal::saturate_add_op{});
+}
+
+/// the saturating subtract view, @see adds
+template <typename _TensorLhs, typename _TensorRhs>
+inline auto subs(_TensorLhs&& ts_lhs, _TensorRhs&& ts_rhs)
+    -> decltype(saturate_map(std::forward<_TensorLhs>(ts_lhs), std::forward<_TensorRhs>(ts_rhs),
+                             matazure::internal::saturate_sub_op{})) {
+    return saturate_map(std::forward<_TensorLhs>(ts_lhs), std::forward<_TensorRhs>(ts_rhs),
+                        matazure::internal::saturate_sub_op{});
+}
+
+/// the Q8 multiply view of byte tensors, 255 is 1.0
+template <typename _TensorLhs, typename _TensorRhs>
+inline auto mulq8(_TensorLhs&& ts_lhs, _TensorRhs&& ts_rhs)
+    -> decltype(saturate_map(std::forward<_TensorLhs>(ts_lhs), std::forward<_TensorRhs>(ts_rhs),
+                             matazure::internal::mul_q8_op{})) {
+    return saturate_map(std::forward<_TensorLhs>(ts_lhs), std::forward<_TensorRhs>(ts_rhs),
+                        matazure::internal::mul_q8_op{});
+}
+
+/// the Q15 multiply view of short tensors, 32768 is 1.0
+template <typename _TensorLhs, typename _TensorRhs>
+inline auto mulq15(_TensorLhs&& ts_lhs, _TensorRhs&& ts_rhs)
+    -> decltype(saturate_map(std::forward<_TensorLhs>(ts_lhs), std::forward<_TensorRhs>(ts_rhs),
+                             matazure::internal::mul_q15_op{})) {
+    return saturate_map(std::forward<_TensorLhs>(ts_lhs), std::forward<_TensorRhs>(ts_rhs),
+                        matazure::internal::mul_q15_op{});
+}
+
+/// the Q8 blend view of byte tensors, lhs * (1 - alpha) + rhs * alpha
+template <typename _TensorLhs, typename _TensorRhs>
+inline auto blendq8(_TensorLhs&& ts_lhs, _TensorRhs&& ts_rhs, byte alpha)
+    -> decltype(saturate_map(std::forward<_TensorLhs>(ts_lhs), std::forward<_TensorRhs>(ts_rhs),
+                             matazure::internal::blend_q8_op{alpha})) {
+    return saturate_map(std::forward<_TensorLhs>(ts_lhs), std::forward<_TensorRhs>(ts_rhs),
+                        matazure::internal::blend_q8_op{alpha});
+}
+
+/// the Q15 blend view of short tensors, lhs * (1 - alpha) + rhs * alpha
+template <typename _TensorLhs, typename _TensorRhs>
+inline auto blendq15(_TensorLhs&& ts_lhs, _TensorRhs&& ts_rhs, short alpha)
+    -> decltype(saturate_map(std::forward<_TensorLhs>(ts_lhs), std::forward<_TensorRhs>(ts_rhs),
+                             matazure::internal::blend_q15_op{alpha})) {
+    return saturate_map(std::forward<_TensorLhs>(ts_lhs), std::forward<_TensorRhs>(ts_rhs),
+                        matazure::internal::blend_q15_op{alpha});
+}
+
+}  // namespace view
+
+/**
+ * @brief copies a saturating view of two dense tensors to a dense tensor by the packed kernel
+ *
+ * the operands are captured by tensor_refs or owned by the view, the chunks are distributed by the
+ * policy, the view elements are not evaluated one by one.
+ */
+template <typename _ExecutionPolicy, int_t _Rank, typename _TensorLhs, typename _TensorRhs,
+          typename _Op, typename _Layout, typename _TensorDst>
+inline void copy(
+    _ExecutionPolicy policy,
+    const lambda_tensor<_Rank, view::linear_saturate_functor<_TensorLhs, _TensorRhs, _Op>,
+                        _Layout>& ts_src,
+    _TensorDst&& ts_dst,
+    enable_if_t<internal::is_saturate_op<_Op>::value &&
+                is_dense_tensor<view_capture_t<_TensorLhs>>::value &&
+                is_dense_tensor<view_capture_t<_TensorRhs>>::value &&
+                is_same<layout_t<_TensorLhs>, _Layout>::value &&
+                is_same<layout_t<_TensorRhs>, _Layout>::value &&
+                is_same<decay_t<typename _TensorLhs::value_type>,
+                        decay_t<typename _TensorRhs::value_type>>::value &&
+                is_same<decay_t<_TensorDst>,
+                        tensor<decay_t<typename _TensorLhs::value_type>, _Rank, _Layout,
+                               typename decay_t<_TensorDst>::allocator_type>>::value>* = 0) {
+    auto functor = ts_src.functor();
+    internal::saturate_transform(policy, functor.op(), functor.lhs(), functor.rhs(), ts_dst);
+}
+
+}  // namespace matazure
@@ -14,7 +14,7 @@ namespace view {
 template <typename _Tensor>
 struct shift_functor {
    private:
-    _Tensor ts_;
+    view_capture_t<_Tensor> ts_;
     pointi<_Tensor::rank> offset_;
 
    public:
@@ -24,14 +24,19 @@ struct shift_functor {
         -> decltype((ts_(idx + offset_))) {
         return ts_(idx + offset_);
     }
+
+    /// whether the source may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(ts_, first, last);
+    }
 };
 
 template <typename _Tensor>
-inline auto shift(_Tensor ts, pointi<_Tensor::rank> offset)
-    -> decltype(make_lambda(ts.shape(), shift_functor<decay_t<_Tensor>>(ts, offset),
-                            runtime_t<_Tensor>{}, layout_t<_Tensor>{})) {
-    return make_lambda(ts.shape(), shift_functor<decay_t<_Tensor>>(ts, offset),
-                       runtime_t<_Tensor>{}, layout_t<_Tensor>{});
+inline auto shift(_Tensor&& ts, pointi<decay_t<_Tensor>::rank> offset)
+    -> decltype(make_lambda(ts.shape(), shift_functor<view_source_t<_Tensor>>(ts, offset),
+                            runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{})) {
+    return make_lambda(ts.shape(), shift_functor<view_source_t<_Tensor>>(ts, offset),
+                       runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{});
 }
 
 }  // namespace view
@@ -14,7 +14,7 @@ namespace view {
 template <typename _Tensor>
 struct slice_functor {
    private:
-    _Tensor ts_;
+    view_capture_t<_Tensor> ts_;
     pointi<_Tensor::rank> offset_;
 
    public:
@@ -24,6 +24,11 @@ struct slice_functor {
         -> decltype((ts_(idx + offset_))) {
         return ts_(idx + offset_);
     }
+
+    /// whether the source may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(ts_, first, last);
+    }
 };
 
 /**
@@ -34,11 +39,12 @@ struct slice_functor {
  * @return a subsection lambda_tensor
  */
 template <typename _Tensor>
-inline auto slice(_Tensor ts, pointi<_Tensor::rank> origin, pointi<_Tensor::rank> shape)
-    -> decltype(make_lambda(shape, slice_functor<decay_t<_Tensor>>(ts, origin),
-                            runtime_t<_Tensor>{}, layout_t<_Tensor>{})) {
-    return make_lambda(shape, slice_functor<decay_t<_Tensor>>(ts, origin), runtime_t<_Tensor>{},
-                       layout_t<_Tensor>{});
+inline auto slice(_Tensor&& ts, pointi<decay_t<_Tensor>::rank> origin,
+                  pointi<decay_t<_Tensor>::rank> shape)
+    -> decltype(make_lambda(shape, slice_functor<view_source_t<_Tensor>>(ts, origin),
+                            runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{})) {
+    return make_lambda(shape, slice_functor<view_source_t<_Tensor>>(ts, origin),
+                       runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{});
 }
 
 }  // namespace view
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <matazure/sparse.hpp>
+#include <matazure/view/map.hpp>
+
+namespace matazure {
+namespace view {
+
+template <typename _ValueType>
+struct sparse_matrix_functor {
+   private:
+    const int_t* p_row_offsets_;
+    const int_t* p_column_indices_;
+    const _ValueType* p_values_;
+    // holds the arrays of the pointers
+    sparse_matrix<_ValueType> sp_;
+
+   public:
+    sparse_matrix_functor(sparse_matrix<_ValueType> sp)
+        : p_row_offsets_(sp.row_offsets().data()),
+          p_column_indices_(sp.column_indices().data()),
+          p_values_(sp.values().data()),
+          sp_(sp) {}
+
+    MATAZURE_GENERAL _ValueType operator()(pointi<2> idx) const {
+        auto first = p_row_offsets_[idx[0]];
+        auto last = p_row_offsets_[idx[0] + 1];
+        auto k = matazure::internal::lower_bound_index(p_column_indices_, first, last, idx[1]);
+        return (k < last && p_column_indices_[k] == idx[1]) ? p_values_[k]
+                                                            : zero<_ValueType>::value();
+    }
+};
+
+template <typename _ValueType, int_t _Rank>
+struct csf_tensor_functor {
+   private:
+    point<const int_t*, _Rank> p_indices_;
+    point<const int_t*, _Rank> p_pointers_;
+    const _ValueType* p_values_;
+    int_t roots_;
+    // holds the arrays of the pointers
+    csf_tensor<_ValueType, _Rank> csf_;
+
+   public:
+    csf_tensor_functor(csf_tensor<_ValueType, _Rank> csf)
+        : p_values_(csf.values().data()), roots_(csf.indices(0).size()), csf_(csf) {
+        for (int_t l = 0; l < _Rank; ++l) {
+            p_indices_[l] = csf.indices(l).data();
+            p_pointers_[l] = l < _Rank - 1 ? csf.pointers(l).data() : nullptr;
+        }
+    }
+
+    /// searches the coordinate of each level among the children of the previous level node
+    MATAZURE_GENERAL _ValueType operator()(pointi<_Rank> idx) const {
+        int_t first = 0;
+        int_t last = roots_;
+        for (int_t l = 0; l < _Rank; ++l) {
+            auto k = matazure::internal::lower_bound_index(p_indices_[l], first, last, idx[l]);
+            if (k == last || p_indices_[l][k] != idx[l]) return zero<_ValueType>::value();
+            if (l == _Rank - 1) return p_values_[k];
+            first = p_pointers_[l][k];
+            last = p_pointers_[l][k + 1];
+        }
+        return zero<_ValueType>::value();
+    }
+};
+
+/**
+ * @brief the dense view of a sparse_matrix
+ *
+ * an element is searched in its row by the sorted column indices, the zeros are not stored, so
+ * the sparse matrix could be used in the elementwise expressions without densifying it.
+ */
+template <typename _ValueType>
+inline auto sparse(sparse_matrix<_ValueType> sp)
+    -> decltype(make_lambda(sp.shape(), sparse_matrix_functor<_ValueType>(sp), host_t{})) {
+    return make_lambda(sp.shape(), sparse_matrix_functor<_ValueType>(sp), host_t{});
+}
+
+/// the dense view of a csf_tensor, an element is searched level by level
+template <typename _ValueType, int_t _Rank>
+inline auto sparse(csf_tensor<_ValueType, _Rank> csf)
+    -> decltype(make_lambda(csf.shape(), csf_tensor_functor<_ValueType, _Rank>(csf), host_t{})) {
+    return make_lambda(csf.shape(), csf_tensor_functor<_ValueType, _Rank>(csf), host_t{});
+}
+
+}  // namespace view
+}  // namespace matazure
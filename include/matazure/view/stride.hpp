@@ -14,7 +14,7 @@ namespace view {
 template <typename _Tensor, typename _StrideType>
 struct stride_functor {
    private:
-    _Tensor ts_;
+    view_capture_t<_Tensor> ts_;
     _StrideType stride_;
 
    public:
@@ -24,6 +24,11 @@ struct stride_functor {
         -> decltype((ts_(idx * stride_))) {
         return ts_(idx * stride_);
     }
+
+    /// whether the source may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(ts_, first, last);
+    }
 };
 
 /**
@@ -33,11 +38,13 @@ struct stride_functor {
  * @return a stride indexing lambda_tensor
  */
 template <typename _Tensor, typename _StrideType>
-inline auto stride(_Tensor ts, _StrideType stride)
-    -> decltype(make_lambda(ts.shape() / stride, stride_functor<_Tensor, _StrideType>(ts, stride),
-                            runtime_t<_Tensor>{}, layout_t<_Tensor>{})) {
-    return make_lambda(ts.shape() / stride, stride_functor<_Tensor, _StrideType>(ts, stride),
-                       runtime_t<_Tensor>{}, layout_t<_Tensor>{});
+inline auto stride(_Tensor&& ts, _StrideType stride)
+    -> decltype(make_lambda(ts.shape() / stride,
+                            stride_functor<view_source_t<_Tensor>, _StrideType>(ts, stride),
+                            runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{})) {
+    return make_lambda(ts.shape() / stride,
+                       stride_functor<view_source_t<_Tensor>, _StrideType>(ts, stride),
+                       runtime_t<decay_t<_Tensor>>{}, layout_t<decay_t<_Tensor>>{});
 }
 
 }  // namespace view
@@ -13,9 +13,11 @@ namespace view {
     };                                                                                \
                                                                                       \
     template <typename _Tensor>                                                       \
-    inline auto fun (_Tensor ts)                                                       \
-        ->decltype(map(ts, fun##_functor<typename _Tensor::value_type>())) {          \
-        return map(ts, fun##_functor<typename _Tensor::value_type>());                \
+    inline auto fun (_Tensor&& ts)                                                     \
+        ->decltype(map(std::forward<_Tensor>(ts),                                     \
+                       fun##_functor<typename decay_t<_Tensor>::value_type>())) {     \
+        return map(std::forward<_Tensor>(ts),                                         \
+                   fun##_functor<typename decay_t<_Tensor>::value_type>());           \
     }
 // clang-format on
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <matazure/view/binary.hpp>
+#include <matazure/view/bit.hpp>
 #include <matazure/view/broadcast.hpp>
 #include <matazure/view/cast.hpp>
 #include <matazure/view/clamp_zero.hpp>
@@ -12,8 +13,12 @@
 #include <matazure/view/ones.hpp>
 #include <matazure/view/pad.hpp>
 #include <matazure/view/permute.hpp>
+#include <matazure/view/random.hpp>
+#include <matazure/view/resize.hpp>
+#include <matazure/view/saturate.hpp>
 #include <matazure/view/shift.hpp>
 #include <matazure/view/slice.hpp>
+#include <matazure/view/sparse.hpp>
 #include <matazure/view/stride.hpp>
 #include <matazure/view/unary.hpp>
 #include <matazure/view/zeros.hpp>
@@ -23,6 +23,11 @@ struct zip_functor {
         return access_imp(idx, make_integer_sequence<int_t, sizeof...(_Tensors)>{});
     }
 
+    /// whether the zipped tensors may read the memory [first, last)
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::may_alias(tensors_, first, last);
+    }
+
    private:
     template <int_t... _Indices>
     MATAZURE_GENERAL tuple<reference_t<_Tensors>...> access_imp(
@@ -31,7 +36,7 @@ struct zip_functor {
     }
 
    private:
-    tuple<_Tensors...> tensors_;
+    tuple<view_capture_t<_Tensors>...> tensors_;
 };
 
 template <typename... _Tensors>
@@ -45,8 +50,9 @@ inline auto zip_imp(tuple<_Tensors...> tensors)
 }
 
 template <typename... _Tensors>
-inline auto zip(_Tensors... tensors) -> decltype(zip_imp(tuple<_Tensors...>(tensors...))) {
-    return zip_imp(tuple<_Tensors...>(tensors...));
+inline auto zip(_Tensors&&... tensors)
+    -> decltype(zip_imp(tuple<view_source_t<_Tensors>...>(tensors...))) {
+    return zip_imp(tuple<view_source_t<_Tensors>...>(tensors...));
 }
 
 }  // namespace view
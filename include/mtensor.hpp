@@ -2,12 +2,27 @@
 
 #include <matazure/allocator.hpp>
 #include <matazure/binary_operator.hpp>
+#include <matazure/chunk_store.hpp>
+#include <matazure/dynamic_dispatch.hpp>
 #include <matazure/dynamic_tensor.hpp>
+#include <matazure/gaussian_blur.hpp>
 #include <matazure/geometry.hpp>
+#include <matazure/half.hpp>
+#include <matazure/huge_page_allocator.hpp>
 #include <matazure/io.hpp>
+#include <matazure/layout_copy.hpp>
 #include <matazure/mem_copy.hpp>
+#include <matazure/morphology.hpp>
+#include <matazure/npy.hpp>
+#include <matazure/numa_allocator.hpp>
+#include <matazure/quantized.hpp>
+#include <matazure/random.hpp>
 #include <matazure/reshape.hpp>
+#include <matazure/resize.hpp>
+#include <matazure/saturate.hpp>
+#include <matazure/sparse.hpp>
 #include <matazure/tensor_selector.hpp>
+#include <matazure/transpose.hpp>
 #include <matazure/view/view.hpp>
 
 #ifdef MATAZURE_OPENMP
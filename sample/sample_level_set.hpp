@@ -260,16 +260,19 @@ image_type drlse_edge(image_type mat_phi0, image_type mat_g, float lambda, float
 
     auto mat_g_grad = gradient(mat_g);
     auto mat_phi = identify(mat_phi0, runtime_t<image_type>{});
+    // the buffers are reused by all iterations, mat_phi and mat_phi_next are ping-ponged
+    image_type mat_phi_next(mat_phi.shape());
+    decltype(mat_g_grad) mat_normalized_gradient_phi(mat_phi.shape());
 
     while (counter--) {
         neumann_bound_conf(mat_phi, std::integral_constant<int_t, rank>{});
         auto mat_phi_grad = gradient(mat_phi);
-        auto mat_normalized_gradient_phi =
-            view::map(mat_phi_grad,
-                      [] MATAZURE_GENERAL(point<value_type, rank> p) { return normalize(p); })
-                .persist();
+        view::map(mat_phi_grad,
+                  [] MATAZURE_GENERAL(point<value_type, rank> p) { return normalize(p); })
+            .persist_into(mat_normalized_gradient_phi);
         auto mat_curvature = div(mat_normalized_gradient_phi);
-        auto mat_dist_term = laplace(mat_phi) - mat_curvature;
+        auto mat_laplace_phi = laplace(mat_phi);
+        auto mat_dist_term = mat_laplace_phi - mat_curvature;
 
         auto mat_dirac_phi = view::map(mat_phi, [epsilon] MATAZURE_GENERAL(value_type x) {
             if (std::abs(x) > epsilon) return 0.0f;
@@ -287,10 +290,9 @@ image_type drlse_edge(image_type mat_phi0, image_type mat_g, float lambda, float
         });
         auto mat_edge_term = mat_dirac_phi * mat_temp_sum + mat_area_term * mat_curvature;
 
-        auto mat_phi_next = (mat_phi + timestep * (mu * mat_dist_term + lambda * mat_edge_term +
-                                                   alpha * mat_area_term))
-                                .persist();
-        copy(mat_phi_next, mat_phi);
+        (mat_phi + timestep * (mu * mat_dist_term + lambda * mat_edge_term + alpha * mat_area_term))
+            .persist_into(mat_phi_next);
+        std::swap(mat_phi, mat_phi_next);
     }
 
     return mat_phi;
@@ -0,0 +1 @@
+#include "ut_chunk_store.hpp"
\ No newline at end of file
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdio>
+#include "ut_foundation.hpp"
+
+namespace {
+
+inline dynamic_tensor smooth_volume(dynamic_shape shape) {
+    dynamic_tensor ts(data_type::dt_uint16, shape);
+    auto p = ts.data<std::uint16_t>();
+    for (int_t i = 0; i < ts.size(); ++i) {
+        p[i] = static_cast<std::uint16_t>(1000 + (i / 7) % 50 + (i % 3 == 0 ? 1 : 0));
+    }
+    return ts;
+}
+
+inline std::streamoff file_size(const std::string& path) {
+    std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+    return ifs.tellg();
+}
+
+}  // namespace
+
+TEST(ChunkStoreTests, Codecs) {
+    std::vector<byte> data(5000);
+    for (int_t i = 0; i < 5000; ++i) data[i] = static_cast<byte>(i % 300 < 150 ? i % 7 : 9);
+    for (auto codec : {chunk_codec::shuffle_lz, chunk_codec::delta_rle}) {
+        for (int_t element_size : {1, 2, 4, 8}) {
+            auto blob = matazure::internal::encode_chunk(codec, data.data(), 4000, element_size);
+            EXPECT_LT(blob.size(), 4000u);
+            std::vector<byte> decoded(4000);
+            matazure::internal::decode_chunk(codec, blob, decoded.data(), 4000, element_size);
+            EXPECT_TRUE(std::equal(decoded.begin(), decoded.end(), data.begin()));
+        }
+    }
+}
+
+TEST(ChunkStoreTests, ReadRegion) {
+    auto ts = smooth_volume({20, 17, 33});
+    auto ts_typed = ts.as_tensor<std::uint16_t, 3>();
+    std::string path = "ut_chunk_store.mtzc";
+    for (auto codec : {chunk_codec::none, chunk_codec::shuffle_lz, chunk_codec::delta_rle}) {
+        write_chunked(path, ts, {8, 8, 8}, codec);
+        auto info = read_chunked_info(path);
+        EXPECT_EQ(data_type::dt_uint16, info.type);
+        EXPECT_EQ(ts.shape(), info.shape);
+        if (codec != chunk_codec::none) {
+            EXPECT_LT(file_size(path), ts.size() * ts.element_size());
+        }
+
+        auto ts_region = read_region(path, {3, 5, 7}, {12, 9, 20}).as_tensor<std::uint16_t, 3>();
+        for_index(ts_region.shape(), [=](pointi<3> idx) {
+            EXPECT_EQ(ts_typed(idx + pointi<3>{3, 5, 7}), ts_region(idx));
+        });
+
+        auto ts_whole = read_chunked(path);
+        EXPECT_TRUE(std::equal(ts.data<std::uint16_t>(), ts.data<std::uint16_t>() + ts.size(),
+                               ts_whole.data<std::uint16_t>()));
+    }
+    EXPECT_THROW(read_region(path, {0, 0, 0}, {21, 1, 1}), invalid_shape);
+    std::remove(path.c_str());
+
+    // a strided view is written by its elements
+    write_chunked(path, ts.permute({2, 1, 0}), {5, 5, 5});
+    auto ts_permuted = read_chunked(path).as_tensor<std::uint16_t, 3>();
+    for_index(ts_permuted.shape(), [=](pointi<3> idx) {
+        EXPECT_EQ(ts_typed(pointi<3>{idx[2], idx[1], idx[0]}), ts_permuted(idx));
+    });
+    std::remove(path.c_str());
+
+    std::ofstream(path, std::ios::binary) << "not a chunk store";
+    EXPECT_THROW(read_chunked_info(path), invalid_file_format);
+    std::remove(path.c_str());
+}
+
+TEST(ChunkStoreTests, CorruptedChunk) {
+    auto ts = smooth_volume({20, 17, 33});
+    std::string path = "ut_chunk_store_corrupted.mtzc";
+    write_chunked(path, ts, {8, 8, 8}, chunk_codec::delta_rle);
+    {
+        // overwrites the blob of the first chunk, its offset and size follow the header
+        std::fstream fs(path, std::ios::binary | std::ios::in | std::ios::out);
+        std::uint64_t offset_size[2];
+        fs.seekg(4 + 4 * sizeof(std::uint32_t) + 6 * sizeof(std::int64_t) + sizeof(std::uint64_t));
+        fs.read(reinterpret_cast<char*>(offset_size), sizeof(offset_size));
+        fs.seekp(offset_size[0]);
+        for (std::uint64_t i = 0; i < offset_size[1]; ++i) fs.put(static_cast<char>(0xff));
+    }
+
+    // the decoding error is rethrown after the loop of chunks
+    EXPECT_THROW(read_chunked(path), invalid_file_format);
+    std::remove(path.c_str());
+}
+
+TEST(ChunkStoreTests, CorruptedHeader) {
+    auto ts = smooth_volume({20, 17, 33});
+    std::string path = "ut_chunk_store_header.mtzc";
+    const std::streamoff rank_pos = 4 + 2 * sizeof(std::uint32_t);
+    const std::streamoff shape_pos = 4 + 4 * sizeof(std::uint32_t);
+    const std::streamoff index_pos = shape_pos + 6 * sizeof(std::int64_t) + sizeof(std::uint64_t);
+    auto corrupt = [&](std::streamoff pos, const void* p, std::streamsize bytes) {
+        write_chunked(path, ts, {8, 8, 8});
+        std::fstream fs(path, std::ios::binary | std::ios::in | std::ios::out);
+        fs.seekp(pos);
+        fs.write(reinterpret_cast<const char*>(p), bytes);
+    };
+
+    std::uint32_t rank = 0x7fffffff;
+    corrupt(rank_pos, &rank, sizeof(rank));
+    EXPECT_THROW(read_chunked_info(path), invalid_file_format);
+    std::int64_t negative_dim = -20;
+    corrupt(shape_pos, &negative_dim, sizeof(negative_dim));
+    EXPECT_THROW(read_chunked_info(path), invalid_file_format);
+    std::int64_t huge_dim = std::int64_t(1) << 40;
+    corrupt(shape_pos, &huge_dim, sizeof(huge_dim));
+    EXPECT_THROW(read_chunked_info(path), invalid_shape);
+    std::int64_t zero_chunk_dim = 0;
+    corrupt(shape_pos + 3 * sizeof(std::int64_t), &zero_chunk_dim, sizeof(zero_chunk_dim));
+    EXPECT_THROW(read_chunked_info(path), invalid_file_format);
+    // the chunks count overflows int_t, the dims are valid themselves
+    std::int64_t dims[6] = {1 << 16, 1 << 16, 1, 1, 1, 1};
+    corrupt(shape_pos, dims, sizeof(dims));
+    EXPECT_THROW(read_chunked_info(path), invalid_shape);
+    // the blob of the first chunk exceeds the file
+    std::uint64_t offset_size[2] = {0, std::uint64_t(1) << 40};
+    corrupt(index_pos, offset_size, sizeof(offset_size));
+    EXPECT_THROW(read_chunked(path), invalid_file_format);
+    std::remove(path.c_str());
+}
+
+TEST(ChunkStoreTests, TruncatedFile) {
+    auto ts = smooth_volume({20, 17, 33});
+    std::string path = "ut_chunk_store_truncated.mtzc";
+    write_chunked(path, ts, {8, 8, 8});
+    std::vector<char> bytes(static_cast<std::size_t>(file_size(path)));
+    std::ifstream(path, std::ios::binary).read(bytes.data(), bytes.size());
+
+    // the file is cut in the fixed header, the dims, the index and the blobs
+    for (std::size_t size : {std::size_t(2), std::size_t(22), std::size_t(60), std::size_t(100),
+                             bytes.size() - 1}) {
+        std::ofstream(path, std::ios::binary).write(bytes.data(), size);
+        EXPECT_THROW(read_chunked(path), invalid_file_format);
+    }
+    std::remove(path.c_str());
+    EXPECT_THROW(read_chunked_info(path), std::ios_base::failure);
+}
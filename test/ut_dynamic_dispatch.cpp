@@ -0,0 +1 @@
+#include "ut_dynamic_dispatch.hpp"
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "ut_foundation.hpp"
+
+namespace {
+
+inline dynamic_tensor::shape_type dispatch_shape(int_t rank) {
+    dynamic_tensor::shape_type shape(rank);
+    for (int_t i = 0; i < rank; ++i) shape[i] = 2 + i % 3;
+    return shape;
+}
+
+template <typename _ValueType>
+inline dynamic_tensor iota_dynamic_tensor(int_t rank) {
+    dynamic_tensor ts(get_data_type_traits<_ValueType>::value, dispatch_shape(rank));
+    auto p = ts.data<_ValueType>();
+    for (int_t i = 0; i < ts.size(); ++i) p[i] = static_cast<_ValueType>(i % 37);
+    return ts;
+}
+
+}  // namespace
+
+TEST(DynamicDispatchTests, CopyFillOfRanks) {
+    for (int_t rank = 1; rank <= 6; ++rank) {
+        auto ts_src = iota_dynamic_tensor<std::int16_t>(rank);
+        dynamic_tensor ts_dst(ts_src.type(), ts_src.shape());
+        copy(ts_src, ts_dst);
+        for (int_t i = 0; i < ts_src.size(); ++i) {
+            EXPECT_EQ(ts_src.data<std::int16_t>()[i], ts_dst.data<std::int16_t>()[i]);
+        }
+
+        dynamic_tensor ts_half(data_type::dt_float16, dispatch_shape(rank));
+        fill(ts_half, 2.5);
+        for (int_t i = 0; i < ts_half.size(); ++i) {
+            EXPECT_EQ(2.5f, float(ts_half.data<half>()[i]));
+        }
+    }
+}
+
+TEST(DynamicDispatchTests, Cast) {
+    auto ts_int = iota_dynamic_tensor<std::int32_t>(3);
+    auto ts_float = cast(ts_int, data_type::dt_float32);
+    auto ts_half = cast(ts_float, data_type::dt_float16);
+    auto ts_byte = cast(ts_half, data_type::dt_uint8);
+    EXPECT_EQ(data_type::dt_uint8, ts_byte.type());
+    for (int_t i = 0; i < ts_int.size(); ++i) {
+        EXPECT_EQ(static_cast<float>(i % 37), ts_float.data<float>()[i]);
+        EXPECT_EQ(static_cast<float>(i % 37), float(ts_half.data<half>()[i]));
+        EXPECT_EQ(i % 37, ts_byte.data<std::uint8_t>()[i]);
+    }
+}
+
+TEST(DynamicDispatchTests, Binary) {
+    // the rank 5 is the collapsed path
+    for (int_t rank : {2, 5}) {
+        auto ts_lhs = iota_dynamic_tensor<float>(rank);
+        auto ts_rhs = cast(iota_dynamic_tensor<std::int8_t>(rank), data_type::dt_float32);
+        dynamic_tensor ts_dst(data_type::dt_float32, ts_lhs.shape());
+        fill(ts_rhs, 3);
+        transform(ts_lhs, ts_rhs, ts_dst, binary_op::mul);
+        for (int_t i = 0; i < ts_dst.size(); ++i) {
+            EXPECT_EQ(3.0f * (i % 37), ts_dst.data<float>()[i]);
+        }
+        transform(ts_lhs, ts_rhs, ts_dst, binary_op::max);
+        for (int_t i = 0; i < ts_dst.size(); ++i) {
+            EXPECT_EQ(std::max(3.0f, float(i % 37)), ts_dst.data<float>()[i]);
+        }
+
+        auto ts_bf_lhs = cast(ts_lhs, data_type::dt_bfloat16);
+        auto ts_bf_rhs = cast(ts_rhs, data_type::dt_bfloat16);
+        dynamic_tensor ts_bf_dst(data_type::dt_bfloat16, ts_lhs.shape());
+        transform(ts_bf_lhs, ts_bf_rhs, ts_bf_dst, binary_op::sub);
+        for (int_t i = 0; i < ts_dst.size(); ++i) {
+            EXPECT_EQ(float(i % 37) - 3.0f, float(ts_bf_dst.data<bfloat16>()[i]));
+        }
+    }
+}
+
+TEST(DynamicDispatchTests, Reduce) {
+    auto ts = iota_dynamic_tensor<std::int8_t>(4);
+    std::int64_t sum = 0;
+    for (int_t i = 0; i < ts.size(); ++i) sum += i % 37;
+    auto ts_sum = reduce(ts, reduce_op::sum);
+    EXPECT_EQ(data_type::dt_int64, ts_sum.type());
+    EXPECT_EQ(sum, ts_sum.data<std::int64_t>()[0]);
+
+    auto ts_max = reduce(cast(ts, data_type::dt_float16), reduce_op::max);
+    EXPECT_EQ(data_type::dt_float16, ts_max.type());
+    EXPECT_EQ(36.0f, float(ts_max.data<half>()[0]));
+    auto ts_min = reduce(cast(ts, data_type::dt_uint32), reduce_op::min);
+    EXPECT_EQ(0u, ts_min.data<std::uint32_t>()[0]);
+}
+
+TEST(DynamicDispatchTests, Mismatched) {
+    auto ts_lhs = iota_dynamic_tensor<float>(2);
+    auto ts_rhs = iota_dynamic_tensor<double>(2);
+    dynamic_tensor ts_dst(data_type::dt_float32, ts_lhs.shape());
+    EXPECT_THROW(transform(ts_lhs, ts_rhs, ts_dst, binary_op::add), invalid_data_type);
+    dynamic_tensor ts_other(data_type::dt_float32, dispatch_shape(3));
+    EXPECT_THROW(copy(ts_lhs, ts_other), invalid_shape);
+    dynamic_tensor ts_undefined(data_type::undefined, ts_lhs.shape(), ts_lhs.shared_data<void>());
+    EXPECT_THROW(reduce(ts_undefined, reduce_op::sum), invalid_data_type);
+}
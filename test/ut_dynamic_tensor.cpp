@@ -0,0 +1 @@
+#include "ut_dynamic_tensor.hpp"
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "ut_foundation.hpp"
+
+namespace {
+
+inline dynamic_tensor iota_float_dynamic_tensor(dynamic_tensor::shape_type shape) {
+    dynamic_tensor ts(data_type::dt_float32, shape);
+    auto p = ts.data<float>();
+    for (int_t i = 0; i < ts.size(); ++i) p[i] = static_cast<float>(i);
+    return ts;
+}
+
+}  // namespace
+
+TEST(DynamicTensorTests, AlignedStorage) {
+    dynamic_tensor ts(data_type::dt_uint8, dynamic_tensor::shape_type{3, 7});
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(ts.data()) % dynamic_tensor::alignment);
+
+    dynamic_tensor ts_page(data_type::dt_float64, dynamic_tensor::shape_type{5},
+                           aligned_allocator<byte, 4096>{});
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(ts_page.data()) % 4096);
+    EXPECT_EQ(5, ts_page.size());
+
+    // the rank 8 shape is not inline
+    dynamic_tensor::shape_type shape(8);
+    for (int_t i = 0; i < 8; ++i) shape[i] = 2;
+    dynamic_tensor ts_rank8(data_type::dt_int16, shape);
+    EXPECT_EQ(8, ts_rank8.rank());
+    EXPECT_EQ(256, ts_rank8.size());
+    EXPECT_EQ(128, ts_rank8.stride(0));
+    EXPECT_TRUE(ts_rank8.is_contiguous());
+}
+
+TEST(DynamicTensorTests, AsTensor) {
+    auto ts = iota_float_dynamic_tensor({4, 6});
+    auto ts_typed = ts.as_tensor<float, 2>();
+    EXPECT_EQ(ts.data<float>(), ts_typed.data());
+    EXPECT_EQ(13.0f, ts_typed(pointi<2>{2, 1}));
+    EXPECT_THROW((ts.as_tensor<int, 2>()), invalid_data_type);
+    EXPECT_THROW((ts.as_tensor<float, 3>()), invalid_shape);
+
+    auto ts_wrapped = dynamic_tensor_wrap(ts_typed);
+    EXPECT_EQ(ts.shape(), ts_wrapped.shape());
+    EXPECT_EQ(ts.data(), ts_wrapped.data());
+}
+
+TEST(DynamicTensorTests, SliceAndPermuteViews) {
+    auto ts = iota_float_dynamic_tensor({4, 5, 6});
+    auto ts_slice = ts.slice({1, 2, 0}, {2, 3, 6});
+    EXPECT_FALSE(ts_slice.is_contiguous());
+    EXPECT_EQ(ts.data<float>() + 1 * 30 + 2 * 6, ts_slice.data<float>());
+    EXPECT_THROW((ts_slice.as_tensor<float, 3>()), invalid_shape);
+    EXPECT_THROW(ts.slice({3, 0, 0}, {2, 5, 6}), invalid_shape);
+
+    // the rows of the slice are contiguous
+    auto ts_slice_re = contiguous(ts_slice).as_tensor<float, 3>();
+    for_index(ts_slice_re.shape(), [=](pointi<3> idx) {
+        EXPECT_EQ((idx[0] + 1) * 30 + (idx[1] + 2) * 6 + idx[2], ts_slice_re(idx));
+    });
+
+    auto ts_permuted = ts.permute({2, 0, 1});
+    EXPECT_EQ((dynamic_tensor::shape_type{6, 4, 5}), ts_permuted.shape());
+    EXPECT_THROW(ts.permute({0, 0, 1}), invalid_shape);
+    auto ts_permuted_re = contiguous(ts_permuted).as_tensor<float, 3>();
+    for_index(ts_permuted_re.shape(), [=](pointi<3> idx) {
+        EXPECT_EQ(idx[1] * 30 + idx[2] * 6 + idx[0], ts_permuted_re(idx));
+    });
+}
+
+TEST(DynamicTensorTests, StridedOperations) {
+    auto ts = iota_float_dynamic_tensor({8, 9, 10});
+    auto ts_permuted = ts.permute({1, 2, 0});
+    auto ts_contiguous = contiguous(ts_permuted);
+    dynamic_tensor ts_dst(data_type::dt_float32, ts_permuted.shape());
+    transform(ts_permuted, ts_contiguous, ts_dst, binary_op::add);
+    auto ts_dst_typed = ts_dst.as_tensor<float, 3>();
+    for_index(ts_dst_typed.shape(), [=](pointi<3> idx) {
+        EXPECT_EQ(2.0f * (idx[2] * 90 + idx[0] * 10 + idx[1]), ts_dst_typed(idx));
+    });
+
+    auto ts_slice = ts.slice({1, 1, 1}, {3, 4, 5});
+    float sum = 0.0f;
+    for_index(pointi<3>{3, 4, 5}, [&](pointi<3> idx) {
+        sum += (idx[0] + 1) * 90 + (idx[1] + 1) * 10 + idx[2] + 1;
+    });
+    EXPECT_EQ(sum, reduce(ts_slice, reduce_op::sum).data<float>()[0]);
+
+    // a strided view of rank 6 uses the general path
+    dynamic_tensor::shape_type shape(6);
+    for (int_t i = 0; i < 6; ++i) shape[i] = 2 + i % 2;
+    auto ts6 = iota_float_dynamic_tensor(shape);
+    auto ts6_permuted = ts6.permute({5, 4, 3, 2, 1, 0});
+    auto ts6_half = cast(ts6_permuted, data_type::dt_float16);
+    fill(ts6_permuted, 1);
+    EXPECT_EQ(ts6.size(), reduce(ts6, reduce_op::sum).data<float>()[0]);
+    auto ts6_half_max = reduce(ts6_half, reduce_op::max);
+    EXPECT_EQ(ts6.size() - 1.0f, float(ts6_half_max.data<half>()[0]));
+}
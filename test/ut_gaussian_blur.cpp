@@ -0,0 +1 @@
+#include "ut_gaussian_blur.hpp"
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "ut_foundation.hpp"
+
+namespace {
+
+inline tensor<float, 2> brute_force_gaussian_blur(tensor<float, 2> ts, float sigma) {
+    auto radius = static_cast<int_t>(std::ceil(5.0f * sigma));
+    tensor<float, 2> ts_re(ts.shape());
+    for_index(ts.shape(), [&](pointi<2> idx) {
+        double sum = 0;
+        double weight_sum = 0;
+        for_index(pointi<2>::all(2 * radius + 1), [&](pointi<2> offset) {
+            auto d = offset - radius;
+            auto w = std::exp(-0.5 * (d[0] * d[0] + d[1] * d[1]) / (sigma * sigma));
+            auto neighbor_idx = idx + d;
+            for (int_t i = 0; i < 2; ++i) {
+                neighbor_idx[i] = border_index(neighbor_idx[i], ts.shape(i), border_mode::reflect);
+            }
+            sum += w * ts(neighbor_idx);
+            weight_sum += w;
+        });
+        ts_re(idx) = static_cast<float>(sum / weight_sum);
+    });
+
+    return ts_re;
+}
+
+inline tensor<float, 2> make_test_image(pointi<2> shape) {
+    tensor<float, 2> ts(shape);
+    for_index(shape, [&](pointi<2> idx) {
+        ts(idx) = (idx[0] / 8 + idx[1] / 8) % 2 ? 1.0f : 0.0f;
+    });
+    return ts;
+}
+
+}  // namespace
+
+TEST(GaussianBlurTests, SmallSigmaFir) {
+    auto ts = make_test_image(pointi<2>{40, 50});
+    auto sigma = 1.5f;
+    tensor<float, 2> ts_blur(ts.shape());
+    gaussian_blur(ts, ts_blur, sigma);
+
+    auto ts_expected = brute_force_gaussian_blur(ts, sigma);
+    for_index(ts.shape(), [&](pointi<2> idx) { ASSERT_NEAR(ts_expected(idx), ts_blur(idx), 0.01f); });
+}
+
+TEST(GaussianBlurTests, LargeSigmaIir) {
+    auto ts = make_test_image(pointi<2>{64, 80});
+    auto sigma = 6.0f;
+    tensor<float, 2> ts_blur(ts.shape());
+    gaussian_blur(ts, ts_blur, sigma);
+
+    auto ts_expected = brute_force_gaussian_blur(ts, sigma);
+    for_index(ts.shape(), [&](pointi<2> idx) { ASSERT_NEAR(ts_expected(idx), ts_blur(idx), 0.03f); });
+}
+
+TEST(GaussianBlurTests, ConstantIsInvariant) {
+    for (auto sigma : {0.8f, 12.0f}) {
+        tensor<double, 3> ts(pointi<3>{5, 17, 23});
+        fill(ts, 3.0);
+        gaussian_blur(ts, ts, sigma);
+        for_each(ts, [](double v) { ASSERT_NEAR(3.0, v, 1e-6); });
+    }
+}
@@ -0,0 +1 @@
+#include "ut_half.hpp"
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "ut_foundation.hpp"
+
+TEST(HalfTests, ScalarConversion) {
+    EXPECT_EQ(0x3c00, half(1.0f).bits);
+    EXPECT_EQ(0xc000, half(-2.0f).bits);
+    EXPECT_EQ(0x7bff, half(65504.0f).bits);
+    EXPECT_EQ(0x7c00, half(65520.0f).bits);
+    EXPECT_EQ(0x0001, half(5.9604645e-8f).bits);
+    // rounds to nearest even
+    EXPECT_EQ(0x3c00, half(1.0f + 1.0f / 2048).bits);
+    EXPECT_EQ(0x3c02, half(1.0f + 3.0f / 2048).bits);
+
+    // all finite half values are exact in float
+    for (int_t bits = 0; bits < 0x10000; ++bits) {
+        auto h = half::from_bits(static_cast<std::uint16_t>(bits));
+        auto v = float(h);
+        if (v != v) continue;
+        EXPECT_EQ(h.bits, half(v).bits);
+    }
+
+    EXPECT_EQ(0x3f80, bfloat16(1.0f).bits);
+    EXPECT_EQ(0x3f80, bfloat16(1.0f + 1.0f / 256).bits);
+    EXPECT_EQ(0x3f82, bfloat16(1.0f + 3.0f / 256).bits);
+    EXPECT_FLOAT_EQ(3.0f, bfloat16(1.5f) + bfloat16(1.5f));
+
+    half h = 1.5f;
+    h *= 2;
+    EXPECT_FLOAT_EQ(3.0f, h);
+    data_type half_type = get_data_type_traits<half>::value;
+    data_type bfloat16_type = get_data_type_traits<bfloat16>::value;
+    EXPECT_EQ(data_type::dt_float16, half_type);
+    EXPECT_EQ(data_type::dt_bfloat16, bfloat16_type);
+}
+
+TEST(HalfTests, CastViewBulkConversion) {
+    tensor<float, 2> ts(pointi<2>{37, 29});
+    for_index(0, ts.size(), [=](int_t i) { ts[i] = static_cast<float>(i) * 0.37f - 100.0f; });
+
+    tensor<half, 2> ts_half(ts.shape());
+    copy(view::cast<half>(ts), ts_half);
+    auto ts_float = view::cast<float>(ts_half).persist();
+    tensor<bfloat16, 2> ts_bfloat16(ts.shape());
+    copy(view::cast<bfloat16>(ts), ts_bfloat16);
+    auto ts_float_bf = view::cast<float>(ts_bfloat16).persist();
+
+    for_index(0, ts.size(), [=](int_t i) {
+        EXPECT_EQ(half(ts[i]).bits, ts_half[i].bits);
+        EXPECT_EQ(float(ts_half[i]), ts_float[i]);
+        EXPECT_EQ(bfloat16(ts[i]).bits, ts_bfloat16[i].bits);
+        EXPECT_EQ(float(ts_bfloat16[i]), ts_float_bf[i]);
+    });
+}
+
+TEST(HalfTests, CastViewBulkConversionRvalue) {
+    auto make_ts = []() {
+        tensor<float, 2> ts(pointi<2>{19, 23});
+        for_index(0, ts.size(), [=](int_t i) { ts[i] = static_cast<float>(i) * 0.61f - 50.0f; });
+        return ts;
+    };
+    auto ts = make_ts();
+
+    // the views own the temporaries, they're converted by the bulk kernel too
+    tensor<half, 2> ts_half(ts.shape());
+    copy(view::cast<half>(make_ts()), ts_half);
+    tensor<bfloat16, 2> ts_bfloat16(ts.shape());
+    copy(view::cast<bfloat16>(make_ts()), ts_bfloat16);
+    tensor<float, 2> ts_float(ts.shape());
+    copy(view::cast<float>(view::cast<half>(make_ts()).persist()), ts_float);
+
+    for_index(0, ts.size(), [=](int_t i) {
+        EXPECT_EQ(half(ts[i]).bits, ts_half[i].bits);
+        EXPECT_EQ(bfloat16(ts[i]).bits, ts_bfloat16[i].bits);
+        EXPECT_EQ(float(ts_half[i]), ts_float[i]);
+    });
+}
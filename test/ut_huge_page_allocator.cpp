@@ -0,0 +1 @@
+#include "ut_huge_page_allocator.hpp"
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "ut_foundation.hpp"
+
+TEST(HugePageAllocatorTests, LargeAllocation) {
+    typedef tensor<float, 2, row_major_layout<2>, huge_page_allocator<float>> tensor_type;
+    auto stats_before = get_huge_page_stats();
+    {
+        // 4MiB and a row, it's rounded up to three huge pages
+        tensor_type ts(pointi<2>{1025, 1024});
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(ts.data()) % huge_page::page_size);
+        for (int_t i = 0; i < ts.size(); ++i) {
+            EXPECT_EQ(0.0f, ts[i]);
+            ts[i] = 1.0f;
+        }
+
+        auto stats = get_huge_page_stats();
+        EXPECT_EQ(stats_before.allocated_bytes + 3 * huge_page::page_size, stats.allocated_bytes);
+        EXPECT_EQ(stats.allocated_bytes,
+                  stats.hugetlb_bytes + stats.transparent_bytes + stats.normal_bytes);
+        // the kernel may back them by normal pages still, the backed bytes are only bounded
+        EXPECT_LE(stats.huge_page_backed_bytes, stats.hugetlb_bytes + stats.transparent_bytes);
+    }
+    EXPECT_EQ(stats_before.allocated_bytes, get_huge_page_stats().allocated_bytes);
+}
+
+TEST(HugePageAllocatorTests, SmallAllocation) {
+    typedef tensor<int_t, 1, row_major_layout<1>, huge_page_allocator<int_t>> tensor_type;
+    auto stats_before = get_huge_page_stats();
+    tensor_type ts(100);
+    for (int_t i = 0; i < ts.size(); ++i) {
+        EXPECT_EQ(0, ts[i]);
+    }
+
+    auto stats = get_huge_page_stats();
+    EXPECT_EQ(stats_before.normal_bytes + 100 * sizeof(int_t), stats.normal_bytes);
+}
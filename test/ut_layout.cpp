@@ -0,0 +1 @@
+#include "ut_layout.hpp"
\ No newline at end of file
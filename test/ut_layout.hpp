@@ -0,0 +1,82 @@
+#pragma once
+
+#include "ut_foundation.hpp"
+
+TEST(LayoutTests, TiledIndexOffsetRoundTrip) {
+    tiled_layout<3, dim<8, 8, 4>> layout(pointi<3>{13, 17, 9});
+    EXPECT_TRUE(equal(layout.grid_shape(), pointi<3>{2, 3, 3}));
+    EXPECT_EQ(2 * 3 * 3 * 8 * 8 * 4, layout.size());
+
+    std::vector<bool> is_used(layout.size(), false);
+    for_index(layout.shape(), [&](pointi<3> idx) {
+        auto offset = layout.index2offset(idx);
+        EXPECT_FALSE(is_used[offset]);
+        is_used[offset] = true;
+        EXPECT_TRUE(equal(idx, layout.offset2index(offset)));
+
+        for (int_t axis = 0; axis < 3; ++axis) {
+            for (int_t delta = -1; delta <= 1; delta += 2) {
+                auto neighbor_idx = idx;
+                neighbor_idx[axis] += delta;
+                if (neighbor_idx[axis] < 0 || neighbor_idx[axis] >= layout.shape()[axis]) continue;
+                EXPECT_EQ(layout.index2offset(neighbor_idx),
+                          layout.neighbor_offset(idx, offset, axis, delta));
+            }
+        }
+    });
+}
+
+TEST(LayoutTests, MortonIndexOffsetRoundTrip) {
+    morton_layout<2> layout_square(pointi<2>{4, 4});
+    EXPECT_EQ(16, layout_square.size());
+    // the last axis has the lowest bit
+    EXPECT_EQ(1, layout_square.index2offset(pointi<2>{0, 1}));
+    EXPECT_EQ(2, layout_square.index2offset(pointi<2>{1, 0}));
+    EXPECT_EQ(3, layout_square.index2offset(pointi<2>{1, 1}));
+    EXPECT_EQ(4, layout_square.index2offset(pointi<2>{0, 2}));
+
+    // the elongated shape isn't padded to a cube
+    morton_layout<3> layout(pointi<3>{5, 3, 33});
+    EXPECT_EQ(8 * 4 * 64, layout.size());
+
+    std::vector<bool> is_used(layout.size(), false);
+    for_index(layout.shape(), [&](pointi<3> idx) {
+        auto offset = layout.index2offset(idx);
+        EXPECT_FALSE(is_used[offset]);
+        is_used[offset] = true;
+        EXPECT_TRUE(equal(idx, layout.offset2index(offset)));
+
+        for (int_t axis = 0; axis < 3; ++axis) {
+            for (int_t delta = -2; delta <= 2; ++delta) {
+                auto neighbor_idx = idx;
+                neighbor_idx[axis] += delta;
+                if (neighbor_idx[axis] < 0 || neighbor_idx[axis] >= layout.shape()[axis]) continue;
+                EXPECT_EQ(layout.index2offset(neighbor_idx),
+                          layout.neighbor_offset(offset, axis, delta));
+            }
+        }
+    });
+}
+
+TEST(LayoutTests, CopyBetweenRowMajorAndBlocked) {
+    tensor<float, 3> ts(pointi<3>{19, 10, 21});
+    for_index(0, ts.size(), [=](int_t i) { ts[i] = static_cast<float>(i); });
+
+    tensor<float, 3, tiled_layout<3, dim<8, 8, 8>>> ts_tiled(ts.shape());
+    copy(ts, ts_tiled);
+    tensor<float, 3, morton_layout<3>> ts_morton(ts.shape());
+    copy(ts, ts_morton);
+    for_index(ts.shape(), [=](pointi<3> idx) {
+        EXPECT_EQ(ts(idx), ts_tiled(idx));
+        EXPECT_EQ(ts(idx), ts_morton(idx));
+    });
+
+    tensor<float, 3> ts_from_tiled(ts.shape());
+    copy(ts_tiled, ts_from_tiled);
+    tensor<float, 3> ts_from_morton(ts.shape());
+    copy(ts_morton, ts_from_morton);
+    for_index(0, ts.size(), [=](int_t i) {
+        EXPECT_EQ(ts[i], ts_from_tiled[i]);
+        EXPECT_EQ(ts[i], ts_from_morton[i]);
+    });
+}
@@ -0,0 +1 @@
+#include "ut_morphology.hpp"
\ No newline at end of file
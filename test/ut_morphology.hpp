@@ -0,0 +1,140 @@
+#pragma once
+
+#include "ut_foundation.hpp"
+
+namespace {
+
+template <typename _Tensor, typename _Op>
+inline typename _Tensor::value_type brute_force_window(_Tensor ts, pointi<_Tensor::rank> idx,
+                                                       int_t axis, int_t size, border_mode mode,
+                                                       typename _Tensor::value_type border_value,
+                                                       _Op op) {
+    auto re = border_value;
+    bool is_first = true;
+    for (int_t k = 0; k < size; ++k) {
+        auto neighbor_idx = idx;
+        neighbor_idx[axis] = border_index(idx[axis] - size / 2 + k, ts.shape(axis), mode);
+        auto v = neighbor_idx[axis] < 0 ? border_value : ts(neighbor_idx);
+        re = is_first ? v : op(re, v);
+        is_first = false;
+    }
+    return re;
+}
+
+template <int_t _Rank>
+inline tensor<int, _Rank> make_random_tensor(pointi<_Rank> shape) {
+    tensor<int, _Rank> ts(shape);
+    for_index(ts.size(), [&](int_t i) { ts[i] = (i * 7919 + 13) % 101; });
+    return ts;
+}
+
+}  // namespace
+
+TEST(MorphologyTests, MinMaxFilterAlongAxes) {
+    auto ts = make_random_tensor(pointi<3>{7, 19, 37});
+    for (int_t axis = 0; axis < 3; ++axis) {
+        for (int_t size : {1, 2, 3, 5, 8, 40}) {
+            for (auto mode : {border_mode::constant, border_mode::replicate, border_mode::reflect}) {
+                tensor<int, 3> ts_min(ts.shape());
+                tensor<int, 3> ts_max(ts.shape());
+                min_filter(sequence_policy{}, ts, ts_min, axis, size, mode, 1000);
+                max_filter(sequence_policy{}, ts, ts_max, axis, size, mode, -1000);
+
+                for_index(ts.shape(), [&](pointi<3> idx) {
+                    ASSERT_EQ(brute_force_window(ts, idx, axis, size, mode, 1000,
+                                                 matazure::internal::min_op{}),
+                              ts_min(idx));
+                    ASSERT_EQ(brute_force_window(ts, idx, axis, size, mode, -1000,
+                                                 matazure::internal::max_op{}),
+                              ts_max(idx));
+                });
+            }
+        }
+    }
+}
+
+TEST(MorphologyTests, ErodeDilate) {
+    auto ts = make_random_tensor(pointi<2>{33, 21});
+    pointi<2> size{5, 3};
+    tensor<int, 2> ts_erode(ts.shape());
+    tensor<int, 2> ts_dilate(ts.shape());
+    erode(ts, ts_erode, size);
+    dilate(ts, ts_dilate, size);
+
+    for_index(ts.shape(), [&](pointi<2> idx) {
+        auto min_v = numeric_limits<int>::max();
+        auto max_v = numeric_limits<int>::lowest();
+        for_index(size, [&](pointi<2> offset) {
+            auto neighbor_idx = idx + offset - size / 2;
+            for (int_t i = 0; i < 2; ++i) {
+                neighbor_idx[i] = border_index(neighbor_idx[i], ts.shape(i), border_mode::replicate);
+            }
+            min_v = std::min(min_v, ts(neighbor_idx));
+            max_v = std::max(max_v, ts(neighbor_idx));
+        });
+        ASSERT_EQ(min_v, ts_erode(idx));
+        ASSERT_EQ(max_v, ts_dilate(idx));
+    });
+}
+
+TEST(MorphologyTests, OpeningClosing) {
+    tensor<byte, 2> ts(pointi<2>{16, 16});
+    fill(ts, byte(0));
+    // a 1 pixel noise and a 6x6 square
+    ts(3, 3) = 255;
+    copy(view::ones<byte>(pointi<2>{6, 6}, host_t{}), view::slice(ts, pointi<2>{8, 8}, pointi<2>{6, 6}));
+
+    tensor<byte, 2> ts_open(ts.shape());
+    opening(ts, ts_open, pointi<2>{3, 3});
+    ASSERT_EQ(0, ts_open(3, 3));
+    ASSERT_EQ(1, ts_open(10, 10));
+
+    tensor<byte, 2> ts_close(ts.shape());
+    closing(ts_open, ts_close, pointi<2>{3, 3});
+    for_index(ts.shape(), [&](pointi<2> idx) { ASSERT_EQ(ts_open(idx), ts_close(idx)); });
+}
+
+TEST(MorphologyTests, OpeningClosingConstantBorder) {
+    // the windows along the axis 0 always reach the border
+    pointi<2> size{5, 1};
+    tensor<int, 2> ts_ones(pointi<2>{2, 8});
+    fill(ts_ones, 1);
+    tensor<int, 2> ts_open(ts_ones.shape());
+    opening(sequence_policy{}, ts_ones, ts_open, size, border_mode::constant, 0);
+    for_index(ts_open.shape(), [&](pointi<2> idx) { ASSERT_EQ(0, ts_open(idx)); });
+
+    tensor<int, 2> ts_zeros(ts_ones.shape());
+    fill(ts_zeros, 0);
+    tensor<int, 2> ts_close(ts_zeros.shape());
+    closing(sequence_policy{}, ts_zeros, ts_close, size, border_mode::constant, 9);
+    for_index(ts_close.shape(), [&](pointi<2> idx) { ASSERT_EQ(9, ts_close(idx)); });
+}
+
+TEST(MorphologyTests, OpeningClosingEvenSize) {
+    tensor<int, 2> ts_line{{0, 5, 5, 0}};
+    tensor<int, 2> ts_line_open(ts_line.shape());
+    opening(ts_line, ts_line_open, pointi<2>{1, 2});
+    ASSERT_EQ(0, ts_line_open(0, 3));
+
+    auto ts = make_random_tensor(pointi<2>{23, 17});
+    for (auto size : {pointi<2>{2, 2}, pointi<2>{4, 3}, pointi<2>{1, 6}}) {
+        tensor<int, 2> ts_open(ts.shape());
+        tensor<int, 2> ts_close(ts.shape());
+        opening(ts, ts_open, size);
+        closing(ts, ts_close, size);
+        for_index(ts.shape(), [&](pointi<2> idx) {
+            ASSERT_LE(ts_open(idx), ts(idx));
+            ASSERT_LE(ts(idx), ts_close(idx));
+        });
+
+        // the opening and the closing are idempotent
+        tensor<int, 2> ts_open_twice(ts.shape());
+        tensor<int, 2> ts_close_twice(ts.shape());
+        opening(ts_open, ts_open_twice, size);
+        closing(ts_close, ts_close_twice, size);
+        for_index(ts.shape(), [&](pointi<2> idx) {
+            ASSERT_EQ(ts_open(idx), ts_open_twice(idx));
+            ASSERT_EQ(ts_close(idx), ts_close_twice(idx));
+        });
+    }
+}
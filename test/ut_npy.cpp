@@ -0,0 +1 @@
+#include "ut_npy.hpp"
\ No newline at end of file
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <cstdio>
+#include "ut_foundation.hpp"
+
+TEST(NpyTests, SaveLoadTensor) {
+    std::string path = "ut_npy.npy";
+    tensor<float, 2> ts(pointi<2>{5, 7});
+    for_index(0, ts.size(), [=](int_t i) { ts[i] = 0.5f * i; });
+    save_npy(path, ts);
+
+    auto ts_dynamic = load_npy(path);
+    EXPECT_EQ(data_type::dt_float32, ts_dynamic.type());
+    EXPECT_EQ((dynamic_shape{5, 7}), ts_dynamic.shape());
+    auto ts_re = load_npy<float, 2>(path);
+    for_index(ts.shape(), [=](pointi<2> idx) { EXPECT_EQ(ts(idx), ts_re(idx)); });
+
+    auto ts_column_major = load_npy<float, 2, column_major_layout<2>>(path);
+    for_index(ts.shape(), [=](pointi<2> idx) { EXPECT_EQ(ts(idx), ts_column_major(idx)); });
+    EXPECT_THROW((load_npy<double, 2>(path)), invalid_data_type);
+
+    // the column major tensor is saved in fortran order and loaded as a permuted view
+    save_npy(path, ts_column_major);
+    auto ts_fortran = map_npy(path);
+    EXPECT_FALSE(ts_fortran.is_contiguous());
+    EXPECT_EQ((dynamic_shape{5, 7}), ts_fortran.shape());
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(ts_fortran.data()) % 64);
+    auto ts_fortran_re = load_npy<float, 2>(path);
+    for_index(ts.shape(), [=](pointi<2> idx) { EXPECT_EQ(ts(idx), ts_fortran_re(idx)); });
+    std::remove(path.c_str());
+}
+
+TEST(NpyTests, Header) {
+    std::string path = "ut_npy.npy";
+    // a big endian int16 array of shape (3,) written by hand
+    std::string dict = "{'descr': '>i2', 'fortran_order': False, 'shape': (3,), }";
+    dict.append(128 - 10 - dict.size() - 1, ' ');
+    dict.push_back('\n');
+    std::string bytes("\x93NUMPY\x01\x00", 8);
+    bytes.push_back(static_cast<char>(dict.size()));
+    bytes.push_back(0);
+    bytes += dict;
+    bytes += std::string("\x00\x01\x01\x00\xff\xfe", 6);
+    std::ofstream(path, std::ios::binary) << bytes;
+
+    for (auto ts : {load_npy(path), map_npy(path)}) {
+        EXPECT_EQ(data_type::dt_int16, ts.type());
+        EXPECT_EQ(dynamic_shape{3}, ts.shape());
+        EXPECT_EQ(1, ts.data<std::int16_t>()[0]);
+        EXPECT_EQ(256, ts.data<std::int16_t>()[1]);
+        EXPECT_EQ(-2, ts.data<std::int16_t>()[2]);
+    }
+
+    std::ofstream(path, std::ios::binary) << std::string(64, 'x');
+    EXPECT_THROW(load_npy(path), invalid_file_format);
+    std::remove(path.c_str());
+}
+
+TEST(NpyTests, Npz) {
+    std::string path = "ut_npy.npz";
+    dynamic_tensor ts_byte(data_type::dt_uint8, dynamic_shape{3});
+    dynamic_tensor ts_double(data_type::dt_float64, dynamic_shape{2, 3, 4});
+    for (int_t i = 0; i < 3; ++i) ts_byte.data<byte>()[i] = static_cast<byte>(i + 1);
+    for (int_t i = 0; i < 24; ++i) ts_double.data<double>()[i] = i * 0.25;
+    save_npz(path, {{"a", ts_byte}, {"b", ts_double.permute({2, 0, 1})}});
+
+    auto arrays = load_npz(path);
+    EXPECT_EQ(2u, arrays.size());
+    EXPECT_EQ(dynamic_shape{3}, arrays["a"].shape());
+    EXPECT_EQ(3, arrays["a"].data<byte>()[2]);
+    auto ts_b = contiguous(arrays["b"]).as_tensor<double, 3>();
+    auto ts_double_typed = ts_double.as_tensor<double, 3>();
+    for_index(ts_b.shape(), [=](pointi<3> idx) {
+        EXPECT_EQ(ts_double_typed(pointi<3>{idx[1], idx[2], idx[0]}), ts_b(idx));
+    });
+    std::remove(path.c_str());
+}
+
+TEST(NpyTests, HeaderShapeOverflow) {
+    std::string path = "ut_npy.npy";
+    // the elements count exceeds int_t, it's rejected before the data is read
+    std::string dict = "{'descr': '<f4', 'fortran_order': False, 'shape': (100000, 100000), }";
+    dict.append(128 - 10 - dict.size() - 1, ' ');
+    dict.push_back('\n');
+    std::string bytes("\x93NUMPY\x01\x00", 8);
+    bytes.push_back(static_cast<char>(dict.size()));
+    bytes.push_back(0);
+    bytes += dict;
+    std::ofstream(path, std::ios::binary) << bytes;
+
+    EXPECT_THROW(load_npy(path), invalid_shape);
+    EXPECT_THROW(map_npy(path), invalid_shape);
+    std::remove(path.c_str());
+}
+
+TEST(NpyTests, SaveNpyStreamExceptions) {
+    std::ostringstream ostr;
+    dynamic_tensor ts(data_type::dt_int32, dynamic_shape{4});
+    save_npy(ostr, ts);
+    // the exceptions mask of the caller's stream is not changed
+    EXPECT_EQ(std::ios_base::goodbit, ostr.exceptions());
+
+    std::ofstream ofs;
+    EXPECT_THROW(save_npy(ofs, ts), std::ios_base::failure);
+    EXPECT_EQ(std::ios_base::goodbit, ofs.exceptions());
+}
+
+TEST(NpyTests, Npz64) {
+    std::string path = "ut_npy.npz";
+    dynamic_tensor ts(data_type::dt_int16, dynamic_shape{3});
+    for (int_t i = 0; i < 3; ++i) ts.data<std::int16_t>()[i] = static_cast<std::int16_t>(i - 1);
+    std::ostringstream npy;
+    save_npy(npy, ts);
+    auto data = npy.str();
+
+    // a zip64 archive, the sizes and offsets are in the zip64 extra fields and records
+    std::ostringstream zip;
+    auto le = [&](std::uint64_t v, int_t bytes) { matazure::internal::write_le(zip, v, bytes); };
+    std::string name = "a.npy";
+    le(0x04034b50, 4);
+    le(45, 2);
+    le(0, 2);
+    le(0, 2);
+    le(0, 4);
+    le(matazure::internal::crc32(reinterpret_cast<const byte*>(data.data()), data.size()), 4);
+    le(0xffffffffu, 4);
+    le(0xffffffffu, 4);
+    le(name.size(), 2);
+    le(20, 2);
+    zip << name;
+    le(0x0001, 2);
+    le(16, 2);
+    le(data.size(), 8);
+    le(data.size(), 8);
+    zip << data;
+
+    std::uint64_t directory = zip.tellp();
+    le(0x02014b50, 4);
+    le(45, 2);
+    le(45, 2);
+    le(0, 2);
+    le(0, 2);
+    le(0, 4);
+    le(matazure::internal::crc32(reinterpret_cast<const byte*>(data.data()), data.size()), 4);
+    le(0xffffffffu, 4);
+    le(0xffffffffu, 4);
+    le(name.size(), 2);
+    le(28, 2);
+    le(0, 2);
+    le(0, 2);
+    le(0, 2);
+    le(0, 4);
+    le(0xffffffffu, 4);
+    zip << name;
+    le(0x0001, 2);
+    le(24, 2);
+    le(data.size(), 8);
+    le(data.size(), 8);
+    le(0, 8);
+
+    std::uint64_t eocd64 = zip.tellp();
+    le(0x06064b50, 4);
+    le(44, 8);
+    le(45, 2);
+    le(45, 2);
+    le(0, 4);
+    le(0, 4);
+    le(1, 8);
+    le(1, 8);
+    le(eocd64 - directory, 8);
+    le(directory, 8);
+    le(0x07064b50, 4);
+    le(0, 4);
+    le(eocd64, 8);
+    le(1, 4);
+    le(0x06054b50, 4);
+    le(0, 2);
+    le(0, 2);
+    le(0xffff, 2);
+    le(0xffff, 2);
+    le(0xffffffffu, 4);
+    le(0xffffffffu, 4);
+    le(0, 2);
+    std::ofstream(path, std::ios::binary) << zip.str();
+
+    auto arrays = load_npz(path);
+    EXPECT_EQ(1u, arrays.size());
+    EXPECT_EQ(dynamic_shape{3}, arrays["a"].shape());
+    EXPECT_EQ(-1, arrays["a"].data<std::int16_t>()[0]);
+    EXPECT_EQ(1, arrays["a"].data<std::int16_t>()[2]);
+
+    // the zip64 extra field is truncated
+    auto bytes = zip.str();
+    bytes[directory + 30] = 12;
+    std::ofstream(path, std::ios::binary) << bytes;
+    EXPECT_THROW(load_npz(path), invalid_file_format);
+    std::remove(path.c_str());
+}
@@ -0,0 +1 @@
+#include "ut_numa_allocator.hpp"
\ No newline at end of file
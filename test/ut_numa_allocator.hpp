@@ -0,0 +1,75 @@
+#pragma once
+
+#include "ut_foundation.hpp"
+
+namespace {
+
+// a policy which records the ranges of its for_index and runs them sequentially
+struct recording_policy {};
+
+std::vector<std::pair<int_t, int_t>>& recorded_ranges() {
+    static std::vector<std::pair<int_t, int_t>> instance;
+    return instance;
+}
+
+template <typename _Fun>
+void for_index(recording_policy, int_t first, int_t last, _Fun fun) {
+    recorded_ranges().push_back(std::make_pair(first, last));
+    for (int_t i = first; i < last; ++i) {
+        fun(i);
+    }
+}
+
+}  // namespace
+
+TEST(NumaAllocatorTests, ParseNodeList) {
+    auto nodes = numa_node_set::parse("0-3,6");
+    EXPECT_EQ(5, nodes.size());
+    EXPECT_TRUE(nodes.contains(0));
+    EXPECT_TRUE(nodes.contains(3));
+    EXPECT_FALSE(nodes.contains(4));
+    EXPECT_TRUE(nodes.contains(6));
+
+    EXPECT_EQ(1, numa_node_set::parse("0\n").size());
+    EXPECT_TRUE(numa_node_set::parse("").empty());
+    EXPECT_EQ(uint64_t(0x5), numa_node_set::parse("0,2").mask());
+}
+
+TEST(NumaAllocatorTests, MemoryNodes) {
+    // without the sysfs the host is taken as the single node 0
+    auto nodes = numa::memory_nodes();
+    EXPECT_FALSE(nodes.empty());
+}
+
+TEST(NumaAllocatorTests, Modes) {
+    typedef numa_allocator<float, sequence_policy> allocator_type;
+    numa_mode modes[] = {numa_mode::interleave, numa_mode::bind, numa_mode::local};
+    for (auto mode : modes) {
+        // the large one is mapped, the small one falls back to the aligned allocation
+        for (auto side : {4, 1024}) {
+            tensor<float, 2, row_major_layout<2>, allocator_type> ts(
+                pointi<2>{side, side}, allocator_type(mode));
+            EXPECT_EQ(mode, ts.get_allocator().mode());
+            for (int_t i = 0; i < ts.size(); ++i) {
+                EXPECT_EQ(0.0f, ts[i]);
+                ts[i] = static_cast<float>(i);
+            }
+            auto ts_copy = ts;
+            EXPECT_EQ(static_cast<float>(ts.size() - 1), ts_copy[ts.size() - 1]);
+        }
+    }
+}
+
+TEST(NumaAllocatorTests, FirstTouchByPolicy) {
+    typedef numa_allocator<int_t, recording_policy> allocator_type;
+    recorded_ranges().clear();
+
+    tensor<int_t, 2, row_major_layout<2>, allocator_type> ts(pointi<2>{37, 1000});
+    // constructed by the rows, the same range for_index of the policy runs on the shape
+    ASSERT_EQ(1u, recorded_ranges().size());
+    EXPECT_EQ(0, recorded_ranges()[0].first);
+    EXPECT_EQ(37, recorded_ranges()[0].second);
+    for (int_t i = 0; i < ts.size(); ++i) {
+        EXPECT_EQ(0, ts[i]);
+    }
+}
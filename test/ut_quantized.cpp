@@ -0,0 +1 @@
+#include "ut_quantized.hpp"
\ No newline at end of file
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "ut_foundation.hpp"
+
+namespace {
+
+template <typename _ValueType, int_t _Rank>
+inline tensor<float, _Rank> dequantized(const quantized_tensor<_ValueType, _Rank>& ts) {
+    tensor<float, _Rank> re(ts.shape());
+    dequantize(ts, re);
+    return re;
+}
+
+}  // namespace
+
+TEST(QuantizedTests, QuantizeDequantize) {
+    tensor<float, 2> ts(pointi<2>{13, 3});
+    for_index(0, ts.size(), [=](int_t i) { ts[i] = static_cast<float>(i % 23) * 0.7f - 5.0f; });
+
+    quantized_tensor<byte, 2> ts_q(ts.shape(), 0.1f, 64);
+    quantize(ts, ts_q);
+    auto ts_re = dequantized(ts_q);
+    for_index(0, ts.size(), [=](int_t i) { EXPECT_NEAR(ts[i], ts_re[i], 0.05f + 1e-5f); });
+
+    tensor<float, 1> scales(pointi<1>{3});
+    tensor<int_t, 1> zero_points(pointi<1>{3});
+    scales[0] = 0.1f, scales[1] = 0.15f, scales[2] = 0.2f;
+    zero_points[0] = -10, zero_points[1] = 0, zero_points[2] = 10;
+    quantized_tensor<std::int8_t, 2> ts_qa(ts.shape(), 1, scales, zero_points);
+    quantize(ts, ts_qa);
+    auto ts_re_a = dequantized(ts_qa);
+    for_index(ts.shape(), [=](pointi<2> idx) {
+        EXPECT_NEAR(ts(idx), ts_re_a(idx), scales[idx[1]] / 2 + 1e-5f);
+    });
+}
+
+TEST(QuantizedTests, AddMulRequantization) {
+    pointi<2> shape{17, 9};
+    quantized_tensor<byte, 2> ts_lhs(shape, 0.05f, 128);
+    quantized_tensor<std::int8_t, 2> ts_rhs(shape, 0.03f, 3);
+    for_index(0, ts_lhs.values().size(), [=](int_t i) {
+        ts_lhs.values()[i] = static_cast<byte>(i * 7 % 256);
+        ts_rhs.values()[i] = static_cast<std::int8_t>(i * 13 % 256 - 128);
+    });
+    auto lhs = dequantized(ts_lhs);
+    auto rhs = dequantized(ts_rhs);
+
+    sequence_policy policy;
+    quantized_tensor<byte, 2> ts_sum(shape, 0.1f, 100);
+    quantized_add(policy, ts_lhs, ts_rhs, ts_sum);
+    quantized_tensor<std::int8_t, 2> ts_product(shape, 0.2f, 0);
+    quantized_mul(policy, ts_lhs, ts_rhs, ts_product);
+
+    for_index(0, lhs.size(), [=](int_t i) {
+        auto sum = lhs[i] + rhs[i];
+        auto q_sum = std::min(255.0f, std::max(0.0f, std::round(sum / 0.1f) + 100));
+        EXPECT_NEAR(q_sum, ts_sum.values()[i], 1);
+        auto product = lhs[i] * rhs[i];
+        auto q_product = std::min(127.0f, std::max(-128.0f, std::round(product / 0.2f)));
+        EXPECT_NEAR(q_product, ts_product.values()[i], 1);
+    });
+}
+
+TEST(QuantizedTests, AddInt16RangeLimits) {
+    pointi<1> shape{6};
+    quantized_tensor<std::int16_t, 1> ts_lhs(shape, 0.01f, -32768);
+    quantized_tensor<std::int16_t, 1> ts_rhs(shape, 0.02f, 32767);
+    std::int16_t lhs_values[] = {-32768, 32767, 32767, 0, -32768, 12345};
+    std::int16_t rhs_values[] = {32767, -32768, 32767, 0, -32768, -12345};
+    for (int_t i = 0; i < shape[0]; ++i) {
+        ts_lhs.values()[i] = lhs_values[i];
+        ts_rhs.values()[i] = rhs_values[i];
+    }
+    auto lhs = dequantized(ts_lhs);
+    auto rhs = dequantized(ts_rhs);
+
+    quantized_tensor<std::int16_t, 1> ts_sum(shape, 0.05f, 0);
+    quantized_add(sequence_policy{}, ts_lhs, ts_rhs, ts_sum);
+    for (int_t i = 0; i < shape[0]; ++i) {
+        auto sum = std::round((lhs[i] + rhs[i]) / 0.05f);
+        auto q_sum = std::min(32767.0f, std::max(-32768.0f, sum));
+        EXPECT_NEAR(q_sum, ts_sum.values()[i], 1);
+    }
+}
+
+TEST(QuantizedTests, Matmul) {
+    int_t m = 7, k = 67, n = 5;
+    quantized_tensor<byte, 2> ts_lhs(pointi<2>{m, k}, 0.02f, 120);
+    tensor<float, 1> scales(pointi<1>{n});
+    tensor<int_t, 1> zero_points(pointi<1>{n});
+    for (int_t j = 0; j < n; ++j) {
+        scales[j] = 0.01f * (j + 1);
+        zero_points[j] = j - 2;
+    }
+    quantized_tensor<std::int8_t, 2> ts_rhs(pointi<2>{k, n}, 1, scales, zero_points);
+    for_index(0, ts_lhs.values().size(), [=](int_t i) {
+        ts_lhs.values()[i] = static_cast<byte>((i * 37 + 11) % 256);
+    });
+    for_index(0, ts_rhs.values().size(), [=](int_t i) {
+        ts_rhs.values()[i] = static_cast<std::int8_t>((i * 53 + 7) % 256 - 128);
+    });
+    auto lhs = dequantized(ts_lhs);
+    auto rhs = dequantized(ts_rhs);
+
+    sequence_policy policy;
+    quantized_tensor<std::int8_t, 2> ts_dst(pointi<2>{m, n}, 0.5f, -3);
+    quantized_matmul(policy, ts_lhs, ts_rhs, ts_dst);
+
+    for_index(ts_dst.shape(), [=](pointi<2> idx) {
+        float sum = 0;
+        for (int_t i = 0; i < k; ++i) sum += lhs(idx[0], i) * rhs(i, idx[1]);
+        auto q = std::min(127.0f, std::max(-128.0f, std::round(sum / 0.5f) - 3));
+        EXPECT_NEAR(q, ts_dst.values()(idx), 1);
+    });
+}
+
+TEST(QuantizedTests, Conv) {
+    // the narrow source is smaller than the kernel, some kernel columns miss it entirely
+    for (auto shape : {pointi<2>{11, 23}, pointi<2>{4, 2}}) {
+        quantized_tensor<byte, 2> ts_src(shape, 0.04f, 30);
+        for_index(0, ts_src.values().size(), [=](int_t i) {
+            ts_src.values()[i] = static_cast<byte>((i * 29 + 3) % 256);
+        });
+        quantized_tensor<std::int8_t, 2> ts_kernel(pointi<2>{3, 5}, 0.01f, 0);
+        for_index(0, ts_kernel.values().size(), [=](int_t i) {
+            ts_kernel.values()[i] = static_cast<std::int8_t>(i * 17 % 200 - 100);
+        });
+        auto src = dequantized(ts_src);
+        auto kernel = dequantized(ts_kernel);
+
+        sequence_policy policy;
+        quantized_tensor<byte, 2> ts_dst(shape, 0.1f, 128);
+        quantized_conv(policy, ts_src, ts_kernel, ts_dst);
+
+        for_index(shape, [=](pointi<2> idx) {
+            float sum = 0;
+            for_index(kernel.shape(), [&](pointi<2> neighbor_idx) {
+                auto src_idx = idx + neighbor_idx - kernel.shape() / 2;
+                if (!inside_rect(src_idx, pointi<2>{0, 0}, shape)) return;
+                sum += kernel(neighbor_idx) * src(src_idx);
+            });
+            auto q = std::min(255.0f, std::max(0.0f, std::round(sum / 0.1f) + 128));
+            EXPECT_NEAR(q, ts_dst.values()(idx), 1);
+        });
+    }
+}
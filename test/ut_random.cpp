@@ -0,0 +1 @@
+#include "ut_random.hpp"
\ No newline at end of file
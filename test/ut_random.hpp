@@ -0,0 +1,73 @@
+#pragma once
+
+#include "ut_foundation.hpp"
+
+TEST(RandomTests, Philox4x32KnownAnswer) {
+    // the known answers of Random123
+    auto re = philox4x32_10(philox4x32_counter{0, 0, 0, 0}, philox4x32_key{0, 0});
+    EXPECT_EQ(0x6627e8d5u, re[0]);
+    EXPECT_EQ(0xe169c58du, re[1]);
+    EXPECT_EQ(0xbc57ac4cu, re[2]);
+    EXPECT_EQ(0x9b00dbd8u, re[3]);
+
+    re = philox4x32_10(philox4x32_counter{0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu},
+                       philox4x32_key{0xffffffffu, 0xffffffffu});
+    EXPECT_EQ(0x408f276du, re[0]);
+    EXPECT_EQ(0x41c83b0eu, re[1]);
+    EXPECT_EQ(0xa20bc7c6u, re[2]);
+    EXPECT_EQ(0x6d5451fdu, re[3]);
+
+    re = philox4x32_10(philox4x32_counter{0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u},
+                       philox4x32_key{0xa4093822u, 0x299f31d0u});
+    EXPECT_EQ(0xd16cfe09u, re[0]);
+    EXPECT_EQ(0x94fdccebu, re[1]);
+    EXPECT_EQ(0x5001e420u, re[2]);
+    EXPECT_EQ(0x24126ea1u, re[3]);
+}
+
+TEST(RandomTests, FillEqualView) {
+    // the size isn't a multiple of the group size
+    pointi<2> shape{37, 19};
+    tensor<float, 2> ts_uniform(shape);
+    fill_random_uniform(ts_uniform, 2020, 7);
+    auto ts_uniform_view = view::random_uniform<float>(shape, 2020, 7).persist();
+    for (int_t i = 0; i < ts_uniform.size(); ++i) {
+        ASSERT_EQ(ts_uniform_view[i], ts_uniform[i]);
+        ASSERT_GE(ts_uniform[i], 0.0f);
+        ASSERT_LT(ts_uniform[i], 1.0f);
+    }
+
+    tensor<double, 2> ts_normal(shape);
+    fill_random_normal(ts_normal, 2020, 7);
+    auto ts_normal_view = view::random_normal<double>(shape, 2020, 7).persist();
+    for (int_t i = 0; i < ts_normal.size(); ++i) {
+        ASSERT_EQ(ts_normal_view[i], ts_normal[i]);
+    }
+
+    // the other stream is independent
+    tensor<float, 2> ts_other(shape);
+    fill_random_uniform(ts_other, 2020, 8);
+    int_t equal_count = 0;
+    for (int_t i = 0; i < ts_other.size(); ++i) {
+        equal_count += ts_other[i] == ts_uniform[i];
+    }
+    EXPECT_LT(equal_count, 3);
+}
+
+TEST(RandomTests, Moments) {
+    tensor<double, 1> ts_uniform(pointi<1>{1 << 16});
+    tensor<double, 1> ts_normal(ts_uniform.shape());
+    fill_random_uniform(ts_uniform, 1, 0);
+    fill_random_normal(ts_normal, 1, 0);
+
+    double uniform_sum = 0, normal_sum = 0, normal_square_sum = 0;
+    for (int_t i = 0; i < ts_uniform.size(); ++i) {
+        uniform_sum += ts_uniform[i];
+        normal_sum += ts_normal[i];
+        normal_square_sum += ts_normal[i] * ts_normal[i];
+    }
+    auto size = static_cast<double>(ts_uniform.size());
+    EXPECT_NEAR(0.5, uniform_sum / size, 0.01);
+    EXPECT_NEAR(0.0, normal_sum / size, 0.02);
+    EXPECT_NEAR(1.0, normal_square_sum / size, 0.02);
+}
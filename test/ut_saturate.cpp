@@ -0,0 +1 @@
+#include "ut_saturate.hpp"
\ No newline at end of file
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "ut_foundation.hpp"
+
+TEST(SaturateTests, Scalar) {
+    for (int_t a = 0; a < 256; ++a) {
+        for (int_t b = 0; b < 256; ++b) {
+            auto x = static_cast<byte>(a);
+            auto y = static_cast<byte>(b);
+            EXPECT_EQ(std::min(a + b, 255), saturate_add(x, y));
+            EXPECT_EQ(std::max(a - b, 0), saturate_sub(x, y));
+            EXPECT_EQ(static_cast<int_t>(std::lround(a * b / 255.0)), mul_q8(x, y));
+            EXPECT_EQ(static_cast<int_t>(std::lround((a * (255 - b) + 255 * b) / 255.0)),
+                      blend_q8(x, 255, y));
+        }
+    }
+
+    short lowest = -32768;
+    short highest = 32767;
+    EXPECT_EQ(highest, saturate_add(highest, short(1)));
+    EXPECT_EQ(lowest, saturate_sub(lowest, short(1)));
+    EXPECT_EQ(highest, mul_q15(lowest, lowest));
+    EXPECT_EQ(short(-8192), mul_q15(short(16384), lowest / 2));
+    EXPECT_EQ(short(100), blend_q15(short(100), short(-100), short(0)));
+    EXPECT_EQ(short(0), blend_q15(short(100), short(-100), short(16384)));
+}
+
+TEST(SaturateTests, DenseEqualScalar) {
+    tensor<byte, 2> ts_lhs(pointi<2>{37, 19});
+    tensor<byte, 2> ts_rhs(ts_lhs.shape());
+    for_index(0, ts_lhs.size(), [=](int_t i) {
+        ts_lhs[i] = static_cast<byte>(i * 7);
+        ts_rhs[i] = static_cast<byte>(i * 13 + 5);
+    });
+
+    tensor<byte, 2> ts_adds(ts_lhs.shape());
+    tensor<byte, 2> ts_subs(ts_lhs.shape());
+    tensor<byte, 2> ts_mul(ts_lhs.shape());
+    tensor<byte, 2> ts_blend(ts_lhs.shape());
+    adds(sequence_policy{}, ts_lhs, ts_rhs, ts_adds);
+    subs(sequence_policy{}, ts_lhs, ts_rhs, ts_subs);
+    mulq8(sequence_policy{}, ts_lhs, ts_rhs, ts_mul);
+    blendq8(sequence_policy{}, ts_lhs, ts_rhs, 77, ts_blend);
+    for_index(0, ts_lhs.size(), [=](int_t i) {
+        EXPECT_EQ(saturate_add(ts_lhs[i], ts_rhs[i]), ts_adds[i]);
+        EXPECT_EQ(saturate_sub(ts_lhs[i], ts_rhs[i]), ts_subs[i]);
+        EXPECT_EQ(mul_q8(ts_lhs[i], ts_rhs[i]), ts_mul[i]);
+        EXPECT_EQ(blend_q8(ts_lhs[i], ts_rhs[i], 77), ts_blend[i]);
+    });
+
+    tensor<short, 1> ts_lhs_s(pointi<1>{1001});
+    tensor<short, 1> ts_rhs_s(ts_lhs_s.shape());
+    for_index(0, ts_lhs_s.size(), [=](int_t i) {
+        ts_lhs_s[i] = static_cast<short>(i * 977 - 32768);
+        ts_rhs_s[i] = static_cast<short>(32767 - i * 1013);
+    });
+    ts_lhs_s[0] = ts_rhs_s[0] = -32768;
+
+    tensor<short, 1> ts_adds_s(ts_lhs_s.shape());
+    tensor<short, 1> ts_mul_s(ts_lhs_s.shape());
+    tensor<short, 1> ts_blend_s(ts_lhs_s.shape());
+    adds(sequence_policy{}, ts_lhs_s, ts_rhs_s, ts_adds_s);
+    mulq15(sequence_policy{}, ts_lhs_s, ts_rhs_s, ts_mul_s);
+    blendq15(sequence_policy{}, ts_lhs_s, ts_rhs_s, 12345, ts_blend_s);
+    for_index(0, ts_lhs_s.size(), [=](int_t i) {
+        EXPECT_EQ(saturate_add(ts_lhs_s[i], ts_rhs_s[i]), ts_adds_s[i]);
+        EXPECT_EQ(mul_q15(ts_lhs_s[i], ts_rhs_s[i]), ts_mul_s[i]);
+        EXPECT_EQ(blend_q15(ts_lhs_s[i], ts_rhs_s[i], 12345), ts_blend_s[i]);
+    });
+}
+
+TEST(SaturateTests, ViewOfPoints) {
+    tensor<point3b, 2> ts_lhs(pointi<2>{11, 23});
+    tensor<point3b, 2> ts_rhs(ts_lhs.shape());
+    for_index(0, ts_lhs.size(), [=](int_t i) {
+        ts_lhs[i] = point3b{static_cast<byte>(i), static_cast<byte>(i * 3), 200};
+        ts_rhs[i] = point3b{static_cast<byte>(i * 5), 100, static_cast<byte>(i * 11)};
+    });
+
+    auto ts_adds = view::adds(ts_lhs, ts_rhs).persist();
+    auto ts_blend = view::blendq8(ts_lhs, ts_rhs, 128).persist();
+    // the sliced view is array indexing, it's evaluated element by element
+    auto ts_subs = view::subs(view::slice(ts_lhs, pointi<2>{1, 2}, pointi<2>{5, 7}),
+                              view::slice(ts_rhs, pointi<2>{1, 2}, pointi<2>{5, 7}))
+                       .persist();
+    for_index(ts_lhs.shape(), [=](pointi<2> idx) {
+        for (int_t c = 0; c < 3; ++c) {
+            EXPECT_EQ(saturate_add(ts_lhs(idx)[c], ts_rhs(idx)[c]), ts_adds(idx)[c]);
+            EXPECT_EQ(blend_q8(ts_lhs(idx)[c], ts_rhs(idx)[c], 128), ts_blend(idx)[c]);
+        }
+    });
+    for_index(ts_subs.shape(), [=](pointi<2> idx) {
+        auto src_idx = idx + pointi<2>{1, 2};
+        EXPECT_TRUE(equal(saturate_sub(ts_lhs(src_idx), ts_rhs(src_idx)), ts_subs(idx)));
+    });
+}
+
+TEST(SaturateTests, ViewOfRvalues) {
+    auto make_ts = [](int_t factor) {
+        tensor<byte, 2> ts(pointi<2>{13, 37});
+        for_index(0, ts.size(), [=](int_t i) { ts[i] = static_cast<byte>(i * factor); });
+        return ts;
+    };
+    auto ts_lhs = make_ts(3);
+    auto ts_rhs = make_ts(7);
+
+    // the lvalue operand is captured by its tensor_ref, the temporary one is owned by the view
+    auto ts_adds = view::adds(ts_lhs, make_ts(7)).persist();
+    auto ts_subs = view::subs(make_ts(3), ts_rhs).persist();
+    auto ts_mul = view::mulq8(make_ts(3), make_ts(7)).persist();
+    for_index(0, ts_lhs.size(), [=](int_t i) {
+        EXPECT_EQ(saturate_add(ts_lhs[i], ts_rhs[i]), ts_adds[i]);
+        EXPECT_EQ(saturate_sub(ts_lhs[i], ts_rhs[i]), ts_subs[i]);
+        EXPECT_EQ(mul_q8(ts_lhs[i], ts_rhs[i]), ts_mul[i]);
+    });
+}
@@ -0,0 +1 @@
+#include "ut_sparse.hpp"
\ No newline at end of file
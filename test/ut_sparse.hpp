@@ -0,0 +1,102 @@
+#pragma once
+
+#include "ut_foundation.hpp"
+
+namespace {
+
+inline tensor<float, 2> sparse_dense_matrix(pointi<2> shape) {
+    tensor<float, 2> ts(shape);
+    for_index(ts.shape(), [=](pointi<2> idx) {
+        auto h = (idx[0] * 31 + idx[1] * 17) % 11;
+        ts(idx) = h < 3 ? static_cast<float>(h + idx[1]) - 5.0f : 0.01f * h;
+    });
+    // a dense row
+    for (int_t j = 0; j < shape[1]; ++j) ts(pointi<2>{3, j}) = 1.0f + j;
+    return ts;
+}
+
+}  // namespace
+
+TEST(SparseTests, DenseCsrCooConversion) {
+    auto ts = sparse_dense_matrix(pointi<2>{37, 29});
+    auto sp = to_sparse(ts, 0.5f);
+    auto ts_re = to_dense(sp);
+    auto coo = to_coo(sp);
+    EXPECT_EQ(sp.nnz(), coo.nnz());
+    for_index(ts.shape(), [=](pointi<2> idx) {
+        auto expected = std::abs(ts(idx)) > 0.5f ? ts(idx) : 0.0f;
+        EXPECT_EQ(expected, ts_re(idx));
+    });
+
+    // reverses the triplets, to_csr sorts them back
+    coo_matrix<float> coo_reversed(coo.shape(), coo.nnz());
+    for_index(0, coo.nnz(), [=](int_t k) {
+        auto k_src = coo.nnz() - 1 - k;
+        coo_reversed.row_indices()[k] = coo.row_indices()[k_src];
+        coo_reversed.column_indices()[k] = coo.column_indices()[k_src];
+        coo_reversed.values()[k] = coo.values()[k_src];
+    });
+    auto sp_re = to_csr(coo_reversed);
+    for_index(0, sp.rows() + 1, [=](int_t i) {
+        EXPECT_EQ(sp.row_offsets()[i], sp_re.row_offsets()[i]);
+    });
+    for_index(0, sp.nnz(), [=](int_t k) {
+        EXPECT_EQ(sp.column_indices()[k], sp_re.column_indices()[k]);
+        EXPECT_EQ(sp.values()[k], sp_re.values()[k]);
+    });
+    auto ts_coo = to_dense(coo_reversed);
+    for_index(ts.shape(), [=](pointi<2> idx) { EXPECT_EQ(ts_re(idx), ts_coo(idx)); });
+}
+
+TEST(SparseTests, SpmvSpmmEqualDense) {
+    auto ts = sparse_dense_matrix(pointi<2>{301, 53});
+    auto sp = to_sparse(ts, 0.5f);
+    auto ts_a = to_dense(sp);
+
+    tensor<float, 1> ts_x(pointi<1>{53});
+    for_index(0, ts_x.size(), [=](int_t i) { ts_x[i] = 0.25f * (i % 7) - 0.5f; });
+    tensor<float, 1> ts_y(pointi<1>{301});
+    spmv(sp, ts_x, ts_y);
+    for (int_t i = 0; i < ts_y.size(); ++i) {
+        float expected = 0.0f;
+        for (int_t j = 0; j < ts_x.size(); ++j) expected += ts_a(pointi<2>{i, j}) * ts_x[j];
+        EXPECT_NEAR(expected, ts_y[i], 1e-3f);
+    }
+
+    tensor<float, 2> ts_b(pointi<2>{53, 5});
+    for_index(0, ts_b.size(), [=](int_t i) { ts_b[i] = 0.5f * (i % 5) - 1.0f; });
+    tensor<float, 2> ts_c(pointi<2>{301, 5});
+    spmm(sp, ts_b, ts_c);
+    for_index(ts_c.shape(), [=](pointi<2> idx) {
+        float expected = 0.0f;
+        for (int_t k = 0; k < ts_b.shape()[0]; ++k) {
+            expected += ts_a(pointi<2>{idx[0], k}) * ts_b(pointi<2>{k, idx[1]});
+        }
+        EXPECT_NEAR(expected, ts_c(idx), 1e-3f);
+    });
+}
+
+TEST(SparseTests, CsfAndSparseView) {
+    tensor<int_t, 3> ts(pointi<3>{7, 5, 9});
+    for_index(ts.shape(), [=](pointi<3> idx) {
+        ts(idx) = (idx[0] * 7 + idx[1] * 3 + idx[2]) % 5 == 0 ? idx[0] + idx[1] + idx[2] + 1 : 0;
+    });
+    // an empty slice
+    for_index(pointi<2>{5, 9}, [=](pointi<2> idx) { ts(pointi<3>{2, idx[0], idx[1]}) = 0; });
+
+    auto csf = to_csf(ts);
+    auto ts_re = to_dense(csf);
+    auto ts_view = view::sparse(csf);
+    for_index(ts.shape(), [=](pointi<3> idx) {
+        EXPECT_EQ(ts(idx), ts_re(idx));
+        EXPECT_EQ(ts(idx), ts_view(idx));
+    });
+
+    auto ts_m = sparse_dense_matrix(pointi<2>{13, 11});
+    auto sp = to_sparse(ts_m, 0.5f);
+    auto ts_sum = (view::sparse(sp) + ts_m).persist();
+    for_index(ts_m.shape(), [=](pointi<2> idx) {
+        auto v = std::abs(ts_m(idx)) > 0.5f ? ts_m(idx) : 0.0f;
+        EXPECT_EQ(v + ts_m(idx), ts_sum(idx));
+    });
+}
@@ -62,4 +62,159 @@ TEST(TensorTests, Layout) {
     ASSERT_EQ(11, ts_column[3]);
     ASSERT_EQ(2, ts_column[4]);
     ASSERT_EQ(12, ts_column[5]);
-}
\ No newline at end of file
+}
+
+TEST(TensorTests, TensorRef) {
+    tensor<float, 2> ts{{0, 1, 2}, {10, 11, 12}};
+    static_assert(std::is_trivially_copyable<tensor_ref<float, 2>>::value,
+                  "tensor_ref should be trivially copyable");
+
+    auto ts_ref = make_tensor_ref(ts);
+    ASSERT_EQ(ts.data(), ts_ref.data());
+    ASSERT_TRUE(equal(ts.shape(), ts_ref.shape()));
+    ts_ref(1, 2) = 100;
+    ASSERT_EQ(100, ts(1, 2));
+
+    tensor_ref<const float, 2> ts_cref = ts;
+    ASSERT_EQ(11, ts_cref(1, 1));
+
+    // the views capture the tensor by its tensor_ref, the reference count is not touched
+    auto use_count = ts.shared_data().use_count();
+    auto ts_view = view::slice(view::map(ts, [](float v) { return v * 2; }), point2i{1, 1},
+                               point2i{1, 2});
+    ASSERT_EQ(use_count, ts.shared_data().use_count());
+    ASSERT_EQ(22, ts_view(0, 0));
+    ASSERT_EQ(200, ts_view(0, 1));
+}
+
+TEST(TensorTests, ViewOwnsRvalueTensor) {
+    auto make_ts = [](float v) {
+        tensor<float, 2> ts(point2i{2, 3});
+        fill(ts, v);
+        return ts;
+    };
+    tensor<float, 2> ts_lvalue = make_ts(1.0f);
+
+    // the temporaries are destroyed after the views are built, the views own their memory
+    auto ts_sub = make_ts(2.0f) - ts_lvalue;
+    auto ts_add = ts_lvalue + make_ts(3.0f);
+    auto ts_mul = make_ts(4.0f) * make_ts(5.0f);
+    auto ts_value_mul = make_ts(2.0f) * 3.0f;
+    auto ts_value_sub = 3.0f - make_ts(2.0f);
+    auto ts_slice = view::slice(make_ts(7.0f), point2i{1, 1}, point2i{1, 2});
+    auto ts_cast = view::cast<int>(make_ts(8.0f));
+    ASSERT_EQ(1.0f, ts_sub(1, 2));
+    ASSERT_EQ(4.0f, ts_add(1, 2));
+    ASSERT_EQ(20.0f, ts_mul(1, 2));
+    ASSERT_EQ(6.0f, ts_value_mul(1, 2));
+    ASSERT_EQ(1.0f, ts_value_sub(1, 2));
+    ASSERT_EQ(7.0f, ts_slice(0, 1));
+    ASSERT_EQ(8, ts_cast(1, 2));
+
+    // a moved tensor is shared by the view, an lvalue one is referenced
+    tensor<float, 2> ts_moved = make_ts(9.0f);
+    auto sp_data = ts_moved.shared_data();
+    auto use_count = sp_data.use_count();
+    auto ts_view = view::map(std::move(ts_moved), [](float v) { return v + 1; });
+    ASSERT_EQ(use_count + 1, sp_data.use_count());
+    auto ts_ref_view = view::map(ts_lvalue, [](float v) { return v + 1; });
+    ASSERT_EQ(2.0f, ts_ref_view(0, 0));
+    ts_moved = tensor<float, 2>{};
+    sp_data.reset();
+    ASSERT_EQ(10.0f, ts_view(1, 2));
+}
+
+TEST(TensorTests, Move) {
+    tensor<int, 2> ts_src{{1, 2}, {3, 4}};
+    auto p_data = ts_src.data();
+
+    tensor<int, 2> ts_dst(std::move(ts_src));
+    ASSERT_EQ(p_data, ts_dst.data());
+    ASSERT_EQ(nullptr, ts_src.shared_data());
+    ASSERT_EQ(nullptr, ts_src.data());
+    ASSERT_EQ(0, ts_src.size());
+
+    tensor<int, 2> ts_other(pointi<2>{3, 3});
+    ts_other = std::move(ts_dst);
+    ASSERT_EQ(p_data, ts_other.data());
+    ASSERT_EQ(2, ts_other.shape(0));
+    ASSERT_EQ(4, ts_other(1, 1));
+    ASSERT_EQ(nullptr, ts_dst.data());
+}
+
+TEST(TensorTests, PersistInto) {
+    tensor<int, 1> ts{0, 1, 2, 3, 4, 5};
+    tensor<int, 1> ts_dst(ts.shape());
+    auto p_data = ts_dst.data();
+    view::map(ts, [](int v) { return v * 2; }).persist_into(ts_dst);
+    ASSERT_EQ(p_data, ts_dst.data());
+    for (int_t i = 0; i < ts.size(); ++i) {
+        ASSERT_EQ(ts[i] * 2, ts_dst[i]);
+    }
+
+    // the reversed view reads the buffer it writes, it's evaluated by a ping-pong buffer
+    auto size = ts.size();
+    make_lambda(ts.shape(), [ts, size](int_t i) { return ts[size - 1 - i]; }).persist_into(ts);
+    for (int_t i = 0; i < size; ++i) {
+        ASSERT_EQ(size - 1 - i, ts[i]);
+    }
+}
+
+TEST(TensorTests, PersistIntoOffsetSubView) {
+    tensor<int, 1> ts{0, 1, 2, 3, 4, 5};
+    tensor<int, 1> ts_other(ts.shape());
+
+    // the slice reads ts from its base, which is before the sub-view but overlaps it
+    tensor_ref<int, 1> ts_tail(ts.data() + 2, row_major_layout<1>(pointi<1>{4}));
+    auto ts_head = view::slice(ts, pointi<1>{0}, pointi<1>{4});
+    auto first = ts_tail.data();
+    auto last = ts_tail.data() + ts_tail.size();
+    ASSERT_TRUE(matazure::internal::may_alias(ts_head, first, last));
+    ASSERT_FALSE(matazure::internal::may_alias(view::map(ts_other, [](int v) { return v * 2; }),
+                                               first, last));
+    // a lambda capturing a pointer is unknown, it's treated as aliased
+    auto p_other = ts_other.data();
+    ASSERT_TRUE(matazure::internal::may_alias(
+        make_lambda(ts_other.shape(), [p_other](int_t i) { return p_other[i]; }), first, last));
+
+    ts_head.persist_into(ts_tail);
+    tensor<int, 1> ts_expected{0, 1, 0, 1, 2, 3};
+    for (int_t i = 0; i < ts.size(); ++i) {
+        ASSERT_EQ(ts_expected[i], ts[i]);
+    }
+}
+
+namespace {
+
+int global_values[4] = {0, 1, 2, 3};
+
+/// an empty functor which reads a global, its may_alias member is used rather than its emptiness
+struct global_reversed_functor {
+    int operator()(int_t i) const { return global_values[3 - i]; }
+
+    bool may_alias(const void* first, const void* last) const {
+        return matazure::internal::ranges_overlap(global_values, global_values + 4, first, last);
+    }
+};
+
+}  // namespace
+
+TEST(TensorTests, PersistIntoScratch) {
+    static_assert(std::is_empty<global_reversed_functor>::value, "the functor should be empty");
+    tensor_ref<int, 1> ts_global(global_values, row_major_layout<1>(pointi<1>{4}));
+    auto ts_view = make_lambda(ts_global.shape(), global_reversed_functor{});
+    tensor<int, 1> ts_other(ts_global.shape());
+    ASSERT_TRUE(matazure::internal::may_alias(ts_view, global_values, global_values + 4));
+    ASSERT_FALSE(matazure::internal::may_alias(ts_view, ts_other.data(), ts_other.data() + 4));
+
+    // the aliased view is evaluated into the scratch tensor, no buffer is allocated
+    tensor<int, 1> ts_scratch(ts_global.shape());
+    auto p_scratch = ts_scratch.data();
+    sequence_policy policy{};
+    ts_view.persist_into(policy, ts_global, ts_scratch);
+    ASSERT_EQ(p_scratch, ts_scratch.data());
+    for (int_t i = 0; i < 4; ++i) {
+        ASSERT_EQ(3 - i, global_values[i]);
+        ASSERT_EQ(3 - i, ts_scratch[i]);
+    }
+}
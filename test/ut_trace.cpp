@@ -0,0 +1 @@
+#include "ut_trace.hpp"
\ No newline at end of file
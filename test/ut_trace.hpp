@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include <thread>
+#include "ut_foundation.hpp"
+
+// it's built as the ut_trace executable which defines MATAZURE_TRACE for all its units
+namespace {
+
+struct traced_value {
+    float value;
+};
+
+int_t count_events(const std::vector<trace::event>& events, const std::string& name) {
+    return static_cast<int_t>(
+        std::count_if(events.begin(), events.end(),
+                      [&name](const trace::event& e) { return name == e.name; }));
+}
+
+}  // namespace
+
+TEST(TraceTests, AlgorithmEvents) {
+    trace::clear();
+
+    tensor<traced_value, 2> ts_src(pointi<2>{4, 8});
+    tensor<traced_value, 2> ts_dst(ts_src.shape());
+    fill(ts_src, traced_value{1.0f});
+    copy(ts_src, ts_dst);
+    transform(ts_src, ts_dst, [](traced_value x) { return traced_value{x.value * 2}; });
+
+    auto events = trace::collect();
+    EXPECT_EQ(1, count_events(events, "fill"));
+    EXPECT_EQ(1, count_events(events, "copy"));
+    EXPECT_EQ(1, count_events(events, "transform"));
+    EXPECT_EQ(1, count_events(events, "for_each"));
+    EXPECT_EQ(3, count_events(events, "for_index"));
+
+    auto it = std::find_if(events.begin(), events.end(),
+                           [](const trace::event& e) { return std::string("copy") == e.name; });
+    ASSERT_NE(events.end(), it);
+    EXPECT_STREQ("sequence", it->policy);
+    EXPECT_EQ(2, it->rank);
+    EXPECT_EQ(4, it->shape[0]);
+    EXPECT_EQ(8, it->shape[1]);
+    EXPECT_EQ(static_cast<int_t>(sizeof(traced_value)), it->element_size);
+    EXPECT_EQ(32 * 4, it->bytes_read);
+    EXPECT_EQ(32 * 4, it->bytes_written);
+    EXPECT_LE(it->begin_ns, it->end_ns);
+    EXPECT_FLOAT_EQ(2.0f, ts_dst[31].value);
+}
+
+TEST(TraceTests, PersistNestsCopy) {
+    trace::clear();
+
+    auto lts = make_lambda(pointi<1>{100}, [](int_t i) { return traced_value{float(i)}; });
+    auto ts = lts.persist();
+    EXPECT_FLOAT_EQ(99.0f, ts[99].value);
+
+    auto events = trace::collect();
+    ASSERT_EQ(3u, events.size());
+    EXPECT_STREQ("persist", events[0].name);
+    EXPECT_STREQ("copy", events[1].name);
+    EXPECT_STREQ("for_index", events[2].name);
+    EXPECT_EQ(100, events[2].shape[0]);
+    EXPECT_LE(events[0].begin_ns, events[1].begin_ns);
+    EXPECT_GE(events[0].end_ns, events[1].end_ns);
+}
+
+TEST(TraceTests, Disabled) {
+    trace::clear();
+    trace::set_enabled(false);
+    for_index(0, 10, [](int_t) {});
+    trace::set_enabled(true);
+    EXPECT_TRUE(trace::collect().empty());
+}
+
+TEST(TraceTests, ThreadBuffers) {
+    trace::clear();
+
+    std::vector<std::thread> threads;
+    for (int_t t = 0; t < 4; ++t) {
+        threads.emplace_back([]() {
+            for (int_t i = 0; i < 3000; ++i) {
+                for_index(0, 1, [](int_t) {});
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto events = trace::collect();
+    EXPECT_EQ(12000u, events.size());
+    std::set<int_t> thread_ids;
+    for (auto& e : events) {
+        thread_ids.insert(e.thread);
+    }
+    EXPECT_EQ(4u, thread_ids.size());
+}
+
+TEST(TraceTests, ChromeTraceAndSummary) {
+    trace::clear();
+
+    tensor<traced_value, 1> ts(pointi<1>{16});
+    fill(ts, traced_value{0.0f});
+
+    std::ostringstream oss_json;
+    trace::export_chrome_trace(oss_json);
+    auto json = oss_json.str();
+    EXPECT_EQ(0u, json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"fill\",\"cat\":\"sequence\",\"ph\":\"X\""));
+    EXPECT_NE(std::string::npos, json.find("\"shape\":[16],\"element_size\":4"));
+    EXPECT_EQ("]}\n", json.substr(json.size() - 3));
+
+    auto rows = trace::summarize();
+    ASSERT_EQ(3u, rows.size());
+    EXPECT_EQ("fill", rows[0].name);
+    EXPECT_EQ(1, rows[0].count);
+    EXPECT_EQ(64, rows[0].bytes_written);
+
+    std::ostringstream oss_summary;
+    trace::print_summary(oss_summary);
+    EXPECT_NE(std::string::npos, oss_summary.str().find("for_each"));
+}
@@ -0,0 +1 @@
+#include "ut_bit.hpp"
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "../ut_foundation.hpp"
+
+TEST(ViewTests, BitTensor) {
+    bit_tensor<2> ts_a(pointi<2>{9, 15});
+    bit_tensor<2> ts_b(ts_a.shape());
+    EXPECT_EQ(3, ts_a.word_count());
+    for_index(ts_a.shape(), [=](pointi<2> idx) {
+        ts_a(idx) = (idx[0] + idx[1]) % 3 == 0;
+        ts_b(idx) = idx[1] % 2 == 0;
+    });
+
+    auto ts_and = ts_a & ts_b;
+    auto ts_or = ts_a | ts_b;
+    auto ts_xor = ts_a ^ ts_b;
+    auto ts_not = ~ts_a;
+    int_t a_count = 0;
+    for_index(ts_a.shape(), [&](pointi<2> idx) {
+        bool a = ts_a(idx), b = ts_b(idx);
+        a_count += a;
+        EXPECT_EQ(a && b, static_cast<bool>(ts_and(idx)));
+        EXPECT_EQ(a || b, static_cast<bool>(ts_or(idx)));
+        EXPECT_EQ(a != b, static_cast<bool>(ts_xor(idx)));
+        EXPECT_EQ(!a, static_cast<bool>(ts_not(idx)));
+    });
+    EXPECT_EQ(a_count, count(ts_a));
+    EXPECT_EQ(ts_a.size() - a_count, count(ts_not));
+    EXPECT_TRUE(any(ts_a));
+    EXPECT_FALSE(all(ts_a));
+    EXPECT_TRUE(all(ts_a | ts_not));
+    EXPECT_FALSE(any(ts_a & ts_not));
+
+    std::vector<int_t> offsets;
+    for_each_set_bit(ts_a, [&](int_t offset) { offsets.push_back(offset); });
+    EXPECT_EQ(a_count, static_cast<int_t>(offsets.size()));
+    for (std::size_t i = 0; i < offsets.size(); ++i) {
+        EXPECT_TRUE(ts_a[offsets[i]]);
+        if (i > 0) {
+            EXPECT_LT(offsets[i - 1], offsets[i]);
+        }
+    }
+}
+
+TEST(ViewTests, BitComparisonViews) {
+    tensor<float, 2> ts(pointi<2>{13, 21});
+    tensor<int_t, 2> ts_i(ts.shape());
+    for_index(0, ts.size(), [=](int_t i) {
+        ts[i] = static_cast<float>(i % 17) - 8.0f;
+        ts_i[i] = i % 11 - 5;
+    });
+    ts[5] = std::numeric_limits<float>::quiet_NaN();
+
+    auto ts_gt = to_bit_tensor(view::greater(ts, 0.0f));
+    auto ts_le = to_bit_tensor(view::less_equal(ts, 0.0f));
+    auto ts_ne = to_bit_tensor(view::not_equal_to(ts, 3.0f));
+    auto ts_ge_i = to_bit_tensor(view::greater_equal(ts_i, 2));
+    auto ts_lt_i = to_bit_tensor(view::less(ts_i, 2));
+    auto ts_eq_i = to_bit_tensor(view::equal_to(ts_i, -5));
+    // the array indexing view is packed element by element
+    auto ts_gt_slice = to_bit_tensor(view::slice(view::greater(ts, 0.0f), pointi<2>{0, 0},
+                                                 ts.shape()));
+    for_index(0, ts.size(), [=](int_t i) {
+        EXPECT_EQ(ts[i] > 0.0f, static_cast<bool>(ts_gt[i]));
+        EXPECT_EQ(ts[i] <= 0.0f, static_cast<bool>(ts_le[i]));
+        EXPECT_EQ(ts[i] != 3.0f, static_cast<bool>(ts_ne[i]));
+        EXPECT_EQ(ts_i[i] >= 2, static_cast<bool>(ts_ge_i[i]));
+        EXPECT_EQ(ts_i[i] < 2, static_cast<bool>(ts_lt_i[i]));
+        EXPECT_EQ(ts_i[i] == -5, static_cast<bool>(ts_eq_i[i]));
+        EXPECT_EQ(ts[i] > 0.0f, static_cast<bool>(ts_gt_slice[i]));
+    });
+}
+
+TEST(ViewTests, BitComparisonViewsOfRvalues) {
+    auto make_ts = []() {
+        tensor<float, 2> ts(pointi<2>{9, 31});
+        for_index(0, ts.size(), [=](int_t i) { ts[i] = static_cast<float>(i % 13) - 6.0f; });
+        return ts;
+    };
+    auto ts = make_ts();
+
+    // the views own the temporaries, they're packed by simd too
+    auto ts_gt = to_bit_tensor(view::greater(make_ts(), 0.0f));
+    bit_tensor<2> ts_eq(ts.shape());
+    copy(view::equal_to(make_ts(), 2.0f), ts_eq);
+    for_index(0, ts.size(), [=](int_t i) {
+        EXPECT_EQ(ts[i] > 0.0f, static_cast<bool>(ts_gt[i]));
+        EXPECT_EQ(ts[i] == 2.0f, static_cast<bool>(ts_eq[i]));
+    });
+}
@@ -0,0 +1 @@
+#include "ut_mask.hpp"
\ No newline at end of file
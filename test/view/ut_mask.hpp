@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../ut_foundation.hpp"
+
+TEST(ViewTests, MaskIndexList) {
+    tensor<bool, 2> ts_mask(pointi<2>{67, 129});
+    for_index(0, ts_mask.size(), [=](int_t i) { ts_mask[i] = (i / 7) % 5 == 0 || i % 97 == 3; });
+
+    auto indices = view::make_mask_index_list(ts_mask);
+    auto spans = view::make_mask_span_list(ts_mask);
+    int_t active_size = 0;
+    for_each(ts_mask, [&](bool v) { active_size += v; });
+    EXPECT_EQ(active_size, indices.size());
+    EXPECT_EQ(active_size, spans.active_size());
+    for_index(0, indices.size(), [=](int_t i) { EXPECT_TRUE(ts_mask(indices[i])); });
+
+    tensor<int_t, 2> ts_src(ts_mask.shape());
+    for_index(0, ts_src.size(), [=](int_t i) { ts_src[i] = i; });
+
+    tensor<int_t, 2> ts_fill(ts_mask.shape());
+    tensor<int_t, 2> ts_copy(ts_mask.shape());
+    tensor<int_t, 2> ts_transform(ts_mask.shape());
+    fill(ts_fill, -1);
+    fill(ts_copy, -1);
+    fill(ts_transform, -1);
+    fill(sequence_policy{}, indices, ts_fill, 7);
+    copy(sequence_policy{}, spans, ts_src, ts_copy);
+    // the array indexing dest is accessed by the array index
+    transform(sequence_policy{}, indices, ts_src, view::slice(ts_transform, pointi<2>{0, 0},
+                                                              ts_mask.shape()),
+              [](int_t v) { return v * 2; });
+    for_index(0, ts_src.size(), [=](int_t i) {
+        EXPECT_EQ(ts_mask[i] ? 7 : -1, ts_fill[i]);
+        EXPECT_EQ(ts_mask[i] ? i : -1, ts_copy[i]);
+        EXPECT_EQ(ts_mask[i] ? 2 * i : -1, ts_transform[i]);
+    });
+
+    int_t sum = 0;
+    for_each(sequence_policy{}, spans, ts_src, [&](int_t v) { sum += v; });
+    int_t expected_sum = 0;
+    for_index(0, ts_src.size(), [&](int_t i) { expected_sum += ts_mask[i] ? i : 0; });
+    EXPECT_EQ(expected_sum, sum);
+}
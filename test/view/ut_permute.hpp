@@ -17,3 +17,62 @@ TEST(ViewTests, Permute) {
 
     for_index(ts.shape(), [=](point2i idx) { EXPECT_EQ(ts(idx), ts_permute(idx[1], idx[0])); });
 }
+
+TEST(ViewTests, PermuteHwcToChw) {
+    tensor<float, 3> ts_hwc(pointi<3>{37, 45, 3});
+    for_index(ts_hwc.shape(), [=](pointi<3> idx) {
+        ts_hwc(idx) = static_cast<float>(idx[0] * 10000 + idx[1] * 10 + idx[2]);
+    });
+
+    auto ts_chw_view = view::permute<1, 2, 0>(ts_hwc);
+    EXPECT_TRUE(equal(ts_chw_view.shape(), pointi<3>{3, 37, 45}));
+
+    // the copy dispatches to the blocked permute_copy
+    auto ts_chw = ts_chw_view.persist();
+    for_index(ts_chw.shape(), [=](pointi<3> idx) {
+        EXPECT_EQ(ts_hwc(idx[1], idx[2], idx[0]), ts_chw(idx));
+    });
+
+    tensor<float, 3> ts_hwc_re(ts_hwc.shape());
+    permute_copy<2, 0, 1>(ts_chw, ts_hwc_re);
+    for_index(ts_hwc.shape(), [=](pointi<3> idx) { EXPECT_EQ(ts_hwc(idx), ts_hwc_re(idx)); });
+}
+
+TEST(ViewTests, TransposeEqualPermuteView) {
+    tensor<int_t, 2> ts(pointi<2>{67, 130});
+    for_index(0, ts.size(), [=](int_t i) { ts[i] = i; });
+
+    tensor<int_t, 2> ts_transposed(pointi<2>{130, 67});
+    transpose(ts, ts_transposed);
+    for_index(ts_transposed.shape(), [=](pointi<2> idx) {
+        EXPECT_EQ(ts(idx[1], idx[0]), ts_transposed(idx));
+    });
+
+    tensor<byte, 2> ts_byte(pointi<2>{33, 5});
+    for_index(0, ts_byte.size(), [=](int_t i) { ts_byte[i] = static_cast<byte>(i); });
+    auto ts_byte_transposed = view::permute<1, 0>(ts_byte).persist();
+    for_index(ts_byte_transposed.shape(), [=](pointi<2> idx) {
+        EXPECT_EQ(ts_byte(idx[1], idx[0]), ts_byte_transposed(idx));
+    });
+}
+
+TEST(ViewTests, PermuteRvalue) {
+    auto make_hwc = []() {
+        tensor<float, 3> ts(pointi<3>{21, 13, 3});
+        for_index(ts.shape(), [=](pointi<3> idx) {
+            ts(idx) = static_cast<float>(idx[0] * 10000 + idx[1] * 10 + idx[2]);
+        });
+        return ts;
+    };
+    auto ts_hwc = make_hwc();
+
+    // the view owns the temporary, the copy dispatches to permute_copy too
+    auto ts_chw_view = view::permute<1, 2, 0>(make_hwc());
+    static_assert(is_row_major_tensor<decltype(ts_chw_view.functor().tensor())>::value,
+                  "the owned source should be a row major tensor");
+    tensor<float, 3> ts_chw(ts_chw_view.shape());
+    copy(ts_chw_view, ts_chw);
+    for_index(ts_chw.shape(), [=](pointi<3> idx) {
+        EXPECT_EQ(ts_hwc(idx[1], idx[2], idx[0]), ts_chw(idx));
+    });
+}
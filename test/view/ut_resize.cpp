@@ -0,0 +1 @@
+#include "ut_resize.hpp"
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../ut_foundation.hpp"
+
+TEST(ViewTests, ResizeAreaDownsample) {
+    tensor<float, 2> ts(pointi<2>{8, 6});
+    for_index(ts.size(), [&](int_t i) { ts[i] = static_cast<float>(i); });
+
+    auto ts_resize = view::resize(ts, pointi<2>{4, 3}, interpolation::area).persist();
+    for_index(ts_resize.shape(), [&](pointi<2> idx) {
+        auto src_idx = idx * 2;
+        auto mean = (ts(src_idx) + ts(src_idx + pointi<2>{0, 1}) + ts(src_idx + pointi<2>{1, 0}) +
+                     ts(src_idx + pointi<2>{1, 1})) /
+                    4;
+        ASSERT_FLOAT_EQ(mean, ts_resize(idx));
+    });
+}
+
+TEST(ViewTests, ResizeBilinearUpsample) {
+    tensor<float, 2> ts = {{0, 4}, {8, 12}};
+    auto ts_resize = view::resize(ts, pointi<2>{4, 4}).persist();
+    // the centers of dest pixels are at -0.25, 0.25, 0.75, 1.25 of the source
+    ASSERT_FLOAT_EQ(0.0f, ts_resize(0, 0));
+    ASSERT_FLOAT_EQ(1.0f, ts_resize(0, 1));
+    ASSERT_FLOAT_EQ(3.0f, ts_resize(0, 2));
+    ASSERT_FLOAT_EQ(4.0f, ts_resize(0, 3));
+    ASSERT_FLOAT_EQ(2.0f, ts_resize(1, 0));
+    ASSERT_FLOAT_EQ(12.0f, ts_resize(3, 3));
+}
+
+template <typename _ValueType>
+void test_resize_kernel_equal_view(pointi<2> src_shape, pointi<2> dst_shape) {
+    typedef typename channel_traits<_ValueType>::scalar_type scalar_type;
+    const int_t channels = channel_traits<_ValueType>::channels;
+
+    tensor<_ValueType, 2> ts(src_shape);
+    auto p = reinterpret_cast<scalar_type*>(ts.data());
+    for (int_t i = 0; i < ts.size() * channels; ++i) {
+        p[i] = static_cast<scalar_type>((i * 37) % 251);
+    }
+
+    for (auto method : {interpolation::nearest, interpolation::bilinear, interpolation::bicubic,
+                        interpolation::area}) {
+        tensor<_ValueType, 2> ts_dst(dst_shape);
+        resize(ts, ts_dst, method);
+        auto ts_view = view::resize(ts, dst_shape, method);
+
+        auto p_dst = reinterpret_cast<scalar_type*>(ts_dst.data());
+        for_index(dst_shape, [&](pointi<2> idx) {
+            auto v = ts_view(idx);
+            auto p_v = reinterpret_cast<scalar_type*>(&v);
+            for (int_t c = 0; c < channels; ++c) {
+                auto offset = (idx[0] * dst_shape[1] + idx[1]) * channels + c;
+                ASSERT_NEAR(p_v[c], p_dst[offset], 1.01);
+            }
+        });
+    }
+}
+
+TEST(ViewTests, ResizeKernelEqualView) {
+    test_resize_kernel_equal_view<float>(pointi<2>{37, 53}, pointi<2>{17, 80});
+    test_resize_kernel_equal_view<byte>(pointi<2>{64, 48}, pointi<2>{21, 99});
+    test_resize_kernel_equal_view<point<byte, 3>>(pointi<2>{30, 40}, pointi<2>{75, 13});
+}